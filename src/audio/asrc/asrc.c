@@ -2,6 +2,7 @@
 //
 // Copyright(c) 2019 Intel Corporation. All rights reserved.
 
+#include <sof/audio/asrc/asrc_drift.h>
 #include <sof/audio/asrc/asrc_farrow.h>
 #include <sof/audio/buffer.h>
 #include <sof/audio/component.h>
@@ -27,17 +28,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
-/* Simple count value to prevent first delta timestamp
- * from being input to low-pass filter.
- */
-#define TS_STABLE_DIFF_COUNT	2
-
-/* Low pass filter coefficient for measured drift factor,
- * The low pass function is y(n) = c1 * x(n) + c2 * y(n -1)
- * coefficient c2 needs to be 1 - c1.
- */
-#define COEF_C1		Q_CONVERT_FLOAT(0.01, 30)
-#define COEF_C2		Q_CONVERT_FLOAT(0.99, 30)
+#if CONFIG_COMP_ASRC_DRIFT_LPF
+#define ASRC_DRIFT_ESTIMATOR	ASRC_DRIFT_LPF
+#else
+#define ASRC_DRIFT_ESTIMATOR	ASRC_DRIFT_KALMAN
+#endif
 
 typedef void (*asrc_proc_func)(struct comp_dev *dev,
 			       const struct audio_stream *source,
@@ -64,11 +59,7 @@ struct comp_data {
 	uint32_t sink_format;	/* For used PCM sample format */
 	uint32_t source_format;	/* For used PCM sample format */
 	uint32_t copy_count;	/* Count copy() operations  */
-	int32_t ts_prev;
-	int32_t sample_prev;
 	int32_t skew;		/* Rate factor in Q2.30 */
-	int32_t skew_min;
-	int32_t skew_max;
 	int ts_count;
 	int asrc_size;		/* ASRC object size */
 	int buf_size;		/* Samples buffer size */
@@ -82,6 +73,7 @@ struct comp_data {
 	uint8_t *ibuf[PLATFORM_MAX_CHANNELS];	/* Input channels pointers */
 	uint8_t *obuf[PLATFORM_MAX_CHANNELS];	/* Output channels pointers */
 	bool track_drift;
+	struct asrc_drift drift;	/* DAI drift estimator */
 	asrc_proc_func asrc_func;		/* ASRC processing function */
 };
 
@@ -678,8 +670,11 @@ static int asrc_prepare(struct comp_dev *dev)
 	if (!cd->skew)
 		cd->skew = Q_CONVERT_FLOAT(1.0, 30);
 
-	cd->skew_min = cd->skew;
-	cd->skew_max = cd->skew;
+	ret = asrc_drift_init(&cd->drift, ASRC_DRIFT_ESTIMATOR, cd->skew);
+	if (ret) {
+		comp_err(dev, "asrc_drift_init(), error %d", ret);
+		goto err_free_asrc;
+	}
 
 	comp_info(dev, "asrc_prepare(), skew = %d", cd->skew);
 	ret = asrc_update_drift(dev, cd->asrc_obj, cd->skew);
@@ -724,15 +719,7 @@ err:
 static int asrc_control_loop(struct comp_dev *dev, struct comp_data *cd)
 {
 	struct timestamp_data tsd;
-	int64_t tmp;
-	int32_t delta_sample;
-	int32_t delta_ts;
-	int32_t sample;
-	int32_t ts;
-	int32_t skew;
-	int32_t f_ds_dt;
-	int32_t f_ck_fs;
-	int ts_ret;
+	int ret;
 
 	if (!cd->track_drift)
 		return 0;
@@ -743,52 +730,27 @@ static int asrc_control_loop(struct comp_dev *dev, struct comp_data *cd)
 		return 0;
 	}
 
-	ts_ret = asrc_dai_get_timestamp(cd, &tsd);
+	ret = asrc_dai_get_timestamp(cd, &tsd);
 	asrc_dai_start_timestamp(cd);
-	if (ts_ret)
-		return ts_ret;
-
-	ts = (int32_t)(tsd.walclk); /* Let it wrap, diff unwraps */
-	sample = (int32_t)(tsd.sample); /* Let it wrap, diff unwraps */
-	delta_ts = ts - cd->ts_prev;
-	delta_sample = sample - cd->sample_prev;
-	cd->ts_prev = ts;
-	cd->sample_prev = sample;
-
-	/* Avoid first delta timestamp(s) those can be off and
-	 * confuse the filter.
-	 */
-	if (cd->ts_count < TS_STABLE_DIFF_COUNT) {
-		cd->ts_count++;
-		return 0;
-	}
+	if (ret)
+		return ret;
 
-	/* Prevent divide by zero */
-	if (delta_sample == 0 || tsd.walclk_rate == 0) {
+	/* Let the timestamps wrap, the estimator unwraps the deltas */
+	ret = asrc_drift_update(&cd->drift, (int32_t)tsd.walclk,
+				(int32_t)tsd.sample, tsd.walclk_rate,
+				cd->asrc_obj->fs_sec);
+	if (ret < 0) {
 		comp_cl_err(&comp_asrc, "asrc_control_loop(), DAI timestamp failed");
-		return -EINVAL;
+		return ret;
 	}
 
-	/* fraction f_ds_dt is Q20.12
-	 * fraction f_cd_fs is Q1.31
-	 * drift needs to be Q2.30
-	 */
-	f_ds_dt = (delta_ts << 12) / delta_sample;
-	f_ck_fs = ((int64_t)cd->asrc_obj->fs_sec << 31) / tsd.walclk_rate;
-	skew = q_multsr_sat_32x32(f_ds_dt, f_ck_fs, 13);
+	if (!ret)
+		return 0;
 
-	/* tmp is Q4.60, shift and round to Q2.30 */
-	tmp = ((int64_t)COEF_C1) * skew + ((int64_t)COEF_C2) * cd->skew;
-	cd->skew = sat_int32(Q_SHIFT_RND(tmp, 60, 30));
+	cd->skew = cd->drift.skew;
 	asrc_update_drift(dev, cd->asrc_obj, cd->skew);
-
-	/* Track skew variation, it helps to analyze possible problems
-	 * with slave DAI frame clock stability.
-	 */
-	cd->skew_min = MIN(cd->skew, cd->skew_min);
-	cd->skew_max = MAX(cd->skew, cd->skew_max);
-	comp_cl_dbg(&comp_asrc, "skew %d %d %d %d", delta_sample, delta_ts,
-		    skew, cd->skew);
+	comp_cl_dbg(&comp_asrc, "skew %d locked %d", cd->skew,
+		    cd->drift.metrics.locked);
 	return 0;
 }
 
@@ -881,9 +843,13 @@ static int asrc_reset(struct comp_dev *dev)
 	struct comp_data *cd = comp_get_drvdata(dev);
 
 	comp_info(dev, "asrc_reset()");
-	comp_info(dev, "asrc_reset(), skew_min=%d, skew_max=%d", cd->skew_min,
-		  cd->skew_max);
-
+	comp_info(dev, "asrc_reset(), skew_min=%d, skew_max=%d",
+		  cd->drift.metrics.skew_min, cd->drift.metrics.skew_max);
+	comp_info(dev, "asrc_reset(), lock_updates=%u, lock_time_us=%u, lock_losses=%u, jitter_max=%d",
+		  cd->drift.metrics.lock_updates,
+		  cd->drift.metrics.lock_time_us,
+		  cd->drift.metrics.lock_losses,
+		  cd->drift.metrics.jitter_max);
 
 	/* If any resources feasible to stop */
 	if (cd->track_drift)
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/asrc/asrc_drift.h>
+#include <sof/audio/format.h>
+#include <sof/math/numbers.h>
+#include <errno.h>
+#include <stdint.h>
+
+/* Low pass filter coefficient for measured drift factor,
+ * The low pass function is y(n) = c1 * x(n) + c2 * y(n -1)
+ * coefficient c2 needs to be 1 - c1.
+ */
+#define COEF_C1		Q_CONVERT_FLOAT(0.01, 30)
+#define COEF_C2		Q_CONVERT_FLOAT(0.99, 30)
+
+/* The Kalman filter tracks a constant rate factor from measurements
+ * with white noise. The variances are relative to the measurement
+ * noise. The initial variance makes the first updates follow the
+ * measurements with a gain close to 1/n. The process noise sets the
+ * steady state gain to 0.01, the same as COEF_C1 of the low-pass
+ * filter, qn = 0.01^2 / (1 - 0.01).
+ */
+#define KALMAN_ONE	Q_CONVERT_FLOAT(1.0, 24)
+#define KALMAN_VAR_INIT	Q_CONVERT_FLOAT(64.0, 24)
+#define KALMAN_QN	Q_CONVERT_FLOAT(0.000101, 24)
+
+/* The estimate is locked when the measurement error, smoothed with
+ * coefficient 1/2^LOCK_ERROR_SHIFT, stays below the limit for
+ * LOCK_COUNT updates. The lock is lost when the smoothed error
+ * exceeds twice the limit.
+ */
+#define LOCK_LIMIT		Q_CONVERT_FLOAT(10e-6, 30)
+#define LOCK_COUNT		16
+#define LOCK_ERROR_SHIFT	4
+
+static void asrc_drift_lpf(struct asrc_drift *drift, int32_t skew)
+{
+	int64_t tmp;
+
+	/* tmp is Q4.60, shift and round to Q2.30 */
+	tmp = ((int64_t)COEF_C1) * skew + ((int64_t)COEF_C2) * drift->skew;
+	drift->skew = sat_int32(Q_SHIFT_RND(tmp, 60, 30));
+}
+
+static void asrc_drift_kalman(struct asrc_drift *drift, int32_t skew)
+{
+	int64_t error = (int64_t)skew - drift->skew;
+
+	/* gain = var / (var + 1) as Q1.30 */
+	drift->gain = ((int64_t)drift->var << 30) / (drift->var + KALMAN_ONE);
+
+	/* error * gain is Q4.60, shift and round to Q2.30 */
+	drift->skew = sat_int32(drift->skew +
+				Q_SHIFT_RND(error * drift->gain, 60, 30));
+
+	/* The posterior variance equals the gain, the process noise
+	 * is added to it for the prior of the next update.
+	 */
+	drift->var = Q_SHIFT(drift->gain, 30, 24) + KALMAN_QN;
+}
+
+static const asrc_drift_func asrc_drift_estimators[ASRC_DRIFT_ESTIMATORS] = {
+	[ASRC_DRIFT_LPF] = asrc_drift_lpf,
+	[ASRC_DRIFT_KALMAN] = asrc_drift_kalman,
+};
+
+int asrc_drift_init(struct asrc_drift *drift,
+		    enum asrc_drift_estimator estimator, int32_t skew)
+{
+	if (estimator >= ASRC_DRIFT_ESTIMATORS)
+		return -EINVAL;
+
+	*drift = (struct asrc_drift) {
+		.estimate = asrc_drift_estimators[estimator],
+		.skew = skew,
+		.var = KALMAN_VAR_INIT,
+		.metrics = {
+			.skew_min = skew,
+			.skew_max = skew,
+		},
+	};
+
+	return 0;
+}
+
+static void asrc_drift_lock(struct asrc_drift *drift, int32_t error)
+{
+	struct asrc_drift_metrics *m = &drift->metrics;
+	int32_t error_abs;
+
+	if (m->updates == 1)
+		drift->error_avg = error;
+	else
+		drift->error_avg += ((int64_t)error - drift->error_avg) >>
+			LOCK_ERROR_SHIFT;
+
+	error_abs = ABS(drift->error_avg);
+	if (m->locked) {
+		m->jitter_max = MAX(m->jitter_max, ABS(error));
+		if (error_abs > 2 * LOCK_LIMIT) {
+			m->locked = false;
+			m->lock_losses++;
+			drift->lock_count = 0;
+		}
+	} else if (error_abs < LOCK_LIMIT) {
+		if (++drift->lock_count >= LOCK_COUNT)
+			m->locked = true;
+	} else {
+		drift->lock_count = 0;
+	}
+}
+
+int asrc_drift_update(struct asrc_drift *drift, int32_t ts, int32_t sample,
+		      uint32_t walclk_rate, int32_t fs)
+{
+	struct asrc_drift_metrics *m = &drift->metrics;
+	int32_t delta_sample;
+	int32_t delta_ts;
+	int32_t skew;
+	int32_t error;
+	int32_t f_ds_dt;
+	int32_t f_ck_fs;
+
+	delta_ts = ts - drift->ts_prev; /* Let it wrap, diff unwraps */
+	delta_sample = sample - drift->sample_prev;
+	drift->ts_prev = ts;
+	drift->sample_prev = sample;
+
+	/* The first timestamp only seeds the deltas */
+	if (!drift->ts_count) {
+		drift->ts_count++;
+		return 0;
+	}
+
+	/* Prevent divide by zero */
+	if (delta_sample == 0 || walclk_rate == 0)
+		return -EINVAL;
+
+	/* fraction f_ds_dt is Q20.12
+	 * fraction f_cd_fs is Q1.31
+	 * drift needs to be Q2.30
+	 */
+	f_ds_dt = (delta_ts << 12) / delta_sample;
+	f_ck_fs = ((int64_t)fs << 31) / walclk_rate;
+	skew = q_multsr_sat_32x32(f_ds_dt, f_ck_fs, 13);
+
+	/* Error of the measurement against the current estimate */
+	error = sat_int32((int64_t)skew - drift->skew);
+
+	drift->estimate(drift, skew);
+	m->updates++;
+
+	/* Track skew variation, it helps to analyze possible problems
+	 * with slave DAI frame clock stability.
+	 */
+	m->skew_min = MIN(drift->skew, m->skew_min);
+	m->skew_max = MAX(drift->skew, m->skew_max);
+
+	if (m->lock_updates) {
+		asrc_drift_lock(drift, error);
+		return 1;
+	}
+
+	/* Stream time until the first lock */
+	drift->ts_elapsed += delta_ts;
+	asrc_drift_lock(drift, error);
+	if (m->locked) {
+		m->lock_updates = m->updates;
+		m->lock_time_us = ((uint64_t)drift->ts_elapsed * 1000000) /
+			walclk_rate;
+	}
+
+	return 1;
+}
@@ -245,7 +245,7 @@ enum asrc_error_code asrc_get_required_size(struct comp_dev *dev,
 		return ASRC_EC_INVALID_POINTER;
 	}
 
-	if (num_channels < 1) {
+	if (num_channels < 1 || num_channels > PLATFORM_MAX_CHANNELS) {
 		comp_err(dev, "asrc_get_required_size(), invalid num_channels = %d",
 			 num_channels);
 		return ASRC_EC_INVALID_NUM_CHANNELS;
@@ -306,7 +306,7 @@ enum asrc_error_code asrc_initialise(struct comp_dev *dev,
 		return ASRC_EC_INVALID_POINTER;
 	}
 
-	if (num_channels < 1) {
+	if (num_channels < 1 || num_channels > PLATFORM_MAX_CHANNELS) {
 		comp_err(dev, "asrc_initialise(), num_channels = %d",
 			 num_channels);
 		return ASRC_EC_INVALID_NUM_CHANNELS;
@@ -883,87 +883,121 @@ enum asrc_error_code asrc_update_fs_ratio(struct comp_dev *dev,
 }
 
 void asrc_write_to_ring_buffer16(struct asrc_farrow  *src_obj,
-				 int16_t **input_buffers, int index_input_frame)
+				 int16_t **input_buffers, int index_input_frame,
+				 int num_frames)
 {
+	const int length = src_obj->buffer_length;
+	const int half = length >> 1;
+	int16_t *ring;
+	int16_t *x;
+	int stride;
+	int run;
 	int ch;
+	int i;
 	int j;
-	int k;
 	int m;
-
-	/* update the buffer_write_position */
-	(src_obj->buffer_write_position)++;
-
-	/* since it's a ring buffer we need a wrap around */
-	if (src_obj->buffer_write_position >= src_obj->buffer_length)
-		src_obj->buffer_write_position -= (src_obj->buffer_length >> 1);
+	int n;
 
 	/* handle input format */
 	if (src_obj->input_format == ASRC_IOF_INTERLEAVED)
-		m = src_obj->num_channels * index_input_frame;
+		stride = src_obj->num_channels;
 	else
-		m = index_input_frame; /* For SRC_IOF_DEINTERLEAVED */
+		stride = 1; /* For SRC_IOF_DEINTERLEAVED */
 
-	/* write data to each channel */
+	/* write the block of frames to each channel in runs that end
+	 * at the wrap around of the ring buffer
+	 */
 	j = src_obj->buffer_write_position;
-	k = j - (src_obj->buffer_length >> 1);
-	for (ch = 0; ch < src_obj->num_channels; ch++) {
-		/*
-		 * Since we want the filter function to load 64 bit of
-		 * buffer data in one cycle, this function writes each
-		 * input sample to the buffer twice, one with an
-		 * offset of half the buffer size. This way we don't
-		 * need a wrap around while loading #filter_length of
-		 * buffered samples. The upper and lower half of the
-		 * buffer are redundant. If the memory tradeoff is
-		 * critical, the buffer can be reduced to half the
-		 * size but therefore increased filter operations have
-		 * to be expected.
-		 */
-		src_obj->ring_buffers16[ch][j] = input_buffers[ch][m];
-		src_obj->ring_buffers16[ch][k] = input_buffers[ch][m];
+	m = stride * index_input_frame;
+	n = num_frames;
+	while (n) {
+		/* since it's a ring buffer we need a wrap around */
+		if (j == length - 1)
+			j -= half;
+
+		run = MIN(n, length - 1 - j);
+		for (ch = 0; ch < src_obj->num_channels; ch++) {
+			ring = &src_obj->ring_buffers16[ch][j + 1];
+			x = &input_buffers[ch][m];
+			/*
+			 * Since we want the filter function to load 64 bit
+			 * of buffer data in one cycle, this function writes
+			 * each input sample to the buffer twice, one with an
+			 * offset of half the buffer size. This way we don't
+			 * need a wrap around while loading #filter_length of
+			 * buffered samples. The upper and lower half of the
+			 * buffer are redundant. If the memory tradeoff is
+			 * critical, the buffer can be reduced to half the
+			 * size but therefore increased filter operations
+			 * have to be expected.
+			 */
+			for (i = 0; i < run; i++) {
+				ring[i] = *x;
+				ring[i - half] = *x;
+				x += stride;
+			}
+		}
+
+		j += run;
+		m += stride * run;
+		n -= run;
 	}
+
+	/* update the buffer_write_position */
+	src_obj->buffer_write_position = j;
 }
 
 void asrc_write_to_ring_buffer32(struct asrc_farrow  *src_obj,
-				 int32_t **input_buffers, int index_input_frame)
+				 int32_t **input_buffers, int index_input_frame,
+				 int num_frames)
 {
+	const int length = src_obj->buffer_length;
+	const int half = length >> 1;
+	int32_t *ring;
+	int32_t *x;
+	int stride;
+	int run;
 	int ch;
+	int i;
 	int j;
-	int k;
 	int m;
-
-	/* update the buffer_write_position */
-	(src_obj->buffer_write_position)++;
-
-	/* since it's a ring buffer we need a wrap around */
-	if (src_obj->buffer_write_position >= src_obj->buffer_length)
-		src_obj->buffer_write_position -= (src_obj->buffer_length >> 1);
+	int n;
 
 	/* handle input format */
 	if (src_obj->input_format == ASRC_IOF_INTERLEAVED)
-		m = src_obj->num_channels * index_input_frame;
+		stride = src_obj->num_channels;
 	else
-		m = index_input_frame; /* For SRC_IOF_DEINTERLEAVED */
+		stride = 1; /* For SRC_IOF_DEINTERLEAVED */
 
-	/* write data to each channel */
+	/* write the block of frames to each channel in runs that end
+	 * at the wrap around of the ring buffer
+	 */
 	j = src_obj->buffer_write_position;
-	k = j - (src_obj->buffer_length >> 1);
-	for (ch = 0; ch < src_obj->num_channels; ch++) {
-		/*
-		 * Since we want the filter function to load 64 bit of
-		 * buffer data in one cycle, this function writes each
-		 * input sample to the buffer twice, one with an
-		 * offset of half the buffer size. This way we don't
-		 * need a wrap around while loading #filter_length of
-		 * buffered samples. The upper and lower half of the
-		 * buffer are redundant. If the memory tradeoff is
-		 * critical, the buffer can be reduced to half the
-		 * size but therefore increased filter operations have
-		 * to be expected.
-		 */
-		src_obj->ring_buffers32[ch][j] = input_buffers[ch][m];
-		src_obj->ring_buffers32[ch][k] = input_buffers[ch][m];
+	m = stride * index_input_frame;
+	n = num_frames;
+	while (n) {
+		/* since it's a ring buffer we need a wrap around */
+		if (j == length - 1)
+			j -= half;
+
+		run = MIN(n, length - 1 - j);
+		for (ch = 0; ch < src_obj->num_channels; ch++) {
+			ring = &src_obj->ring_buffers32[ch][j + 1];
+			x = &input_buffers[ch][m];
+			for (i = 0; i < run; i++) {
+				ring[i] = *x;
+				ring[i - half] = *x;
+				x += stride;
+			}
+		}
+
+		j += run;
+		m += stride * run;
+		n -= run;
 	}
+
+	/* update the buffer_write_position */
+	src_obj->buffer_write_position = j;
 }
 
 enum asrc_error_code asrc_process_push16(struct comp_dev *dev,
@@ -977,6 +1011,7 @@ enum asrc_error_code asrc_process_push16(struct comp_dev *dev,
 {
 	int index_input_frame;
 	int max_num_free_frames;
+	int num_frames;
 
 	/* parameter error handling */
 	if (!src_obj || !input_buffers || !output_buffers ||
@@ -1032,13 +1067,18 @@ enum asrc_error_code asrc_process_push16(struct comp_dev *dev,
 
 			(*output_num_frames)++;
 		} else {
-			/* Consume one input sample */
+			/* Consume in one block the input samples that
+			 * precede the next output sample
+			 */
+			num_frames = MIN(src_obj->time_value / TIME_VALUE_ONE,
+					 *input_num_frames - index_input_frame);
 			asrc_write_to_ring_buffer16(src_obj, input_buffers,
-						    index_input_frame);
-			index_input_frame++;
+						    index_input_frame,
+						    num_frames);
+			index_input_frame += num_frames;
 
 			/* Update time */
-			src_obj->time_value -= TIME_VALUE_ONE;
+			src_obj->time_value -= num_frames * TIME_VALUE_ONE;
 		}
 	}
 	*write_index = src_obj->io_buffer_idx;
@@ -1090,6 +1130,7 @@ enum asrc_error_code asrc_process_push32(struct comp_dev *dev,
 	 */
 	int index_input_frame;
 	int max_num_free_frames;
+	int num_frames;
 
 	/* parameter error handling */
 	if (!src_obj || !input_buffers || !output_buffers ||
@@ -1140,13 +1181,16 @@ enum asrc_error_code asrc_process_push32(struct comp_dev *dev,
 
 			(*output_num_frames)++;
 		} else {
-			/* Consume input sample */
+			/* Consume input samples */
+			num_frames = MIN(src_obj->time_value / TIME_VALUE_ONE,
+					 *input_num_frames - index_input_frame);
 			asrc_write_to_ring_buffer32(src_obj, input_buffers,
-						    index_input_frame);
-			index_input_frame++;
+						    index_input_frame,
+						    num_frames);
+			index_input_frame += num_frames;
 
 			/* Update time */
-			src_obj->time_value -= TIME_VALUE_ONE;
+			src_obj->time_value -= num_frames * TIME_VALUE_ONE;
 		}
 	}
 	*write_index = src_obj->io_buffer_idx;
@@ -1195,6 +1239,8 @@ enum asrc_error_code asrc_process_pull16(struct comp_dev *dev,
 					 int *read_index)
 {
 	int index_output_frame = 0;
+	int max_num_frames;
+	int num_frames;
 
 	/* parameter error handling */
 	if (!src_obj || !input_buffers || !output_buffers ||
@@ -1218,27 +1264,46 @@ enum asrc_error_code asrc_process_pull16(struct comp_dev *dev,
 	/* Run state machine until number of output samples are written */
 	while (index_output_frame < *output_num_frames) {
 		if (src_obj->time_value_pull < TIME_VALUE_ONE) {
-			/* Consume one input sample */
+			/* Consume input samples */
 			if (src_obj->io_buffer_idx == write_index)
 				break;
 
+			/* Input available without a wrap around */
+			if (write_index > src_obj->io_buffer_idx)
+				max_num_frames = write_index -
+					src_obj->io_buffer_idx;
+			else
+				max_num_frames = src_obj->io_buffer_length -
+					src_obj->io_buffer_idx;
+
+			/* Advance time over all the input samples that
+			 * precede the next output sample, then write them
+			 * in one block
+			 */
+			num_frames = 0;
+			do {
+				/* Update time as Q5.27 */
+				src_obj->time_value =
+					(((int64_t)TIME_VALUE_ONE -
+					  src_obj->time_value_pull) *
+					 src_obj->fs_ratio_inv) >> 27;
+				src_obj->time_value_pull += src_obj->fs_ratio;
+				num_frames++;
+			} while (num_frames < max_num_frames &&
+				 src_obj->time_value_pull < TIME_VALUE_ONE);
+
 			asrc_write_to_ring_buffer16(src_obj,
 						    input_buffers,
-						    src_obj->io_buffer_idx);
-			src_obj->io_buffer_idx++;
+						    src_obj->io_buffer_idx,
+						    num_frames);
+			src_obj->io_buffer_idx += num_frames;
 
 			/* Wrap around */
 			if (src_obj->io_buffer_mode == ASRC_BM_CIRCULAR &&
 			    src_obj->io_buffer_idx >= src_obj->io_buffer_length)
 				src_obj->io_buffer_idx = 0;
 
-			(*input_num_frames)++;
-
-			/* Update time as Q5.27 */
-			src_obj->time_value = (((int64_t)TIME_VALUE_ONE -
-						src_obj->time_value_pull) *
-					       src_obj->fs_ratio_inv) >> 27;
-			src_obj->time_value_pull += src_obj->fs_ratio;
+			*input_num_frames += num_frames;
 		} else {
 			/* Calculate impulse response */
 			(*src_obj->calc_ir)(src_obj);
@@ -1298,6 +1363,8 @@ enum asrc_error_code asrc_process_pull32(struct comp_dev *dev,
 					 int *read_index)
 {
 	int index_output_frame = 0;
+	int max_num_frames;
+	int num_frames;
 
 	/* parameter error handling */
 	if (!src_obj || !input_buffers || !output_buffers ||
@@ -1322,27 +1389,41 @@ enum asrc_error_code asrc_process_pull32(struct comp_dev *dev,
 	*input_num_frames = 0;
 	while (index_output_frame < *output_num_frames) {
 		if (src_obj->time_value_pull < TIME_VALUE_ONE) {
-			/* Consume input sample */
+			/* Consume input samples */
 			if (src_obj->io_buffer_idx == write_index)
 				break;
 
+			if (write_index > src_obj->io_buffer_idx)
+				max_num_frames = write_index -
+					src_obj->io_buffer_idx;
+			else
+				max_num_frames = src_obj->io_buffer_length -
+					src_obj->io_buffer_idx;
+
+			num_frames = 0;
+			do {
+				/* Update time as Q5.27 */
+				src_obj->time_value =
+					(((int64_t)TIME_VALUE_ONE -
+					  src_obj->time_value_pull) *
+					 src_obj->fs_ratio_inv) >> 27;
+				src_obj->time_value_pull += src_obj->fs_ratio;
+				num_frames++;
+			} while (num_frames < max_num_frames &&
+				 src_obj->time_value_pull < TIME_VALUE_ONE);
+
 			asrc_write_to_ring_buffer32(src_obj,
 						    input_buffers,
-						    src_obj->io_buffer_idx);
-			src_obj->io_buffer_idx++;
+						    src_obj->io_buffer_idx,
+						    num_frames);
+			src_obj->io_buffer_idx += num_frames;
 
 			/* Wrap around */
 			if (src_obj->io_buffer_mode == ASRC_BM_CIRCULAR &&
 			    src_obj->io_buffer_idx >= src_obj->io_buffer_length)
 				src_obj->io_buffer_idx = 0;
 
-			(*input_num_frames)++;
-
-			/* Update time as Q5.27 */
-			src_obj->time_value = (((int64_t)TIME_VALUE_ONE -
-						src_obj->time_value_pull) *
-					       src_obj->fs_ratio_inv) >> 27;
-			src_obj->time_value_pull += src_obj->fs_ratio;
+			*input_num_frames += num_frames;
 		} else {
 			/* Calculate impulse response */
 			(*src_obj->calc_ir)(src_obj);
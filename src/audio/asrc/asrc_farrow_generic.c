@@ -8,105 +8,113 @@
 
 #include <sof/audio/asrc/asrc_farrow.h>
 #include <sof/audio/format.h>
+#include <sof/platform.h>
 
 void asrc_fir_filter16(struct asrc_farrow *src_obj, int16_t **output_buffers,
 		       int index_output_frame)
 {
-	int64_t prod;
+	int64_t prod[PLATFORM_MAX_CHANNELS];
 	int32_t prod32;
-	int16_t prod16;
-	int32_t *filter_p;
-	int16_t *buffer_p;
+	int32_t coef;
+	const int32_t *filter_p;
+	const int16_t *buffer_p;
+	const int nch = src_obj->num_channels;
+	const int stride = src_obj->buffer_length;
 	int ch;
 	int n;
 	int i;
 
 	if (src_obj->output_format == ASRC_IOF_INTERLEAVED)
-		i = src_obj->num_channels * index_output_frame;
+		i = nch * index_output_frame;
 	else
 		i = index_output_frame;
 
-	/* Iterate over each channel */
-	for (ch = 0; ch < src_obj->num_channels; ch++) {
-		/* Pointer to the beginning of the impulse response */
-		filter_p = &src_obj->impulse_response[0];
+	/* Pointer to the beginning of the impulse response */
+	filter_p = &src_obj->impulse_response[0];
 
-		/* Pointer to the buffered input data */
-		buffer_p = &src_obj->ring_buffers16[ch]
-			[src_obj->buffer_write_position];
+	/* Pointer to the buffered input data of the first channel. The
+	 * ring buffers of the channels follow each other with a stride
+	 * of buffer_length.
+	 */
+	buffer_p = &src_obj->ring_buffers16[0][src_obj->buffer_write_position];
 
-		/* Initialise the accumulator */
-		prod = 0;
+	/* Initialise the accumulators */
+	for (ch = 0; ch < nch; ch++)
+		prod[ch] = 0;
 
-		/* Iterate over the filter bins.
-		 * Data is Q1.15, coefficients are Q1.30. Prod will be Qx.45.
-		 */
-		for (n = 0; n < src_obj->filter_length; n++)
-			prod += (int64_t)(*buffer_p--) * (*filter_p++);
+	/* Iterate over the filter bins and apply each coefficient to all
+	 * channels. Data is Q1.15, coefficients are Q1.30. Prod will be
+	 * Qx.45.
+	 */
+	for (n = 0; n < src_obj->filter_length; n++) {
+		coef = *filter_p++;
+		for (ch = 0; ch < nch; ch++)
+			prod[ch] += (int64_t)buffer_p[ch * stride] * coef;
 
+		buffer_p--;
+	}
+
+	for (ch = 0; ch < nch; ch++) {
 		/* Shift left after accumulation, because interim
 		 * results might saturate during filtering prod = prod
 		 * << 1; will shift after last addition
 		 */
-		prod32 = sat_int32(Q_SHIFT(prod, 45, 31));
+		prod32 = sat_int32(Q_SHIFT(prod[ch], 45, 31));
 
 		/* Round 'prod' to 16 bit and store it in
 		 * (de-)interleaved format in the output buffers
 		 */
-		prod16 = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
-		output_buffers[ch][i] = prod16;
+		output_buffers[ch][i] = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
 	}
 }
 
 void asrc_fir_filter32(struct asrc_farrow *src_obj, int32_t **output_buffers,
 		       int index_output_frame)
 {
-	int64_t prod;
-	int32_t prod32;
+	int64_t prod[PLATFORM_MAX_CHANNELS];
+	int32_t coef;
 	const int32_t *filter_p;
-	int32_t *buffer_p;
+	const int32_t *buffer_p;
+	const int nch = src_obj->num_channels;
+	const int stride = src_obj->buffer_length;
 	int ch;
 	int n;
 	int i;
 
 	if (src_obj->output_format == ASRC_IOF_INTERLEAVED)
-		i = src_obj->num_channels * index_output_frame;
+		i = nch * index_output_frame;
 	else
 		i = index_output_frame;
 
-	/* Iterate over each channel */
-	for (ch = 0; ch < src_obj->num_channels; ch++) {
-		/* Pointer to the beginning of the impulse response */
-		filter_p = &src_obj->impulse_response[0];
-
-		/* Pointer to the buffered input data */
-		buffer_p = &src_obj->ring_buffers32[ch]
-			[src_obj->buffer_write_position];
-
-		/* Initialise the accumulator */
-		prod = 0;
+	/* See asrc_fir_filter16() for the buffer layout */
+	filter_p = &src_obj->impulse_response[0];
+	buffer_p = &src_obj->ring_buffers32[0][src_obj->buffer_write_position];
 
-		/* Iterate over the filter bins. Data is Q1.31, coefficients
-		 * are Q1.22. They are down scaled by 1 shift. In addition
-		 * there C is implementation specific right shift by 8. It
-		 * gives headroom to calculate up to 256 taps FIR. The use
-		 * of 24 bits of 32 bits is not a practical limitation for
-		 * quality. The product is Qx.54.
-		 */
-		for (n = 0; n < src_obj->filter_length; n++)
-			prod += (int64_t)(*buffer_p--) * (*filter_p++ >> 8);
+	for (ch = 0; ch < nch; ch++)
+		prod[ch] = 0;
 
-		/* Shift left after accumulation, because interim
-		 * results might saturate during filtering prod = prod
-		 * << 1; will shift after last addition
-		 */
-		prod32 = sat_int32(Q_SHIFT(prod, 53, 31));
+	/* Iterate over the filter bins. Data is Q1.31, coefficients
+	 * are Q1.22. They are down scaled by 1 shift. In addition
+	 * there C is implementation specific right shift by 8. It
+	 * gives headroom to calculate up to 256 taps FIR. The use
+	 * of 24 bits of 32 bits is not a practical limitation for
+	 * quality. The product is Qx.54.
+	 */
+	for (n = 0; n < src_obj->filter_length; n++) {
+		coef = *filter_p++ >> 8;
+		for (ch = 0; ch < nch; ch++)
+			prod[ch] += (int64_t)buffer_p[ch * stride] * coef;
 
-		/* Store 'prod' in (de-)interleaved format in the output
-		 * buffers
-		 */
-		output_buffers[ch][i] = prod32;
+		buffer_p--;
 	}
+
+	/* Shift left after accumulation, because interim
+	 * results might saturate during filtering prod = prod
+	 * << 1; will shift after last addition. Store the result
+	 * in (de-)interleaved format in the output buffers.
+	 */
+	for (ch = 0; ch < nch; ch++)
+		output_buffers[ch][i] = sat_int32(Q_SHIFT(prod[ch], 53, 31));
 }
 
 /* + ALGORITHM SPECIFIC FUNCTIONS */
@@ -12,6 +12,7 @@
 #include <sof/lib/cache.h>
 #include <sof/lib/memory.h>
 #include <sof/lib/notifier.h>
+#include <sof/lib/slab.h>
 #include <sof/list.h>
 #include <sof/spinlock.h>
 #include <ipc/topology.h>
@@ -38,8 +39,7 @@ struct comp_buffer *buffer_alloc(uint32_t size, uint32_t caps, uint32_t align)
 	}
 
 	/* allocate new buffer */
-	buffer = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
-			 sizeof(*buffer));
+	buffer = slab_zalloc(SLAB_BUFFER, 0, SOF_MEM_CAPS_RAM, sizeof(*buffer));
 	if (!buffer) {
 		tr_err(&buffer_tr, "buffer_alloc(): could not alloc structure");
 		return NULL;
@@ -99,6 +99,17 @@ struct comp_buffer *buffer_new(struct sof_ipc_buffer *desc)
 	return buffer;
 }
 
+static void buffer_arena_put(struct comp_buffer *buffer)
+{
+	struct buffer_arena *arena = buffer->arena;
+
+	if (!arena || --arena->users)
+		return;
+
+	rfree(arena->addr);
+	rfree(arena);
+}
+
 int buffer_set_size(struct comp_buffer *buffer, uint32_t size)
 {
 	void *new_ptr = NULL;
@@ -112,6 +123,35 @@ int buffer_set_size(struct comp_buffer *buffer, uint32_t size)
 	if (size == buffer->stream.size)
 		return 0;
 
+	/* memory shared in place can't move */
+	if (buffer->inplace_source || buffer->inplace_sink) {
+		buf_err(buffer, "resize of in-place buffer");
+		return -EBUSY;
+	}
+
+	/* a size not fitting the arena place takes memory of its own */
+	if (buffer->arena) {
+		if (size <= buffer->arena_size) {
+			buffer_init(buffer, size, buffer->caps);
+			return 0;
+		}
+
+		new_ptr = rballoc_align(0, buffer->caps, size,
+					PLATFORM_DCACHE_ALIGN);
+		if (!new_ptr) {
+			buf_err(buffer, "resize can't alloc %u bytes type %u",
+				size, buffer->caps);
+			return -ENOMEM;
+		}
+
+		buffer_arena_put(buffer);
+		buffer->arena = NULL;
+		buffer->stream.addr = new_ptr;
+		buffer_init(buffer, size, buffer->caps);
+
+		return 0;
+	}
+
 	new_ptr = rbrealloc(buffer->stream.addr, SOF_MEM_FLAG_NO_COPY,
 			    buffer->caps, size, buffer->stream.size);
 
@@ -131,6 +171,200 @@ int buffer_set_size(struct comp_buffer *buffer, uint32_t size)
 	return 0;
 }
 
+/*
+ * Buffers without overrun or underrun permitted have a single producer and
+ * a single consumer that never passes it, across cores they publish their
+ * positions lock-free.
+ */
+int buffer_set_inter_core(struct comp_buffer *buffer)
+{
+	if (buffer->inter_core)
+		return 0;
+
+	buffer->inter_core = true;
+
+	if (buffer->stream.overrun_permitted ||
+	    buffer->stream.underrun_permitted)
+		return 0;
+
+	buffer->spsc = rballoc(0, SOF_MEM_CAPS_RAM, sizeof(*buffer->spsc));
+	if (!buffer->spsc) {
+		buf_err(buffer, "buffer_set_inter_core(): could not alloc positions");
+		return -ENOMEM;
+	}
+
+	/* connected before streaming, positions start at the buffer base */
+	buffer_spsc_reset(buffer);
+
+	return 0;
+}
+
+/*
+ * The component between the buffers produces every sample where it has
+ * consumed it from, so the sink is written right behind the source read
+ * position and its own memory goes back to the heap. Buffers already
+ * sharing memory of the sink move to the source memory along with it.
+ */
+int buffer_inplace_attach(struct comp_buffer *sink, struct comp_buffer *source)
+{
+	struct comp_buffer *b;
+
+	if (sink->inplace_source == source)
+		goto out;
+
+	if (sink->inplace_source || source->inplace_sink ||
+	    sink->stream.size != source->stream.size) {
+		buf_err(sink, "buffer_inplace_attach(): can't share buffer %u",
+			source->id);
+		return -EINVAL;
+	}
+
+	/* memory in an arena stays reserved for detaching */
+	if (!sink->arena)
+		rfree(sink->stream.addr);
+
+	sink->inplace_source = source;
+	source->inplace_sink = sink;
+
+	for (b = sink; b; b = b->inplace_sink) {
+		audio_stream_init(&b->stream, source->stream.addr,
+				  source->stream.size);
+		b->stream.w_ptr = source->stream.r_ptr;
+		b->stream.r_ptr = source->stream.r_ptr;
+	}
+
+out:
+	buffer_inplace_sync(sink);
+
+	return 0;
+}
+
+/* streams of the buffer and the ones sharing it start over */
+int buffer_inplace_detach(struct comp_buffer *buffer)
+{
+	struct comp_buffer *source = buffer->inplace_source;
+	struct comp_buffer *b;
+	void *addr;
+
+	if (!source)
+		return 0;
+
+	addr = buffer->arena ? buffer->arena_addr :
+		rballoc_align(0, buffer->caps, buffer->stream.size,
+			      PLATFORM_DCACHE_ALIGN);
+	if (!addr) {
+		buf_err(buffer, "buffer_inplace_detach(): could not alloc size = %u bytes of type = %u",
+			buffer->stream.size, buffer->caps);
+		return -ENOMEM;
+	}
+
+	buffer->inplace_source = NULL;
+	source->inplace_sink = NULL;
+
+	for (b = buffer; b; b = b->inplace_sink)
+		audio_stream_init(&b->stream, addr, buffer->stream.size);
+
+	buffer_inplace_sync(buffer);
+
+	/* the source keeps its data, only the space held below is freed */
+	source->stream.free = source->stream.size - source->stream.avail;
+	buffer_inplace_sync(source);
+
+	return 0;
+}
+
+/* moves an empty stream and the sinks sharing it in place to addr */
+static void buffer_move_empty(struct comp_buffer *buffer, void *addr)
+{
+	struct comp_buffer *b;
+
+	buffer->stream.addr = addr;
+	buffer_init(buffer, buffer->stream.size, buffer->caps);
+
+	for (b = buffer->inplace_sink; b; b = b->inplace_sink)
+		audio_stream_init(&b->stream, addr, buffer->stream.size);
+
+	buffer_inplace_sync(buffer);
+}
+
+/*
+ * Every allocation from the buffer heap is rounded up to whole blocks and
+ * reserves its alignment, packing the buffers of a pipeline together pays
+ * that once and leaves the heap less fragmented for the next pipelines.
+ * Own memory of the buffers is freed before the arena is allocated, so
+ * the heap never holds both. Without the arena the buffers get memory of
+ * their own again, -ENOMEM means some of them were left without any.
+ */
+int buffer_arena_new(struct comp_buffer **buffers, uint32_t count)
+{
+	struct buffer_arena *arena;
+	struct comp_buffer *buffer;
+	uint32_t caps = buffers[0]->caps;
+	uint32_t heap_size = 0;
+	uint32_t size = 0;
+	char *addr;
+	uint32_t i;
+	int ret = 0;
+
+	for (i = 0; i < count; i++)
+		size += ALIGN_UP(buffers[i]->stream.size,
+				 PLATFORM_DCACHE_ALIGN);
+
+	arena = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			sizeof(*arena));
+	if (!arena)
+		return 0;
+
+	/* streams haven't started, there is no data to move, the heap
+	 * blocks they take are what the arena saves on
+	 */
+	for (i = 0; i < count; i++) {
+		heap_size += rballoc_heap_size(buffers[i]->stream.addr);
+		rfree(buffers[i]->stream.addr);
+	}
+
+	arena->addr = rballoc_align(0, caps, size, PLATFORM_DCACHE_ALIGN);
+	if (!arena->addr) {
+		tr_warn(&buffer_tr, "buffer_arena_new(): could not alloc size = %u bytes of type = %u",
+			size, caps);
+		rfree(arena);
+
+		for (i = 0; i < count; i++) {
+			buffer = buffers[i];
+			addr = rballoc_align(0, buffer->caps,
+					     buffer->stream.size,
+					     PLATFORM_DCACHE_ALIGN);
+			if (!addr) {
+				buf_err(buffer, "buffer_arena_new(): could not realloc size = %u bytes",
+					buffer->stream.size);
+				ret = -ENOMEM;
+			}
+
+			buffer_move_empty(buffer, addr);
+		}
+
+		return ret;
+	}
+
+	arena->users = count;
+	addr = arena->addr;
+
+	for (i = 0; i < count; i++) {
+		buffer = buffers[i];
+		buffer->arena = arena;
+		buffer->arena_addr = addr;
+		buffer->arena_size = buffer->stream.size;
+		buffer->caps = caps;
+		buffer_move_empty(buffer, addr);
+		addr += ALIGN_UP(buffer->stream.size, PLATFORM_DCACHE_ALIGN);
+	}
+
+	tr_info(&buffer_tr, "buffer_arena_new(), %u buffers taking %u heap bytes in arena of %u bytes taking %u",
+		count, heap_size, size, rballoc_heap_size(arena->addr));
+
+	return 0;
+}
+
 /* free component in the pipeline */
 void buffer_free(struct comp_buffer *buffer)
 {
@@ -148,7 +382,19 @@ void buffer_free(struct comp_buffer *buffer)
 
 	list_item_del(&buffer->source_list);
 	list_item_del(&buffer->sink_list);
-	rfree(buffer->stream.addr);
+
+	/* memory shared in place is owned by the top of the chain */
+	if (buffer->inplace_sink)
+		buffer_inplace_detach(buffer->inplace_sink);
+
+	if (buffer->inplace_source)
+		buffer->inplace_source->inplace_sink = NULL;
+	else if (!buffer->arena)
+		rfree(buffer->stream.addr);
+
+	buffer_arena_put(buffer);
+
+	rfree(buffer->spsc);
 	rfree(buffer->lock);
 	rfree(buffer);
 }
@@ -173,14 +419,26 @@ void comp_update_buffer_produce(struct comp_buffer *buffer, uint32_t bytes)
 		return;
 	}
 
-	buffer_lock(buffer, &flags);
+	if (buffer->spsc) {
+		/* the sink core only ever reads the produced position */
+		audio_stream_produce(&buffer->stream, bytes);
+		buffer_spsc_advance(buffer, &buffer->spsc->produced, bytes);
 
-	audio_stream_produce(&buffer->stream, bytes);
+		notifier_event(buffer, NOTIFIER_ID_BUFFER_PRODUCE,
+			       NOTIFIER_TARGET_CORE_LOCAL, &cb_data,
+			       sizeof(cb_data));
+	} else {
+		buffer_lock(buffer, &flags);
 
-	notifier_event(buffer, NOTIFIER_ID_BUFFER_PRODUCE,
-		       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
+		audio_stream_produce(&buffer->stream, bytes);
+		buffer_inplace_sync(buffer);
 
-	buffer_unlock(buffer, flags);
+		notifier_event(buffer, NOTIFIER_ID_BUFFER_PRODUCE,
+			       NOTIFIER_TARGET_CORE_LOCAL, &cb_data,
+			       sizeof(cb_data));
+
+		buffer_unlock(buffer, flags);
+	}
 
 	addr = buffer->stream.addr;
 
@@ -213,14 +471,26 @@ void comp_update_buffer_consume(struct comp_buffer *buffer, uint32_t bytes)
 		return;
 	}
 
-	buffer_lock(buffer, &flags);
+	if (buffer->spsc) {
+		/* the source core only ever reads the consumed position */
+		audio_stream_consume(&buffer->stream, bytes);
+		buffer_spsc_advance(buffer, &buffer->spsc->consumed, bytes);
 
-	audio_stream_consume(&buffer->stream, bytes);
+		notifier_event(buffer, NOTIFIER_ID_BUFFER_CONSUME,
+			       NOTIFIER_TARGET_CORE_LOCAL, &cb_data,
+			       sizeof(cb_data));
+	} else {
+		buffer_lock(buffer, &flags);
 
-	notifier_event(buffer, NOTIFIER_ID_BUFFER_CONSUME,
-		       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
+		audio_stream_consume(&buffer->stream, bytes);
+		buffer_inplace_sync(buffer);
 
-	buffer_unlock(buffer, flags);
+		notifier_event(buffer, NOTIFIER_ID_BUFFER_CONSUME,
+			       NOTIFIER_TARGET_CORE_LOCAL, &cb_data,
+			       sizeof(cb_data));
+
+		buffer_unlock(buffer, flags);
+	}
 
 	addr = buffer->stream.addr;
 
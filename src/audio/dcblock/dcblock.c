@@ -373,6 +373,9 @@ static int dcblock_prepare(struct comp_dev *dev)
 	comp_info(dev, "dcblock_prepare(), source_format=%d, sink_format=%d",
 		  cd->source_format, cd->sink_format);
 
+	/* the filter state holds the previous samples it needs */
+	dev->inplace = true;
+
 	return 0;
 
 err:
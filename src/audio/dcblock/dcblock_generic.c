@@ -5,6 +5,7 @@
 // Author: Sebastiano Carlucci <scarlucci@google.com>
 
 #include <stdint.h>
+#include <sof/audio/audio_stream.h>
 #include <sof/audio/component.h>
 #include <sof/audio/format.h>
 #include <sof/audio/dcblock/dcblock.h>
@@ -37,26 +38,24 @@ static void dcblock_s16_default(const struct comp_dev *dev,
 				uint32_t frames)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct dcblock_state *state;
-	int16_t *x;
+	struct audio_stream_span span;
+	const int16_t *x;
 	int16_t *y;
-	int32_t R;
 	int32_t tmp;
-	int idx;
-	int ch;
+	int ch = 0;
 	int i;
 	int nch = source->channels;
 
-	for (ch = 0; ch < nch; ch++) {
-		state = &cd->state[ch];
-		R = cd->R_coeffs[ch];
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s16(source, idx);
-			y = audio_stream_read_frag_s16(sink, idx);
-			tmp = dcblock_generic(state, R, *x << 16);
-			*y = sat_int16(Q_SHIFT_RND(tmp, 31, 15));
-			idx += nch;
+	audio_stream_span_init(&span, source, sink, 0, frames);
+	while (audio_stream_span_next(&span)) {
+		x = span.src;
+		y = span.snk;
+		for (i = 0; i < span.samples; i++) {
+			tmp = dcblock_generic(&cd->state[ch], cd->R_coeffs[ch],
+					      x[i] << 16);
+			y[i] = sat_int16(Q_SHIFT_RND(tmp, 31, 15));
+			if (++ch == nch)
+				ch = 0;
 		}
 	}
 }
@@ -69,26 +68,24 @@ static void dcblock_s24_default(const struct comp_dev *dev,
 				uint32_t frames)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct dcblock_state *state;
-	int32_t *x;
+	struct audio_stream_span span;
+	const int32_t *x;
 	int32_t *y;
-	int32_t R;
 	int32_t tmp;
-	int idx;
-	int ch;
+	int ch = 0;
 	int i;
 	int nch = source->channels;
 
-	for (ch = 0; ch < nch; ch++) {
-		state = &cd->state[ch];
-		R = cd->R_coeffs[ch];
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source, idx);
-			y = audio_stream_read_frag_s32(sink, idx);
-			tmp = dcblock_generic(state, R, *x << 8);
-			*y = sat_int24(Q_SHIFT_RND(tmp, 31, 23));
-			idx += nch;
+	audio_stream_span_init(&span, source, sink, 0, frames);
+	while (audio_stream_span_next(&span)) {
+		x = span.src;
+		y = span.snk;
+		for (i = 0; i < span.samples; i++) {
+			tmp = dcblock_generic(&cd->state[ch], cd->R_coeffs[ch],
+					      x[i] << 8);
+			y[i] = sat_int24(Q_SHIFT_RND(tmp, 31, 23));
+			if (++ch == nch)
+				ch = 0;
 		}
 	}
 }
@@ -101,24 +98,22 @@ static void dcblock_s32_default(const struct comp_dev *dev,
 				uint32_t frames)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct dcblock_state *state;
-	int32_t *x;
+	struct audio_stream_span span;
+	const int32_t *x;
 	int32_t *y;
-	int32_t R;
-	int idx;
-	int ch;
+	int ch = 0;
 	int i;
 	int nch = source->channels;
 
-	for (ch = 0; ch < nch; ch++) {
-		state = &cd->state[ch];
-		R = cd->R_coeffs[ch];
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source, idx);
-			y = audio_stream_read_frag_s32(sink, idx);
-			*y = dcblock_generic(state, R, *x);
-			idx += nch;
+	audio_stream_span_init(&span, source, sink, 0, frames);
+	while (audio_stream_span_next(&span)) {
+		x = span.src;
+		y = span.snk;
+		for (i = 0; i < span.samples; i++) {
+			y[i] = dcblock_generic(&cd->state[ch], cd->R_coeffs[ch],
+					       x[i]);
+			if (++ch == nch)
+				ch = 0;
 		}
 	}
 }
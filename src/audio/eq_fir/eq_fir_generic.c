@@ -12,31 +12,45 @@
 
 #include <sof/audio/eq_fir/eq_fir.h>
 #include <sof/math/fir_generic.h>
+#include <sof/math/numbers.h>
 #include <errno.h>
 #include <stddef.h>
 #include <stdint.h>
 
+/* Frames of a channel gathered for a fir_32x16_block() call */
+#define EQ_FIR_BLOCK_FRAMES	16
+
 #if CONFIG_FORMAT_S16LE
 void eq_fir_s16(struct fir_state_32x16 fir[], const struct audio_stream *source,
 		struct audio_stream *sink, int frames, int nch)
 {
-	struct fir_state_32x16 *filter;
+	int32_t block[EQ_FIR_BLOCK_FRAMES];
 	int16_t *x;
 	int16_t *y;
-	int32_t z;
+	int done;
 	int idx;
 	int ch;
+	int n;
 	int i;
 
-	for (ch = 0; ch < nch; ch++) {
-		filter = &fir[ch];
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s16(source, idx);
-			y = audio_stream_write_frag_s16(sink, idx);
-			z = fir_32x16(filter, *x << 16);
-			*y = sat_int16(Q_SHIFT_RND(z, 31, 15));
-			idx += nch;
+	for (done = 0; done < frames; done += n) {
+		n = MIN(frames - done, EQ_FIR_BLOCK_FRAMES);
+		for (ch = 0; ch < nch; ch++) {
+			idx = done * nch + ch;
+			for (i = 0; i < n; i++) {
+				x = audio_stream_read_frag_s16(source, idx);
+				block[i] = *x << 16;
+				idx += nch;
+			}
+
+			fir_32x16_block(&fir[ch], block, block, n);
+
+			idx = done * nch + ch;
+			for (i = 0; i < n; i++) {
+				y = audio_stream_write_frag_s16(sink, idx);
+				*y = sat_int16(Q_SHIFT_RND(block[i], 31, 15));
+				idx += nch;
+			}
 		}
 	}
 }
@@ -46,23 +60,33 @@ void eq_fir_s16(struct fir_state_32x16 fir[], const struct audio_stream *source,
 void eq_fir_s24(struct fir_state_32x16 fir[], const struct audio_stream *source,
 		struct audio_stream *sink, int frames, int nch)
 {
-	struct fir_state_32x16 *filter;
+	int32_t block[EQ_FIR_BLOCK_FRAMES];
 	int32_t *x;
 	int32_t *y;
-	int32_t z;
+	int done;
 	int idx;
 	int ch;
+	int n;
 	int i;
 
-	for (ch = 0; ch < nch; ch++) {
-		filter = &fir[ch];
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source, idx);
-			y = audio_stream_write_frag_s32(sink, idx);
-			z = fir_32x16(filter, *x << 8);
-			*y = sat_int24(Q_SHIFT_RND(z, 31, 23));
-			idx += nch;
+	for (done = 0; done < frames; done += n) {
+		n = MIN(frames - done, EQ_FIR_BLOCK_FRAMES);
+		for (ch = 0; ch < nch; ch++) {
+			idx = done * nch + ch;
+			for (i = 0; i < n; i++) {
+				x = audio_stream_read_frag_s32(source, idx);
+				block[i] = *x << 8;
+				idx += nch;
+			}
+
+			fir_32x16_block(&fir[ch], block, block, n);
+
+			idx = done * nch + ch;
+			for (i = 0; i < n; i++) {
+				y = audio_stream_write_frag_s32(sink, idx);
+				*y = sat_int24(Q_SHIFT_RND(block[i], 31, 23));
+				idx += nch;
+			}
 		}
 	}
 }
@@ -72,21 +96,33 @@ void eq_fir_s24(struct fir_state_32x16 fir[], const struct audio_stream *source,
 void eq_fir_s32(struct fir_state_32x16 fir[], const struct audio_stream *source,
 		struct audio_stream *sink, int frames, int nch)
 {
-	struct fir_state_32x16 *filter;
+	int32_t block[EQ_FIR_BLOCK_FRAMES];
 	int32_t *x;
 	int32_t *y;
+	int done;
 	int idx;
 	int ch;
+	int n;
 	int i;
 
-	for (ch = 0; ch < nch; ch++) {
-		filter = &fir[ch];
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source, idx);
-			y = audio_stream_write_frag_s32(sink, idx);
-			*y = fir_32x16(filter, *x);
-			idx += nch;
+	for (done = 0; done < frames; done += n) {
+		n = MIN(frames - done, EQ_FIR_BLOCK_FRAMES);
+		for (ch = 0; ch < nch; ch++) {
+			idx = done * nch + ch;
+			for (i = 0; i < n; i++) {
+				x = audio_stream_read_frag_s32(source, idx);
+				block[i] = *x;
+				idx += nch;
+			}
+
+			fir_32x16_block(&fir[ch], block, block, n);
+
+			idx = done * nch + ch;
+			for (i = 0; i < n; i++) {
+				y = audio_stream_write_frag_s32(sink, idx);
+				*y = block[i];
+				idx += nch;
+			}
 		}
 	}
 }
@@ -6,6 +6,7 @@
 //         Liam Girdwood <liam.r.girdwood@linux.intel.com>
 //         Keyon Jie <yang.jie@linux.intel.com>
 
+#include <sof/audio/audio_stream.h>
 #include <sof/audio/component.h>
 #include <sof/audio/buffer.h>
 #include <sof/audio/eq_iir/eq_iir.h>
@@ -41,23 +42,173 @@ DECLARE_SOF_RT_UUID("eq-iir", eq_iir_uuid, 0x5150c0e6, 0x27f9, 0x4ec8,
 
 DECLARE_TR_CTX(eq_iir_tr, SOF_UUID(eq_iir_uuid), LOG_LEVEL_INFO);
 
-/* IIR component private data */
-struct comp_data {
-	struct iir_state_df2t iir[PLATFORM_MAX_CHANNELS]; /**< filters state */
-	struct comp_data_blob_handler *model_handler;
-	struct sof_eq_iir_config *config;
-	enum sof_ipc_frame source_format;	/**< source frame format */
-	enum sof_ipc_frame sink_format;		/**< sink frame format */
-	int64_t *iir_delay;			/**< pointer to allocated RAM */
-	size_t iir_delay_size;			/**< allocated size */
-	eq_iir_func eq_iir_func;		/**< processing function */
-};
-
-#if CONFIG_FORMAT_S16LE
 /*
  * EQ IIR algorithm code
  */
 
+/* Filters the block of every channel, channels with filters of the same
+ * structure are run in lockstep.
+ */
+static void eq_iir_block(struct comp_data *cd, int nch, int frames)
+{
+	struct iir_state_df2t *iir[IIR_DF2T_MAX_LANES];
+	int32_t *x[IIR_DF2T_MAX_LANES];
+	int lanes;
+	int ch = 0;
+
+	while (ch < nch) {
+		iir[0] = &cd->iir[ch];
+		x[0] = cd->block[ch];
+		lanes = 1;
+		while (lanes < IIR_DF2T_MAX_LANES && ch + lanes < nch &&
+		       iir_df2t_lanes_match(iir[0], &cd->iir[ch + lanes])) {
+			iir[lanes] = &cd->iir[ch + lanes];
+			x[lanes] = cd->block[ch + lanes];
+			lanes++;
+		}
+
+		if (lanes > 1)
+			iir_df2t_block_lanes(iir, x, lanes, frames);
+		else
+			iir_df2t_block(iir[0], x[0], frames);
+
+		ch += lanes;
+	}
+}
+
+#if CONFIG_FORMAT_S16LE
+/* Deinterleaves frames from the offset in the source to the blocks */
+static void eq_iir_read_s16(struct comp_data *cd,
+			    const struct audio_stream *source,
+			    uint32_t offset, uint32_t frames)
+{
+	struct audio_stream_span span;
+	const int16_t *x;
+	int nch = source->channels;
+	int ch = 0;
+	int i = 0;
+	int k;
+
+	audio_stream_span_init(&span, source, NULL, offset, frames);
+	while (audio_stream_span_next(&span)) {
+		x = span.src;
+		for (k = 0; k < span.samples; k++) {
+			cd->block[ch][i] = x[k] << 16;
+			if (++ch == nch) {
+				ch = 0;
+				i++;
+			}
+		}
+	}
+}
+
+/* Interleaves the blocks to frames from the offset in the sink */
+static void eq_iir_write_s16(struct comp_data *cd, struct audio_stream *sink,
+			     uint32_t offset, uint32_t frames)
+{
+	struct audio_stream_span span;
+	int16_t *y;
+	int nch = sink->channels;
+	int ch = 0;
+	int i = 0;
+	int k;
+
+	audio_stream_span_init(&span, NULL, sink, offset, frames);
+	while (audio_stream_span_next(&span)) {
+		y = span.snk;
+		for (k = 0; k < span.samples; k++) {
+			y[k] = sat_int16(Q_SHIFT_RND(cd->block[ch][i], 31, 15));
+			if (++ch == nch) {
+				ch = 0;
+				i++;
+			}
+		}
+	}
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
+/* Deinterleaves frames from the offset in the source to the blocks, the
+ * samples are shifted left to Q1.31.
+ */
+static void eq_iir_read_s32(struct comp_data *cd,
+			    const struct audio_stream *source,
+			    uint32_t offset, uint32_t frames, int shift)
+{
+	struct audio_stream_span span;
+	const int32_t *x;
+	int nch = source->channels;
+	int ch = 0;
+	int i = 0;
+	int k;
+
+	audio_stream_span_init(&span, source, NULL, offset, frames);
+	while (audio_stream_span_next(&span)) {
+		x = span.src;
+		for (k = 0; k < span.samples; k++) {
+			cd->block[ch][i] = x[k] << shift;
+			if (++ch == nch) {
+				ch = 0;
+				i++;
+			}
+		}
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
+
+#if CONFIG_FORMAT_S24LE
+/* Interleaves the blocks to frames from the offset in the sink */
+static void eq_iir_write_s24(struct comp_data *cd, struct audio_stream *sink,
+			     uint32_t offset, uint32_t frames)
+{
+	struct audio_stream_span span;
+	int32_t *y;
+	int nch = sink->channels;
+	int ch = 0;
+	int i = 0;
+	int k;
+
+	audio_stream_span_init(&span, NULL, sink, offset, frames);
+	while (audio_stream_span_next(&span)) {
+		y = span.snk;
+		for (k = 0; k < span.samples; k++) {
+			y[k] = sat_int24(Q_SHIFT_RND(cd->block[ch][i], 31, 23));
+			if (++ch == nch) {
+				ch = 0;
+				i++;
+			}
+		}
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+/* Interleaves the blocks to frames from the offset in the sink */
+static void eq_iir_write_s32(struct comp_data *cd, struct audio_stream *sink,
+			     uint32_t offset, uint32_t frames)
+{
+	struct audio_stream_span span;
+	int32_t *y;
+	int nch = sink->channels;
+	int ch = 0;
+	int i = 0;
+	int k;
+
+	audio_stream_span_init(&span, NULL, sink, offset, frames);
+	while (audio_stream_span_next(&span)) {
+		y = span.snk;
+		for (k = 0; k < span.samples; k++) {
+			y[k] = cd->block[ch][i];
+			if (++ch == nch) {
+				ch = 0;
+				i++;
+			}
+		}
+	}
+}
+#endif /* CONFIG_FORMAT_S32LE */
+
+#if CONFIG_FORMAT_S16LE
 static void eq_iir_s16_default(const struct comp_dev *dev,
 			       const struct audio_stream *source,
 			       struct audio_stream *sink,
@@ -65,25 +216,14 @@ static void eq_iir_s16_default(const struct comp_dev *dev,
 
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct iir_state_df2t *filter;
-	int16_t *x;
-	int16_t *y;
-	int32_t z;
-	int ch;
-	int i;
-	int idx;
-	int nch = source->channels;
-
-	for (ch = 0; ch < nch; ch++) {
-		filter = &cd->iir[ch];
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s16(source, idx);
-			y = audio_stream_write_frag_s16(sink, idx);
-			z = iir_df2t(filter, *x << 16);
-			*y = sat_int16(Q_SHIFT_RND(z, 31, 15));
-			idx += nch;
-		}
+	uint32_t done;
+	uint32_t n;
+
+	for (done = 0; done < frames; done += n) {
+		n = MIN(frames - done, EQ_IIR_BLOCK_FRAMES);
+		eq_iir_read_s16(cd, source, done, n);
+		eq_iir_block(cd, source->channels, n);
+		eq_iir_write_s16(cd, sink, done, n);
 	}
 }
 #endif /* CONFIG_FORMAT_S16LE */
@@ -96,25 +236,14 @@ static void eq_iir_s24_default(const struct comp_dev *dev,
 
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct iir_state_df2t *filter;
-	int32_t *x;
-	int32_t *y;
-	int32_t z;
-	int idx;
-	int ch;
-	int i;
-	int nch = source->channels;
-
-	for (ch = 0; ch < nch; ch++) {
-		filter = &cd->iir[ch];
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source, idx);
-			y = audio_stream_write_frag_s32(sink, idx);
-			z = iir_df2t(filter, *x << 8);
-			*y = sat_int24(Q_SHIFT_RND(z, 31, 23));
-			idx += nch;
-		}
+	uint32_t done;
+	uint32_t n;
+
+	for (done = 0; done < frames; done += n) {
+		n = MIN(frames - done, EQ_IIR_BLOCK_FRAMES);
+		eq_iir_read_s32(cd, source, done, n, 8);
+		eq_iir_block(cd, source->channels, n);
+		eq_iir_write_s24(cd, sink, done, n);
 	}
 }
 #endif /* CONFIG_FORMAT_S24LE */
@@ -127,23 +256,14 @@ static void eq_iir_s32_default(const struct comp_dev *dev,
 
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct iir_state_df2t *filter;
-	int32_t *x;
-	int32_t *y;
-	int idx;
-	int ch;
-	int i;
-	int nch = source->channels;
-
-	for (ch = 0; ch < nch; ch++) {
-		filter = &cd->iir[ch];
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source, idx);
-			y = audio_stream_write_frag_s32(sink, idx);
-			*y = iir_df2t(filter, *x);
-			idx += nch;
-		}
+	uint32_t done;
+	uint32_t n;
+
+	for (done = 0; done < frames; done += n) {
+		n = MIN(frames - done, EQ_IIR_BLOCK_FRAMES);
+		eq_iir_read_s32(cd, source, done, n, 0);
+		eq_iir_block(cd, source->channels, n);
+		eq_iir_write_s32(cd, sink, done, n);
 	}
 }
 #endif /* CONFIG_FORMAT_S32LE */
@@ -156,25 +276,14 @@ static void eq_iir_s32_16_default(const struct comp_dev *dev,
 
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct iir_state_df2t *filter;
-	int32_t *x;
-	int16_t *y;
-	int32_t z;
-	int idx;
-	int ch;
-	int i;
-	int nch = source->channels;
-
-	for (ch = 0; ch < nch; ch++) {
-		filter = &cd->iir[ch];
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source, idx);
-			y = audio_stream_write_frag_s16(sink, idx);
-			z = iir_df2t(filter, *x);
-			*y = sat_int16(Q_SHIFT_RND(z, 31, 15));
-			idx += nch;
-		}
+	uint32_t done;
+	uint32_t n;
+
+	for (done = 0; done < frames; done += n) {
+		n = MIN(frames - done, EQ_IIR_BLOCK_FRAMES);
+		eq_iir_read_s32(cd, source, done, n, 0);
+		eq_iir_block(cd, source->channels, n);
+		eq_iir_write_s16(cd, sink, done, n);
 	}
 }
 #endif /* CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S16LE */
@@ -187,25 +296,14 @@ static void eq_iir_s32_24_default(const struct comp_dev *dev,
 
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct iir_state_df2t *filter;
-	int32_t *x;
-	int32_t *y;
-	int32_t z;
-	int idx;
-	int ch;
-	int i;
-	int nch = source->channels;
-
-	for (ch = 0; ch < nch; ch++) {
-		filter = &cd->iir[ch];
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source, idx);
-			y = audio_stream_write_frag_s32(sink, idx);
-			z = iir_df2t(filter, *x);
-			*y = sat_int24(Q_SHIFT_RND(z, 31, 23));
-			idx += nch;
-		}
+	uint32_t done;
+	uint32_t n;
+
+	for (done = 0; done < frames; done += n) {
+		n = MIN(frames - done, EQ_IIR_BLOCK_FRAMES);
+		eq_iir_read_s32(cd, source, done, n, 0);
+		eq_iir_block(cd, source->channels, n);
+		eq_iir_write_s24(cd, sink, done, n);
 	}
 }
 #endif /* CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S24LE */
@@ -281,6 +379,8 @@ const struct eq_iir_func_map fm_configured[] = {
 #endif /* CONFIG_FORMAT_S32LE */
 };
 
+const size_t fm_configured_count = ARRAY_SIZE(fm_configured);
+
 const struct eq_iir_func_map fm_passthrough[] = {
 #if CONFIG_FORMAT_S16LE
 	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S16_LE,  eq_iir_pass},
@@ -593,7 +693,7 @@ static int eq_iir_verify_params(struct comp_dev *dev,
 	 */
 	buffer_flag = eq_iir_find_func(sourceb->stream.frame_fmt,
 				       sinkb->stream.frame_fmt, fm_configured,
-				       ARRAY_SIZE(fm_configured)) ?
+				       fm_configured_count) ?
 				       BUFF_PARAMS_FRAME_FMT : 0;
 
 	ret = comp_verify_params(dev, buffer_flag, params);
@@ -806,7 +906,7 @@ static int eq_iir_prepare(struct comp_dev *dev)
 		cd->eq_iir_func = eq_iir_find_func(cd->source_format,
 						   cd->sink_format,
 						   fm_configured,
-						   ARRAY_SIZE(fm_configured));
+						   fm_configured_count);
 		if (!cd->eq_iir_func) {
 			comp_err(dev, "eq_iir_prepare(), No proc func");
 			ret = -EINVAL;
@@ -825,6 +925,10 @@ static int eq_iir_prepare(struct comp_dev *dev)
 		}
 		comp_info(dev, "eq_iir_prepare(), pass-through mode.");
 	}
+
+	/* blocks are read out before the filtered samples are written back */
+	dev->inplace = true;
+
 	return 0;
 
 err:
@@ -32,6 +32,7 @@
 #include <sof/math/numbers.h>
 #include <sof/platform.h>
 #include <sof/schedule/edf_schedule.h>
+#include <sof/schedule/ll_schedule.h>
 #include <sof/schedule/schedule.h>
 #include <sof/schedule/task.h>
 #include <sof/string.h>
@@ -57,6 +58,10 @@ DECLARE_TR_CTX(kpb_tr, SOF_UUID(kpb_uuid), LOG_LEVEL_INFO);
 DECLARE_SOF_UUID("kpb-task", kpb_task_uuid, 0xe50057a5, 0x8b27, 0x4db4,
 		 0xbd, 0x79, 0x9a, 0x63, 0x9c, 0xee, 0x5f, 0x50);
 
+/* 3b4c2a6e-9d1f-4e57-a8c3-5f0e7d216b94 */
+DECLARE_SOF_UUID("kpb-wait-task", kpb_wait_task_uuid, 0x3b4c2a6e, 0x9d1f,
+		 0x4e57, 0xa8, 0xc3, 0x5f, 0x0e, 0x7d, 0x21, 0x6b, 0x94);
+
 /* KPB private data, runtime data */
 struct comp_data {
 	enum kpb_state state; /**< current state of KPB component */
@@ -65,6 +70,7 @@ struct comp_data {
 	struct sof_kpb_config config;   /**< component configuration data */
 	struct history_data hd; /** data related to history buffer */
 	struct task draining_task;
+	struct task draining_wait_task; /**< starts the next draining burst */
 	struct draining_data draining_task_data;
 	struct kpb_client clients[KPB_MAX_NO_OF_CLIENTS];
 	struct comp_buffer *sel_sink; /**< real time sink (channel selector )*/
@@ -84,6 +90,7 @@ static void kpb_event_handler(void *arg, enum notify_id type, void *event_data);
 static int kpb_register_client(struct comp_data *kpb, struct kpb_client *cli);
 static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli);
 static enum task_state kpb_draining_task(void *arg);
+static enum task_state kpb_draining_wait(void *arg);
 static int kpb_buffer_data(struct comp_dev *dev,
 			   const struct comp_buffer *source, size_t size);
 static size_t kpb_allocate_history_buffer(struct comp_data *kpb,
@@ -92,13 +99,9 @@ static void kpb_clear_history_buffer(struct history_buffer *buff);
 static void kpb_free_history_buffer(struct history_buffer *buff);
 static inline bool kpb_is_sample_width_supported(uint32_t sampling_width);
 static void kpb_copy_samples(struct comp_buffer *sink,
-			     struct comp_buffer *source, size_t size,
-			     size_t sample_width);
-static void kpb_drain_samples(void *source, struct audio_stream *sink,
-			      size_t size, size_t sample_width);
+			     struct comp_buffer *source, size_t size);
 static void kpb_buffer_samples(const struct audio_stream *source,
-			       uint32_t start, void *sink, size_t size,
-			       size_t sample_width);
+			       uint32_t start, void *sink, size_t size);
 static void kpb_reset_history_buffer(struct history_buffer *buff);
 static inline bool validate_host_params(struct comp_dev *dev,
 					size_t host_period_size,
@@ -181,6 +184,12 @@ static struct comp_dev *kpb_new(const struct comp_driver *drv,
 			       0, /* core on which we should run */
 			       0); /* no flags */
 
+	/* Initialize timer starting the draining bursts */
+	schedule_task_init_ll(&kpb->draining_wait_task,
+			      SOF_UUID(kpb_wait_task_uuid),
+			      SOF_SCHEDULE_LL_TIMER, SOF_TASK_PRI_MED,
+			      kpb_draining_wait, kpb, 0, 0);
+
 	/* Init basic component data */
 	kpb->hd.c_hb = NULL;
 	kpb->kpb_no_of_clients = 0;
@@ -196,99 +205,100 @@ static struct comp_dev *kpb_new(const struct comp_driver *drv,
 /**
  * \brief Allocate history buffer.
  * \param[in] kpb - KPB component data pointer.
+ * \param[in] hb_size_req - requested size of history buffer.
  *
- * \return: none.
+ * \return: allocated size.
  */
 static size_t kpb_allocate_history_buffer(struct comp_data *kpb,
 					  size_t hb_size_req)
 {
-	struct history_buffer *hb;
-	struct history_buffer *new_hb = NULL;
-	/*! Total allocation size */
+	struct history_buffer *hb = NULL;
+	struct history_buffer *new_hb;
+	/*! Remaining allocation size */
 	size_t hb_size = hb_size_req;
 	/*! Current allocation size */
-	size_t ca_size = hb_size;
+	size_t ca_size;
 	/*! Memory caps priorites for history buffer */
 	int hb_mcp[KPB_NO_OF_MEM_POOLS] = {SOF_MEM_CAPS_LP, SOF_MEM_CAPS_HP,
 					   SOF_MEM_CAPS_RAM };
-	void *new_mem_block = NULL;
-	size_t temp_ca_size;
+	void *new_mem_block;
 	int i = 0;
 	size_t allocated_size = 0;
 
 	comp_cl_info(&comp_kpb, "kpb_allocate_history_buffer()");
 
-	/* Initialize history buffer */
-	kpb->hd.c_hb = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
-			       sizeof(struct history_buffer));
-	if (!kpb->hd.c_hb)
-		return 0;
-	kpb->hd.c_hb->next = kpb->hd.c_hb;
-	kpb->hd.c_hb->prev = kpb->hd.c_hb;
-	hb = kpb->hd.c_hb;
+	kpb->hd.c_hb = NULL;
 
 	/* Allocate history buffer/s. KPB history buffer has a size of
 	 * KPB_MAX_BUFFER_SIZE, since there is no single memory block
 	 * that big, we need to allocate couple smaller blocks which
-	 * linked together will form history buffer.
+	 * linked together will form history buffer. Each block is as big
+	 * as the largest free region of the pool in priority order, so
+	 * the buffer is made of as few blocks as possible.
 	 */
 	while (hb_size > 0 && i < ARRAY_SIZE(hb_mcp)) {
-		/* Try to allocate ca_size (current allocation size). At first
-		 * attempt it will be equal to hb_size (history buffer size).
+		/* Blocks hold whole frames, the request itself is made of
+		 * whole frames.
 		 */
-		new_mem_block = rballoc(0, hb_mcp[i], ca_size);
+		ca_size = MIN(hb_size,
+			      ALIGN_DOWN(rballoc_max_size(hb_mcp[i],
+							  PLATFORM_DCACHE_ALIGN),
+					 KPB_ALLOCATION_STEP));
+		if (!ca_size) {
+			i++;
+			continue;
+		}
 
-		if (new_mem_block) {
-			/* We managed to allocate a block of ca_size.
-			 * Now we initialize it.
-			 */
-			comp_cl_info(&comp_kpb, "kpb new memory block: %d",
-				     ca_size);
-			allocated_size += ca_size;
-			hb->start_addr = new_mem_block;
-			hb->end_addr = (char *)new_mem_block +
-				ca_size;
-			hb->w_ptr = new_mem_block;
-			hb->r_ptr = new_mem_block;
-			hb->state = KPB_BUFFER_FREE;
-			hb_size -= ca_size;
-			hb->next = kpb->hd.c_hb;
-			/* Do we need another buffer? */
-			if (hb_size > 0) {
-				/* Yes, we still need at least one more buffer.
-				 * Let's first create new container for it.
-				 */
-				new_hb = rzalloc(SOF_MEM_ZONE_RUNTIME, 0,
-						 SOF_MEM_CAPS_RAM,
-						 sizeof(struct history_buffer));
-				if (!new_hb)
-					return 0;
-				hb->next = new_hb;
-				new_hb->next = kpb->hd.c_hb;
-				new_hb->state = KPB_BUFFER_OFF;
-				new_hb->prev = hb;
-				hb = new_hb;
-				kpb->hd.c_hb->prev = new_hb;
-				ca_size = hb_size;
-				i++;
-			}
-		} else {
-			/* We've failed to allocate ca_size of that hb_mcp
-			 * let's try again with some smaller size.
-			 * NOTE! If we decrement by some small value,
-			 * the allocation will take significant time.
-			 * However, bigger values like
-			 * HEAP_HP_BUFFER_BLOCK_SIZE will result in lower
-			 * accuracy of allocation.
-			 */
-			temp_ca_size = ca_size - KPB_ALLOCATION_STEP;
-			ca_size = (ca_size < temp_ca_size) ? 0 : temp_ca_size;
-			if (ca_size == 0) {
-				ca_size = hb_size;
-				i++;
-			}
+		/* The largest free region may still not fit an aligned
+		 * block of its size, retry a step smaller before giving up
+		 * on the pool.
+		 */
+		do {
+			new_mem_block = rballoc(0, hb_mcp[i], ca_size);
+			if (new_mem_block)
+				break;
+
+			ca_size = ca_size > KPB_ALLOCATION_STEP ?
+				  ALIGN_DOWN(ca_size - 1, KPB_ALLOCATION_STEP) :
+				  0;
+		} while (ca_size);
+
+		if (!new_mem_block) {
+			i++;
 			continue;
 		}
+
+		new_hb = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+				 sizeof(struct history_buffer));
+		if (!new_hb) {
+			rfree(new_mem_block);
+			break;
+		}
+
+		comp_cl_info(&comp_kpb, "kpb new memory block: %d", ca_size);
+
+		new_hb->start_addr = new_mem_block;
+		new_hb->end_addr = (char *)new_mem_block + ca_size;
+		new_hb->w_ptr = new_mem_block;
+		new_hb->r_ptr = new_mem_block;
+
+		/* Link the block at the end of the ring */
+		if (hb) {
+			new_hb->state = KPB_BUFFER_OFF;
+			new_hb->prev = hb;
+			new_hb->next = kpb->hd.c_hb;
+			hb->next = new_hb;
+			kpb->hd.c_hb->prev = new_hb;
+		} else {
+			new_hb->state = KPB_BUFFER_FREE;
+			new_hb->prev = new_hb;
+			new_hb->next = new_hb;
+			kpb->hd.c_hb = new_hb;
+		}
+		hb = new_hb;
+
+		allocated_size += ca_size;
+		hb_size -= ca_size;
 	}
 
 	comp_cl_info(&comp_kpb, "kpb_allocate_history_buffer(): allocated %d bytes",
@@ -346,6 +356,7 @@ static void kpb_free(struct comp_dev *dev)
 	kpb->hd.buffer_size = 0;
 
 	/* remove scheduling */
+	schedule_task_free(&kpb->draining_wait_task);
 	schedule_task_free(&kpb->draining_task);
 
 	/* change state */
@@ -614,7 +625,6 @@ static int kpb_copy(struct comp_dev *dev)
 	struct comp_buffer *source = NULL;
 	struct comp_buffer *sink = NULL;
 	size_t copy_bytes = 0;
-	size_t sample_width = kpb->config.sampling_width;
 	uint32_t flags = 0;
 	struct draining_data *dd = &kpb->draining_task_data;
 
@@ -675,7 +685,7 @@ static int kpb_copy(struct comp_dev *dev)
 			goto out;
 		}
 
-		kpb_copy_samples(sink, source, copy_bytes, sample_width);
+		kpb_copy_samples(sink, source, copy_bytes);
 
 		/* Buffer source data internally in history buffer for future
 		 * use by clients.
@@ -738,7 +748,7 @@ static int kpb_copy(struct comp_dev *dev)
 			goto out;
 		}
 
-		kpb_copy_samples(sink, source, copy_bytes, sample_width);
+		kpb_copy_samples(sink, source, copy_bytes);
 
 		comp_update_buffer_produce(sink, copy_bytes);
 		comp_update_buffer_consume(source, copy_bytes);
@@ -801,7 +811,6 @@ static int kpb_buffer_data(struct comp_dev *dev,
 	uint64_t timeout = 0;
 	uint64_t current_time;
 	enum kpb_state state_preserved = kpb->state;
-	size_t sample_width = kpb->config.sampling_width;
 	struct timer *timer = timer_get();
 
 	comp_dbg(dev, "kpb_buffer_data()");
@@ -858,7 +867,7 @@ static int kpb_buffer_data(struct comp_dev *dev,
 			 * with next buffer.
 			 */
 			kpb_buffer_samples(&source->stream, offset, buff->w_ptr,
-					   space_avail, sample_width);
+					   space_avail);
 			/* Update write pointer & requested copy size */
 			buff->w_ptr = (char *)buff->w_ptr + space_avail;
 			size_to_copy = size_to_copy - space_avail;
@@ -872,7 +881,7 @@ static int kpb_buffer_data(struct comp_dev *dev,
 			 * copy what was requested.
 			 */
 			kpb_buffer_samples(&source->stream, offset, buff->w_ptr,
-					   size_to_copy, sample_width);
+					   size_to_copy);
 			/* Update write pointer & requested copy size */
 			buff->w_ptr = (char *)buff->w_ptr + size_to_copy;
 			/* Reset requested copy size */
@@ -1015,6 +1024,7 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 			      (KPB_SAMPLE_CONTAINER_SIZE(sample_width) / 8) *
 			      kpb->config.channels;
 	size_t period_bytes_limit;
+	uint64_t request_time = platform_timer_get(timer_get());
 	uint32_t flags;
 
 	comp_info(dev, "kpb_init_draining(): requested draining of %d [ms] from history buffer",
@@ -1100,20 +1110,23 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 		 * Note! We have already verified host params during
 		 * kpb_prepare().
 		 */
+		/* Calculate time in clock ticks each draining event
+		 * shall take place. This time will be used to
+		 * synchronize us with application interrupts.
+		 */
+		drain_interval = ((host_period_size / bytes_per_ms) *
+				 ticks_per_ms) /
+				 KPB_DRAIN_NUM_OF_PPL_PERIODS_AT_ONCE;
+
 		if (kpb->sync_draining_mode) {
-			/* Calculate time in clock ticks each draining event
-			 * shall take place. This time will be used to
-			 * synchronize us with application interrupts.
-			 */
-			drain_interval = ((host_period_size / bytes_per_ms) *
-					 ticks_per_ms) /
-					 KPB_DRAIN_NUM_OF_PPL_PERIODS_AT_ONCE;
 			period_bytes_limit = host_period_size;
 			comp_info(dev, "kpb_init_draining(): sync_draining_mode selected with interval %d [uS].",
 				  drain_interval * 1000 / ticks_per_ms);
 		} else {
-			/* Unlimited draining */
-			drain_interval = 0;
+			/* Unlimited draining, every burst fills the host
+			 * buffer as much as it can take. The interval is
+			 * only waited when the host buffer is full.
+			 */
 			period_bytes_limit = 0;
 			comp_info(dev, "kpb_init_draining: unlimited draining speed selected.");
 		}
@@ -1124,11 +1137,14 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 		kpb->draining_task_data.sink = kpb->host_sink;
 		kpb->draining_task_data.hb = buff;
 		kpb->draining_task_data.drain_req = drain_req;
-		kpb->draining_task_data.sample_width = sample_width;
 		kpb->draining_task_data.drain_interval = drain_interval;
 		kpb->draining_task_data.pb_limit = period_bytes_limit;
 		kpb->draining_task_data.dev = dev;
 		kpb->draining_task_data.sync_mode_on = kpb->sync_draining_mode;
+		kpb->draining_task_data.request_time = request_time;
+		kpb->draining_task_data.drained = 0;
+		kpb->draining_task_data.max_burst = 0;
+		kpb->draining_task_data.bursts = 0;
 
 		/* Set host-sink copy mode to blocking */
 		comp_set_attribute(kpb->host_sink->sink, COMP_ATTR_COPY_TYPE,
@@ -1142,215 +1158,196 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 	}
 }
 
+/**
+ * \brief Drains a burst of history to the host sink.
+ * \param[in] dd - draining data.
+ * \param[in] limit - max size of the burst in bytes.
+ *
+ * \return size of the burst in bytes.
+ */
+static size_t kpb_drain_burst(struct draining_data *dd, size_t limit)
+{
+	struct audio_stream *sink = &dd->sink->stream;
+	struct history_buffer *buff = dd->hb;
+	size_t burst = 0;
+	size_t size;
+
+	limit = MIN(limit, audio_stream_get_free_bytes(sink));
+	limit = MIN(limit, dd->drain_req);
+
+	while (burst < limit) {
+		size = MIN(limit - burst,
+			   (char *)buff->end_addr - (char *)buff->r_ptr);
+
+		/* History is stored as it came, only the sink can wrap */
+		audio_stream_copy_from_linear(buff->r_ptr, sink, burst, size);
+
+		buff->r_ptr = (char *)buff->r_ptr + size;
+		burst += size;
+
+		if (buff->r_ptr == buff->end_addr) {
+			buff->r_ptr = buff->start_addr;
+			buff = buff->next;
+		}
+	}
+
+	dd->hb = buff;
+	dd->drain_req -= burst;
+
+	return burst;
+}
+
 /**
  * \brief Draining task.
  *
+ * Every run moves one burst of history to the host and yields to the
+ * scheduler until the whole request is drained. In sync mode a burst is
+ * a host period every drain interval, otherwise it is as much as the host
+ * buffer can take. The drain interval, and room in a full host buffer, are
+ * waited for by a timer task, so the DSP can idle between bursts.
+ *
  * \param[in] arg - pointer keeping drainig data previously prepared
  * by kpb_init_draining().
  *
- * \return none.
+ * \return task state.
  */
 static enum task_state kpb_draining_task(void *arg)
 {
 	struct draining_data *draining_data = (struct draining_data *)arg;
 	struct comp_buffer *sink = draining_data->sink;
-	struct history_buffer *buff = draining_data->hb;
-	size_t drain_req = draining_data->drain_req;
-	size_t sample_width = draining_data->sample_width;
-	size_t size_to_read;
-	size_t size_to_copy;
-	bool move_buffer = false;
-	uint32_t drained = 0;
-	uint64_t draining_time_start;
-	uint64_t draining_time_end;
-	uint64_t draining_time_ms;
+	struct comp_data *kpb = comp_get_drvdata(draining_data->dev);
 	enum comp_copy_type copy_type = COMP_COPY_NORMAL;
-	uint64_t drain_interval = draining_data->drain_interval;
-	uint64_t next_copy_time = 0;
-	uint64_t current_time;
-	size_t period_bytes = 0;
-	size_t period_bytes_limit = draining_data->pb_limit;
 	struct timer *timer = timer_get();
-	size_t period_copy_start = platform_timer_get(timer);
-	size_t time_taken;
-	size_t *rt_stream_update = &draining_data->buffered_while_draining;
-	struct comp_data *kpb = comp_get_drvdata(draining_data->dev);
-	bool sync_mode_on = &draining_data->sync_mode_on;
+	uint64_t current_time = platform_timer_get(timer);
+	uint64_t ticks_per_ms = clock_ms_to_ticks(PLATFORM_DEFAULT_CLOCK, 1);
+	uint64_t draining_time_ms;
+	uint64_t wait_us;
+	size_t burst;
 	uint32_t flags;
 
-	comp_cl_info(&comp_kpb, "kpb_draining_task(), start.");
-
+	/* The DSP stays awake while a burst is in flight only */
 	pm_runtime_disable(PM_RUNTIME_DSP, PLATFORM_PRIMARY_CORE_ID);
 
-	/* Change KPB internal state to DRAINING */
-	kpb_change_state(kpb, KPB_STATE_DRAINING);
+	if (!draining_data->is_draining_active) {
+		comp_cl_info(&comp_kpb, "kpb_draining_task(), start.");
 
-	draining_time_start = platform_timer_get(timer);
+		/* Change KPB internal state to DRAINING */
+		kpb_change_state(kpb, KPB_STATE_DRAINING);
 
-	while (drain_req > 0) {
-		/* Have we received reset request? */
-		if (kpb->state == KPB_STATE_RESETTING) {
-			kpb_change_state(kpb, KPB_STATE_RESET_FINISHING);
-			kpb_reset(draining_data->dev);
-			goto out;
-		}
-		/* Are we ready to drain further or host still need some time
-		 * to read the data already provided?
-		 */
-		if (sync_mode_on &&
-		    next_copy_time > platform_timer_get(timer)) {
-			period_bytes = 0;
-			period_copy_start = platform_timer_get(timer);
-			continue;
-		} else if (next_copy_time == 0) {
-			period_copy_start = platform_timer_get(timer);
-		}
-
-		size_to_read = (uint32_t)buff->end_addr - (uint32_t)buff->r_ptr;
-
-		if (size_to_read > audio_stream_get_free_bytes(&sink->stream)) {
-			if (audio_stream_get_free_bytes(&sink->stream) >= drain_req)
-				size_to_copy = drain_req;
-			else
-				size_to_copy = audio_stream_get_free_bytes(&sink->stream);
-		} else {
-			if (size_to_read > drain_req) {
-				size_to_copy = drain_req;
-			} else {
-				size_to_copy = size_to_read;
-				move_buffer = true;
-			}
-		}
-
-		kpb_drain_samples(buff->r_ptr, &sink->stream, size_to_copy,
-				  sample_width);
-
-		buff->r_ptr = (char *)buff->r_ptr + (uint32_t)size_to_copy;
-		drain_req -= size_to_copy;
-		drained += size_to_copy;
-		period_bytes += size_to_copy;
-		kpb->hd.free += MIN(kpb->hd.buffer_size -
-				    kpb->hd.free, size_to_copy);
+		draining_data->is_draining_active = 1;
+		draining_data->start_time = current_time;
+	}
 
-		if (move_buffer) {
-			buff->r_ptr = buff->start_addr;
-			buff = buff->next;
-			move_buffer = false;
-		}
+	/* Have we received reset request? */
+	if (kpb->state == KPB_STATE_RESETTING) {
+		kpb_change_state(kpb, KPB_STATE_RESET_FINISHING);
+		kpb_reset(draining_data->dev);
+		goto out;
+	}
 
-		if (size_to_copy) {
-			comp_update_buffer_produce(sink, size_to_copy);
-			comp_copy(sink->sink);
-		} else if (!audio_stream_get_free_bytes(&sink->stream)) {
-			/* There is no free space in sink buffer.
-			 * Call .copy() on sink component so it can
-			 * process its data further.
-			 */
-			comp_copy(sink->sink);
-		}
+	burst = kpb_drain_burst(draining_data, draining_data->sync_mode_on ?
+				draining_data->pb_limit : SIZE_MAX);
+
+	if (burst) {
+		if (!draining_data->bursts++)
+			draining_data->first_burst_time = current_time;
+		draining_data->max_burst = MAX(draining_data->max_burst,
+					       burst);
+		draining_data->drained += burst;
+		kpb->hd.free += MIN(kpb->hd.buffer_size - kpb->hd.free, burst);
+
+		comp_update_buffer_produce(sink, burst);
+		comp_copy(sink->sink);
+	} else if (!audio_stream_get_free_bytes(&sink->stream)) {
+		/* There is no free space in sink buffer.
+		 * Call .copy() on sink component so it can
+		 * process its data further.
+		 */
+		comp_copy(sink->sink);
+	}
 
-		if (sync_mode_on && period_bytes >= period_bytes_limit) {
-			current_time = platform_timer_get(timer);
-			time_taken = current_time - period_copy_start;
-			next_copy_time = current_time + drain_interval -
-					 time_taken;
-		}
+	if (draining_data->drain_req)
+		goto next_burst;
 
-		if (drain_req == 0) {
-		/* We have finished draining of requested data however
-		 * while we were draining real time stream could provided
-		 * new data which needs to be copy to host.
+	/* We have finished draining of requested data however
+	 * while we were draining real time stream could provided
+	 * new data which needs to be copy to host.
+	 */
+	comp_cl_dbg(&comp_kpb, "kpb: update drain_req by %d",
+		    draining_data->buffered_while_draining);
+	spin_lock_irq(&kpb->lock, flags);
+	draining_data->drain_req += draining_data->buffered_while_draining;
+	draining_data->buffered_while_draining = 0;
+	if (!draining_data->drain_req && kpb->state == KPB_STATE_DRAINING) {
+		/* Draining is done. Now switch KPB to copy real time
+		 * stream to client's sink. This state is called
+		 * "draining on demand"
+		 * Note! If KPB state changed during draining due to
+		 * i.e reset request we should not change that state.
 		 */
-			comp_cl_info(&comp_kpb, "kpb: update drain_req by %d",
-				     *rt_stream_update);
-			spin_lock_irq(&kpb->lock, flags);
-			drain_req += *rt_stream_update;
-			*rt_stream_update = 0;
-			if (!drain_req && kpb->state == KPB_STATE_DRAINING) {
-			/* Draining is done. Now switch KPB to copy real time
-			 * stream to client's sink. This state is called
-			 * "draining on demand"
-			 * Note! If KPB state changed during draining due to
-			 * i.e reset request we should not change that state.
-			 */
-				kpb_change_state(kpb, KPB_STATE_HOST_COPY);
-			}
-			spin_unlock_irq(&kpb->lock, flags);
-		}
+		kpb_change_state(kpb, KPB_STATE_HOST_COPY);
 	}
+	spin_unlock_irq(&kpb->lock, flags);
 
-out:
-	draining_time_end = platform_timer_get(timer);
+	if (draining_data->drain_req)
+		goto next_burst;
 
+out:
 	/* Reset host-sink copy mode back to unblocking */
 	comp_set_attribute(sink->sink, COMP_ATTR_COPY_TYPE, &copy_type);
 
-	draining_time_ms = (draining_time_end - draining_time_start)
-		/ clock_ms_to_ticks(PLATFORM_DEFAULT_CLOCK, 1);
+	draining_time_ms = (current_time - draining_data->start_time) /
+			   ticks_per_ms;
 	if (draining_time_ms <= UINT_MAX)
 		comp_cl_info(&comp_kpb, "KPB: kpb_draining_task(), done. %u drained in %u ms",
-			     drained, (unsigned int)draining_time_ms);
+			     draining_data->drained,
+			     (unsigned int)draining_time_ms);
 	else
 		comp_cl_info(&comp_kpb, "KPB: kpb_draining_task(), done. %u drained in > %u ms",
-			     drained, UINT_MAX);
+			     draining_data->drained, UINT_MAX);
+
+	if (draining_data->bursts)
+		comp_cl_info(&comp_kpb, "KPB: %u bursts of max %u bytes, first one %u us after request",
+			     draining_data->bursts, draining_data->max_burst,
+			     (unsigned int)((draining_data->first_burst_time -
+					     draining_data->request_time) *
+					    1000 / ticks_per_ms));
+
+	draining_data->is_draining_active = 0;
 
 	pm_runtime_enable(PM_RUNTIME_DSP, PLATFORM_PRIMARY_CORE_ID);
 
+	return SOF_TASK_STATE_COMPLETED;
+
+next_burst:
+	pm_runtime_enable(PM_RUNTIME_DSP, PLATFORM_PRIMARY_CORE_ID);
+
+	/* Unlimited draining goes on while the host buffer takes data */
+	if (!draining_data->sync_mode_on && burst)
+		return SOF_TASK_STATE_RESCHEDULE;
+
+	/* Give host time to read the data already provided, the DSP may
+	 * idle until the timer starts the next burst.
+	 */
+	wait_us = draining_data->drain_interval * 1000 / ticks_per_ms;
+	schedule_task(&kpb->draining_wait_task, wait_us, wait_us);
+
 	return SOF_TASK_STATE_COMPLETED;
 }
 
 /**
- * \brief Drain data samples safe, according to configuration.
+ * \brief Starts the next draining burst once the interval has passed.
+ * \param[in] arg - pointer to the KPB private data.
  *
- * \param[in] dev - kpb component device pointer
- * \param[in] sink - pointer to sink buffer.
- * \param[in] source - pointer to source buffer.
- * \param[in] size - requested copy size in bytes.
- *
- * \return none.
+ * \return task state.
  */
-static void kpb_drain_samples(void *source, struct audio_stream *sink,
-			      size_t size, size_t sample_width)
+static enum task_state kpb_draining_wait(void *arg)
 {
-#if CONFIG_FORMAT_S16LE || CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
-	void *dst;
-	void *src = source;
-#endif
-	size_t i;
-	size_t j = 0;
-	size_t channel;
-	size_t frames = KPB_BYTES_TO_FRAMES(size, sample_width);
-
-	switch (sample_width) {
-#if CONFIG_FORMAT_S16LE
-	case 16:
-		for (i = 0; i < frames; i++) {
-			for (channel = 0; channel < KPB_NUM_OF_CHANNELS; channel++) {
-				dst = audio_stream_write_frag_s16(sink, j);
-				*((int16_t *)dst) = *((int16_t *)src);
-				src = ((int16_t *)src) + 1;
-				j++;
-			}
-		}
-		break;
-#endif /* CONFIG_FORMAT_S16LE */
-#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
-	case 24:
-	case 32:
-		for (i = 0; i < frames; i++) {
-			for (channel = 0; channel < KPB_NUM_OF_CHANNELS; channel++) {
-				dst = audio_stream_write_frag_s32(sink, j);
-				*((int32_t *)dst) = *((int32_t *)src);
-				src = ((int32_t *)src) + 1;
-				j++;
-			}
-		}
-		break;
-#endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
-	default:
-		comp_cl_err(&comp_kpb, "KPB: An attempt to copy not supported format!");
-		return;
-	}
+	struct comp_data *kpb = arg;
+
+	schedule_task(&kpb->draining_task, 0, 0);
+
+	return SOF_TASK_STATE_COMPLETED;
 }
 
 /**
@@ -1359,43 +1356,11 @@ static void kpb_drain_samples(void *source, struct audio_stream *sink,
  * \param[in] start Start offset of source buffer in bytes.
  * \param[in,out] sink Pointer to sink buffer.
  * \param[in] size Requested copy size in bytes.
- * \param[in] sample_width Sample size.
  */
 static void kpb_buffer_samples(const struct audio_stream *source,
-			       uint32_t start, void *sink, size_t size,
-			       size_t sample_width)
+			       uint32_t start, void *sink, size_t size)
 {
-	void *src;
-	void *dst = sink;
-	size_t i;
-	size_t j = start /
-		(sample_width == 16 ? sizeof(int16_t) : sizeof(int32_t));
-	size_t channel;
-	size_t frames = KPB_BYTES_TO_FRAMES(size, sample_width);
-
-	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < KPB_NUM_OF_CHANNELS; channel++) {
-			switch (sample_width) {
-			case 16:
-				src = audio_stream_read_frag_s16(source, j);
-				*((int16_t *)dst) = *((int16_t *)src);
-				dst = ((int16_t *)dst) + 1;
-				break;
-#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
-			case 24:
-			case 32:
-				src = audio_stream_read_frag_s32(source, j);
-				*((int32_t *)dst) = *((int32_t *)src);
-				dst = ((int32_t *)dst) + 1;
-				break;
-#endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE*/
-			default:
-				comp_cl_err(&comp_kpb, "KPB: An attempt to copy not supported format!");
-				return;
-			}
-			j++;
-		}
-	}
+	audio_stream_copy_to_linear(source, start, sink, size);
 }
 
 /**
@@ -1459,48 +1424,15 @@ static inline bool kpb_is_sample_width_supported(uint32_t sampling_width)
  * \return none.
  */
 static void kpb_copy_samples(struct comp_buffer *sink,
-			     struct comp_buffer *source, size_t size,
-			     size_t sample_width)
+			     struct comp_buffer *source, size_t size)
 {
-#if CONFIG_FORMAT_S16LE || CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
-	void *dst;
-	void *src;
-#endif
-	size_t i;
-	size_t j = 0;
-	size_t channel;
-	size_t frames = KPB_BYTES_TO_FRAMES(size, sample_width);
 	struct audio_stream *istream = &source->stream;
 	struct audio_stream *ostream = &sink->stream;
 
 	buffer_invalidate(source, size);
 
-	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < KPB_NUM_OF_CHANNELS; channel++) {
-			switch (sample_width) {
-#if CONFIG_FORMAT_S16LE
-			case 16:
-				dst = audio_stream_write_frag_s16(ostream, j);
-				src = audio_stream_read_frag_s16(istream, j);
-				*((int16_t *)dst) = *((int16_t *)src);
-				break;
-#endif /* CONFIG_FORMAT_S16LE */
-#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
-			case 24:
-				/* FALLTHROUGH */
-			case 32:
-				dst = audio_stream_write_frag_s32(ostream, j);
-				src = audio_stream_read_frag_s32(istream, j);
-				*((int32_t *)dst) = *((int32_t *)src);
-				break;
-#endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE*/
-			default:
-				comp_cl_err(&comp_kpb, "KPB: An attempt to copy not supported format!");
-				return;
-			}
-			j++;
-		}
-	}
+	audio_stream_copy(istream, 0, ostream, 0,
+			  size / audio_stream_sample_bytes(istream));
 
 	buffer_writeback(sink, size);
 }
@@ -7,7 +7,6 @@
 
 #include <sof/audio/buffer.h>
 #include <sof/audio/component.h>
-#include <sof/audio/format.h>
 #include <sof/audio/mixer.h>
 #include <sof/audio/pipeline.h>
 #include <sof/common.h>
@@ -38,81 +37,9 @@ DECLARE_TR_CTX(mixer_tr, SOF_UUID(mixer_uuid), LOG_LEVEL_INFO);
 
 /* mixer component private data */
 struct mixer_data {
-	void (*mix_func)(struct comp_dev *dev, struct audio_stream *sink,
-			 const struct audio_stream **sources, uint32_t count,
-			 uint32_t frames);
+	mixer_func mix_func;
 };
 
-#if CONFIG_FORMAT_S16LE
-/* Mix n 16 bit PCM source streams to one sink stream */
-static void mix_n_s16(struct comp_dev *dev, struct audio_stream *sink,
-		      const struct audio_stream **sources, uint32_t num_sources,
-		      uint32_t frames)
-{
-	int16_t *src;
-	int16_t *dest;
-	int32_t val;
-	int i;
-	int j;
-	int channel;
-	uint32_t frag = 0;
-
-	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < sink->channels; channel++) {
-			val = 0;
-
-			for (j = 0; j < num_sources; j++) {
-				src = audio_stream_read_frag_s16(sources[j],
-								 frag);
-				val += *src;
-			}
-
-			dest = audio_stream_write_frag_s16(sink, frag);
-
-			/* Saturate to 16 bits */
-			*dest = sat_int16(val);
-
-			frag++;
-		}
-	}
-}
-#endif /* CONFIG_FORMAT_S16LE */
-
-#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
-/* Mix n 32 bit PCM source streams to one sink stream */
-static void mix_n_s32(struct comp_dev *dev, struct audio_stream *sink,
-		      const struct audio_stream **sources, uint32_t num_sources,
-		      uint32_t frames)
-{
-	int32_t *src;
-	int32_t *dest;
-	int64_t val;
-	int i;
-	int j;
-	int channel;
-	uint32_t frag = 0;
-
-	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < sink->channels; channel++) {
-			val = 0;
-
-			for (j = 0; j < num_sources; j++) {
-				src = audio_stream_read_frag_s32(sources[j],
-								 frag);
-				val += *src;
-			}
-
-			dest = audio_stream_write_frag_s32(sink, frag);
-
-			/* Saturate to 32 bits */
-			*dest = sat_int32(val);
-
-			frag++;
-		}
-	}
-}
-#endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
-
 static struct comp_dev *mixer_new(const struct comp_driver *drv,
 				  struct sof_ipc_comp *comp)
 {
@@ -399,23 +326,9 @@ static int mixer_prepare(struct comp_dev *dev)
 	/* does mixer already have active source streams ? */
 	if (dev->state != COMP_STATE_ACTIVE) {
 		/* currently inactive so setup mixer */
-		switch (sink->stream.frame_fmt) {
-#if CONFIG_FORMAT_S16LE
-		case SOF_IPC_FRAME_S16_LE:
-			md->mix_func = mix_n_s16;
-			break;
-#endif /* CONFIG_FORMAT_S16LE */
-#if CONFIG_FORMAT_S24LE
-		case SOF_IPC_FRAME_S24_4LE:
-			md->mix_func = mix_n_s32;
-			break;
-#endif /* CONFIG_FORMAT_S24LE */
-#if CONFIG_FORMAT_S32LE
-		case SOF_IPC_FRAME_S32_LE:
-			md->mix_func = mix_n_s32;
-			break;
-#endif /* CONFIG_FORMAT_S32LE */
-		default:
+		md->mix_func =
+			mixer_get_processing_function(sink->stream.frame_fmt);
+		if (!md->mix_func) {
 			comp_err(dev, "unsupported data format");
 			return -EINVAL;
 		}
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2016 Intel Corporation. All rights reserved.
+//
+// Author: Liam Girdwood <liam.r.girdwood@linux.intel.com>
+//         Keyon Jie <yang.jie@linux.intel.com>
+
+/**
+ * \file audio/mixer/mixer_generic.c
+ * \brief Mixer generic processing implementation
+ * \authors Liam Girdwood <liam.r.girdwood@linux.intel.com>\n
+ *          Keyon Jie <yang.jie@linux.intel.com>
+ */
+
+#include <sof/audio/mixer.h>
+
+#ifdef MIXER_GENERIC
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/component.h>
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <sof/math/numbers.h>
+#include <sof/platform.h>
+#include <ipc/stream.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if CONFIG_FORMAT_S16LE
+/* Mix n 16 bit PCM source streams to one sink stream */
+static void mix_n_s16(struct comp_dev *dev, struct audio_stream *sink,
+		      const struct audio_stream **sources, uint32_t num_sources,
+		      uint32_t frames)
+{
+	const int16_t *src[PLATFORM_MAX_STREAMS];
+	int32_t acc[MIXER_BLOCK_SAMPLES];
+	int16_t *dest = sink->w_ptr;
+	uint32_t samples = frames * sink->channels;
+	uint32_t seg;
+	uint32_t n;
+	int i;
+	int j;
+
+	for (j = 0; j < num_sources; j++)
+		src[j] = sources[j]->r_ptr;
+
+	while (samples) {
+		/* the longest span without wrap in sink and all sources */
+		seg = MIN(samples,
+			  audio_stream_bytes_without_wrap(sink, dest) >> 1);
+		for (j = 0; j < num_sources; j++)
+			seg = MIN(seg, audio_stream_bytes_without_wrap(sources[j],
+								       src[j]) >> 1);
+
+		samples -= seg;
+
+		while (seg) {
+			n = MIN(seg, MIXER_BLOCK_SAMPLES);
+
+			/* accumulate the whole block source by source */
+			for (i = 0; i < n; i++)
+				acc[i] = src[0][i];
+
+			for (j = 1; j < num_sources; j++)
+				for (i = 0; i < n; i++)
+					acc[i] += src[j][i];
+
+			/* Saturate to 16 bits */
+			for (i = 0; i < n; i++)
+				dest[i] = sat_int16(acc[i]);
+
+			for (j = 0; j < num_sources; j++)
+				src[j] += n;
+			dest += n;
+			seg -= n;
+		}
+
+		for (j = 0; j < num_sources; j++)
+			src[j] = audio_stream_wrap(sources[j], (void *)src[j]);
+		dest = audio_stream_wrap(sink, dest);
+	}
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
+/* Mix n 32 bit PCM source streams to one sink stream */
+static void mix_n_s32(struct comp_dev *dev, struct audio_stream *sink,
+		      const struct audio_stream **sources, uint32_t num_sources,
+		      uint32_t frames)
+{
+	const int32_t *src[PLATFORM_MAX_STREAMS];
+	int64_t acc[MIXER_BLOCK_SAMPLES];
+	int32_t *dest = sink->w_ptr;
+	uint32_t samples = frames * sink->channels;
+	uint32_t seg;
+	uint32_t n;
+	int i;
+	int j;
+
+	for (j = 0; j < num_sources; j++)
+		src[j] = sources[j]->r_ptr;
+
+	while (samples) {
+		/* the longest span without wrap in sink and all sources */
+		seg = MIN(samples,
+			  audio_stream_bytes_without_wrap(sink, dest) >> 2);
+		for (j = 0; j < num_sources; j++)
+			seg = MIN(seg, audio_stream_bytes_without_wrap(sources[j],
+								       src[j]) >> 2);
+
+		samples -= seg;
+
+		while (seg) {
+			n = MIN(seg, MIXER_BLOCK_SAMPLES);
+
+			/* accumulate the whole block source by source */
+			for (i = 0; i < n; i++)
+				acc[i] = src[0][i];
+
+			for (j = 1; j < num_sources; j++)
+				for (i = 0; i < n; i++)
+					acc[i] += src[j][i];
+
+			/* Saturate to 32 bits */
+			for (i = 0; i < n; i++)
+				dest[i] = sat_int32(acc[i]);
+
+			for (j = 0; j < num_sources; j++)
+				src[j] += n;
+			dest += n;
+			seg -= n;
+		}
+
+		for (j = 0; j < num_sources; j++)
+			src[j] = audio_stream_wrap(sources[j], (void *)src[j]);
+		dest = audio_stream_wrap(sink, dest);
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
+
+const struct mix_func_map mix_func_map[] = {
+#if CONFIG_FORMAT_S16LE
+	{ SOF_IPC_FRAME_S16_LE, mix_n_s16 },
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S24_4LE, mix_n_s32 },
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S32_LE, mix_n_s32 },
+#endif /* CONFIG_FORMAT_S32LE */
+};
+
+const size_t mix_count = ARRAY_SIZE(mix_func_map);
+
+#endif /* MIXER_GENERIC */
@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+/**
+ * \file audio/mixer/mixer_hifi3.c
+ * \brief Mixer HiFi3 processing implementation
+ */
+
+#include <sof/audio/mixer.h>
+
+#ifdef MIXER_HIFI3
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/component.h>
+#include <sof/common.h>
+#include <sof/math/numbers.h>
+#include <sof/platform.h>
+#include <ipc/stream.h>
+#include <xtensa/tie/xt_hifi3.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if CONFIG_FORMAT_S16LE
+/**
+ * \brief HiFi3 enabled mixing of n 16 bit PCM source streams.
+ * \param[in,out] dev Mixer base component device.
+ * \param[in,out] sink Destination stream.
+ * \param[in] sources Array of source streams.
+ * \param[in] num_sources Number of source streams.
+ * \param[in] frames Number of frames to process.
+ */
+static void mix_n_s16(struct comp_dev *dev, struct audio_stream *sink,
+		      const struct audio_stream **sources, uint32_t num_sources,
+		      uint32_t frames)
+{
+	int16_t *src[PLATFORM_MAX_STREAMS];
+	ae_int32x2 acc[MIXER_BLOCK_SAMPLES / 2];
+	int16_t *dest = sink->w_ptr;
+	ae_int16x4 *in;
+	ae_int16x4 *out;
+	ae_int16x4 sample;
+	ae_int32x2 lo;
+	ae_int32x2 hi;
+	ae_int32x2 sum;
+	ae_valign align_in;
+	ae_valign align_out = AE_ZALIGN64();
+	uint32_t samples = frames * sink->channels;
+	uint32_t seg;
+	uint32_t n;
+	uint32_t quads;
+	int i;
+	int j;
+
+	for (j = 0; j < num_sources; j++)
+		src[j] = sources[j]->r_ptr;
+
+	while (samples) {
+		/* the longest span without wrap in sink and all sources */
+		seg = MIN(samples,
+			  audio_stream_bytes_without_wrap(sink, dest) >> 1);
+		for (j = 0; j < num_sources; j++)
+			seg = MIN(seg, audio_stream_bytes_without_wrap(sources[j],
+								       src[j]) >> 1);
+
+		samples -= seg;
+
+		while (seg) {
+			n = MIN(seg, MIXER_BLOCK_SAMPLES);
+			quads = n >> 2;
+
+			for (i = 0; i < quads * 2; i++)
+				acc[i] = AE_ZERO32();
+
+			/* accumulate the whole block source by source, four
+			 * samples per load
+			 */
+			for (j = 0; j < num_sources; j++) {
+				in = (ae_int16x4 *)src[j];
+				align_in = AE_LA64_PP(in);
+				for (i = 0; i < quads; i++) {
+					AE_LA16X4_IP(sample, align_in, in);
+					lo = AE_CVT32X2F16_32(sample);
+					hi = AE_CVT32X2F16_10(sample);
+					acc[2 * i] = AE_ADD32(acc[2 * i],
+							      AE_SRAI32(lo, 16));
+					acc[2 * i + 1] = AE_ADD32(acc[2 * i + 1],
+								  AE_SRAI32(hi, 16));
+				}
+			}
+
+			/* Saturate to 16 bits */
+			out = (ae_int16x4 *)dest;
+			for (i = 0; i < quads; i++) {
+				sample = AE_SAT16X4(acc[2 * i], acc[2 * i + 1]);
+				AE_SA16X4_IP(sample, align_out, out);
+			}
+			AE_SA64POS_FP(align_out, out);
+
+			/* samples of the block left over the last four */
+			for (i = quads * 4; i < n; i++) {
+				sum = AE_ZERO32();
+				for (j = 0; j < num_sources; j++) {
+					sample = AE_L16_X((ae_int16 *)src[j],
+							  i * sizeof(ae_int16));
+					lo = AE_CVT32X2F16_32(sample);
+					sum = AE_ADD32(sum, AE_SRAI32(lo, 16));
+				}
+
+				sample = AE_SAT16X4(sum, sum);
+				AE_S16_0_X(sample, (ae_int16 *)dest,
+					   i * sizeof(ae_int16));
+			}
+
+			for (j = 0; j < num_sources; j++)
+				src[j] += n;
+			dest += n;
+			seg -= n;
+		}
+
+		for (j = 0; j < num_sources; j++)
+			src[j] = audio_stream_wrap(sources[j], src[j]);
+		dest = audio_stream_wrap(sink, dest);
+	}
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
+/**
+ * \brief HiFi3 enabled mixing of n 32 bit PCM source streams.
+ * \param[in,out] dev Mixer base component device.
+ * \param[in,out] sink Destination stream.
+ * \param[in] sources Array of source streams.
+ * \param[in] num_sources Number of source streams.
+ * \param[in] frames Number of frames to process.
+ */
+static void mix_n_s32(struct comp_dev *dev, struct audio_stream *sink,
+		      const struct audio_stream **sources, uint32_t num_sources,
+		      uint32_t frames)
+{
+	int32_t *src[PLATFORM_MAX_STREAMS];
+	ae_int64 acc[MIXER_BLOCK_SAMPLES];
+	int32_t *dest = sink->w_ptr;
+	ae_int32x2 *in;
+	ae_int32x2 *out;
+	ae_int32x2 sample;
+	ae_f32x2 out_sample;
+	ae_int64 lo;
+	ae_int64 hi;
+	ae_int64 sum;
+	ae_valign align_in;
+	ae_valign align_out = AE_ZALIGN64();
+	uint32_t samples = frames * sink->channels;
+	uint32_t seg;
+	uint32_t n;
+	uint32_t pairs;
+	int i;
+	int j;
+
+	for (j = 0; j < num_sources; j++)
+		src[j] = sources[j]->r_ptr;
+
+	while (samples) {
+		/* the longest span without wrap in sink and all sources */
+		seg = MIN(samples,
+			  audio_stream_bytes_without_wrap(sink, dest) >> 2);
+		for (j = 0; j < num_sources; j++)
+			seg = MIN(seg, audio_stream_bytes_without_wrap(sources[j],
+								       src[j]) >> 2);
+
+		samples -= seg;
+
+		while (seg) {
+			n = MIN(seg, MIXER_BLOCK_SAMPLES);
+			pairs = n >> 1;
+
+			for (i = 0; i < pairs * 2; i++)
+				acc[i] = AE_ZERO64();
+
+			/* accumulate the whole block source by source, two
+			 * samples per load
+			 */
+			for (j = 0; j < num_sources; j++) {
+				in = (ae_int32x2 *)src[j];
+				align_in = AE_LA64_PP(in);
+				for (i = 0; i < pairs; i++) {
+					AE_LA32X2_IP(sample, align_in, in);
+					lo = AE_CVT64F32_H(sample);
+					hi = AE_CVT64F32_L(sample);
+					acc[2 * i] = AE_ADD64(acc[2 * i],
+							      AE_SRAI64(lo, 32));
+					acc[2 * i + 1] = AE_ADD64(acc[2 * i + 1],
+								  AE_SRAI64(hi, 32));
+				}
+			}
+
+			/* Integer sums shifted to Q17.47 round and saturate
+			 * to 32 bits exactly.
+			 */
+			out = (ae_int32x2 *)dest;
+			for (i = 0; i < pairs; i++) {
+				lo = AE_SLAI64(acc[2 * i], 16);
+				hi = AE_SLAI64(acc[2 * i + 1], 16);
+				out_sample = AE_ROUND32X2F48SSYM(lo, hi);
+				AE_SA32X2_IP(out_sample, align_out, out);
+			}
+			AE_SA64POS_FP(align_out, out);
+
+			/* odd sample at the end of the block */
+			if (n & 1) {
+				sum = AE_ZERO64();
+				for (j = 0; j < num_sources; j++) {
+					sample = AE_L32_X((ae_int32 *)src[j],
+							  (n - 1) *
+							  sizeof(ae_int32));
+					lo = AE_CVT64F32_H(sample);
+					sum = AE_ADD64(sum, AE_SRAI64(lo, 32));
+				}
+
+				out_sample = AE_ROUND32F48SSYM(AE_SLAI64(sum, 16));
+				AE_S32_L_X(out_sample, (ae_int32 *)dest,
+					   (n - 1) * sizeof(ae_int32));
+			}
+
+			for (j = 0; j < num_sources; j++)
+				src[j] += n;
+			dest += n;
+			seg -= n;
+		}
+
+		for (j = 0; j < num_sources; j++)
+			src[j] = audio_stream_wrap(sources[j], src[j]);
+		dest = audio_stream_wrap(sink, dest);
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
+
+const struct mix_func_map mix_func_map[] = {
+#if CONFIG_FORMAT_S16LE
+	{ SOF_IPC_FRAME_S16_LE, mix_n_s16 },
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S24_4LE, mix_n_s32 },
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S32_LE, mix_n_s32 },
+#endif /* CONFIG_FORMAT_S32LE */
+};
+
+const size_t mix_count = ARRAY_SIZE(mix_func_map);
+
+#endif /* MIXER_HIFI3 */
@@ -17,6 +17,7 @@
 #include <sof/lib/clk.h>
 #include <sof/lib/mailbox.h>
 #include <sof/lib/mm_heap.h>
+#include <sof/lib/slab.h>
 #include <sof/lib/uuid.h>
 #include <sof/list.h>
 #include <sof/math/numbers.h>
@@ -130,6 +131,8 @@ int pipeline_connect(struct comp_dev *comp, struct comp_buffer *buffer,
 	list_item_prepend(buffer_comp_list(buffer, dir),
 			  comp_buffer_list(comp, dir));
 	buffer_set_comp(buffer, comp, dir);
+	if (comp->pipeline)
+		pipeline_copy_plan_invalidate(comp->pipeline);
 	comp_writeback(comp);
 	irq_local_enable(flags);
 
@@ -228,6 +231,98 @@ static int pipeline_comp_complete(struct comp_dev *current,
 	return 0;
 }
 
+/* data used while planning memory of the pipeline buffers */
+struct pipeline_buffer_plan_data {
+	struct comp_dev *start;
+	struct comp_buffer **buffers;	/* NULL when only counting */
+	uint32_t count;
+	uint32_t caps;
+};
+
+static void pipeline_buffer_plan_add(struct comp_buffer *buffer, void *data)
+{
+	struct pipeline_buffer_plan_data *plan = data;
+	uint32_t i;
+
+	/* buffers to other pipelines and cores keep memory of their own,
+	 * in-place sinks have none
+	 */
+	if (buffer->pipeline_id != dev_comp_pipe_id(plan->start) ||
+	    buffer->inter_core || buffer->arena || buffer->inplace_source)
+		return;
+
+	if (!plan->count)
+		plan->caps = buffer->caps;
+	else if (buffer->caps != plan->caps)
+		return;
+
+	if (plan->buffers) {
+		/* branches joining again reach the buffer twice */
+		for (i = 0; i < plan->count; i++)
+			if (plan->buffers[i] == buffer)
+				return;
+
+		plan->buffers[plan->count] = buffer;
+	}
+
+	plan->count++;
+}
+
+static int pipeline_comp_buffer_plan(struct comp_dev *current,
+				     struct comp_buffer *calling_buf,
+				     struct pipeline_walk_context *ctx, int dir)
+{
+	struct pipeline_buffer_plan_data *plan = ctx->buff_data;
+
+	if (!comp_is_single_pipeline(current, plan->start))
+		return 0;
+
+	return pipeline_for_each_comp(current, ctx, dir);
+}
+
+/* Packs memory of the pipeline buffers into a single arena. Samples stay
+ * in the ring buffers from one period to the next, so lifetime of every
+ * buffer spans the whole period and none of them can take over memory of
+ * another, apart from the in-place sinks already decided. What the arena
+ * saves is the rounding and alignment of every separate heap allocation.
+ * Buffers stay in the arena until freed or resized beyond their place.
+ */
+static int pipeline_buffer_plan(struct pipeline *p, struct comp_dev *source)
+{
+	struct pipeline_buffer_plan_data plan = {
+		.start = source,
+	};
+	struct pipeline_walk_context walk_ctx = {
+		.comp_func = pipeline_comp_buffer_plan,
+		.buff_func = pipeline_buffer_plan_add,
+		.buff_data = &plan,
+	};
+	int ret;
+
+	/* first walk only counts the buffers */
+	walk_ctx.comp_func(source, NULL, &walk_ctx, PPL_DIR_DOWNSTREAM);
+	if (plan.count < 2)
+		return 0;
+
+	/* buffers keep their own memory without the plan */
+	plan.buffers = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			       sizeof(*plan.buffers) * plan.count);
+	if (!plan.buffers)
+		return 0;
+
+	plan.count = 0;
+	walk_ctx.comp_func(source, NULL, &walk_ctx, PPL_DIR_DOWNSTREAM);
+
+	ret = buffer_arena_new(plan.buffers, plan.count);
+	if (ret < 0)
+		pipe_err(p, "pipeline_buffer_plan(): %u buffers lost memory, ret = %d",
+			 plan.count, ret);
+
+	rfree(plan.buffers);
+
+	return ret;
+}
+
 int pipeline_complete(struct pipeline *p, struct comp_dev *source,
 		      struct comp_dev *sink)
 {
@@ -330,6 +425,8 @@ int pipeline_free(struct pipeline *p)
 		rfree(p->pipe_task);
 	}
 
+	rfree(p->copy_steps);
+
 	ipc_msg_free(p->msg);
 
 	pipeline_posn_offset_put(p->posn_offset);
@@ -570,8 +667,7 @@ static struct task *pipeline_task_init(struct pipeline *p, uint32_t type,
 {
 	struct pipeline_task *task = NULL;
 
-	task = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
-		       sizeof(*task));
+	task = slab_zalloc(SLAB_TASK, 0, SOF_MEM_CAPS_RAM, sizeof(*task));
 	if (!task)
 		return NULL;
 
@@ -582,6 +678,12 @@ static struct task *pipeline_task_init(struct pipeline *p, uint32_t type,
 		return NULL;
 	}
 
+	/* the topology gives the worst case instructions per period,
+	 * budget them as cycles
+	 */
+	schedule_task_budget_ll(&task->task, p->ipc_pipe.pipeline_id,
+				p->ipc_pipe.period_mips);
+
 	task->sched_comp = p->sched_comp;
 	task->registrable = p == p->sched_comp->pipeline;
 
@@ -610,6 +712,59 @@ static int pipeline_comp_task_init(struct pipeline *p)
 	return 0;
 }
 
+static int pipeline_copy_plan_build(struct pipeline *p);
+
+/* checks if the list holds exactly one item */
+static inline bool pipeline_list_is_single(struct list_item *list)
+{
+	return !list_is_empty(list) && list_item_is_last(list->next, list);
+}
+
+/* Lets the sink buffer of an in-place component share memory of its source
+ * buffer, which saves the sink memory and a copy of every sample. Both have
+ * to be the same stream, with a single producer and a single consumer each,
+ * within the pipeline.
+ */
+static void pipeline_comp_inplace(struct pipeline *p, struct comp_dev *comp)
+{
+	struct comp_buffer *source;
+	struct comp_buffer *sink;
+
+	if (!comp->inplace ||
+	    !pipeline_list_is_single(&comp->bsource_list) ||
+	    !pipeline_list_is_single(&comp->bsink_list))
+		return;
+
+	source = list_first_item(&comp->bsource_list, struct comp_buffer,
+				 sink_list);
+	sink = list_first_item(&comp->bsink_list, struct comp_buffer,
+			       source_list);
+
+	if (source->inter_core || sink->inter_core ||
+	    source->pipeline_id != p->ipc_pipe.pipeline_id ||
+	    sink->pipeline_id != p->ipc_pipe.pipeline_id)
+		return;
+
+	if (source->stream.size != sink->stream.size ||
+	    source->stream.frame_fmt != sink->stream.frame_fmt ||
+	    source->stream.channels != sink->stream.channels ||
+	    (source->caps & sink->caps) != sink->caps)
+		return;
+
+	/* xruns would break the sink write position following source reads */
+	if (source->stream.overrun_permitted ||
+	    source->stream.underrun_permitted ||
+	    sink->stream.overrun_permitted ||
+	    sink->stream.underrun_permitted)
+		return;
+
+	if (buffer_inplace_attach(sink, source) < 0)
+		return;
+
+	pipe_info(p, "pipeline_comp_inplace(), comp %u writes buffer %u in place of buffer %u",
+		  dev_comp_id(comp), sink->id, source->id);
+}
+
 static int pipeline_comp_prepare(struct comp_dev *current,
 				 struct comp_buffer *calling_buf,
 				 struct pipeline_walk_context *ctx, int dir)
@@ -664,6 +819,7 @@ int pipeline_prepare(struct pipeline *p, struct comp_dev *dev)
 		.buff_func = buffer_reset_pos,
 		.skip_incomplete = true,
 	};
+	uint32_t i;
 	int ret;
 
 	pipe_info(p, "pipe prepare");
@@ -677,6 +833,19 @@ int pipeline_prepare(struct pipeline *p, struct comp_dev *dev)
 		return ret;
 	}
 
+	/* flatten copy walk now, so it's not done in the first period */
+	ret = pipeline_copy_plan_build(p);
+	if (ret < 0)
+		return ret;
+
+	for (i = 0; i < p->copy_steps_count; i++)
+		pipeline_comp_inplace(p, p->copy_steps[i].comp);
+
+	/* memory left after the in-place sinks is packed */
+	ret = pipeline_buffer_plan(p, p->source_comp);
+	if (ret < 0)
+		return ret;
+
 	p->status = COMP_STATE_PREPARE;
 
 	return ret;
@@ -894,6 +1063,8 @@ static int pipeline_comp_reset(struct comp_dev *current,
 			       struct pipeline_walk_context *ctx, int dir)
 {
 	struct pipeline *p = ctx->comp_data;
+	struct comp_buffer *buffer;
+	struct list_item *clist;
 	int stream_direction = dir;
 	int end_type;
 	int is_single_ppl = comp_is_single_pipeline(current, p->source_comp);
@@ -932,6 +1103,14 @@ static int pipeline_comp_reset(struct comp_dev *current,
 	if (err < 0 || err == PPL_STATUS_PATH_STOP)
 		return err;
 
+	/* sink shared in place gets its own memory for the next params */
+	list_for_item(clist, &current->bsink_list) {
+		buffer = container_of(clist, struct comp_buffer, source_list);
+		err = buffer_inplace_detach(buffer);
+		if (err < 0)
+			return err;
+	}
+
 	return pipeline_for_each_comp(current, ctx, dir);
 }
 
@@ -957,60 +1136,79 @@ int pipeline_reset(struct pipeline *p, struct comp_dev *host)
 	return ret;
 }
 
-static int pipeline_comp_copy(struct comp_dev *current,
-			      struct comp_buffer *calling_buf,
-			      struct pipeline_walk_context *ctx, int dir)
-{
-	struct pipeline_data *ppl_data = ctx->comp_data;
-	int is_single_ppl = comp_is_single_pipeline(current, ppl_data->start);
-	int err;
+/* data used while flattening the copy walk */
+struct pipeline_copy_plan_data {
+	struct comp_dev *start;
+	struct pipeline_copy_step *steps;	/* NULL when only counting */
+	uint32_t count;
+	int32_t parent;
+};
 
-	pipe_dbg(current->pipeline, "pipeline_comp_copy(), current->comp.id = %u, dir = %u",
-		 dev_comp_id(current), dir);
+/* parent index not known yet, it's resolved once parent step is added */
+#define PPL_COPY_STEP_PARENT_PENDING	-2
 
-	if (!is_single_ppl) {
-		pipe_dbg(current->pipeline, "pipeline_comp_copy(), current is from another pipeline and can't be scheduled together");
-		return 0;
+static void pipeline_copy_plan_add(struct pipeline_copy_plan_data *data,
+				   struct comp_dev *comp, int32_t parent)
+{
+	if (data->steps) {
+		data->steps[data->count].comp = comp;
+		data->steps[data->count].parent = parent;
 	}
 
-	if (!comp_is_active(current)) {
-		pipe_dbg(current->pipeline, "pipeline_comp_copy(), current is not active");
+	data->count++;
+}
+
+static int pipeline_comp_copy_plan(struct comp_dev *current,
+				   struct comp_buffer *calling_buf,
+				   struct pipeline_walk_context *ctx, int dir)
+{
+	struct pipeline_copy_plan_data *data = ctx->comp_data;
+	int32_t parent = data->parent;
+	uint32_t first = data->count;
+	uint32_t i;
+
+	/* copy never goes through the other pipelines */
+	if (!comp_is_single_pipeline(current, data->start))
 		return 0;
-	}
 
-	/* copy to downstream immediately */
 	if (dir == PPL_DIR_DOWNSTREAM) {
-		err = comp_copy(current);
-		if (err < 0 || err == PPL_STATUS_PATH_STOP)
-			return err;
-	}
+		/* downstream copies current before its sinks */
+		data->parent = data->count;
+		pipeline_copy_plan_add(data, current, parent);
+		pipeline_for_each_comp(current, ctx, dir);
+	} else {
+		/* upstream copies all sources before current */
+		data->parent = PPL_COPY_STEP_PARENT_PENDING;
+		pipeline_for_each_comp(current, ctx, dir);
+
+		if (data->steps) {
+			for (i = first; i < data->count; i++)
+				if (data->steps[i].parent ==
+				    PPL_COPY_STEP_PARENT_PENDING)
+					data->steps[i].parent = data->count;
+		}
 
-	err = pipeline_for_each_comp(current, ctx, dir);
-	if (err < 0 || err == PPL_STATUS_PATH_STOP)
-		return err;
+		pipeline_copy_plan_add(data, current, parent);
+	}
 
-	if (dir == PPL_DIR_UPSTREAM)
-		err = comp_copy(current);
+	data->parent = parent;
 
-	return err;
+	return 0;
 }
 
-/* Copy data across all pipeline components.
- * For capture pipelines it always starts from source component
- * and continues downstream and for playback pipelines it first
- * copies sink component itself and then goes upstream.
+/* Flatten the recursive copy walk into an array of steps, so the copy
+ * executed every period doesn't need to walk the graph.
  */
-static int pipeline_copy(struct pipeline *p)
+static int pipeline_copy_plan_build(struct pipeline *p)
 {
-	struct pipeline_data data;
+	struct pipeline_copy_plan_data data;
 	struct pipeline_walk_context walk_ctx = {
-		.comp_func = pipeline_comp_copy,
+		.comp_func = pipeline_comp_copy_plan,
 		.comp_data = &data,
 		.skip_incomplete = true,
 	};
 	struct comp_dev *start;
 	uint32_t dir;
-	int ret;
 
 	if (p->source_comp->direction == SOF_IPC_STREAM_PLAYBACK) {
 		dir = PPL_DIR_UPSTREAM;
@@ -1020,13 +1218,113 @@ static int pipeline_copy(struct pipeline *p)
 		start = p->source_comp;
 	}
 
+	if (p->copy_plan_valid && p->copy_dir == dir)
+		return 0;
+
+	rfree(p->copy_steps);
+	p->copy_steps = NULL;
+	p->copy_steps_count = 0;
+
 	data.start = start;
-	data.p = p;
+	data.steps = NULL;
+	data.count = 0;
+	data.parent = PPL_COPY_STEP_NO_PARENT;
+
+	/* first walk only counts the steps */
+	walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
+
+	data.steps = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			     sizeof(*data.steps) * data.count);
+	if (!data.steps) {
+		pipe_err(p, "pipeline_copy_plan_build(): Out of Memory, steps = %u",
+			 data.count);
+		return -ENOMEM;
+	}
+
+	data.count = 0;
+	data.parent = PPL_COPY_STEP_NO_PARENT;
+
+	walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
+
+	p->copy_steps = data.steps;
+	p->copy_steps_count = data.count;
+	p->copy_dir = dir;
+	p->copy_plan_valid = true;
+
+	pipe_dbg(p, "pipeline_copy_plan_build(), steps = %u, dir = %u",
+		 data.count, dir);
+
+	return 0;
+}
+
+/* checks if step and the path it has been reached from are active */
+static inline bool pipeline_copy_step_active(struct pipeline *p,
+					     struct pipeline_copy_step *step)
+{
+	if (step->parent != PPL_COPY_STEP_NO_PARENT &&
+	    !p->copy_steps[step->parent].run)
+		return false;
+
+	return comp_is_active(step->comp);
+}
+
+/* Copy data across all pipeline components.
+ * For capture pipelines it always starts from source component
+ * and continues downstream and for playback pipelines it first
+ * copies sink component itself and then goes upstream.
+ *
+ * Both cases are executed from the flattened walk. Downstream steps
+ * follow their parents, so the path can be stopped immediately.
+ * Upstream steps precede their parents, so activity of the whole
+ * path is resolved first, starting from the sink component.
+ */
+static int pipeline_copy(struct pipeline *p)
+{
+	struct pipeline_copy_step *step;
+	uint32_t i;
+	int ret;
 
-	ret = walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
+	ret = pipeline_copy_plan_build(p);
 	if (ret < 0)
-		pipe_err(p, "pipeline_copy(): ret = %d, start->comp.id = %u, dir = %u",
-			 ret, dev_comp_id(start), dir);
+		return ret;
+
+	if (p->copy_dir == PPL_DIR_DOWNSTREAM) {
+		for (i = 0; i < p->copy_steps_count; i++) {
+			step = &p->copy_steps[i];
+			step->run = pipeline_copy_step_active(p, step);
+			if (!step->run)
+				continue;
+
+			ret = comp_copy(step->comp);
+			if (ret < 0)
+				goto err;
+
+			/* don't go further on this path */
+			if (ret == PPL_STATUS_PATH_STOP)
+				step->run = false;
+		}
+	} else {
+		for (i = p->copy_steps_count; i > 0; i--) {
+			step = &p->copy_steps[i - 1];
+			step->run = pipeline_copy_step_active(p, step);
+		}
+
+		for (i = 0; i < p->copy_steps_count; i++) {
+			step = &p->copy_steps[i];
+			if (!step->run)
+				continue;
+
+			ret = comp_copy(step->comp);
+			if (ret < 0)
+				goto err;
+		}
+	}
+
+	return 0;
+
+err:
+	pipe_err(p, "pipeline_copy(): ret = %d, comp->comp.id = %u, dir = %u",
+		 ret, dev_comp_id(step->comp), p->copy_dir);
 
 	return ret;
 }
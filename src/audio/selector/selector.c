@@ -407,10 +407,12 @@ static int selector_copy(struct comp_dev *dev)
 	comp_dbg(dev, "selector_copy(), source_bytes = 0x%x, sink_bytes = 0x%x",
 		 source_bytes, sink_bytes);
 
-	/* copy selected channels from in to out */
-	buffer_invalidate(source, source_bytes);
-	cd->sel_func(dev, &sink->stream, &source->stream, frames);
-	buffer_writeback(sink, sink_bytes);
+	/* copy selected channels from in to out, in place they are there */
+	if (!buffer_is_inplace(sink)) {
+		buffer_invalidate(source, source_bytes);
+		cd->sel_func(dev, &sink->stream, &source->stream, frames);
+		buffer_writeback(sink, sink_bytes);
+	}
 
 	/* calculate new free and available */
 	comp_update_buffer_produce(sink, sink_bytes);
@@ -497,6 +499,10 @@ static int selector_prepare(struct comp_dev *dev)
 		goto err;
 	}
 
+	/* all channels are passed through when the count doesn't change */
+	dev->inplace = sourceb->stream.channels == sinkb->stream.channels &&
+		       (sinkb->stream.channels > 1 || !cd->config.sel_channel);
+
 	return 0;
 
 err:
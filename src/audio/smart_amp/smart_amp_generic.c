@@ -5,6 +5,7 @@
 // Author: Ryan Lee <ryans.lee@maximintegrated.com>
 
 #include <stdint.h>
+#include <sof/audio/audio_stream.h>
 #include <sof/audio/component.h>
 #include <sof/audio/format.h>
 #include <sof/audio/smart_amp/smart_amp.h>
@@ -29,22 +30,19 @@ static void smart_amp_s16_ff_default(const struct comp_dev *dev,
 				     const struct audio_stream *feedback,
 				     uint32_t frames)
 {
-	int16_t *x;
+	struct audio_stream_span span;
+	const int16_t *x;
 	int16_t *y;
 	int32_t tmp;
-	int idx;
-	int ch;
 	int i;
-	int nch = source->channels;
-
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s16(source, idx);
-			y = audio_stream_read_frag_s16(sink, idx);
-			tmp = smart_amp_ff_generic(*x << 16);
-			*y = sat_int16(Q_SHIFT_RND(tmp, 31, 15));
-			idx += nch;
+
+	audio_stream_span_init(&span, source, sink, 0, frames);
+	while (audio_stream_span_next(&span)) {
+		x = span.src;
+		y = span.snk;
+		for (i = 0; i < span.samples; i++) {
+			tmp = smart_amp_ff_generic(x[i] << 16);
+			y[i] = sat_int16(Q_SHIFT_RND(tmp, 31, 15));
 		}
 	}
 }
@@ -57,22 +55,19 @@ static void smart_amp_s24_ff_default(const struct comp_dev *dev,
 				     const struct audio_stream *feedback,
 				     uint32_t frames)
 {
-	int32_t *x;
+	struct audio_stream_span span;
+	const int32_t *x;
 	int32_t *y;
 	int32_t tmp;
-	int idx;
-	int ch;
 	int i;
-	int nch = source->channels;
-
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source, idx);
-			y = audio_stream_read_frag_s32(sink, idx);
-			tmp = smart_amp_ff_generic(*x << 8);
-			*y = sat_int24(Q_SHIFT_RND(tmp, 31, 23));
-			idx += nch;
+
+	audio_stream_span_init(&span, source, sink, 0, frames);
+	while (audio_stream_span_next(&span)) {
+		x = span.src;
+		y = span.snk;
+		for (i = 0; i < span.samples; i++) {
+			tmp = smart_amp_ff_generic(x[i] << 8);
+			y[i] = sat_int24(Q_SHIFT_RND(tmp, 31, 23));
 		}
 	}
 }
@@ -85,21 +80,17 @@ static void smart_amp_s32_ff_default(const struct comp_dev *dev,
 				     const struct audio_stream *feedback,
 				     uint32_t frames)
 {
-	int32_t *x;
+	struct audio_stream_span span;
+	const int32_t *x;
 	int32_t *y;
-	int idx;
-	int ch;
 	int i;
-	int nch = source->channels;
-
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source, idx);
-			y = audio_stream_read_frag_s32(sink, idx);
-			*y = smart_amp_ff_generic(*x);
-			idx += nch;
-		}
+
+	audio_stream_span_init(&span, source, sink, 0, frames);
+	while (audio_stream_span_next(&span)) {
+		x = span.src;
+		y = span.snk;
+		for (i = 0; i < span.samples; i++)
+			y[i] = smart_amp_ff_generic(x[i]);
 	}
 }
 #endif /* CONFIG_FORMAT_S32LE */
@@ -111,19 +102,15 @@ static void smart_amp_s16_fb_default(const struct comp_dev *dev,
 				     const struct audio_stream *feedback,
 				     uint32_t frames)
 {
-	int16_t *x;
-	int idx;
-	int ch;
+	struct audio_stream_span span;
+	const int16_t *x;
 	int i;
-	int nch = source->channels;
-
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s16(feedback, idx);
-			smart_amp_fb_generic(*x << 16);
-			idx += nch;
-		}
+
+	audio_stream_span_init(&span, feedback, NULL, 0, frames);
+	while (audio_stream_span_next(&span)) {
+		x = span.src;
+		for (i = 0; i < span.samples; i++)
+			smart_amp_fb_generic(x[i] << 16);
 	}
 }
 #endif /* CONFIG_FORMAT_S16LE */
@@ -135,19 +122,15 @@ static void smart_amp_s24_fb_default(const struct comp_dev *dev,
 				     const struct audio_stream *feedback,
 				     uint32_t frames)
 {
-	int32_t *x;
-	int idx;
-	int ch;
+	struct audio_stream_span span;
+	const int32_t *x;
 	int i;
-	int nch = source->channels;
-
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(feedback, idx);
-			smart_amp_fb_generic(*x << 8);
-			idx += nch;
-		}
+
+	audio_stream_span_init(&span, feedback, NULL, 0, frames);
+	while (audio_stream_span_next(&span)) {
+		x = span.src;
+		for (i = 0; i < span.samples; i++)
+			smart_amp_fb_generic(x[i] << 8);
 	}
 }
 #endif /* CONFIG_FORMAT_S24LE */
@@ -159,19 +142,15 @@ static void smart_amp_s32_fb_default(const struct comp_dev *dev,
 				     const struct audio_stream *feedback,
 				     uint32_t frames)
 {
-	int32_t *x;
-	int idx;
-	int ch;
+	struct audio_stream_span span;
+	const int32_t *x;
 	int i;
-	int nch = source->channels;
-
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(feedback, idx);
-			smart_amp_ff_generic(*x);
-			idx += nch;
-		}
+
+	audio_stream_span_init(&span, feedback, NULL, 0, frames);
+	while (audio_stream_span_next(&span)) {
+		x = span.src;
+		for (i = 0; i < span.samples; i++)
+			smart_amp_ff_generic(x[i]);
 	}
 }
 #endif /* CONFIG_FORMAT_S32LE */
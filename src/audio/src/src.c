@@ -31,7 +31,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#if SRC_SHORT || CONFIG_COMP_SRC_TINY
+#if CONFIG_COMP_SRC_RUNTIME
+/* Filters are designed by src_coef_design() for the rates in use */
+#elif SRC_SHORT || CONFIG_COMP_SRC_TINY
 #include <sof/audio/coefficients/src/src_tiny_int16_define.h>
 #include <sof/audio/coefficients/src/src_tiny_int16_table.h>
 #else
@@ -94,6 +96,7 @@ static int src_out_delay_length(struct src_stage *s)
 	return 1 + (s->num_of_subfilters - 1) * s->odm;
 }
 
+#if !CONFIG_COMP_SRC_RUNTIME
 /* Returns index of a matching sample rate */
 static int src_find_fs(int fs_list[], int list_length, int fs)
 {
@@ -105,6 +108,7 @@ static int src_find_fs(int fs_list[], int list_length, int fs)
 	}
 	return -EINVAL;
 }
+#endif
 
 /* Calculates buffers to allocate for a SRC mode */
 int src_buffer_lengths(struct src_param *a, int fs_in, int fs_out, int nch,
@@ -122,6 +126,23 @@ int src_buffer_lengths(struct src_param *a, int fs_in, int fs_out, int nch,
 	}
 
 	a->nch = nch;
+#if CONFIG_COMP_SRC_RUNTIME
+	/* Rates are not table indexed, the filters are designed instead */
+	a->idx_in = 0;
+	a->idx_out = 0;
+	r1 = src_coef_design(a, fs_in, fs_out);
+	if (r1 < 0) {
+		comp_cl_err(&comp_src, "src_buffer_lengths(): filter design failed %d, fs_in: %u, fs_out: %u",
+			    r1, fs_in, fs_out);
+		return r1;
+	}
+
+	comp_cl_info(&comp_src, "src_buffer_lengths(), stage1 %d/%d taps %d, stage2 %d/%d taps %d",
+		     a->stage1->num_of_subfilters, a->stage1->blk_in,
+		     a->stage1->filter_length,
+		     a->stage2->num_of_subfilters, a->stage2->blk_in,
+		     a->stage2->filter_length);
+#else
 	a->idx_in = src_find_fs(src_in_fs, NUM_IN_FS, fs_in);
 	a->idx_out = src_find_fs(src_out_fs, NUM_OUT_FS, fs_out);
 
@@ -132,8 +153,12 @@ int src_buffer_lengths(struct src_param *a, int fs_in, int fs_out, int nch,
 		return -EINVAL;
 	}
 
-	stage1 = src_table1[a->idx_out][a->idx_in];
-	stage2 = src_table2[a->idx_out][a->idx_in];
+	a->stage1 = src_table1[a->idx_out][a->idx_in];
+	a->stage2 = src_table2[a->idx_out][a->idx_in];
+#endif
+
+	stage1 = a->stage1;
+	stage2 = a->stage2;
 
 	/* Check from stage1 parameter for a deleted in/out rate combination.*/
 	if (stage1->filter_length < 1) {
@@ -175,12 +200,23 @@ int src_buffer_lengths(struct src_param *a, int fs_in, int fs_out, int nch,
 		a->sbuf_length = 2 * nch * stage1->blk_out * r1;
 	}
 
-	a->src_multich = a->fir_s1 + a->fir_s2 + a->out_s1 + a->out_s2;
+	a->src_multich = SRC_FIR_DELAY_COPIES * (a->fir_s1 + a->fir_s2) +
+		a->out_s1 + a->out_s2;
 	a->total = a->sbuf_length + a->src_multich;
 
 	return 0;
 }
 
+/* Releases the filters selected by src_buffer_lengths() */
+void src_param_free(struct src_param *a)
+{
+#if CONFIG_COMP_SRC_RUNTIME
+	src_coef_free(a);
+#endif
+	a->stage1 = NULL;
+	a->stage2 = NULL;
+}
+
 static void src_state_reset(struct src_state *state)
 {
 	state->fir_delay_size = 0;
@@ -212,8 +248,8 @@ static int init_stages(struct src_stage *stage1, struct src_stage *stage2,
 	src->state1.fir_delay_size = p->fir_s1;
 	src->state1.out_delay_size = p->out_s1;
 	src->state1.fir_delay = delay_lines_start;
-	src->state1.out_delay =
-		src->state1.fir_delay + src->state1.fir_delay_size;
+	src->state1.out_delay = src->state1.fir_delay +
+		SRC_FIR_DELAY_COPIES * src->state1.fir_delay_size;
 	/* Initialize to last ensures that circular wrap cannot happen
 	 * mid-frame. The size is multiple of channels count.
 	 */
@@ -224,8 +260,8 @@ static int init_stages(struct src_stage *stage1, struct src_stage *stage2,
 		src->state2.out_delay_size = p->out_s2;
 		src->state2.fir_delay =
 			src->state1.out_delay + src->state1.out_delay_size;
-		src->state2.out_delay =
-			src->state2.fir_delay + src->state2.fir_delay_size;
+		src->state2.out_delay = src->state2.fir_delay +
+			SRC_FIR_DELAY_COPIES * src->state2.fir_delay_size;
 		/* Initialize to last ensures that circular wrap cannot happen
 		 * mid-frame. The size is multiple of channels count.
 		 */
@@ -265,29 +301,25 @@ void src_polyphase_reset(struct polyphase_src *src)
 int src_polyphase_init(struct polyphase_src *src, struct src_param *p,
 		       int32_t *delay_lines_start)
 {
-	struct src_stage *stage1;
-	struct src_stage *stage2;
 	int n_stages;
 	int ret;
 
-	if (p->idx_in < 0 || p->idx_out < 0)
+	if (!p->stage1 || !p->stage2)
 		return -EINVAL;
 
 	/* Get setup for 2 stage conversion */
-	stage1 = src_table1[p->idx_out][p->idx_in];
-	stage2 = src_table2[p->idx_out][p->idx_in];
-	ret = init_stages(stage1, stage2, src, p, 2, delay_lines_start);
+	ret = init_stages(p->stage1, p->stage2, src, p, 2, delay_lines_start);
 	if (ret < 0)
 		return -EINVAL;
 
 	/* Get number of stages used for optimize opportunity. 2nd
 	 * stage length is one if conversion needs only one stage.
-	 * If input and output rate is the same return 0 to
-	 * use a simple copy function instead of 1 stage FIR with one
-	 * tap.
+	 * If input and output rate is the same the first stage is
+	 * also one tap, return 0 to use a simple copy function instead
+	 * of 1 stage FIR with one tap.
 	 */
 	n_stages = (src->stage2->filter_length == 1) ? 1 : 2;
-	if (p->idx_in == p->idx_out)
+	if (src->stage1->filter_length == 1)
 		n_stages = 0;
 
 	/* If filter length for first stage is zero this is a deleted
@@ -504,6 +536,7 @@ static void src_free(struct comp_dev *dev)
 	if (cd->delay_lines)
 		rfree(cd->delay_lines);
 
+	src_param_free(&cd->param);
 	rfree(cd);
 	rfree(dev);
 }
@@ -0,0 +1,497 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+/*
+ * Runtime design of the SRC polyphase filters. The conversion is factored
+ * into two stages and the filter of every stage is a Kaiser windowed sinc
+ * with the specification the coefficient tables are exported with by
+ * tools/tune/src: 20 kHz passband at 44.1 kHz, stopband from the Nyquist
+ * frequency of the lower rate, 70 dB attenuation and -1 dB gain. Only the
+ * filters of the rates in use are kept in memory.
+ */
+
+#include <sof/audio/src/src_config.h>
+
+#if CONFIG_COMP_SRC_RUNTIME
+
+#include <sof/audio/src/src.h>
+#include <sof/common.h>
+#include <sof/lib/alloc.h>
+#include <sof/lib/memory.h>
+#include <sof/math/numbers.h>
+#include <sof/math/trig.h>
+#include <sof/string.h>
+#include <ipc/topology.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Kaiser beta for 70 dB stopband attenuation, 0.1102 * (70 - 8.7) */
+#define SRC_COEF_BETA_Q28	1813351298
+
+/* Filter order times transition width, (70 - 7.95) / (2.285 * 2pi) with
+ * 10 % added as the estimate is short for the short filters.
+ */
+#define SRC_COEF_ORDER_Q16	311564
+
+/* Gain of -1 dB for a single stage and -0.5 dB per stage for two stages */
+#define SRC_COEF_GAIN_1S_Q31	1913946816
+#define SRC_COEF_GAIN_2S_Q31	2027355295
+
+/* Passband is 20 kHz at 44.1 kHz, 24 kHz for rates above 80 kHz */
+#define SRC_COEF_PB_NUM		200
+#define SRC_COEF_PB_DEN		441
+#define SRC_COEF_PB_HIGH_FS	80000
+#define SRC_COEF_PB_HIGH	24000
+
+/* Largest coefficient, 32767/32768 in Q1.31 */
+#define SRC_COEF_MAX_Q31	(INT32_MAX - 65535)
+
+/* Precision of the gain normalization, the shift is below it */
+#define SRC_COEF_SCALE_Q	20
+#define SRC_COEF_SHIFT_MIN	-16
+#define SRC_COEF_SHIFT_MAX	15
+
+#if SRC_SHORT
+static const int16_t src_coef_one = 16384;
+#else
+static const int32_t src_coef_one = 1073741824;
+#endif
+
+/* Pass through stage, the coefficient is 0.5 with shift of -1 */
+static const struct src_stage src_coef_copy = {
+	0, 0, 1, 1, 1, 1, 1, 0, -1, &src_coef_one
+};
+
+struct src_conv {
+	int fs_in;
+	int fs_out;
+	struct src_stage stage1;
+	struct src_stage stage2;
+	void *coefs;			/* coefficients of both stages */
+};
+
+/* Factor closest to the square root of c, port of factor2() */
+static void src_coef_factor2(int c, int *a, int *b)
+{
+	int x = 1;
+	int a1 = 0;
+	int a2 = 0;
+	int t;
+
+	while ((x + 1) * (x + 1) <= c)
+		x++;
+
+	/* round() of the square root */
+	if (c - x * x > (x + 1) * (x + 1) - c)
+		x++;
+
+	for (t = x; t <= 2 * x; t++) {
+		if (!(c % t)) {
+			a1 = t;
+			break;
+		}
+	}
+
+	for (t = x; t >= x / 2 && t > 0; t--) {
+		if (!(c % t)) {
+			a2 = t;
+			break;
+		}
+	}
+
+	if (!a2 || (a1 && a1 - x < x - a2))
+		*a = a1;
+	else
+		*a = a2;
+
+	*b = c / *a;
+}
+
+/* Two stage factoring of fs_out / fs_in, port of src_factor2_lm() */
+static int src_coef_factor(int fs1, int fs2, int *l1, int *m1, int *l2,
+			   int *m2)
+{
+	int k = gcd(fs1, fs2);
+	int l = fs2 / k;
+	int m = fs1 / k;
+	int l0[2];
+	int m0[2];
+	int64_t fs3;
+	int64_t delta = INT64_MAX;
+	int64_t fs_ref = fs1 > fs2 ? fs2 : fs1;
+	int i;
+	int j;
+
+	src_coef_factor2(l, &l0[0], &l0[1]);
+	src_coef_factor2(m, &m0[0], &m0[1]);
+
+	/* 44.1 kHz family and 24 to 32 kHz conversions */
+	if (l == 147 && (m == 640 || m == 320 || m == 160)) {
+		l0[0] = 7;
+		m0[0] = 8;
+	} else if ((l == 160 || l == 320) && m == 147) {
+		l0[0] = 8;
+		m0[0] = 7;
+	} else if ((l == 4 && m == 3) || (l == 3 && m == 4)) {
+		l0[0] = l;
+		m0[0] = m;
+	}
+
+	l0[1] = l / l0[0];
+	m0[1] = m / m0[0];
+
+	/* Intermediate rate nearest to the lower of the rates, not below */
+	*l1 = 0;
+	for (i = 0; i < 2; i++) {
+		for (j = 0; j < 2; j++) {
+			fs3 = (int64_t)fs1 * l0[i] / m0[j];
+			if (fs3 < fs_ref || fs3 - fs_ref >= delta)
+				continue;
+
+			delta = fs3 - fs_ref;
+			*l1 = l0[i];
+			*m1 = m0[j];
+			*l2 = l0[1 - i];
+			*m2 = m0[1 - j];
+		}
+	}
+
+	if (!*l1)
+		return -EINVAL;
+
+	if (*l1 == 1 && *m1 == 1) {
+		*l1 = *l2;
+		*m1 = *m2;
+		*l2 = 1;
+		*m2 = 1;
+	}
+
+	return 0;
+}
+
+/* Sub-filter input and output delays, port of src_find_l0m0() */
+static int src_coef_find_l0m0(int l, int m, int *l0, int *m0)
+{
+	int lt;
+
+	if (m == 1) {
+		*l0 = 0;
+		*m0 = 1;
+		return 0;
+	}
+
+	if (l == 1) {
+		*l0 = 1;
+		*m0 = 0;
+		return 0;
+	}
+
+	/* l0 * l + 1 = m0 * m has a solution below m for coprime l and m,
+	 * the smallest l0 also gives the smallest l0 + m0
+	 */
+	for (lt = 1; lt <= m; lt++) {
+		if (!((1 + lt * l) % m)) {
+			*l0 = lt;
+			*m0 = (1 + lt * l) / m;
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+/* Integer square root */
+static uint32_t src_coef_sqrt(uint64_t x)
+{
+	uint64_t bit = 1ULL << 62;
+	uint64_t y = 0;
+
+	while (bit > x)
+		bit >>= 2;
+
+	while (bit) {
+		if (x >= y + bit) {
+			x -= y + bit;
+			y = (y >> 1) + bit;
+		} else {
+			y >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (uint32_t)y;
+}
+
+/* Modified Bessel function of the first kind I0(x), x and result Q28 */
+static int64_t src_coef_i0(int64_t x)
+{
+	/* (x / 2)^2 as Q17 */
+	int64_t y = (x * x) >> 41;
+	int64_t term = 1LL << 28;
+	int64_t sum = term;
+	int k;
+
+	for (k = 1; term && k < 64; k++) {
+		term = ((term * y) >> 17) / (k * k);
+		sum += term;
+	}
+
+	return sum;
+}
+
+/* Windowed sinc prototype as Q2.30, returns the sum of the coefficients */
+static int64_t src_coef_prototype(int32_t *h, int taps, uint32_t fc)
+{
+	int64_t i0_beta = src_coef_i0(SRC_COEF_BETA_Q28) >> 8;
+	int64_t k2 = (int64_t)(taps - 1) * (taps - 1);
+	int64_t sum = 0;
+	int64_t sinc;
+	int64_t w;
+	uint32_t phase;
+	int32_t x;
+	int t2;
+	int n;
+
+	for (n = 0; n < (taps + 1) / 2; n++) {
+		/* distance from the center in half samples */
+		t2 = taps - 1 - 2 * n;
+
+		/* sin(pi * 2fc * t) / (pi * t) */
+		if (t2) {
+			phase = (uint32_t)(((uint64_t)fc * t2) >> 1);
+			x = ((uint64_t)phase * PI_MUL2_Q4_28) >> 32;
+			sinc = ((int64_t)sin_fixed(x) << 28) /
+				((int64_t)PI_Q4_28 * t2);
+		} else {
+			sinc = fc >> 1;
+		}
+
+		/* I0(beta * sqrt(1 - (2t / (taps - 1))^2)) / I0(beta) */
+		x = ((int64_t)SRC_COEF_BETA_Q28 *
+		     src_coef_sqrt((((uint64_t)(k2 - (int64_t)t2 * t2) << 38) /
+				    k2) << 22)) >> 30;
+		w = (src_coef_i0(x) << 22) / i0_beta;
+
+		h[n] = (sinc * w) >> 30;
+		h[taps - 1 - n] = h[n];
+		sum += n == taps - 1 - n ? h[n] : 2 * (int64_t)h[n];
+	}
+
+	return sum;
+}
+
+/* Q1.31 coefficient (h * scale) >> SRC_COEF_SCALE_Q times 2^shift */
+static int64_t src_coef_scale(int32_t h, int64_t scale, int shift)
+{
+	int s = SRC_COEF_SCALE_Q - shift;
+
+	return ((int64_t)h * scale + (1LL << (s - 1))) >> s;
+}
+
+/* Designs the filter of a stage converting from fs1 to fs2, with NULL
+ * coefs only the stage parameters are computed.
+ */
+static int src_coef_stage(struct src_stage *stage, void *coefs, int32_t *h,
+			  int fs1, int fs2, int fs_pb, int32_t gain)
+{
+	int k = gcd(fs1, fs2);
+	int l = fs2 / k;
+	int m = fs1 / k;
+	int64_t fs3 = (int64_t)l * fs1;
+	int64_t order;
+	int64_t scale;
+	int64_t sum;
+	uint32_t f_pb;
+	uint32_t f_sb;
+	int32_t h_max = 0;
+	int32_t c;
+	int shift = 0;
+	int taps;
+	int sub;
+	int idm;
+	int odm;
+	int ret;
+	int i;
+
+	ret = src_coef_find_l0m0(l, m, &idm, &odm);
+	if (ret < 0)
+		return ret;
+
+	/* band edges as fractions of the interpolated rate, Q0.32 */
+	if (fs_pb > SRC_COEF_PB_HIGH_FS)
+		f_pb = ((uint64_t)SRC_COEF_PB_HIGH << 32) / fs3;
+	else
+		f_pb = ((uint64_t)fs_pb * SRC_COEF_PB_NUM << 32) /
+			(SRC_COEF_PB_DEN * fs3);
+
+	f_sb = ((uint64_t)MIN(fs1, fs2) << 31) / fs3;
+	if (f_pb >= f_sb)
+		return -EINVAL;
+
+	order = ((int64_t)SRC_COEF_ORDER_Q16 << 16) / (f_sb - f_pb);
+	if (order >= SRC_COEF_MAX_TAPS)
+		return -EINVAL;
+
+	/* sub-filter length is a multiple of four for the optimized cores */
+	taps = ceil_divide(order + 1, 4 * l) * 4 * l;
+	sub = taps / l;
+	if (taps > SRC_COEF_MAX_TAPS ||
+	    sub + (l - 1) * idm + m > MAX_FIR_DELAY_SIZE ||
+	    1 + (l - 1) * odm > MAX_OUT_DELAY_SIZE)
+		return -EINVAL;
+
+	if (coefs) {
+		sum = src_coef_prototype(h, taps, (f_pb >> 1) + (f_sb >> 1));
+
+		for (i = 0; i < taps; i++)
+			h_max = MAX(h_max, ABS(h[i]));
+
+		/* unity gain of every sub-filter times the stage gain */
+		scale = ((int64_t)gain * l << SRC_COEF_SCALE_Q) / sum;
+
+		/* largest shift with the largest coefficient below one */
+		while (shift > SRC_COEF_SHIFT_MIN &&
+		       src_coef_scale(h_max, scale, shift) > SRC_COEF_MAX_Q31)
+			shift--;
+
+		while (shift < SRC_COEF_SHIFT_MAX &&
+		       src_coef_scale(h_max, scale, shift + 1) <=
+		       SRC_COEF_MAX_Q31)
+			shift++;
+
+		/* polyphase order, sub-filter n has prototype taps n + i * l */
+		for (i = 0; i < taps; i++) {
+			c = src_coef_scale(h[i], scale, shift);
+#if SRC_SHORT
+			((int16_t *)coefs)[(i % l) * sub + i / l] =
+				(c + (1 << 15)) >> 16;
+#else
+			((int32_t *)coefs)[(i % l) * sub + i / l] = c;
+#endif
+		}
+	}
+
+	/* the stage fields are const, the whole stage is written at once */
+	memcpy_s(stage, sizeof(*stage), &(struct src_stage){
+		idm, odm, l, sub, taps, m, l, 0, shift, coefs
+	}, sizeof(*stage));
+
+	return 0;
+}
+
+/* Designs the stages of the conversion from fs1 to fs2 */
+static int src_coef_stages(struct src_conv *conv, int32_t *h, int fs1,
+			   int fs3, int fs2, int32_t gain)
+{
+	int fs_pb = MIN(fs1, fs2);
+	int ret;
+
+	ret = src_coef_stage(&conv->stage1, conv->coefs, h, fs1, fs3, fs_pb,
+			     gain);
+	if (ret < 0 || fs3 == fs2)
+		return ret;
+
+	return src_coef_stage(&conv->stage2, conv->coefs ?
+			      (char *)conv->coefs +
+			      conv->stage1.filter_length *
+			      sizeof(src_coef_one) : NULL,
+			      h, fs3, fs2, fs_pb, gain);
+}
+
+int src_coef_design(struct src_param *a, int fs_in, int fs_out)
+{
+	struct src_conv *conv = a->conv;
+	int32_t *h = NULL;
+	int32_t gain;
+	int fs3;
+	int l1;
+	int m1;
+	int l2;
+	int m2;
+	int ret;
+
+	/* keep the filters of the previous stream with the same rates */
+	if (conv && conv->fs_in == fs_in && conv->fs_out == fs_out)
+		goto out;
+
+	src_coef_free(a);
+
+	if (fs_in <= 0 || fs_out <= 0)
+		return -EINVAL;
+
+	conv = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+		       sizeof(*conv));
+	if (!conv)
+		return -ENOMEM;
+
+	conv->fs_in = fs_in;
+	conv->fs_out = fs_out;
+	memcpy_s(&conv->stage1, sizeof(conv->stage1), &src_coef_copy,
+		 sizeof(src_coef_copy));
+	memcpy_s(&conv->stage2, sizeof(conv->stage2), &src_coef_copy,
+		 sizeof(src_coef_copy));
+
+	if (fs_in == fs_out)
+		goto done;
+
+	ret = src_coef_factor(fs_in, fs_out, &l1, &m1, &l2, &m2);
+	if (ret < 0)
+		goto err;
+
+	fs3 = (int64_t)fs_in * l1 / m1;
+	gain = l2 == 1 && m2 == 1 ? SRC_COEF_GAIN_1S_Q31 :
+		SRC_COEF_GAIN_2S_Q31;
+
+	/* size the stages first to allocate only the designed filters */
+	ret = src_coef_stages(conv, NULL, fs_in, fs3, fs_out, gain);
+	if (ret < 0)
+		goto err;
+
+	conv->coefs = rballoc(0, SOF_MEM_CAPS_RAM,
+			      (conv->stage1.filter_length +
+			       (fs3 == fs_out ? 0 :
+				conv->stage2.filter_length)) *
+			      sizeof(src_coef_one));
+	h = rballoc(0, SOF_MEM_CAPS_RAM,
+		    MAX(conv->stage1.filter_length,
+			conv->stage2.filter_length) * sizeof(*h));
+	if (!conv->coefs || !h) {
+		ret = -ENOMEM;
+		goto err;
+	}
+
+	ret = src_coef_stages(conv, h, fs_in, fs3, fs_out, gain);
+	if (ret < 0)
+		goto err;
+
+	rfree(h);
+
+done:
+	a->conv = conv;
+out:
+	a->stage1 = &conv->stage1;
+	a->stage2 = &conv->stage2;
+
+	return 0;
+
+err:
+	rfree(h);
+	rfree(conv->coefs);
+	rfree(conv);
+
+	return ret;
+}
+
+void src_coef_free(struct src_param *a)
+{
+	if (!a->conv)
+		return;
+
+	rfree(a->conv->coefs);
+	rfree(a->conv);
+	a->conv = NULL;
+}
+
+#endif /* CONFIG_COMP_SRC_RUNTIME */
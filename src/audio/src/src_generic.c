@@ -14,210 +14,128 @@
 
 #include <sof/audio/format.h>
 #include <sof/audio/src/src.h>
+#include <sof/platform.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #if SRC_SHORT /* 16 bit coefficients version */
 
-static inline void fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
-				      int32_t *fir_start, int32_t *fir_end,
-				      const int fir_delay_length,
-				      const int taps_x_nch,
+static inline void fir_filter_generic(const int32_t *rp, const void *cp,
+				      int32_t *wp, const int taps,
 				      const int shift, const int nch)
 {
+	int64_t y[PLATFORM_MAX_CHANNELS];
 	int64_t y0;
 	int64_t y1;
-	int32_t *data;
-	const int16_t *coef;
+	const int32_t *data;
+	const int16_t *coef = cp;
+	int16_t c;
 	int i;
 	int j;
-	int n1;
-	int n2;
-	int frames;
 	const int qshift = 15 + shift; /* Q2.46 -> Q2.31 */
 	const int32_t rnd = 1 << (qshift - 1); /* Half LSB */
-	int32_t *d = rp;
-	int32_t *wp = wp0;
+
+	/* The taps of all channels are in one linear block that starts
+	 * from the last channel of the newest frame.
+	 */
+	data = rp - nch + 1;
 
 	/* Check for 2ch FIR case */
 	if (nch == 2) {
-		/* Decrement data pointer to next channel start. Note that
-		 * initialization code ensures that circular wrap does not
-		 * happen mid-frame.
-		 */
-		data = d - 1;
-
 		/* Initialize to half LSB for rounding, prepare for FIR core */
 		y0 = rnd;
 		y1 = rnd;
-		coef = (const int16_t *)cp;
-		frames = fir_end - data; /* Frames until wrap */
-		n1 = ((taps_x_nch < frames) ? taps_x_nch : frames) >> 1;
-		n2 = (taps_x_nch >> 1) - n1;
 
 		/* The FIR is calculated as Q1.15 x Q1.31 -> Q2.46. The
 		 * output shift includes the shift by 15 for Qx.46 to
 		 * Qx.31.
 		 */
-		for (i = 0; i < n1; i++) {
-			y0 += (int64_t)(*coef) * (*data);
-			data++;
-			y1 += (int64_t)(*coef) * (*data);
-			data++;
-			coef++;
-		}
-		if (data == fir_end)
-			data = fir_start;
-
-		for (i = 0; i < n2; i++) {
-			y0 += (int64_t)(*coef) * (*data);
-			data++;
-			y1 += (int64_t)(*coef) * (*data);
-			data++;
-			coef++;
+		for (i = 0; i < taps; i++) {
+			y0 += (int64_t)coef[i] * data[2 * i];
+			y1 += (int64_t)coef[i] * data[2 * i + 1];
 		}
 
-		*wp = sat_int32(y1 >> qshift);
-		*(wp + 1) = sat_int32(y0 >> qshift);
+		wp[0] = sat_int32(y1 >> qshift);
+		wp[1] = sat_int32(y0 >> qshift);
 		return;
 	}
 
-	for (j = 0; j < nch; j++) {
-		/* Decrement data pointer to next channel start. Note that
-		 * initialization code ensures that circular wrap does not
-		 * happen mid-frame.
-		 */
-		data = d--;
+	/* All channels are accumulated in parallel with one coefficient
+	 * load per tap.
+	 */
+	for (j = 0; j < nch; j++)
+		y[j] = rnd;
 
-		/* Initialize to half LSB for rounding, prepare for FIR core */
-		y0 = rnd;
-		coef = (const int16_t *)cp;
-		frames = fir_end - data + nch - j - 1; /* Frames until wrap */
-		n1 = (taps_x_nch < frames) ? taps_x_nch : frames;
-		n2 = taps_x_nch - n1;
+	for (i = 0; i < taps; i++) {
+		c = coef[i];
+		for (j = 0; j < nch; j++)
+			y[j] += (int64_t)c * data[j];
 
-		/* The FIR is calculated as Q1.15 x Q1.31 -> Q2.46. The
-		 * output shift includes the shift by 15 for Qx.46 to
-		 * Qx.31.
-		 */
-		for (i = 0; i < n1; i += nch) {
-			y0 += (int64_t)(*coef) * (*data);
-			coef++;
-			data += nch;
-		}
-		if (data >= fir_end)
-			data -= fir_delay_length;
-
-		for (i = 0; i < n2; i += nch) {
-			y0 += (int64_t)(*coef) * (*data);
-			coef++;
-			data += nch;
-		}
-
-		*wp = sat_int32(y0 >> qshift);
-		wp++;
+		data += nch;
 	}
+
+	for (j = 0; j < nch; j++)
+		wp[j] = sat_int32(y[nch - 1 - j] >> qshift);
 }
 
 #else /* 32bit coefficients version */
 
-static inline void fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
-				      int32_t *fir_start, int32_t *fir_end,
-				      int fir_delay_length,
-				      const int taps_x_nch, const int shift,
-				      const int nch)
+static inline void fir_filter_generic(const int32_t *rp, const void *cp,
+				      int32_t *wp, const int taps,
+				      const int shift, const int nch)
 {
+	int64_t y[PLATFORM_MAX_CHANNELS];
 	int64_t y0;
 	int64_t y1;
-	int32_t *data;
-	const int32_t *coef;
+	const int32_t *data;
+	const int32_t *coef = cp;
+	int32_t c;
 	int i;
 	int j;
-	int frames;
-	int n1;
-	int n2;
-
 	const int qshift = 23 + shift; /* Qx.54 -> Qx.31 */
 	const int32_t rnd = 1 << (qshift - 1); /* Half LSB */
-	int32_t *d = rp;
-	int32_t *wp = wp0;
+
+	/* The taps of all channels are in one linear block that starts
+	 * from the last channel of the newest frame.
+	 */
+	data = rp - nch + 1;
 
 	/* Check for 2ch FIR case */
 	if (nch == 2) {
-		/* Decrement data pointer to next channel start. Note that
-		 * initialization code ensures that circular wrap does not
-		 * happen mid-frame.
-		 */
-		data = d - 1;
-
 		/* Initialize to half LSB for rounding, prepare for FIR core */
 		y0 = rnd;
 		y1 = rnd;
-		coef = (const int32_t *)cp;
-		frames = fir_end - data; /* Frames until wrap */
-		n1 = ((taps_x_nch < frames) ? taps_x_nch : frames) >> 1;
-		n2 = (taps_x_nch >> 1) - n1;
 
 		/* The FIR is calculated as Q1.23 x Q1.31 -> Q2.54. The
 		 * output shift includes the shift by 23 for Qx.54 to
 		 * Qx.31.
 		 */
-		for (i = 0; i < n1; i++) {
-			y0 += (int64_t)(*coef >> 8) * (*data);
-			data++;
-			y1 += (int64_t)(*coef >> 8) * (*data);
-			data++;
-			coef++;
-		}
-		if (data == fir_end)
-			data = fir_start;
-
-		for (i = 0; i < n2; i++) {
-			y0 += (int64_t)(*coef >> 8) * (*data);
-			data++;
-			y1 += (int64_t)(*coef >> 8) * (*data);
-			data++;
-			coef++;
+		for (i = 0; i < taps; i++) {
+			y0 += (int64_t)(coef[i] >> 8) * data[2 * i];
+			y1 += (int64_t)(coef[i] >> 8) * data[2 * i + 1];
 		}
-		*wp = sat_int32(y1 >> qshift);
-		*(wp + 1) = sat_int32(y0 >> qshift);
+
+		wp[0] = sat_int32(y1 >> qshift);
+		wp[1] = sat_int32(y0 >> qshift);
 		return;
 	}
 
-	for (j = 0; j < nch; j++) {
-		/* Decrement data pointer to next channel start. Note that
-		 * initialization code ensures that circular wrap does not
-		 * happen mid-frame.
-		 */
-		data = d--;
+	/* All channels are accumulated in parallel with one coefficient
+	 * load per tap.
+	 */
+	for (j = 0; j < nch; j++)
+		y[j] = rnd;
 
-		/* Initialize to half LSB for rounding, prepare for FIR core */
-		y0 = rnd;
-		coef = (const int32_t *)cp;
-		frames = fir_end - data + nch - j - 1; /* Frames until wrap */
-		n1 = (taps_x_nch < frames) ? taps_x_nch : frames;
-		n2 = taps_x_nch - n1;
+	for (i = 0; i < taps; i++) {
+		c = coef[i] >> 8;
+		for (j = 0; j < nch; j++)
+			y[j] += (int64_t)c * data[j];
 
-		/* The FIR is calculated as Q1.23 x Q1.31 -> Q2.54. The
-		 * output shift includes the shift by 23 for Qx.54 to
-		 * Qx.31.
-		 */
-		for (i = 0; i < n1; i += nch) {
-			y0 += (int64_t)(*coef >> 8) * (*data);
-			coef++;
-			data += nch;
-		}
-		if (data >= fir_end)
-			data -= fir_delay_length;
-
-		for (i = 0; i < n2; i += nch) {
-			y0 += (int64_t)(*coef >> 8) * (*data);
-			coef++;
-			data += nch;
-		}
-		*wp = sat_int32(y0 >> qshift);
-		wp++;
+		data += nch;
 	}
+
+	for (j = 0; j < nch; j++)
+		wp[j] = sat_int32(y[nch - 1 - j] >> qshift);
 }
 
 #endif /* 32bit coefficients version */
@@ -250,7 +168,6 @@ void src_polyphase_stage_cir(struct src_stage_prm *s)
 		+ (cfg->num_of_subfilters - 1) * cfg->idm) - nch;
 	const int nch_x_idm = nch * cfg->idm;
 	const size_t fir_size = fir->fir_delay_size * sizeof(int32_t);
-	const int taps_x_nch = cfg->subfilter_length * nch;
 	int32_t *x_rptr = (int32_t *)s->x_rptr;
 	int32_t *y_wptr = (int32_t *)s->y_wptr;
 	int32_t *x_end_addr = (int32_t *)s->x_end_addr;
@@ -274,7 +191,11 @@ void src_polyphase_stage_cir(struct src_stage_prm *s)
 			n_min = (m < n_min) ? m : n_min;
 			m -= n_min;
 			for (i = 0; i < n_min; i++) {
+				/* the copy after the delay line is kept
+				 * identical for linear reads
+				 */
 				*fir->fir_wp = *x_rptr << s->shift;
+				fir->fir_wp[fir_length] = *fir->fir_wp;
 				fir->fir_wp--;
 				x_rptr++;
 			}
@@ -289,9 +210,8 @@ void src_polyphase_stage_cir(struct src_stage_prm *s)
 		src_inc_wrap(&rp, fir_end, fir_size);
 		wp = fir->out_rp;
 		for (i = 0; i < cfg->num_of_subfilters; i++) {
-			fir_filter_generic(rp, cp, wp,
-					   fir_delay, fir_end, fir_length,
-					   taps_x_nch, cfg->shift, nch);
+			fir_filter_generic(rp, cp, wp, cfg->subfilter_length,
+					   cfg->shift, nch);
 			wp += nch_x_odm;
 			cp = (char *)cp + subfilter_size;
 			src_inc_wrap(&wp, out_delay_end, out_size);
@@ -351,7 +271,6 @@ void src_polyphase_stage_cir_s16(struct src_stage_prm *s)
 		+ (cfg->num_of_subfilters - 1) * cfg->idm) - nch;
 	const int nch_x_idm = nch * cfg->idm;
 	const size_t fir_size = fir->fir_delay_size * sizeof(int32_t);
-	const int taps_x_nch = cfg->subfilter_length * nch;
 	int16_t *x_rptr = (int16_t *)s->x_rptr;
 	int16_t *y_wptr = (int16_t *)s->y_wptr;
 	int16_t *x_end_addr = (int16_t *)s->x_end_addr;
@@ -375,7 +294,11 @@ void src_polyphase_stage_cir_s16(struct src_stage_prm *s)
 			n_min = (m < n_min) ? m : n_min;
 			m -= n_min;
 			for (i = 0; i < n_min; i++) {
+				/* the copy after the delay line is kept
+				 * identical for linear reads
+				 */
 				*fir->fir_wp = Q_SHIFT_LEFT(*x_rptr, 15, 31);
+				fir->fir_wp[fir_length] = *fir->fir_wp;
 				fir->fir_wp--;
 				x_rptr++;
 			}
@@ -390,9 +313,8 @@ void src_polyphase_stage_cir_s16(struct src_stage_prm *s)
 		src_inc_wrap(&rp, fir_end, fir_size);
 		wp = fir->out_rp;
 		for (i = 0; i < cfg->num_of_subfilters; i++) {
-			fir_filter_generic(rp, cp, wp,
-					   fir_delay, fir_end, fir_length,
-					   taps_x_nch, cfg->shift, nch);
+			fir_filter_generic(rp, cp, wp, cfg->subfilter_length,
+					   cfg->shift, nch);
 			wp += nch_x_odm;
 			cp = (char *)cp + subfilter_size;
 			src_inc_wrap(&wp, out_delay_end, out_size);
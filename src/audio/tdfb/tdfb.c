@@ -481,7 +481,7 @@ static int tdfb_prepare(struct comp_dev *dev)
 
 		/* Clear in/out buffers */
 		memset(cd->in, 0, TDFB_IN_BUF_LENGTH * sizeof(int32_t));
-		memset(cd->out, 0, TDFB_IN_BUF_LENGTH * sizeof(int32_t));
+		memset(cd->out, 0, TDFB_OUT_BUF_LENGTH * sizeof(int32_t));
 
 		ret = set_func(dev);
 		return ret;
@@ -13,63 +13,75 @@
 #if TDFB_GENERIC
 
 #include <sof/math/fir_generic.h>
+#include <sof/math/numbers.h>
+
+/* Runs every filter over a block of planar input in cd->in and mixes the
+ * outputs to the interleaved frames in cd->out. The output is stored as
+ * Q5.27 to fit max. 16 filters sum to a channel.
+ */
+static void tdfb_fir_block(struct tdfb_comp_data *cd, int out_nch, int frames)
+{
+	struct sof_tdfb_config *cfg = cd->config;
+	int32_t y[TDFB_BLOCK_FRAMES];
+	int32_t *out;
+	int om;
+	int i;
+	int j;
+	int k;
+
+	memset(cd->out, 0, frames * out_nch * sizeof(int32_t));
+
+	for (i = 0; i < cfg->num_filters; i++) {
+		fir_32x16_block(&cd->fir[i],
+				&cd->in[cd->input_channel_select[i] *
+					TDFB_BLOCK_FRAMES],
+				y, frames);
+
+		om = cd->output_channel_mix[i];
+		for (k = 0; k < out_nch; k++) {
+			if (om & 1) {
+				out = &cd->out[k];
+				for (j = 0; j < frames; j++) {
+					*out += y[j] >> 4;
+					out += out_nch;
+				}
+			}
+			om = om >> 1;
+		}
+	}
+}
 
 #if CONFIG_FORMAT_S16LE
 void tdfb_fir_s16(struct tdfb_comp_data *cd,
 		  const struct audio_stream *source,
 		  struct audio_stream *sink, int frames)
 {
-	struct sof_tdfb_config *cfg = cd->config;
-	struct fir_state_32x16 *filter;
-	int32_t y0;
-	int32_t y1;
 	int16_t *x;
 	int16_t *y;
-	int is2;
-	int is;
-	int om;
+	int done;
+	int ch;
+	int n;
 	int i;
-	int j;
-	int k;
 	int in_nch = source->channels;
 	int out_nch = sink->channels;
 	int idx_in = 0;
 	int idx_out = 0;
 
-	for (j = 0; j < (frames >> 1); j++) {
-		/* Clear output mix*/
-		memset(cd->out, 0,  2 * out_nch * sizeof(int32_t));
-
-		/* Read two frames from all input channels */
-		for (i = 0; i < 2 * in_nch; i++) {
-			x = audio_stream_read_frag_s16(source, idx_in++);
-			cd->in[i] = *x << 16;
-		}
+	for (done = 0; done < frames; done += n) {
+		n = MIN(frames - done, TDFB_BLOCK_FRAMES);
 
-		/* Run and mix all filters to their output channel */
-		for (i = 0; i < cfg->num_filters; i++) {
-			is = cd->input_channel_select[i];
-			is2 = is + in_nch;
-			om = cd->output_channel_mix[i];
-			filter = &cd->fir[i];
-			/* Process sample and successive sample. This follows
-			 * optimized FIR version implementation that processes
-			 * two samples per call. The output is stored as Q5.27
-			 * to fit max. 16 filters sum to a channel.
-			 */
-			y0 = fir_32x16(filter, cd->in[is]) >> 4;
-			y1 = fir_32x16(filter, cd->in[is2]) >> 4;
-			for (k = 0; k < out_nch; k++) {
-				if (om & 1) {
-					cd->out[k] += y0;
-					cd->out[k + out_nch] += y1;
-				}
-				om = om >> 1;
+		/* Read a block of frames to per channel input buffers */
+		for (i = 0; i < n; i++) {
+			for (ch = 0; ch < in_nch; ch++) {
+				x = audio_stream_read_frag_s16(source, idx_in++);
+				cd->in[ch * TDFB_BLOCK_FRAMES + i] = *x << 16;
 			}
 		}
 
-		/* Write two frames of output */
-		for (i = 0; i < 2 * out_nch; i++) {
+		tdfb_fir_block(cd, out_nch, n);
+
+		/* Write the block of output frames */
+		for (i = 0; i < n * out_nch; i++) {
 			y = audio_stream_write_frag_s16(sink, idx_out++);
 			*y = sat_int16(Q_SHIFT_RND(cd->out[i], 27, 15));
 		}
@@ -82,57 +94,32 @@ void tdfb_fir_s24(struct tdfb_comp_data *cd,
 		  const struct audio_stream *source,
 		  struct audio_stream *sink, int frames)
 {
-	struct sof_tdfb_config *cfg = cd->config;
-	struct fir_state_32x16 *filter;
-	int32_t y0;
-	int32_t y1;
 	int32_t *x;
 	int32_t *y;
-	int is2;
-	int is;
-	int om;
+	int done;
+	int ch;
+	int n;
 	int i;
-	int j;
-	int k;
 	int in_nch = source->channels;
 	int out_nch = sink->channels;
 	int idx_in = 0;
 	int idx_out = 0;
 
-	for (j = 0; j < (frames >> 1); j++) {
-		/* Clear output mix*/
-		memset(cd->out, 0,  2 * out_nch * sizeof(int32_t));
-
-		/* Read two frames from all input channels */
-		for (i = 0; i < 2 * in_nch; i++) {
-			x = audio_stream_read_frag_s32(source, idx_in++);
-			cd->in[i] = *x << 8;
-		}
+	for (done = 0; done < frames; done += n) {
+		n = MIN(frames - done, TDFB_BLOCK_FRAMES);
 
-		/* Run and mix all filters to their output channel */
-		for (i = 0; i < cfg->num_filters; i++) {
-			is = cd->input_channel_select[i];
-			is2 = is + in_nch;
-			om = cd->output_channel_mix[i];
-			filter = &cd->fir[i];
-			/* Process sample and successive sample. This follows
-			 * optimized FIR version implementation that processes
-			 * two samples per call. The output is stored as Q5.27
-			 * to fit max. 16 filters sum to a channel.
-			 */
-			y0 = fir_32x16(filter, cd->in[is]) >> 4;
-			y1 = fir_32x16(filter, cd->in[is2]) >> 4;
-			for (k = 0; k < out_nch; k++) {
-				if (om & 1) {
-					cd->out[k] += y0;
-					cd->out[k + out_nch] += y1;
-				}
-				om = om >> 1;
+		/* Read a block of frames to per channel input buffers */
+		for (i = 0; i < n; i++) {
+			for (ch = 0; ch < in_nch; ch++) {
+				x = audio_stream_read_frag_s32(source, idx_in++);
+				cd->in[ch * TDFB_BLOCK_FRAMES + i] = *x << 8;
 			}
 		}
 
-		/* Write two frames of output */
-		for (i = 0; i < 2 * out_nch; i++) {
+		tdfb_fir_block(cd, out_nch, n);
+
+		/* Write the block of output frames */
+		for (i = 0; i < n * out_nch; i++) {
 			y = audio_stream_write_frag_s32(sink, idx_out++);
 			*y = sat_int24(Q_SHIFT_RND(cd->out[i], 27, 23));
 		}
@@ -145,59 +132,35 @@ void tdfb_fir_s32(struct tdfb_comp_data *cd,
 		  const struct audio_stream *source,
 		  struct audio_stream *sink, int frames)
 {
-	struct sof_tdfb_config *cfg = cd->config;
-	struct fir_state_32x16 *filter;
-	int32_t y0;
-	int32_t y1;
 	int32_t *x;
 	int32_t *y;
-	int is2;
-	int is;
-	int om;
+	int done;
+	int ch;
+	int n;
 	int i;
-	int j;
-	int k;
 	int in_nch = source->channels;
 	int out_nch = sink->channels;
 	int idx_in = 0;
 	int idx_out = 0;
 
-	for (j = 0; j < (frames >> 1); j++) {
-		/* Clear output mix*/
-		memset(cd->out, 0,  2 * out_nch * sizeof(int32_t));
+	for (done = 0; done < frames; done += n) {
+		n = MIN(frames - done, TDFB_BLOCK_FRAMES);
 
-		/* Read two frames from all input channels */
-		for (i = 0; i < 2 * in_nch; i++) {
-			x = audio_stream_read_frag_s32(source, idx_in++);
-			cd->in[i] = *x;
-		}
-
-		/* Run and mix all filters to their output channel */
-		for (i = 0; i < cfg->num_filters; i++) {
-			is = cd->input_channel_select[i];
-			is2 = is + in_nch;
-			om = cd->output_channel_mix[i];
-			filter = &cd->fir[i];
-			/* Process sample and successive sample. This follows
-			 * optimized FIR version implementation that processes
-			 * two samples per call. The output is stored as Q5.27
-			 * to fit max. 16 filters sum to a channel.
-			 */
-			y0 = fir_32x16(filter, cd->in[is]) >> 4;
-			y1 = fir_32x16(filter, cd->in[is2]) >> 4;
-			for (k = 0; k < out_nch; k++) {
-				if (om & 1) {
-					cd->out[k] += y0;
-					cd->out[k + out_nch] += y1;
-				}
-				om = om >> 1;
+		/* Read a block of frames to per channel input buffers */
+		for (i = 0; i < n; i++) {
+			for (ch = 0; ch < in_nch; ch++) {
+				x = audio_stream_read_frag_s32(source, idx_in++);
+				cd->in[ch * TDFB_BLOCK_FRAMES + i] = *x;
 			}
 		}
 
-		/* Write two frames of output. In Q5.27 to Q1.31 conversion
-		 * rounding is not applicable so just shift left by 4.
+		tdfb_fir_block(cd, out_nch, n);
+
+		/* Write the block of output frames. In Q5.27 to Q1.31
+		 * conversion rounding is not applicable so just shift left
+		 * by 4.
 		 */
-		for (i = 0; i < 2 * out_nch; i++) {
+		for (i = 0; i < n * out_nch; i++) {
 			y = audio_stream_write_frag_s32(sink, idx_out++);
 			*y = sat_int32((int64_t)cd->out[i] << 4);
 		}
@@ -206,4 +169,3 @@ void tdfb_fir_s32(struct tdfb_comp_data *cd,
 #endif
 
 #endif /* TDFB_GENERIC */
-
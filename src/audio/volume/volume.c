@@ -889,6 +889,9 @@ static int volume_prepare(struct comp_dev *dev)
 	else
 		cd->vol_ramp_frames = dev->frames / (dev->period / ramp_update_us);
 
+	/* gain only scales each sample, so sink can overlay the source */
+	dev->inplace = true;
+
 	return 0;
 
 err:
@@ -18,6 +18,7 @@
 
 #ifdef CONFIG_GENERIC
 
+#include <sof/audio/audio_stream.h>
 #include <sof/audio/buffer.h>
 #include <sof/audio/component.h>
 #include <sof/audio/format.h>
@@ -55,21 +56,24 @@ static void vol_s24_to_s24(struct comp_dev *dev, struct audio_stream *sink,
 			   const struct audio_stream *source, uint32_t frames)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	int32_t *src;
+	struct audio_stream_span span;
+	const int32_t *src;
 	int32_t *dest;
-	int32_t i;
-	uint32_t channel;
-	uint32_t buff_frag = 0;
-
-	/* Samples are Q1.23 --> Q1.23 and volume is Q8.16 */
-	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < sink->channels; channel++) {
-			src = audio_stream_read_frag_s32(source, buff_frag);
-			dest = audio_stream_write_frag_s32(sink, buff_frag);
-
-			*dest = vol_mult_s24_to_s24(*src, cd->volume[channel]);
-
-			buff_frag++;
+	uint32_t channel = 0;
+	uint32_t nch = sink->channels;
+	uint32_t i;
+
+	audio_stream_span_init(&span, source, sink, 0, frames);
+	while (audio_stream_span_next(&span)) {
+		src = span.src;
+		dest = span.snk;
+
+		/* Samples are Q1.23 --> Q1.23 and volume is Q8.16 */
+		for (i = 0; i < span.samples; i++) {
+			dest[i] = vol_mult_s24_to_s24(src[i],
+						      cd->volume[channel]);
+			if (++channel == nch)
+				channel = 0;
 		}
 	}
 }
@@ -90,23 +94,25 @@ static void vol_s32_to_s32(struct comp_dev *dev, struct audio_stream *sink,
 			   const struct audio_stream *source, uint32_t frames)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	int32_t *src;
+	struct audio_stream_span span;
+	const int32_t *src;
 	int32_t *dest;
-	int32_t i;
-	uint32_t channel;
-	uint32_t buff_frag = 0;
-
-	/* Samples are Q1.31 --> Q1.31 and volume is Q8.16 */
-	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < sink->channels; channel++) {
-			src = audio_stream_read_frag_s32(source, buff_frag);
-			dest = audio_stream_write_frag_s32(sink, buff_frag);
-
-			*dest = q_multsr_sat_32x32
-				(*src, cd->volume[channel],
+	uint32_t channel = 0;
+	uint32_t nch = sink->channels;
+	uint32_t i;
+
+	audio_stream_span_init(&span, source, sink, 0, frames);
+	while (audio_stream_span_next(&span)) {
+		src = span.src;
+		dest = span.snk;
+
+		/* Samples are Q1.31 --> Q1.31 and volume is Q8.16 */
+		for (i = 0; i < span.samples; i++) {
+			dest[i] = q_multsr_sat_32x32
+				(src[i], cd->volume[channel],
 				 Q_SHIFT_BITS_64(31, 16, 31));
-
-			buff_frag++;
+			if (++channel == nch)
+				channel = 0;
 		}
 	}
 }
@@ -127,23 +133,25 @@ static void vol_s16_to_s16(struct comp_dev *dev, struct audio_stream *sink,
 			   const struct audio_stream *source, uint32_t frames)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	int16_t *src;
+	struct audio_stream_span span;
+	const int16_t *src;
 	int16_t *dest;
-	int32_t i;
-	uint32_t channel;
-	uint32_t buff_frag = 0;
-
-	/* Samples are Q1.15 --> Q1.15 and volume is Q8.16 */
-	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < sink->channels; channel++) {
-			src = audio_stream_read_frag_s16(source, buff_frag);
-			dest = audio_stream_write_frag_s16(sink, buff_frag);
-
-			*dest = q_multsr_sat_32x32_16
-				(*src, cd->volume[channel],
+	uint32_t channel = 0;
+	uint32_t nch = sink->channels;
+	uint32_t i;
+
+	audio_stream_span_init(&span, source, sink, 0, frames);
+	while (audio_stream_span_next(&span)) {
+		src = span.src;
+		dest = span.snk;
+
+		/* Samples are Q1.15 --> Q1.15 and volume is Q8.16 */
+		for (i = 0; i < span.samples; i++) {
+			dest[i] = q_multsr_sat_32x32_16
+				(src[i], cd->volume[channel],
 				 Q_SHIFT_BITS_32(15, 16, 15));
-
-			buff_frag++;
+			if (++channel == nch)
+				channel = 0;
 		}
 	}
 }
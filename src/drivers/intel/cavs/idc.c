@@ -84,6 +84,17 @@ static bool idc_is_received(int target_core)
 		IPC_IDCIETC_DONE;
 }
 
+/**
+ * \brief Checks IDC registers whether the previous message has been taken.
+ * \param[in] target_core Id of the core receiving the message.
+ * \return True if the target core cleared BUSY, false otherwise.
+ */
+static bool idc_is_free(int target_core)
+{
+	return !(idc_read(IPC_IDCITC(target_core), cpu_get_id()) &
+		 IPC_IDCITC_BUSY);
+}
+
 /**
  * \brief Checks core status register.
  * \param[in] target_core Id of the core powering up.
@@ -111,6 +122,15 @@ int idc_send_msg(struct idc_msg *msg, uint32_t mode)
 
 	tr_dbg(&idc_tr, "arch_idc_send_msg()");
 
+	/* a doorbell may come right after the previous one was handled,
+	 * but before the target core cleared BUSY
+	 */
+	if (mode == IDC_DOORBELL) {
+		ret = idc_wait_in_blocking_mode(msg->core, idc_is_free);
+		if (ret < 0)
+			return ret;
+	}
+
 	/* clear any previous messages */
 	idcietc = idc_read(IPC_IDCIETC(msg->core), core);
 	if (idcietc & IPC_IDCIETC_DONE)
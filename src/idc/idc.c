@@ -6,7 +6,9 @@
 
 #include <sof/audio/component.h>
 #include <sof/audio/component_ext.h>
+#include <sof/debug/panic.h>
 #include <sof/drivers/idc.h>
+#include <sof/drivers/interrupt.h>
 #include <sof/drivers/ipc.h>
 #include <sof/drivers/timer.h>
 #include <sof/lib/alloc.h>
@@ -15,21 +17,30 @@
 #include <sof/lib/memory.h>
 #include <sof/lib/notifier.h>
 #include <sof/lib/uuid.h>
+#include <sof/math/numbers.h>
 #include <sof/platform.h>
 #include <sof/schedule/edf_schedule.h>
 #include <sof/schedule/ll_schedule.h>
 #include <sof/schedule/schedule.h>
 #include <sof/schedule/task.h>
+#include <sof/string.h>
 #include <sof/trace/trace.h>
 #include <ipc/header.h>
 #include <ipc/stream.h>
 #include <ipc/topology.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 /** \brief IDC message payload per core. */
 static SHARED_DATA struct idc_payload payload[PLATFORM_CORE_COUNT];
 
+#if CONFIG_IDC_RING
+/** \brief IDC message rings per source and target core. */
+static SHARED_DATA struct idc_ring rings[PLATFORM_CORE_COUNT]
+					[PLATFORM_CORE_COUNT];
+#endif
+
 /* 379a60ae-cedb-4777-aaf2-5659b0a85735 */
 DECLARE_SOF_UUID("idc", idc_uuid, 0x379a60ae, 0xcedb, 0x4777,
 		 0xaa, 0xf2, 0x56, 0x59, 0xb0, 0xa8, 0x57, 0x35);
@@ -122,14 +133,13 @@ static void idc_ipc(void)
 /**
  * \brief Executes IDC component params message.
  * \param[in] comp_id Component id to have params set.
+ * \param[in] payload Message payload.
  * \return Error code.
  */
-static int idc_params(uint32_t comp_id)
+static int idc_params(uint32_t comp_id, struct idc_payload *payload)
 {
 	struct ipc *ipc = ipc_get();
 	struct ipc_comp_dev *ipc_dev;
-	struct idc *idc = *idc_get();
-	struct idc_payload *payload = idc_payload_get(idc, cpu_get_id());
 	struct sof_ipc_stream_params *params =
 		(struct sof_ipc_stream_params *)payload;
 	int ret;
@@ -207,14 +217,13 @@ out:
 /**
  * \brief Executes IDC component trigger message.
  * \param[in] comp_id Component id to be triggered.
+ * \param[in] payload Message payload.
  * \return Error code.
  */
-static int idc_trigger(uint32_t comp_id)
+static int idc_trigger(uint32_t comp_id, struct idc_payload *payload)
 {
 	struct ipc *ipc = ipc_get();
 	struct ipc_comp_dev *ipc_dev;
-	struct idc *idc = *idc_get();
-	struct idc_payload *payload = idc_payload_get(idc, cpu_get_id());
 	uint32_t cmd = *(uint32_t *)payload;
 	int ret;
 
@@ -271,12 +280,26 @@ static int idc_reset(uint32_t comp_id)
 	return ret;
 }
 
+/**
+ * \brief Executes IDC core load query message.
+ * \return Demand of the core in thousands of cycles per second.
+ */
+static int idc_load(void)
+{
+	return MIN(schedule_ll_load(), INT32_MAX);
+}
+
 /**
  * \brief Executes IDC message based on type.
- * \param[in,out] msg Pointer to IDC message.
+ * \param[in] msg Pointer to IDC message, its payload is either carried
+ *		  with the message or found in the payload slot of the core.
+ * \return Status of the message.
  */
-void idc_cmd(struct idc_msg *msg)
+int idc_cmd_run(struct idc_msg *msg)
 {
+	struct idc *idc = *idc_get();
+	struct idc_payload *payload = msg->payload ? msg->payload :
+		idc_payload_get(idc, cpu_get_id());
 	uint32_t type = iTS(msg->header);
 	int ret = 0;
 
@@ -285,29 +308,49 @@ void idc_cmd(struct idc_msg *msg)
 		cpu_power_down_core();
 		break;
 	case iTS(IDC_MSG_NOTIFY):
-		notifier_notify_remote();
+		if (msg->payload)
+			notifier_notify_remote_data(msg->payload);
+		else
+			notifier_notify_remote();
 		break;
 	case iTS(IDC_MSG_IPC):
 		idc_ipc();
 		break;
 	case iTS(IDC_MSG_PARAMS):
-		ret = idc_params(msg->extension);
+		ret = idc_params(msg->extension, payload);
 		break;
 	case iTS(IDC_MSG_PREPARE):
 		ret = idc_prepare(msg->extension);
 		break;
 	case iTS(IDC_MSG_TRIGGER):
-		ret = idc_trigger(msg->extension);
+		ret = idc_trigger(msg->extension, payload);
 		break;
 	case iTS(IDC_MSG_RESET):
 		ret = idc_reset(msg->extension);
 		break;
+	case iTS(IDC_MSG_LOAD):
+		ret = idc_load();
+		break;
+#if CONFIG_IDC_RING
+	case iTS(IDC_MSG_RING):
+		ret = idc_ring_drain(msg->core);
+		break;
+#endif
 	default:
 		tr_err(&idc_tr, "idc_cmd(): invalid msg->header = %u",
 		       msg->header);
 	}
 
-	idc_msg_status_set(ret, cpu_get_id());
+	return ret;
+}
+
+/**
+ * \brief Executes IDC message based on type.
+ * \param[in,out] msg Pointer to IDC message.
+ */
+void idc_cmd(struct idc_msg *msg)
+{
+	idc_msg_status_set(idc_cmd_run(msg), cpu_get_id());
 }
 
 int idc_init(void)
@@ -323,6 +366,10 @@ int idc_init(void)
 	/* initialize idc data */
 	*idc = rzalloc(SOF_MEM_ZONE_SYS, 0, SOF_MEM_CAPS_RAM, sizeof(**idc));
 	(*idc)->payload = cache_to_uncache((struct idc_payload *)payload);
+#if CONFIG_IDC_RING
+	(*idc)->ring = cache_to_uncache((struct idc_ring *)rings);
+	idc_ring_reset(*idc);
+#endif
 
 	/* process task */
 	schedule_task_init_edf(&(*idc)->idc_task, SOF_UUID(idc_cmd_task_uuid),
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/common.h>
+#include <sof/drivers/idc.h>
+#include <sof/drivers/interrupt.h>
+#include <sof/drivers/timer.h>
+#include <sof/lib/clk.h>
+#include <sof/lib/cpu.h>
+#include <sof/lib/memory.h>
+#include <sof/platform.h>
+#include <sof/string.h>
+#include <sof/trace/trace.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Messages from one core to another queued in shared memory, the target
+ * core executes all of them on a single doorbell interrupt.
+ */
+
+/**
+ * \brief Waits until the target core executed messages up to a cookie.
+ * \param[in] ring Ring of the target core.
+ * \param[in] cookie Cookie of the last message to wait for.
+ * \return Error code.
+ */
+static int idc_ring_wait_tail(struct idc_ring *ring, uint32_t cookie)
+{
+	struct timer *timer = timer_get();
+	uint64_t deadline;
+
+	deadline = platform_timer_get(timer) +
+		clock_ms_to_ticks(PLATFORM_DEFAULT_CLOCK, 1) *
+		IDC_TIMEOUT / 1000;
+
+	while ((int32_t)(ring->tail - cookie) < 0) {
+		if (deadline < platform_timer_get(timer)) {
+			/* safe check in case we've got preempted
+			 * after read
+			 */
+			if ((int32_t)(ring->tail - cookie) >= 0)
+				break;
+
+			tr_err(&idc_tr, "idc_ring_wait_tail() error: timeout");
+			return -ETIME;
+		}
+	}
+
+	return 0;
+}
+
+int idc_ring_post(struct idc_msg *msg, uint32_t *cookie)
+{
+	struct idc *idc = *idc_get();
+	struct idc_ring *ring = idc_ring_get(idc, cpu_get_id(), msg->core);
+	struct idc_ring_entry *entry;
+	uint32_t flags;
+	int ret;
+
+	if (msg->size > IDC_MAX_PAYLOAD_SIZE) {
+		tr_err(&idc_tr, "idc_ring_post() error: payload size %u",
+		       msg->size);
+		return -EINVAL;
+	}
+
+	irq_local_disable(flags);
+
+	while (idc_ring_full(ring)) {
+		/* nobody waits for the message, don't stall the sender */
+		if (!cookie) {
+			ring->dropped++;
+			platform_shared_commit(ring, sizeof(*ring));
+			irq_local_enable(flags);
+			return -EBUSY;
+		}
+
+		irq_local_enable(flags);
+
+		/* let the target core make room */
+		ret = idc_ring_flush(msg->core);
+		if (ret < 0)
+			return ret;
+
+		ret = idc_ring_wait_tail(ring, ring->tail + 1);
+		if (ret < 0)
+			return ret;
+
+		irq_local_disable(flags);
+	}
+
+	entry = idc_ring_entry_get(ring, ring->head + 1);
+	entry->header = msg->header;
+	entry->extension = msg->extension;
+	entry->size = msg->payload ? msg->size : 0;
+	entry->status = 0;
+	if (entry->size) {
+		ret = memcpy_s(entry->payload.data, IDC_MAX_PAYLOAD_SIZE,
+			       msg->payload, msg->size);
+		assert(!ret);
+	}
+	platform_shared_commit(entry, sizeof(*entry));
+
+	/* publish the message only once it is complete */
+	ring->head++;
+	platform_shared_commit(ring, sizeof(*ring));
+
+	if (cookie)
+		*cookie = ring->head;
+
+	irq_local_enable(flags);
+
+	return 0;
+}
+
+int idc_ring_flush(uint32_t core)
+{
+	struct idc_msg msg = { IDC_MSG_RING, IDC_MSG_RING_EXT, core, };
+	struct idc *idc = *idc_get();
+	struct idc_ring *ring = idc_ring_get(idc, cpu_get_id(), core);
+	uint32_t flags;
+	bool ring_bell;
+	int ret;
+
+	irq_local_disable(flags);
+	ring_bell = idc_ring_bell_set(ring);
+	platform_shared_commit(ring, sizeof(*ring));
+	irq_local_enable(flags);
+
+	if (!ring_bell)
+		return 0;
+
+	ret = idc_send_msg(&msg, IDC_DOORBELL);
+	if (ret < 0) {
+		ring->doorbell = 0;
+		platform_shared_commit(ring, sizeof(*ring));
+	}
+
+	return ret;
+}
+
+int idc_ring_wait(uint32_t core, uint32_t cookie)
+{
+	struct idc *idc = *idc_get();
+	struct idc_ring *ring = idc_ring_get(idc, cpu_get_id(), core);
+	int ret;
+
+	ret = idc_ring_flush(core);
+	if (ret < 0)
+		return ret;
+
+	ret = idc_ring_wait_tail(ring, cookie);
+	if (ret < 0)
+		return ret;
+
+	return idc_ring_entry_get(ring, cookie)->status;
+}
+
+int idc_ring_drain(uint32_t source)
+{
+	struct idc *idc = *idc_get();
+	struct idc_ring *ring = idc_ring_get(idc, source, cpu_get_id());
+	struct idc_msg msg = { .core = source, };
+	struct idc_ring_entry *entry;
+
+	do {
+		while (ring->tail != ring->head) {
+			entry = idc_ring_entry_get(ring, ring->tail + 1);
+			msg.header = entry->header;
+			msg.extension = entry->extension;
+			msg.size = entry->size;
+			msg.payload = entry->size ? &entry->payload : NULL;
+
+			entry->status = idc_cmd_run(&msg);
+			platform_shared_commit(entry, sizeof(*entry));
+
+			ring->tail++;
+			platform_shared_commit(ring, sizeof(*ring));
+		}
+
+		/* messages posted before the doorbell is cleared don't
+		 * ring it again, so look at the ring once more
+		 */
+	} while (idc_ring_bell_clear(ring));
+
+	platform_shared_commit(ring, sizeof(*ring));
+
+	return 0;
+}
+
+void idc_ring_reset(struct idc *idc)
+{
+	struct idc_ring *ring;
+	int i;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		ring = idc_ring_get(idc, i, cpu_get_id());
+		ring->tail = ring->head;
+		ring->doorbell = 0;
+		platform_shared_commit(ring, sizeof(*ring));
+	}
+}
@@ -0,0 +1,140 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2020 Intel Corporation. All rights reserved.
+ */
+
+/**
+ * \file include/ipc/debug.h
+ * \brief IPC debug definitions
+ */
+
+#ifndef __IPC_DEBUG_H__
+#define __IPC_DEBUG_H__
+
+#include <ipc/header.h>
+#include <stdint.h>
+
+/** \name Memory zones reported by SOF_IPC_DEBUG_MEM_STATS
+ *  @{
+ */
+
+#define SOF_IPC_DEBUG_MEM_ZONE_SYS		0
+#define SOF_IPC_DEBUG_MEM_ZONE_SYS_RUNTIME	1
+#define SOF_IPC_DEBUG_MEM_ZONE_RUNTIME		2
+#define SOF_IPC_DEBUG_MEM_ZONE_BUFFER		3
+#define SOF_IPC_DEBUG_MEM_ZONE_COUNT		4
+
+/** @} */
+
+/** Allocation statistics of a zone. */
+struct sof_ipc_debug_mem_zone {
+	uint32_t allocs;		/**< successful allocations */
+	uint32_t failures;		/**< failed allocations */
+	uint32_t alloc_cycles_max;	/**< longest allocation in DSP cycles */
+} __attribute__((packed));
+
+/** State of a single heap. */
+struct sof_ipc_debug_mem_heap {
+	uint32_t zone;		/**< SOF_IPC_DEBUG_MEM_ZONE_ */
+	uint32_t index;		/**< heap index in the zone */
+	uint32_t caps;		/**< SOF_MEM_CAPS_ */
+	uint32_t size;		/**< size in bytes */
+	uint32_t used;		/**< bytes in use */
+	uint32_t free;		/**< free bytes */
+	uint32_t max_free;	/**< largest contiguous free run in bytes */
+} __attribute__((packed));
+
+/**
+ * Reply to SOF_IPC_DEBUG_MEM_STATS. Heaps are reported from the buffer zone
+ * down to the system zone for as long as they fit in the reply.
+ * Memory of the slab caches is taken from the buffer heap and counted in
+ * its used bytes, slab_size and slab_used break it down.
+ */
+struct sof_ipc_debug_mem_stats {
+	struct sof_ipc_reply rhdr;
+	uint32_t frees;			/**< frees of heap memory */
+	uint32_t free_cycles_max;	/**< longest free in DSP cycles */
+	uint32_t num_heaps;		/**< number of elements in heaps */
+	uint32_t slab_size;		/**< bytes held by the slab caches */
+	uint32_t slab_used;		/**< bytes of cached objects in use */
+
+	struct sof_ipc_debug_mem_zone zones[SOF_IPC_DEBUG_MEM_ZONE_COUNT];
+	struct sof_ipc_debug_mem_heap heaps[];
+} __attribute__((packed));
+
+/** Scheduling statistics of an EDF task. */
+struct sof_ipc_debug_edf_task {
+	uint32_t uid;		/**< address of the task UUID entry */
+	uint32_t state;		/**< enum task_state */
+	uint32_t runs;		/**< runs started */
+	uint32_t missed;	/**< runs completed after the deadline */
+	uint32_t latency_max;	/**< longest queued time in timer ticks */
+	uint32_t reserved;
+} __attribute__((packed));
+
+/**
+ * Reply to SOF_IPC_DEBUG_EDF_STATS. Tasks of the primary core are
+ * reported for as long as they fit in the reply.
+ */
+struct sof_ipc_debug_edf_stats {
+	struct sof_ipc_reply rhdr;
+	uint32_t num_tasks;	/**< number of elements in tasks */
+	uint32_t reserved[3];
+
+	struct sof_ipc_debug_edf_task tasks[];
+} __attribute__((packed));
+
+/** \name LL schedulers reported by SOF_IPC_DEBUG_LL_STATS
+ *  @{
+ */
+
+#define SOF_IPC_DEBUG_LL_SCHED_TIMER		0
+#define SOF_IPC_DEBUG_LL_SCHED_DMA		1
+#define SOF_IPC_DEBUG_LL_SCHED_COUNT		2
+
+/** @} */
+
+/** Run time statistics of a low latency task, in DSP cycles. */
+struct sof_ipc_debug_ll_task {
+	uint32_t uid;		/**< address of the task UUID entry */
+	uint32_t sched;		/**< SOF_IPC_DEBUG_LL_SCHED_ */
+	uint32_t id;		/**< owner id, pipeline id for pipelines */
+	uint32_t budget;	/**< cycles allowed per run */
+	uint32_t runs;		/**< runs of the task */
+	uint32_t overruns;	/**< runs longer than the budget */
+	uint32_t cycles_avg;	/**< moving average of a run */
+	uint32_t cycles_peak;	/**< longest run */
+} __attribute__((packed));
+
+/**
+ * Reply to SOF_IPC_DEBUG_LL_STATS. Scheduled tasks of the primary core
+ * are reported, timer driven first, for as long as they fit in the reply.
+ */
+struct sof_ipc_debug_ll_stats {
+	struct sof_ipc_reply rhdr;
+	uint32_t num_tasks;	/**< number of elements in tasks */
+	uint32_t reserved[3];
+
+	struct sof_ipc_debug_ll_task tasks[];
+} __attribute__((packed));
+
+/** Load of a DSP core, in thousands of cycles per second. */
+struct sof_ipc_debug_core_load {
+	uint32_t core;		/**< core id */
+	uint32_t enabled;	/**< 1 if the core is powered up */
+	uint32_t pipelines;	/**< pipelines created on the core */
+	uint32_t load_kcps;	/**< measured demand of its LL tasks */
+	uint32_t reserved_kcps;	/**< demand reserved by pipeline placement */
+	uint32_t reserved;
+} __attribute__((packed));
+
+/** Reply to SOF_IPC_DEBUG_CORE_LOAD, one element per DSP core. */
+struct sof_ipc_debug_core_load_stats {
+	struct sof_ipc_reply rhdr;
+	uint32_t num_cores;	/**< number of elements in cores */
+	uint32_t reserved[3];
+
+	struct sof_ipc_debug_core_load cores[];
+} __attribute__((packed));
+
+#endif /* __IPC_DEBUG_H__ */
@@ -186,6 +186,7 @@
 #define SOF_IPC_GLB_GDB_DEBUG                   SOF_GLB_TYPE(0xAU)
 #define SOF_IPC_GLB_TEST			SOF_GLB_TYPE(0xBU)
 #define SOF_IPC_GLB_PROBE			SOF_GLB_TYPE(0xCU)
+#define SOF_IPC_GLB_DEBUG			SOF_GLB_TYPE(0xDU) /**< ABI3.18 */
 
 /** @} */
 
@@ -285,6 +286,17 @@
 
  /** @} */
 
+/** \name DSP Command: Debug
+ *  @{
+ */
+
+#define SOF_IPC_DEBUG_MEM_STATS			SOF_CMD_TYPE(0x001) /**< ABI3.18 */
+#define SOF_IPC_DEBUG_EDF_STATS			SOF_CMD_TYPE(0x002) /**< ABI3.18 */
+#define SOF_IPC_DEBUG_LL_STATS			SOF_CMD_TYPE(0x003) /**< ABI3.18 */
+#define SOF_IPC_DEBUG_CORE_LOAD			SOF_CMD_TYPE(0x004) /**< ABI3.18 */
+
+/** @} */
+
 /** \name DSP Command: Test - Debug build only
  *  @{
  */
@@ -0,0 +1,92 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2020 Intel Corporation. All rights reserved.
+ */
+
+/*
+ * @brief Estimation of the rate factor of a DAI that is not in sync
+ * with the firmware timer, from the wall clock and sample count
+ * timestamps of the DAI.
+ */
+
+#ifndef __SOF_AUDIO_ASRC_ASRC_DRIFT_H__
+#define __SOF_AUDIO_ASRC_ASRC_DRIFT_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * @brief Drift estimators
+ */
+enum asrc_drift_estimator {
+	ASRC_DRIFT_LPF = 0,	/*!< First order low-pass filter */
+	ASRC_DRIFT_KALMAN,	/*!< Scalar Kalman filter */
+	ASRC_DRIFT_ESTIMATORS,	/*!< Number of estimators */
+};
+
+/*
+ * @brief Convergence statistics of the estimate. The skews are Q2.30.
+ */
+struct asrc_drift_metrics {
+	int32_t skew_min;	/*!< Smallest estimate */
+	int32_t skew_max;	/*!< Largest estimate */
+	int32_t jitter_max;	/*!< Peak deviation of the measurements
+				 *   from the estimate after lock
+				 */
+	uint32_t updates;	/*!< Number of estimate updates */
+	uint32_t lock_updates;	/*!< Updates until the first lock */
+	uint32_t lock_time_us;	/*!< Stream time until the first lock */
+	uint32_t lock_losses;	/*!< Number of times the lock was lost */
+	bool locked;		/*!< The estimate is locked */
+};
+
+struct asrc_drift;
+
+typedef void (*asrc_drift_func)(struct asrc_drift *drift, int32_t skew);
+
+struct asrc_drift {
+	asrc_drift_func estimate;	/*!< Estimator update function */
+	int32_t skew;		/*!< Estimated rate factor in Q2.30 */
+	int32_t gain;		/*!< Kalman gain in Q1.30 */
+	int32_t var;		/*!< Kalman prior error variance relative
+				 *   to measurement noise in Q8.24
+				 */
+	int32_t error_avg;	/*!< Smoothed measurement error in Q2.30 */
+	int32_t ts_prev;	/*!< Previous wall clock timestamp */
+	int32_t sample_prev;	/*!< Previous sample count timestamp */
+	uint32_t ts_elapsed;	/*!< Wall clock ticks before the lock */
+	int ts_count;		/*!< Number of timestamps received */
+	int lock_count;		/*!< Consecutive updates within limit */
+	struct asrc_drift_metrics metrics;
+};
+
+/*
+ * @brief Initialise the drift estimator.
+ *
+ * @param[in] drift      Estimator state.
+ * @param[in] estimator  Type of the estimator.
+ * @param[in] skew       Initial rate factor in Q2.30.
+ *
+ * @return 0 on success, -EINVAL for an unknown estimator.
+ */
+int asrc_drift_init(struct asrc_drift *drift,
+		    enum asrc_drift_estimator estimator, int32_t skew);
+
+/*
+ * @brief Update the estimate with a new DAI timestamp.
+ *
+ * The first timestamp only seeds the deltas.
+ *
+ * @param[in] drift        Estimator state.
+ * @param[in] ts           Wall clock timestamp, may wrap.
+ * @param[in] sample       Sample count timestamp, may wrap.
+ * @param[in] walclk_rate  Wall clock rate in Hz.
+ * @param[in] fs           Sample rate of the DAI in Hz.
+ *
+ * @return 1 when the estimate was updated, 0 when it was not, or
+ *         -EINVAL for a failed timestamp.
+ */
+int asrc_drift_update(struct asrc_drift *drift, int32_t ts, int32_t sample,
+		      uint32_t walclk_rate, int32_t fs);
+
+#endif /* __SOF_AUDIO_ASRC_ASRC_DRIFT_H__ */
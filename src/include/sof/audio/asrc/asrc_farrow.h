@@ -613,18 +613,20 @@ enum asrc_error_code asrc_set_output_format(struct comp_dev *dev,
 					    enum asrc_io_format output_format);
 
 /*
- * Write value of 16 bit input buffers to the channels of the ring buffer
+ * Write num_frames frames of 16 bit input buffers, starting from
+ * index_input_frame, to the channels of the ring buffer
  */
 void asrc_write_to_ring_buffer16(struct asrc_farrow *src_obj,
 				 int16_t **input_buffers,
-				 int index_input_frame);
+				 int index_input_frame, int num_frames);
 
 /*
- * Write value of 32 bit input buffers to the channels of the ring buffer
+ * Write num_frames frames of 32 bit input buffers, starting from
+ * index_input_frame, to the channels of the ring buffer
  */
 void asrc_write_to_ring_buffer32(struct asrc_farrow *src_obj,
 				 int32_t **input_buffers,
-				 int index_input_frame);
+				 int index_input_frame, int num_frames);
 
 /*
  * Filter the 32 bit ring buffer values with impulse_response
@@ -568,6 +568,10 @@ static inline int audio_stream_copy(const struct audio_stream *source,
 	uint32_t bytes_copied;
 	int ret;
 
+	/* streams sharing memory in place have nothing to copy */
+	if (src == snk)
+		return samples;
+
 	while (bytes) {
 		bytes_src = audio_stream_bytes_without_wrap(source, src);
 		bytes_snk = audio_stream_bytes_without_wrap(sink, snk);
@@ -587,6 +591,155 @@ static inline int audio_stream_copy(const struct audio_stream *source,
 	return samples;
 }
 
+/**
+ * Span of samples without a wrap in both the source and the sink stream,
+ * lets the processing run linear loops over the samples of the span.
+ *
+ * @code
+ * struct audio_stream_span span;
+ *
+ * audio_stream_span_init(&span, source, sink, 0, frames);
+ * while (audio_stream_span_next(&span)) {
+ *	const int32_t *x = span.src;
+ *	int32_t *y = span.snk;
+ *
+ *	for (i = 0; i < span.samples; i++)
+ *		y[i] = x[i];
+ * }
+ * @endcode
+ */
+struct audio_stream_span {
+	const struct audio_stream *source; /**< source, NULL if sink only */
+	const struct audio_stream *sink; /**< sink, NULL if source only */
+	const void *src; /**< source samples of the span */
+	void *snk; /**< sink samples of the span */
+	uint32_t samples; /**< number of samples in the span */
+	uint32_t remaining; /**< samples left after the span */
+};
+
+/**
+ * Starts iterating over frames from the read pointer of the source and the
+ * write pointer of the sink.
+ * @param span Span iterator.
+ * @param source Source stream, can be NULL if sink is given.
+ * @param sink Sink stream, can be NULL if source is given.
+ * @param offset Number of frames to skip from the read and write pointer.
+ * @param frames Number of frames to iterate over.
+ */
+static inline void audio_stream_span_init(struct audio_stream_span *span,
+					  const struct audio_stream *source,
+					  const struct audio_stream *sink,
+					  uint32_t offset, uint32_t frames)
+{
+	span->source = source;
+	span->sink = sink;
+	span->src = source ? audio_stream_wrap(source, (char *)source->r_ptr +
+					       offset *
+					       audio_stream_frame_bytes(source)) :
+		NULL;
+	span->snk = sink ? audio_stream_wrap(sink, (char *)sink->w_ptr +
+					     offset *
+					     audio_stream_frame_bytes(sink)) :
+		NULL;
+	span->samples = 0;
+	span->remaining = frames * (source ? source->channels : sink->channels);
+}
+
+/**
+ * Moves to the next span, the longest one before either stream wraps.
+ * @param span Span iterator.
+ * @return false when all the frames have been iterated over.
+ */
+static inline bool audio_stream_span_next(struct audio_stream_span *span)
+{
+	uint32_t samples = span->remaining;
+	uint32_t ssize;
+
+	if (span->source) {
+		ssize = audio_stream_sample_bytes(span->source);
+		span->src = audio_stream_wrap(span->source, (char *)span->src +
+					      span->samples * ssize);
+		samples = MIN(samples,
+			      audio_stream_bytes_without_wrap(span->source,
+							      span->src) / ssize);
+	}
+
+	if (span->sink) {
+		ssize = audio_stream_sample_bytes(span->sink);
+		span->snk = audio_stream_wrap(span->sink, (char *)span->snk +
+					      span->samples * ssize);
+		samples = MIN(samples,
+			      audio_stream_bytes_without_wrap(span->sink,
+							      span->snk) / ssize);
+	}
+
+	span->samples = samples;
+	span->remaining -= samples;
+
+	return samples > 0;
+}
+
+/**
+ * Copies data from the stream to linear memory, a memcpy_s() per wrap.
+ * @param source Source stream.
+ * @param ioffset Offset (in bytes) from read pointer to start reading from.
+ * @param linear Destination memory.
+ * @param bytes Number of bytes to copy.
+ */
+static inline void audio_stream_copy_to_linear(const struct audio_stream *source,
+					       uint32_t ioffset, void *linear,
+					       uint32_t bytes)
+{
+	void *src = audio_stream_wrap(source, (char *)source->r_ptr + ioffset);
+	char *dst = linear;
+	uint32_t bytes_src;
+	uint32_t bytes_copied;
+	int ret;
+
+	while (bytes) {
+		bytes_src = audio_stream_bytes_without_wrap(source, src);
+		bytes_copied = MIN(bytes, bytes_src);
+
+		ret = memcpy_s(dst, bytes, src, bytes_copied);
+		assert(!ret);
+
+		bytes -= bytes_copied;
+		dst += bytes_copied;
+		src = audio_stream_wrap(source, (char *)src + bytes_copied);
+	}
+}
+
+/**
+ * Copies data from linear memory to the stream, a memcpy_s() per wrap.
+ * @param linear Source memory.
+ * @param sink Sink stream.
+ * @param ooffset Offset (in bytes) from write pointer to start writing to.
+ * @param bytes Number of bytes to copy.
+ */
+static inline void audio_stream_copy_from_linear(const void *linear,
+						 struct audio_stream *sink,
+						 uint32_t ooffset,
+						 uint32_t bytes)
+{
+	const char *src = linear;
+	void *snk = audio_stream_wrap(sink, (char *)sink->w_ptr + ooffset);
+	uint32_t bytes_snk;
+	uint32_t bytes_copied;
+	int ret;
+
+	while (bytes) {
+		bytes_snk = audio_stream_bytes_without_wrap(sink, snk);
+		bytes_copied = MIN(bytes, bytes_snk);
+
+		ret = memcpy_s(snk, bytes_snk, src, bytes_copied);
+		assert(!ret);
+
+		bytes -= bytes_copied;
+		src += bytes_copied;
+		snk = audio_stream_wrap(sink, (char *)snk + bytes_copied);
+	}
+}
+
 /** @}*/
 
 #endif /* __SOF_AUDIO_AUDIO_STREAM_H__ */
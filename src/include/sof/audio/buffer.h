@@ -11,7 +11,9 @@
 #include <sof/audio/audio_stream.h>
 #include <sof/audio/pipeline.h>
 #include <sof/math/numbers.h>
+#include <sof/atomic.h>
 #include <sof/common.h>
+#include <sof/compiler_attributes.h>
 #include <sof/debug/panic.h>
 #include <sof/lib/alloc.h>
 #include <sof/lib/cache.h>
@@ -83,6 +85,33 @@ extern struct tr_ctx buffer_tr;
 #define BUFF_PARAMS_RATE	BIT(2)
 #define BUFF_PARAMS_CHANNELS	BIT(3)
 
+/**
+ * Read or write position of a lock-free inter-core buffer. It is written
+ * only by the core owning that side and has a cache line of its own, so
+ * publishing it never writes back anything of the other side.
+ */
+struct buffer_spsc_pos {
+	atomic_t pos;	/**< byte offset in [0, 2 * size) */
+} __aligned(PLATFORM_DCACHE_ALIGN);
+
+/**
+ * Positions of a single producer, single consumer inter-core buffer. Both
+ * run over twice the buffer size so that a full buffer is told apart from
+ * an empty one without any shared counter.
+ */
+struct buffer_spsc {
+	struct buffer_spsc_pos produced;	/**< written by the source */
+	struct buffer_spsc_pos consumed;	/**< written by the sink */
+};
+
+/**
+ * Memory holding buffers of a pipeline, freed along with the last of them.
+ */
+struct buffer_arena {
+	void *addr;		/**< memory of all the buffers */
+	uint32_t users;		/**< buffers still using the memory */
+};
+
 /* audio component buffer - connects 2 audio components together in pipeline */
 struct comp_buffer {
 	spinlock_t *lock;		/* locking mechanism */
@@ -96,6 +125,7 @@ struct comp_buffer {
 	uint32_t caps;
 	uint32_t core;
 	bool inter_core; /* true if connected to a comp from another core */
+	struct buffer_spsc *spsc; /* lock-free positions of inter_core buffer */
 	struct tr_ctx tctx;			/* trace settings */
 
 	/* connected components */
@@ -112,6 +142,15 @@ struct comp_buffer {
 
 	bool hw_params_configured; /**< indicates whether hw params were set */
 	bool walking;	/**< indicates if the buffer is being walking */
+
+	/* in-place processing */
+	struct comp_buffer *inplace_source; /**< buffer owning our memory */
+	struct comp_buffer *inplace_sink;   /**< buffer sharing our memory */
+
+	/* memory packed with other buffers of the pipeline */
+	struct buffer_arena *arena;	/**< arena of the memory, if any */
+	void *arena_addr;		/**< own memory within the arena */
+	uint32_t arena_size;		/**< size of own memory in the arena */
 };
 
 struct buffer_cb_transact {
@@ -159,12 +198,52 @@ struct comp_buffer *buffer_new(struct sof_ipc_buffer *desc);
 int buffer_set_size(struct comp_buffer *buffer, uint32_t size);
 void buffer_free(struct comp_buffer *buffer);
 
+/* marks buffer as connecting components on different cores */
+int buffer_set_inter_core(struct comp_buffer *buffer);
+
+/* lets sink buffer of an in-place component share memory of its source */
+int buffer_inplace_attach(struct comp_buffer *sink, struct comp_buffer *source);
+
+/* gives in-place buffer its own memory back */
+int buffer_inplace_detach(struct comp_buffer *buffer);
+
+/* moves memory of the buffers into a single allocation */
+int buffer_arena_new(struct comp_buffer **buffers, uint32_t count);
+
 /* called by a component after producing data into this buffer */
 void comp_update_buffer_produce(struct comp_buffer *buffer, uint32_t bytes);
 
 /* called by a component after consuming data from this buffer */
 void comp_update_buffer_consume(struct comp_buffer *buffer, uint32_t bytes);
 
+/* checks if the buffer shares memory of the source of its producer */
+static inline bool buffer_is_inplace(const struct comp_buffer *buffer)
+{
+	return buffer->inplace_source;
+}
+
+/**
+ * Updates free bytes of buffers sharing memory in place. Every buffer of
+ * the chain can only be written up to where its last buffer is read.
+ * @param buffer Any buffer of the chain.
+ */
+static inline void buffer_inplace_sync(struct comp_buffer *buffer)
+{
+	uint32_t held = 0;
+
+	if (!buffer->inplace_source && !buffer->inplace_sink)
+		return;
+
+	while (buffer->inplace_sink)
+		buffer = buffer->inplace_sink;
+
+	for (; buffer; buffer = buffer->inplace_source) {
+		held += buffer->stream.avail;
+		buffer->stream.free = buffer->stream.size -
+			MIN(held, buffer->stream.size);
+	}
+}
+
 static inline void buffer_invalidate(struct comp_buffer *buffer, uint32_t bytes)
 {
 	if (!buffer->inter_core)
@@ -181,6 +260,77 @@ static inline void buffer_writeback(struct comp_buffer *buffer, uint32_t bytes)
 	audio_stream_writeback(&buffer->stream, bytes);
 }
 
+/**
+ * Sets the read and write positions of a lock-free inter-core buffer.
+ * Only allowed while neither side is streaming.
+ * @param buffer Buffer instance.
+ */
+static inline void buffer_spsc_reset(struct comp_buffer *buffer)
+{
+	if (!buffer->spsc)
+		return;
+
+	atomic_set(&buffer->spsc->produced.pos, 0);
+	atomic_set(&buffer->spsc->consumed.pos, 0);
+	dcache_writeback_invalidate_region(buffer->spsc,
+					   sizeof(*buffer->spsc));
+}
+
+/**
+ * Advances and publishes the position owned by the calling core. The
+ * position is stored with a serializing volatile write and written back
+ * on its own, after the data it covers has been written back.
+ * @param buffer Buffer instance.
+ * @param pos Position owned by the calling core.
+ * @param bytes Number of bytes produced or consumed.
+ */
+static inline void buffer_spsc_advance(struct comp_buffer *buffer,
+				       struct buffer_spsc_pos *pos,
+				       uint32_t bytes)
+{
+	uint32_t limit = 2 * buffer->stream.size;
+	uint32_t value = atomic_read(&pos->pos) + bytes;
+
+	if (value >= limit)
+		value -= limit;
+
+	atomic_set(&pos->pos, value);
+	dcache_writeback_region(pos, sizeof(*pos));
+}
+
+/**
+ * Refreshes stream pointers and counters of a lock-free inter-core buffer
+ * from the positions published by both sides.
+ * @param buffer Buffer instance.
+ */
+static inline void buffer_spsc_sync(struct comp_buffer *buffer)
+{
+	struct audio_stream *stream = &buffer->stream;
+	uint32_t w;
+	uint32_t r;
+
+	/* own position is always written back, nothing is lost here */
+	dcache_writeback_invalidate_region(buffer->spsc,
+					   sizeof(*buffer->spsc));
+
+	w = atomic_read(&buffer->spsc->produced.pos);
+	r = atomic_read(&buffer->spsc->consumed.pos);
+
+	stream->avail = w >= r ? w - r : w + 2 * stream->size - r;
+
+	/* a sink that consumed more than was produced is ahead of the
+	 * source, nothing is available to it until the source catches up
+	 */
+	if (stream->avail > stream->size)
+		stream->avail = 0;
+
+	stream->free = stream->size - stream->avail;
+	stream->w_ptr = (char *)stream->addr +
+		(w < stream->size ? w : w - stream->size);
+	stream->r_ptr = (char *)stream->addr +
+		(r < stream->size ? r : r - stream->size);
+}
+
 /**
  * Locks buffer instance for buffers connecting components
  * running on different cores. Buffer parameters will be invalidated
@@ -197,6 +347,10 @@ static inline void buffer_lock(struct comp_buffer *buffer, uint32_t *flags)
 
 	/* invalidate in case something has changed during our wait */
 	dcache_invalidate_region(buffer, sizeof(*buffer));
+
+	/* stream state of lock-free buffers lives in the positions only */
+	if (buffer->spsc)
+		buffer_spsc_sync(buffer);
 }
 
 /**
@@ -239,6 +393,8 @@ static inline void buffer_reset_pos(struct comp_buffer *buffer, void *data)
 
 	/* reset rw pointers and avail/free bytes counters */
 	audio_stream_reset(&buffer->stream);
+	buffer_spsc_reset(buffer);
+	buffer_inplace_sync(buffer);
 
 	/* clear buffer contents */
 	buffer_zero(buffer);
@@ -253,6 +409,7 @@ static inline void buffer_init(struct comp_buffer *buffer, uint32_t size,
 
 	/* addr should be set in alloc function */
 	audio_stream_init(&buffer->stream, buffer->stream.addr, size);
+	buffer_spsc_reset(buffer);
 }
 
 static inline void buffer_reset_params(struct comp_buffer *buffer, void *data)
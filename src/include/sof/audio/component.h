@@ -27,6 +27,7 @@
 #include <sof/lib/dai.h>
 #include <sof/lib/memory.h>
 #include <sof/lib/perf_cnt.h>
+#include <sof/lib/slab.h>
 #include <sof/math/numbers.h>
 #include <sof/schedule/schedule.h>
 #include <sof/sof.h>
@@ -428,6 +429,10 @@ struct comp_dev {
 	bool is_shared;		/**< indicates whether component is shared
 				  *  across cores
 				  */
+	bool inplace;		/**< indicates whether component can write
+				  *  its sink over its source, sample by
+				  *  sample, set in prepare()
+				  */
 	struct tr_ctx tctx;	/**< trace settings */
 
 	/* common runtime configuration for downstream/upstream */
@@ -541,7 +546,7 @@ static inline struct comp_dev *comp_alloc(const struct comp_driver *drv,
 {
 	struct comp_dev *dev = NULL;
 
-	dev = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, bytes);
+	dev = slab_zalloc(SLAB_COMP_DEV, 0, SOF_MEM_CAPS_RAM, bytes);
 	if (!dev)
 		return NULL;
 	dev->size = bytes;
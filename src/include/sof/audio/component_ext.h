@@ -76,7 +76,7 @@ static inline int comp_params_remote(struct comp_dev *dev,
 	struct idc_msg msg = { IDC_MSG_PARAMS, IDC_MSG_PARAMS_EXT(dev->comp.id),
 		dev->comp.core, sizeof(*params), params, };
 
-	return idc_send_msg(&msg, IDC_BLOCKING);
+	return idc_send_msg_wait(&msg);
 }
 
 /** See comp_ops::params */
@@ -151,7 +151,7 @@ static inline int comp_trigger_remote(struct comp_dev *dev, int cmd)
 		IDC_MSG_TRIGGER_EXT(dev->comp.id), dev->comp.core, sizeof(cmd),
 		&cmd, };
 
-	return idc_send_msg(&msg, IDC_BLOCKING);
+	return idc_send_msg_wait(&msg);
 }
 
 /** See comp_ops::trigger */
@@ -175,7 +175,7 @@ static inline int comp_prepare_remote(struct comp_dev *dev)
 	struct idc_msg msg = { IDC_MSG_PREPARE,
 		IDC_MSG_PREPARE_EXT(dev->comp.id), dev->comp.core, };
 
-	return idc_send_msg(&msg, IDC_BLOCKING);
+	return idc_send_msg_wait(&msg);
 }
 
 /** See comp_ops::prepare */
@@ -230,7 +230,7 @@ static inline int comp_reset_remote(struct comp_dev *dev)
 	struct idc_msg msg = { IDC_MSG_RESET,
 		IDC_MSG_RESET_EXT(dev->comp.id), dev->comp.core, };
 
-	return idc_send_msg(&msg, IDC_BLOCKING);
+	return idc_send_msg_wait(&msg);
 }
 
 /**
@@ -10,10 +10,19 @@
 #ifndef __SOF_AUDIO_EQ_IIR_EQ_IIR_H__
 #define __SOF_AUDIO_EQ_IIR_EQ_IIR_H__
 
+#include <sof/math/iir_df2t.h>
+#include <sof/platform.h>
+#include <ipc/stream.h>
+#include <stddef.h>
 #include <stdint.h>
 
 struct audio_stream;
 struct comp_dev;
+struct comp_data_blob_handler;
+struct sof_eq_iir_config;
+
+/** \brief Frames filtered per call of the IIR block functions. */
+#define EQ_IIR_BLOCK_FRAMES	16
 
 /** \brief Type definition for processing function select return value. */
 typedef void (*eq_iir_func)(const struct comp_dev *dev,
@@ -28,4 +37,24 @@ struct eq_iir_func_map {
 	eq_iir_func func;			/**< processing function */
 };
 
+/* IIR component private data */
+struct comp_data {
+	struct iir_state_df2t iir[PLATFORM_MAX_CHANNELS]; /**< filters state */
+	struct comp_data_blob_handler *model_handler;
+	struct sof_eq_iir_config *config;
+	enum sof_ipc_frame source_format;	/**< source frame format */
+	enum sof_ipc_frame sink_format;		/**< sink frame format */
+	int64_t *iir_delay;			/**< pointer to allocated RAM */
+	size_t iir_delay_size;			/**< allocated size */
+	eq_iir_func eq_iir_func;		/**< processing function */
+	int32_t block[PLATFORM_MAX_CHANNELS][EQ_IIR_BLOCK_FRAMES];
+						/**< Q1.31 samples in process */
+};
+
+/** \brief Map of formats with dedicated processing functions. */
+extern const struct eq_iir_func_map fm_configured[];
+
+/** \brief Number of processing functions. */
+extern const size_t fm_configured_count;
+
 #endif /* __SOF_AUDIO_EQ_IIR_EQ_IIR_H__ */
@@ -37,7 +37,7 @@ struct comp_buffer;
 	KPB_NUM_OF_CHANNELS)
 #define KPB_MAX_NO_OF_CLIENTS 2
 #define KPB_NO_OF_HISTORY_BUFFERS 2 /**< no of internal buffers */
-#define KPB_ALLOCATION_STEP 0x100
+#define KPB_ALLOCATION_STEP 0x100 /**< granularity of history buffer blocks */
 #define KPB_NO_OF_MEM_POOLS 3
 #define KPB_BYTES_TO_FRAMES(bytes, sample_width) \
 	(bytes / ((KPB_SAMPLE_CONTAINER_SIZE(sample_width) / 8) * \
@@ -123,12 +123,21 @@ struct draining_data {
 	struct history_buffer *hb;
 	size_t drain_req;
 	uint8_t is_draining_active;
-	size_t sample_width;
 	size_t buffered_while_draining;
-	size_t drain_interval;
+	size_t drain_interval; /**< ticks to the next burst in sync mode
+				 * or when the host buffer is full
+				 */
 	size_t pb_limit; /**< Period bytes limit */
 	struct comp_dev *dev;
 	bool sync_mode_on;
+
+	/* statistics, in platform timer ticks */
+	uint64_t request_time; /**< when the client requested draining */
+	uint64_t start_time; /**< when the task started draining */
+	uint64_t first_burst_time; /**< when the first burst reached host */
+	size_t drained; /**< bytes drained */
+	size_t max_burst; /**< the largest burst in bytes */
+	uint32_t bursts; /**< number of bursts */
 };
 
 struct history_data {
@@ -8,6 +8,66 @@
 #ifndef __SOF_AUDIO_MIXER_H__
 #define __SOF_AUDIO_MIXER_H__
 
+#include <stddef.h>
+#include <stdint.h>
+
+struct audio_stream;
+struct comp_dev;
+
+#if __XCC__
+#include <xtensa/config/core-isa.h>
+#endif
+
+#if __XCC__ && XCHAL_HAVE_HIFI3
+#define MIXER_HIFI3
+#else
+#define MIXER_GENERIC
+#endif
+
+/** \brief Number of samples accumulated at once by the mixers. */
+#define MIXER_BLOCK_SAMPLES	32
+
+/**
+ * \brief Mixer processing function interface.
+ * \param[in,out] dev Mixer base component device.
+ * \param[in,out] sink Destination stream.
+ * \param[in] sources Array of source streams.
+ * \param[in] count Number of source streams.
+ * \param[in] frames Number of frames to process.
+ */
+typedef void (*mixer_func)(struct comp_dev *dev, struct audio_stream *sink,
+			   const struct audio_stream **sources, uint32_t count,
+			   uint32_t frames);
+
+/** \brief Mixer processing functions map. */
+struct mix_func_map {
+	uint16_t frame_fmt;	/**< frame format */
+	mixer_func func;	/**< mixer processing function */
+};
+
+/** \brief Map of formats with dedicated processing functions. */
+extern const struct mix_func_map mix_func_map[];
+
+/** \brief Number of processing functions. */
+extern const size_t mix_count;
+
+/**
+ * \brief Retrieves mixer processing function.
+ * \param[in] frame_fmt Sink stream frame format.
+ * \return Processing function or NULL if format is not supported.
+ */
+static inline mixer_func mixer_get_processing_function(uint16_t frame_fmt)
+{
+	int i;
+
+	for (i = 0; i < mix_count; i++) {
+		if (frame_fmt == mix_func_map[i].frame_fmt)
+			return mix_func_map[i].func;
+	}
+
+	return NULL;
+}
+
 #ifdef UNIT_TEST
 void sys_comp_mixer_init(void);
 #endif
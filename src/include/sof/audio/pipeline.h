@@ -89,6 +89,23 @@ extern struct tr_ctx pipe_tr;
 #define PPL_POSN_OFFSETS \
 	(MAILBOX_STREAM_SIZE / sizeof(struct sof_ipc_stream_posn))
 
+/* copy plan step has no parent, i.e. it's the starting component */
+#define PPL_COPY_STEP_NO_PARENT	-1
+
+/*
+ * Single step of the flattened pipeline copy walk.
+ *
+ * Steps are stored in the execution order of the recursive graph walk.
+ * Each step keeps the index of the step it has been reached from, so the
+ * copy can skip the whole path behind an inactive or stopped component
+ * without walking the graph again.
+ */
+struct pipeline_copy_step {
+	struct comp_dev *comp;	/**< component to be copied */
+	int32_t parent;		/**< index of the parent step */
+	bool run;		/**< runtime, step is executed in this period */
+};
+
 /*
  * Audio pipeline.
  */
@@ -112,6 +129,12 @@ struct pipeline {
 
 	struct list_item list;	/**< list in walk context */
 
+	/* flattened copy walk, built on prepare */
+	struct pipeline_copy_step *copy_steps;
+	uint32_t copy_steps_count;
+	uint32_t copy_dir;		/* walk direction of copy_steps */
+	bool copy_plan_valid;		/* false if graph has changed */
+
 	/* position update */
 	uint32_t posn_offset;		/* position update array offset*/
 	struct ipc_msg *msg;
@@ -194,6 +217,12 @@ static inline bool pipeline_is_same_sched_comp(struct pipeline *current,
 	return current->sched_comp == previous->sched_comp;
 }
 
+/* invalidates flattened copy walk after graph change */
+static inline void pipeline_copy_plan_invalidate(struct pipeline *p)
+{
+	p->copy_plan_valid = false;
+}
+
 /* checks if pipeline is scheduled with timer */
 static inline bool pipeline_is_timer_driven(struct pipeline *p)
 {
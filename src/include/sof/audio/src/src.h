@@ -11,6 +11,15 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#if CONFIG_COMP_SRC_RUNTIME
+/* Limits of the filters designed at prepare time */
+#define SRC_COEF_MAX_TAPS	4096
+#define MAX_FIR_DELAY_SIZE	768
+#define MAX_OUT_DELAY_SIZE	1024
+
+struct src_conv;
+#endif
+
 struct src_param {
 	int fir_s1;
 	int fir_s2;
@@ -26,6 +35,11 @@ struct src_param {
 	int idx_in;
 	int idx_out;
 	int nch;
+	struct src_stage *stage1;
+	struct src_stage *stage2;
+#if CONFIG_COMP_SRC_RUNTIME
+	struct src_conv *conv;	/* filters designed for the current rates */
+#endif
 };
 
 struct src_stage {
@@ -118,6 +132,14 @@ void src_polyphase_stage_cir_s16(struct src_stage_prm *s);
 int src_buffer_lengths(struct src_param *a, int fs_in, int fs_out, int nch,
 		       int source_frames);
 
+void src_param_free(struct src_param *a);
+
+#if CONFIG_COMP_SRC_RUNTIME
+int src_coef_design(struct src_param *a, int fs_in, int fs_out);
+
+void src_coef_free(struct src_param *a);
+#endif
+
 int32_t src_input_rates(void);
 
 int32_t src_output_rates(void);
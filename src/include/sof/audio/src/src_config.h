@@ -58,4 +58,14 @@
 #endif
 #endif
 
+/* The generic filter core keeps a copy of the FIR delay line right after
+ * it so that every sub-filter reads its taps as one linear block. The
+ * HiFi cores use the circular addressing of the load instructions.
+ */
+#if SRC_GENERIC
+#define SRC_FIR_DELAY_COPIES	2
+#else
+#define SRC_FIR_DELAY_COPIES	1
+#endif
+
 #endif /* __SOF_AUDIO_SRC_SRC_CONFIG_H__ */
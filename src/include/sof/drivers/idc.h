@@ -16,9 +16,12 @@
 
 #include <arch/drivers/idc.h>
 #include <platform/drivers/idc.h>
+#include <sof/common.h>
+#include <sof/lib/cpu.h>
 #include <sof/schedule/task.h>
 #include <sof/trace/trace.h>
 #include <user/trace.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 /** \brief IDC send blocking flag. */
@@ -30,6 +33,9 @@
 /** \brief IDC send core power up flag. */
 #define IDC_POWER_UP		2
 
+/** \brief IDC send flag waiting only until the previous message is taken. */
+#define IDC_DOORBELL		3
+
 /** \brief IDC send timeout in microseconds. */
 #define IDC_TIMEOUT	10000
 
@@ -85,6 +91,14 @@
 #define IDC_MSG_RESET		IDC_TYPE(0x8)
 #define IDC_MSG_RESET_EXT(x)	IDC_EXTENSION(x)
 
+/** \brief IDC core load query message. */
+#define IDC_MSG_LOAD		IDC_TYPE(0x9)
+#define IDC_MSG_LOAD_EXT	IDC_EXTENSION(0x0)
+
+/** \brief IDC message ring doorbell. */
+#define IDC_MSG_RING		IDC_TYPE(0xa)
+#define IDC_MSG_RING_EXT	IDC_EXTENSION(0x0)
+
 /** \brief Decodes IDC message type. */
 #define iTS(x)	(((x) >> IDC_TYPE_SHIFT) & IDC_TYPE_MASK)
 
@@ -105,12 +119,45 @@ struct idc_msg {
 	void *payload;		/**< pointer to payload data */
 };
 
+#if CONFIG_IDC_RING
+/** \brief IDC message queued in a ring. */
+struct idc_ring_entry {
+	uint32_t header;		/**< header value */
+	uint32_t extension;		/**< extension value */
+	uint32_t size;			/**< payload size in bytes */
+	int32_t status;			/**< status after execution */
+	struct idc_payload payload;	/**< payload data */
+};
+
+/**
+ * \brief IDC messages from one core to another.
+ *
+ * Only the sending core writes head and only the receiving core writes
+ * tail, so neither side takes a lock. Both count messages from boot and
+ * a message cookie is the head value after posting it. The depth is a
+ * power of two, so entries stay in order when the counters wrap.
+ */
+struct idc_ring {
+	uint32_t head;		/**< messages posted */
+	uint32_t tail;		/**< messages executed */
+	uint32_t doorbell;	/**< doorbell sent and ring not drained yet */
+	uint32_t dropped;	/**< messages not waited for, lost on full ring */
+	struct idc_ring_entry entry[CONFIG_IDC_RING_DEPTH];
+};
+
+STATIC_ASSERT(!(CONFIG_IDC_RING_DEPTH & (CONFIG_IDC_RING_DEPTH - 1)),
+	      idc_ring_depth_not_power_of_two);
+#endif
+
 /** \brief IDC data. */
 struct idc {
 	uint32_t busy_bit_mask;		/**< busy interrupt mask */
 	struct idc_msg received_msg;	/**< received message */
 	struct task idc_task;		/**< IDC processing task */
 	struct idc_payload *payload;
+#if CONFIG_IDC_RING
+	struct idc_ring *ring;		/**< rings of all core pairs */
+#endif
 	int irq;
 };
 
@@ -123,6 +170,119 @@ static inline struct idc_payload *idc_payload_get(struct idc *idc,
 	return idc->payload + core;
 }
 
+#if CONFIG_IDC_RING
+static inline struct idc_ring *idc_ring_get(struct idc *idc,
+					    uint32_t source, uint32_t target)
+{
+	return idc->ring + source * PLATFORM_CORE_COUNT + target;
+}
+
+static inline bool idc_ring_full(const struct idc_ring *ring)
+{
+	return ring->head - ring->tail >= CONFIG_IDC_RING_DEPTH;
+}
+
+/**
+ * \brief Returns entry of a message.
+ * \param[in] ring Ring of the message.
+ * \param[in] cookie Cookie of the message, head value after posting it.
+ * \return Entry of the message.
+ */
+static inline struct idc_ring_entry *idc_ring_entry_get(struct idc_ring *ring,
+							uint32_t cookie)
+{
+	return &ring->entry[(cookie - 1) % CONFIG_IDC_RING_DEPTH];
+}
+
+/**
+ * \brief Marks the doorbell sent, done by the sending core.
+ * \param[in] ring Ring to be drained.
+ * \return True if the doorbell has to be sent, false if the ring is empty
+ *	   or the target core hasn't drained it since the last doorbell.
+ */
+static inline bool idc_ring_bell_set(struct idc_ring *ring)
+{
+	if (ring->doorbell || ring->head == ring->tail)
+		return false;
+
+	ring->doorbell = 1;
+
+	return true;
+}
+
+/**
+ * \brief Clears the doorbell once drained, done by the receiving core.
+ * \param[in] ring Drained ring.
+ * \return True if messages posted while the doorbell was still set have
+ *	   to be drained as well, nobody rings for them.
+ */
+static inline bool idc_ring_bell_clear(struct idc_ring *ring)
+{
+	ring->doorbell = 0;
+
+	return ring->tail != ring->head;
+}
+
+/**
+ * \brief Queues IDC message to the ring of the target core.
+ * \param[in] msg Message, its payload is copied.
+ * \param[out] cookie Cookie to wait for the message with, can be NULL.
+ * \return Error code, -EBUSY if the ring is full and cookie is NULL, the
+ *	   message is then dropped and counted instead of waiting for room.
+ */
+int idc_ring_post(struct idc_msg *msg, uint32_t *cookie);
+
+/**
+ * \brief Rings the doorbell of the target core, unless it is pending.
+ * \param[in] core Target core id.
+ * \return Error code.
+ */
+int idc_ring_flush(uint32_t core);
+
+/**
+ * \brief Waits until the target core executed a queued message.
+ * \param[in] core Target core id.
+ * \param[in] cookie Cookie returned when posting the message.
+ * \return Status of the message, valid until CONFIG_IDC_RING_DEPTH later
+ *	   messages are posted to the same core.
+ */
+int idc_ring_wait(uint32_t core, uint32_t cookie);
+
+/**
+ * \brief Executes all messages queued by the source core.
+ * \param[in] source Id of the core which rang the doorbell.
+ * \return Error code.
+ */
+int idc_ring_drain(uint32_t source);
+
+/**
+ * \brief Drops messages left for this core, e.g. when it was powered down.
+ * \param[in] idc IDC data.
+ */
+void idc_ring_reset(struct idc *idc);
+#endif
+
+/**
+ * \brief Sends IDC message and returns its status once executed.
+ * \param[in] msg Message to send.
+ * \return Status of the message or error code.
+ */
+static inline int idc_send_msg_wait(struct idc_msg *msg)
+{
+#if CONFIG_IDC_RING
+	uint32_t cookie;
+	int ret;
+
+	ret = idc_ring_post(msg, &cookie);
+	if (ret < 0)
+		return ret;
+
+	return idc_ring_wait(msg->core, cookie);
+#else
+	return idc_send_msg(msg, IDC_BLOCKING);
+#endif
+}
+
 void idc_enable_interrupts(int target_core, int source_core);
 
 void idc_free(void);
@@ -133,6 +293,8 @@ enum task_state idc_do_cmd(void *data);
 
 void idc_cmd(struct idc_msg *msg);
 
+int idc_cmd_run(struct idc_msg *msg);
+
 int idc_wait_in_blocking_mode(uint32_t target_core, bool (*cond)(int));
 
 int idc_msg_status_get(uint32_t core);
@@ -97,6 +97,11 @@ struct ipc {
 
 	struct list_item comp_list;	/* list of component devices */
 
+#if CONFIG_IPC_PIPELINE_PLACEMENT
+	/* cores chosen for pipelines, used by primary core only */
+	struct list_item placement_list;
+#endif
+
 	/* processing task */
 	struct task ipc_task;
 
@@ -340,6 +345,87 @@ void ipc_cmd(struct sof_ipc_cmd_hdr *hdr);
  */
 int ipc_process_on_core(uint32_t core);
 
+/**
+ * \brief Measured demand of the low latency tasks of a core.
+ * @param[in] core Core id, queried over IDC if not the current core.
+ * @return Thousands of cycles per second, 0 for a disabled core.
+ */
+uint32_t ipc_core_load(uint32_t core);
+
+#if CONFIG_IPC_PIPELINE_PLACEMENT
+/**
+ * \brief Places a new component or buffer.
+ *
+ * Objects of a pipeline without a core set by the topology wait until the
+ * pipeline itself is created, the scheduling component tells its core.
+ * @param[in] ipc IPC data.
+ * @param[in,out] comp Object IPC, its core is updated if known.
+ * @return 1 if the object waits for its pipeline, 0 if it is created now
+ *	   on comp->core, error code otherwise.
+ */
+int ipc_placement_object(struct ipc *ipc, struct sof_ipc_comp *comp);
+
+/**
+ * \brief Places a new pipeline and creates its waiting objects.
+ *
+ * A pipeline goes to the core of its scheduling component, so pipelines
+ * scheduled by a component of another pipeline are grouped with it.
+ * Pipelines scheduling themselves pick the least loaded enabled core.
+ * @param[in] ipc IPC data.
+ * @param[in,out] pipe_desc Pipeline IPC, its core is updated.
+ * @return 0 if successful, error code otherwise.
+ */
+int ipc_placement_pipeline(struct ipc *ipc, struct sof_ipc_pipe_new *pipe_desc);
+
+/** \brief Frees a waiting object, returns false if it isn't one. */
+bool ipc_placement_object_free(struct ipc *ipc, uint32_t id);
+
+/** \brief Releases the placement of a freed pipeline. */
+void ipc_placement_free(struct ipc *ipc, uint32_t comp_id);
+
+/** \brief Releases the placement of a pipeline not created. */
+void ipc_placement_drop(struct ipc *ipc, uint32_t pipeline_id);
+
+/** \brief Reserved demand of the pipelines placed on a core. */
+uint32_t ipc_placement_reserved(struct ipc *ipc, uint32_t core);
+
+/** \brief Number of the pipelines placed on a core. */
+uint32_t ipc_placement_count(struct ipc *ipc, uint32_t core);
+#else
+static inline int ipc_placement_object(struct ipc *ipc,
+				       struct sof_ipc_comp *comp)
+{
+	return 0;
+}
+
+static inline int ipc_placement_pipeline(struct ipc *ipc,
+					 struct sof_ipc_pipe_new *pipe_desc)
+{
+	return 0;
+}
+
+static inline bool ipc_placement_object_free(struct ipc *ipc, uint32_t id)
+{
+	return false;
+}
+
+static inline void ipc_placement_free(struct ipc *ipc, uint32_t comp_id) { }
+
+static inline void ipc_placement_drop(struct ipc *ipc, uint32_t pipeline_id)
+{
+}
+
+static inline uint32_t ipc_placement_reserved(struct ipc *ipc, uint32_t core)
+{
+	return 0;
+}
+
+static inline uint32_t ipc_placement_count(struct ipc *ipc, uint32_t core)
+{
+	return 0;
+}
+#endif
+
 /**
  * \brief Initialise IPC hardware for polling mode.
  * @return 0 if successful error code otherwise.
@@ -51,6 +51,7 @@ enum mem_zone {
 	SOF_MEM_ZONE_SYS_RUNTIME,	/**< System-runtime zone */
 	SOF_MEM_ZONE_RUNTIME,		/**< Runtime zone */
 	SOF_MEM_ZONE_BUFFER,		/**< Buffer zone */
+	SOF_MEM_ZONE_COUNT,		/**< Number of zones */
 };
 
 /** \name Heap zone flags
@@ -131,6 +132,22 @@ static inline void *rbrealloc(void *ptr, uint32_t flags, uint32_t caps,
 			       PLATFORM_DCACHE_ALIGN);
 }
 
+/**
+ * Gets the size of the largest block rballoc_align() can currently return.
+ * @param caps Capabilities, see SOF_MEM_CAPS_...
+ * @param alignment Alignment in bytes.
+ * @return Size in bytes, 0 if no buffer heap has the capabilities.
+ */
+size_t rballoc_max_size(uint32_t caps, uint32_t alignment);
+
+/**
+ * Gets the heap space taken by a block from rballoc_align(), that is the
+ * requested size rounded up to whole heap blocks, alignment included.
+ * @param ptr Pointer to the memory block.
+ * @return Size in bytes, 0 if not known.
+ */
+size_t rballoc_heap_size(void *ptr);
+
 /**
  * Frees the memory block.
  * @param ptr Pointer to the memory block.
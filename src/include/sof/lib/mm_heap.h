@@ -12,7 +12,9 @@
 #include <sof/common.h>
 #include <sof/lib/alloc.h>
 #include <sof/lib/cache.h>
+#include <sof/lib/cpu.h>
 #include <sof/lib/memory.h>
+#include <sof/lib/slab.h>
 #include <sof/sof.h>
 #include <sof/spinlock.h>
 
@@ -55,6 +57,29 @@ struct mm_heap {
 	struct mm_info info;
 };
 
+/* allocation statistics of a zone */
+struct mm_zone_stats {
+	uint32_t allocs;		/* successful allocations */
+	uint32_t failures;		/* failed allocations */
+	uint32_t alloc_cycles_max;	/* longest allocation incl. lock */
+};
+
+/* allocator statistics, slab cache hits are accounted in the caches */
+struct mm_stats {
+	struct mm_zone_stats zone[SOF_MEM_ZONE_COUNT];
+	uint32_t frees;			/* frees of heap memory */
+	uint32_t free_cycles_max;	/* longest free incl. lock */
+};
+
+/* state of a single heap */
+struct mm_heap_info {
+	uint32_t caps;
+	uint32_t size;		/* size in bytes */
+	uint32_t used;		/* bytes in use */
+	uint32_t free;		/* free bytes */
+	uint32_t max_free;	/* largest contiguous free run */
+};
+
 /* heap block memory map */
 struct mm {
 	/* system heap - used during init cannot be freed */
@@ -65,8 +90,13 @@ struct mm {
 	struct mm_heap runtime[PLATFORM_HEAP_RUNTIME];
 	/* general component buffer heap */
 	struct mm_heap buffer[PLATFORM_HEAP_BUFFER];
+#if CONFIG_SLAB_CACHE
+	/* object caches in front of the runtime heap */
+	struct slab_cache slab[PLATFORM_CORE_COUNT][SLAB_CACHE_COUNT];
+#endif
 
 	struct mm_info total;
+	struct mm_stats stats;
 	uint32_t heap_trace_updated;	/* updates that can be presented */
 	spinlock_t lock;	/* all allocs and frees are atomic */
 };
@@ -86,6 +116,10 @@ void free_heap(enum mem_zone zone);
 void heap_trace_all(int force);
 void heap_trace(struct mm_heap *heap, int size);
 
+/* statistics, heap_info() returns -EINVAL past the last heap of the zone */
+void heap_stats_get(struct mm_stats *stats);
+int heap_info(enum mem_zone zone, int index, struct mm_heap_info *info);
+
 /* retrieve memory map pointer */
 static inline struct mm *memmap_get(void)
 {
@@ -64,6 +64,7 @@ void notifier_unregister(void *receiver, void *caller, enum notify_id type);
 void notifier_unregister_all(void *receiver, void *caller);
 
 void notifier_notify_remote(void);
+void notifier_notify_remote_data(struct notify_data *notify_data);
 void notifier_event(const void *caller, enum notify_id type, uint32_t core_mask,
 		    void *data, uint32_t data_size);
 
@@ -0,0 +1,104 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2020 Intel Corporation. All rights reserved.
+ */
+
+/**
+ * \file include/sof/lib/slab.h
+ * \brief Per core object caches of the runtime heap
+ */
+
+#ifndef __SOF_LIB_SLAB_H__
+#define __SOF_LIB_SLAB_H__
+
+#include <sof/lib/alloc.h>
+#include <sof/spinlock.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** \brief Object caches, sized after the objects created on topology load. */
+enum slab_cache_type {
+	SLAB_IPC_COMP_DEV = 0,	/**< struct ipc_comp_dev */
+	SLAB_TASK,		/**< struct pipeline_task */
+	SLAB_BUFFER,		/**< struct comp_buffer */
+	SLAB_COMP_DEV,		/**< struct comp_dev with its IPC description */
+	SLAB_CACHE_COUNT,
+};
+
+/* the free objects are tracked in a single word bitmap */
+#define SLAB_MAX_OBJECTS	32
+
+/**
+ * \brief Cache of equally sized objects.
+ *
+ * The objects are carved from a single buffer heap allocation made on the
+ * first use of the cache, so both alloc and free are a bitmap operation.
+ * Objects are never given back to the heap.
+ */
+struct slab_cache {
+	uint32_t obj_size;	/**< object size, cache line aligned */
+	uint32_t count;		/**< number of objects */
+	uintptr_t base;		/**< address of the first object */
+	uint32_t free;		/**< bitmap of free objects */
+	spinlock_t lock;	/**< frees can come from other cores */
+
+	/* statistics */
+	uint32_t allocs;	/**< allocations served by the cache */
+	uint32_t misses;	/**< allocations left to the heap */
+	uint32_t peak;		/**< max number of objects in use */
+};
+
+/** \brief Memory held by the caches of all cores. */
+struct slab_info {
+	uint32_t size;		/**< bytes taken from the buffer heap */
+	uint32_t used;		/**< bytes of the objects in use */
+};
+
+struct mm;
+
+#if CONFIG_SLAB_CACHE
+
+void slab_init(struct mm *memmap);
+
+/**
+ * \brief Allocates a zeroed object from the cache of its type on the
+ *	  current core, from the runtime heap when the cache is full.
+ * \param[in] type Object type.
+ * \param[in] flags Flags, see SOF_MEM_FLAG_...
+ * \param[in] caps Capabilities, see SOF_MEM_CAPS_...
+ * \param[in] bytes Size in bytes.
+ * \return Pointer to the object, freed with rfree().
+ */
+void *slab_zalloc(enum slab_cache_type type, uint32_t flags, uint32_t caps,
+		  size_t bytes);
+
+/**
+ * \brief Returns an object to its cache.
+ * \param[in] ptr Cached address of the memory.
+ * \return True if the memory belonged to a cache.
+ */
+bool slab_free(void *ptr);
+
+void slab_info_get(struct slab_info *info);
+
+void slab_trace(void);
+
+#else
+
+static inline void *slab_zalloc(enum slab_cache_type type, uint32_t flags,
+				uint32_t caps, size_t bytes)
+{
+	return rzalloc(SOF_MEM_ZONE_RUNTIME, flags, caps, bytes);
+}
+
+static inline void slab_info_get(struct slab_info *info)
+{
+	info->size = 0;
+	info->used = 0;
+}
+
+#endif
+
+#endif /* __SOF_LIB_SLAB_H__ */
@@ -42,5 +42,9 @@ void fir_init_delay(struct fir_state_32x16 *fir, int32_t **data);
 
 int32_t fir_32x16(struct fir_state_32x16 *fir, int32_t x);
 
+/* Filters frames contiguous Q1.31 samples, x and y may be the same */
+void fir_32x16_block(struct fir_state_32x16 *fir, const int32_t *x,
+		     int32_t *y, int frames);
+
 #endif
 #endif /* __SOF_MATH_FIR_GENERIC_H__ */
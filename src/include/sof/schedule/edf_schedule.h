@@ -11,6 +11,7 @@
 #include <sof/schedule/task.h>
 #include <sof/trace/trace.h>
 #include <user/trace.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #define edf_sch_set_pdata(task, data) \
@@ -18,14 +19,72 @@
 
 #define edf_sch_get_pdata(task) task->priv_data
 
+/* EDF task statistics, times are in platform timer ticks */
+struct edf_task_stats {
+	uint32_t runs;		/* runs started */
+	uint32_t missed;	/* runs completed after the deadline */
+	uint32_t latency_max;	/* longest time from queued to started */
+};
+
 struct edf_task_pdata {
 	void *ctx;
+	uint64_t deadline;	/* deadline of the queued run */
+	uint64_t ready;		/* time the run was queued */
+	uint32_t seq;		/* queueing order among equal deadlines */
+	int queue_idx;		/* position in the ready queue */
+	struct edf_task_stats stats;
+};
+
+/* Ready queue, a binary min-heap ordered by deadline and queueing order */
+struct edf_queue {
+	struct task **tasks;
+	int count;		/* queued tasks */
+	int size;		/* capacity */
+	uint32_t seq;		/* next queueing order number */
 };
 
+/* EDF task information reported by schedule_edf_task_stats() */
+struct edf_task_info {
+	const struct sof_uuid_entry *uid;
+	enum task_state state;
+	struct edf_task_stats stats;
+};
+
+/* deadlines that are not points in time can't be missed */
+static inline bool edf_deadline_is_time(uint64_t deadline)
+{
+	return deadline != SOF_TASK_DEADLINE_NOW &&
+		deadline != SOF_TASK_DEADLINE_ALMOST_IDLE &&
+		deadline != SOF_TASK_DEADLINE_IDLE;
+}
+
+static inline struct task *edf_queue_first(struct edf_queue *queue)
+{
+	return queue->count ? queue->tasks[0] : NULL;
+}
+
+int edf_queue_reserve(struct edf_queue *queue, int size);
+
+void edf_queue_free(struct edf_queue *queue);
+
+void edf_queue_insert(struct edf_queue *queue, struct task *task,
+		      uint64_t deadline);
+
+void edf_queue_remove(struct edf_queue *queue, struct task *task);
+
+void edf_task_stats_start(struct task *task, uint64_t now);
+
+void edf_task_stats_complete(struct task *task, uint64_t now);
+
 int scheduler_init_edf(void);
 
 int schedule_task_init_edf(struct task *task, const struct sof_uuid_entry *uid,
 			   const struct task_ops *ops,
 			   void *data, uint16_t core, uint32_t flags);
 
+/* Fills info of up to count EDF tasks of the current core and returns
+ * the number of tasks filled.
+ */
+int schedule_edf_task_stats(struct edf_task_info *info, int count);
+
 #endif /* __SOF_SCHEDULE_EDF_SCHEDULE_H__ */
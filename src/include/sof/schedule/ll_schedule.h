@@ -28,8 +28,28 @@ extern struct tr_ctx ll_tr;
 
 #define ll_sch_get_pdata(task) ((task)->priv_data)
 
+/* LL task run statistics, in DSP cycles */
+struct ll_task_stats {
+	uint32_t runs;		/* runs of the task */
+	uint32_t overruns;	/* runs longer than the budget */
+	uint32_t cycles_avg;	/* moving average of a run */
+	uint32_t cycles_peak;	/* longest run */
+};
+
 struct ll_task_pdata {
 	uint64_t period;
+	uint32_t id;		/* owner id reported with the statistics */
+	uint32_t budget_hint;	/* cycles per run given by the owner */
+	uint32_t budget;	/* cycles per run, the period without a hint */
+	struct ll_task_stats stats;
+};
+
+/* LL task information reported by schedule_ll_task_stats() */
+struct ll_task_info {
+	const struct sof_uuid_entry *uid;
+	uint32_t id;
+	uint32_t budget;
+	struct ll_task_stats stats;
 };
 
 int scheduler_init_ll(struct ll_schedule_domain *domain);
@@ -39,4 +59,21 @@ int schedule_task_init_ll(struct task *task,
 			  uint16_t priority, enum task_state (*run)(void *data),
 			  void *data, uint16_t core, uint32_t flags);
 
+/* Sets the owner id and the cycle budget of a run of the task, 0 budgets
+ * the whole period at the current DSP clock.
+ */
+void schedule_task_budget_ll(struct task *task, uint32_t id, uint32_t budget);
+
+/* Fills info of up to count scheduled tasks of the LL scheduler type on
+ * the current core and returns the number of tasks filled.
+ */
+int schedule_ll_task_stats(uint16_t type, struct ll_task_info *info,
+			   int count);
+
+/* Demand of the scheduled LL tasks of the current core in thousands of
+ * cycles per second. Tasks that did not run yet count with their budget
+ * hint.
+ */
+uint32_t schedule_ll_load(void);
+
 #endif /* __SOF_SCHEDULE_LL_SCHEDULE_H__ */
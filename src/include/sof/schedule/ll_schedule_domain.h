@@ -50,9 +50,16 @@ struct ll_schedule_domain {
 	int type;			/**< domain type */
 	int clk;			/**< source clock */
 	bool synchronous;		/**< are tasks should be synchronous */
+	bool multi_rate;		/**< tasks start on their period grid
+					  *  and idle ticks are skipped
+					  */
 	void *priv_data;		/**< pointer to private data */
 	bool registered[PLATFORM_CORE_COUNT];		/**< registered cores */
 	bool enabled[PLATFORM_CORE_COUNT];		/**< enabled cores */
+	uint64_t next_tick[PLATFORM_CORE_COUNT];	/**< earliest task start
+							  *  per core, 0 if
+							  *  unknown
+							  */
 	const struct ll_schedule_domain_ops *ops;	/**< domain ops */
 };
 
@@ -164,6 +171,36 @@ static inline bool domain_is_pending(struct ll_schedule_domain *domain,
 	return ret;
 }
 
+/* earliest task start over all cores, 0 if unknown, domain_set() callers
+ * hold domain->lock which the cores take to update their next tick
+ */
+static inline uint64_t domain_next_tick(struct ll_schedule_domain *domain)
+{
+	uint64_t next = 0;
+	int i;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++)
+		if (domain->next_tick[i] &&
+		    (!next || domain->next_tick[i] < next))
+			next = domain->next_tick[i];
+
+	return next;
+}
+
+/* ticks from now to the requested tick, a request already overshot or
+ * not started yet waits no longer than from its start
+ */
+static inline uint64_t domain_ticks_delta(uint64_t req, uint64_t start,
+					  uint64_t now)
+{
+	uint64_t delta = req - now;
+
+	if (delta > req - start)
+		delta = req - start;
+
+	return delta;
+}
+
 struct ll_schedule_domain *timer_domain_init(struct timer *timer, int clk,
 					     uint64_t timeout);
 
@@ -30,10 +30,14 @@
 #include <sof/lib/dma.h>
 #include <sof/lib/mailbox.h>
 #include <sof/lib/memory.h>
+#include <sof/lib/mm_heap.h>
 #include <sof/lib/pm_runtime.h>
+#include <sof/lib/slab.h>
 #include <sof/list.h>
 #include <sof/math/numbers.h>
 #include <sof/platform.h>
+#include <sof/schedule/edf_schedule.h>
+#include <sof/schedule/ll_schedule.h>
 #include <sof/schedule/schedule.h>
 #include <sof/schedule/task.h>
 #include <sof/spinlock.h>
@@ -42,6 +46,7 @@
 #include <sof/trace/trace.h>
 #include <ipc/control.h>
 #include <ipc/dai.h>
+#include <ipc/debug.h>
 #include <ipc/header.h>
 #include <ipc/pm.h>
 #include <ipc/stream.h>
@@ -615,6 +620,7 @@ static int ipc_pm_core_enable(uint32_t header)
 {
 	struct sof_ipc_pm_core_config pm_core_config;
 	int ret = 0;
+	int err;
 	int i = 0;
 
 	/* copy message with ABI safe method */
@@ -624,11 +630,20 @@ static int ipc_pm_core_enable(uint32_t header)
 		pm_core_config.enable_mask);
 
 	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
-		if (i != PLATFORM_PRIMARY_CORE_ID) {
-			if (pm_core_config.enable_mask & (1 << i))
-				ret = cpu_enable_core(i);
-			else
-				cpu_disable_core(i);
+		if (i == PLATFORM_PRIMARY_CORE_ID)
+			continue;
+
+		if (pm_core_config.enable_mask & (1 << i)) {
+			err = cpu_enable_core(i);
+			if (err < 0)
+				ret = err;
+		} else if (ipc_placement_count(ipc_get(), i)) {
+			/* pipelines placed there would stop running */
+			tr_err(&ipc_tr, "ipc: pm core %d has pipelines placed, not disabled",
+			       i);
+			ret = -EBUSY;
+		} else {
+			cpu_disable_core(i);
 		}
 	}
 
@@ -1115,6 +1130,18 @@ static int ipc_glb_tplg_comp_new(uint32_t header)
 	};
 	int ret;
 
+	/* pick the core of the pipeline */
+	if (!cpu_is_secondary(cpu_get_id())) {
+		ret = ipc_placement_object(ipc, comp);
+		platform_shared_commit(comp, comp->hdr.size);
+		if (ret < 0)
+			return ret;
+
+		/* created with its pipeline */
+		if (ret > 0)
+			goto reply;
+	}
+
 	/* check core */
 	if (!cpu_is_me(comp->core))
 		return ipc_process_on_core(comp->core);
@@ -1130,6 +1157,7 @@ static int ipc_glb_tplg_comp_new(uint32_t header)
 		return ret;
 	}
 
+reply:
 	/* write component values to the outbox */
 	mailbox_hostbox_write(0, &reply, sizeof(reply));
 
@@ -1151,6 +1179,20 @@ static int ipc_glb_tplg_buffer_new(uint32_t header)
 	/* copy message with ABI safe method */
 	IPC_COPY_CMD(ipc_buffer, ipc->comp_data);
 
+	/* pick the core of the pipeline */
+	if (!cpu_is_secondary(cpu_get_id())) {
+		ret = ipc_placement_object(ipc, ipc->comp_data);
+		ipc_buffer.comp.core =
+			((struct sof_ipc_comp *)ipc->comp_data)->core;
+		platform_shared_commit(ipc->comp_data, ipc_buffer.comp.hdr.size);
+		if (ret < 0)
+			return ret;
+
+		/* created with its pipeline */
+		if (ret > 0)
+			goto reply;
+	}
+
 	/* check core */
 	if (!cpu_is_me(ipc_buffer.comp.core))
 		return ipc_process_on_core(ipc_buffer.comp.core);
@@ -1167,6 +1209,7 @@ static int ipc_glb_tplg_buffer_new(uint32_t header)
 		return ret;
 	}
 
+reply:
 	/* write component values to the outbox */
 	mailbox_hostbox_write(0, &reply, sizeof(reply));
 
@@ -1188,9 +1231,30 @@ static int ipc_glb_tplg_pipe_new(uint32_t header)
 	/* copy message with ABI safe method */
 	IPC_COPY_CMD(ipc_pipeline, ipc->comp_data);
 
+	/* pick the core of the pipeline, its waiting objects are created
+	 * through the mailbox copy, so restore the pipeline after
+	 */
+	if (!cpu_is_secondary(cpu_get_id())) {
+		ret = ipc_placement_pipeline(ipc, &ipc_pipeline);
+		if (ret < 0)
+			return ret;
+
+		ret = memcpy_s(ipc->comp_data, SOF_IPC_MSG_MAX_SIZE,
+			       &ipc_pipeline, sizeof(ipc_pipeline));
+		assert(!ret);
+		platform_shared_commit(ipc->comp_data, ipc_pipeline.hdr.size);
+	}
+
 	/* check core */
-	if (!cpu_is_me(ipc_pipeline.core))
-		return ipc_process_on_core(ipc_pipeline.core);
+	if (!cpu_is_me(ipc_pipeline.core)) {
+		ret = ipc_process_on_core(ipc_pipeline.core);
+
+		/* the other core reports the failure to the host */
+		if (!ipc_get_comp_by_id(ipc, ipc_pipeline.comp_id))
+			ipc_placement_drop(ipc, ipc_pipeline.pipeline_id);
+
+		return ret;
+	}
 
 	tr_dbg(&ipc_tr, "ipc: pipe %d -> new", ipc_pipeline.pipeline_id);
 
@@ -1199,6 +1263,8 @@ static int ipc_glb_tplg_pipe_new(uint32_t header)
 	if (ret < 0) {
 		tr_err(&ipc_tr, "ipc: pipe %d creation failed %d",
 		       ipc_pipeline.pipeline_id, ret);
+		if (!cpu_is_secondary(cpu_get_id()))
+			ipc_placement_drop(ipc, ipc_pipeline.pipeline_id);
 		return ret;
 	}
 
@@ -1243,12 +1309,20 @@ static int ipc_glb_tplg_free(uint32_t header,
 
 	tr_info(&ipc_tr, "ipc: comp %d -> free", ipc_free.id);
 
+	/* object still waiting for its pipeline */
+	if (!cpu_is_secondary(cpu_get_id()) &&
+	    ipc_placement_object_free(ipc, ipc_free.id))
+		return 0;
+
 	/* free the object */
 	ret = free_func(ipc, ipc_free.id);
 
 	if (ret < 0) {
 		tr_err(&ipc_tr, "ipc: comp %d free failed %d",
 		       ipc_free.id, ret);
+	} else if (free_func == ipc_pipeline_free &&
+		   !cpu_is_secondary(cpu_get_id())) {
+		ipc_placement_free(ipc, ipc_free.id);
 	}
 
 	return ret;
@@ -1281,6 +1355,223 @@ static int ipc_glb_tplg_message(uint32_t header)
 	}
 }
 
+/* IPC zone numbers are the ones of enum mem_zone */
+STATIC_ASSERT(SOF_IPC_DEBUG_MEM_ZONE_COUNT == SOF_MEM_ZONE_COUNT,
+	      debug_mem_zones_match);
+
+/* heaps are listed from the buffer zone down while they fit the reply */
+static int ipc_debug_mem_stats(void)
+{
+	static const enum mem_zone zones[] = {
+		SOF_MEM_ZONE_BUFFER, SOF_MEM_ZONE_RUNTIME,
+		SOF_MEM_ZONE_SYS_RUNTIME, SOF_MEM_ZONE_SYS,
+	};
+	struct sof_ipc_debug_mem_stats *reply = ipc_get()->comp_data;
+	size_t max_size = MIN(MAILBOX_HOSTBOX_SIZE, SOF_IPC_MSG_MAX_SIZE);
+	uint32_t max_heaps = (max_size - sizeof(*reply)) /
+		sizeof(reply->heaps[0]);
+	struct sof_ipc_debug_mem_heap *elem;
+	struct mm_heap_info info;
+	struct slab_info slab;
+	struct mm_stats stats;
+	int i;
+	int j;
+
+	heap_stats_get(&stats);
+	slab_info_get(&slab);
+
+	memset(reply, 0, sizeof(*reply));
+	reply->frees = stats.frees;
+	reply->free_cycles_max = stats.free_cycles_max;
+	reply->slab_size = slab.size;
+	reply->slab_used = slab.used;
+
+	for (i = 0; i < SOF_IPC_DEBUG_MEM_ZONE_COUNT; i++) {
+		reply->zones[i].allocs = stats.zone[i].allocs;
+		reply->zones[i].failures = stats.zone[i].failures;
+		reply->zones[i].alloc_cycles_max =
+			stats.zone[i].alloc_cycles_max;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(zones); i++) {
+		for (j = 0; reply->num_heaps < max_heaps &&
+		     !heap_info(zones[i], j, &info); j++) {
+			elem = &reply->heaps[reply->num_heaps++];
+			elem->zone = zones[i];
+			elem->index = j;
+			elem->caps = info.caps;
+			elem->size = info.size;
+			elem->used = info.used;
+			elem->free = info.free;
+			elem->max_free = info.max_free;
+		}
+	}
+
+	reply->rhdr.hdr.cmd = SOF_IPC_GLB_REPLY;
+	reply->rhdr.hdr.size = sizeof(*reply) +
+		reply->num_heaps * sizeof(reply->heaps[0]);
+
+	mailbox_hostbox_write(0, reply, reply->rhdr.hdr.size);
+
+	return 1;
+}
+
+/* EDF tasks of the core handling IPC, while they fit the reply */
+static int ipc_debug_edf_stats(void)
+{
+	struct sof_ipc_debug_edf_stats *reply = ipc_get()->comp_data;
+	size_t max_size = MIN(MAILBOX_HOSTBOX_SIZE, SOF_IPC_MSG_MAX_SIZE);
+	int max_tasks = (max_size - sizeof(*reply)) /
+		sizeof(reply->tasks[0]);
+	struct sof_ipc_debug_edf_task *elem;
+	struct edf_task_info *info;
+	int count;
+	int i;
+
+	info = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+		       max_tasks * sizeof(*info));
+	if (!info) {
+		tr_err(&ipc_tr, "ipc_debug_edf_stats(): out of memory");
+		return -ENOMEM;
+	}
+
+	count = schedule_edf_task_stats(info, max_tasks);
+
+	memset(reply, 0, sizeof(*reply));
+	reply->num_tasks = count;
+
+	for (i = 0; i < count; i++) {
+		elem = &reply->tasks[i];
+		memset(elem, 0, sizeof(*elem));
+		elem->uid = (uint32_t)(uintptr_t)info[i].uid;
+		elem->state = info[i].state;
+		elem->runs = info[i].stats.runs;
+		elem->missed = info[i].stats.missed;
+		elem->latency_max = info[i].stats.latency_max;
+	}
+
+	rfree(info);
+
+	reply->rhdr.hdr.cmd = SOF_IPC_GLB_REPLY;
+	reply->rhdr.hdr.size = sizeof(*reply) +
+		count * sizeof(reply->tasks[0]);
+
+	mailbox_hostbox_write(0, reply, reply->rhdr.hdr.size);
+
+	return 1;
+}
+
+/* LL tasks of the core handling IPC, while they fit the reply */
+static int ipc_debug_ll_stats(void)
+{
+	static const uint16_t types[SOF_IPC_DEBUG_LL_SCHED_COUNT] = {
+		[SOF_IPC_DEBUG_LL_SCHED_TIMER] = SOF_SCHEDULE_LL_TIMER,
+		[SOF_IPC_DEBUG_LL_SCHED_DMA] = SOF_SCHEDULE_LL_DMA,
+	};
+	struct sof_ipc_debug_ll_stats *reply = ipc_get()->comp_data;
+	size_t max_size = MIN(MAILBOX_HOSTBOX_SIZE, SOF_IPC_MSG_MAX_SIZE);
+	int max_tasks = (max_size - sizeof(*reply)) /
+		sizeof(reply->tasks[0]);
+	struct sof_ipc_debug_ll_task *elem;
+	struct ll_task_info *info;
+	int count;
+	int i;
+	int j;
+
+	info = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+		       max_tasks * sizeof(*info));
+	if (!info) {
+		tr_err(&ipc_tr, "ipc_debug_ll_stats(): out of memory");
+		return -ENOMEM;
+	}
+
+	memset(reply, 0, sizeof(*reply));
+
+	for (i = 0; i < ARRAY_SIZE(types); i++) {
+		count = schedule_ll_task_stats(types[i], info,
+					       max_tasks - reply->num_tasks);
+
+		for (j = 0; j < count; j++) {
+			elem = &reply->tasks[reply->num_tasks++];
+			elem->uid = (uint32_t)(uintptr_t)info[j].uid;
+			elem->sched = i;
+			elem->id = info[j].id;
+			elem->budget = info[j].budget;
+			elem->runs = info[j].stats.runs;
+			elem->overruns = info[j].stats.overruns;
+			elem->cycles_avg = info[j].stats.cycles_avg;
+			elem->cycles_peak = info[j].stats.cycles_peak;
+		}
+	}
+
+	rfree(info);
+
+	reply->rhdr.hdr.cmd = SOF_IPC_GLB_REPLY;
+	reply->rhdr.hdr.size = sizeof(*reply) +
+		reply->num_tasks * sizeof(reply->tasks[0]);
+
+	mailbox_hostbox_write(0, reply, reply->rhdr.hdr.size);
+
+	return 1;
+}
+
+static int ipc_debug_core_load(void)
+{
+	struct ipc *ipc = ipc_get();
+	struct sof_ipc_debug_core_load_stats *reply = ipc->comp_data;
+	struct sof_ipc_debug_core_load *elem;
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+	int i;
+
+	memset(reply, 0, sizeof(*reply) +
+	       PLATFORM_CORE_COUNT * sizeof(reply->cores[0]));
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		elem = &reply->cores[i];
+		elem->core = i;
+		elem->enabled = cpu_is_core_enabled(i);
+		if (elem->enabled)
+			elem->load_kcps = ipc_core_load(i);
+		elem->reserved_kcps = ipc_placement_reserved(ipc, i);
+	}
+
+	list_for_item(clist, &ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type == COMP_TYPE_PIPELINE &&
+		    icd->core < PLATFORM_CORE_COUNT)
+			reply->cores[icd->core].pipelines++;
+	}
+
+	reply->num_cores = PLATFORM_CORE_COUNT;
+	reply->rhdr.hdr.cmd = SOF_IPC_GLB_REPLY;
+	reply->rhdr.hdr.size = sizeof(*reply) +
+		reply->num_cores * sizeof(reply->cores[0]);
+
+	mailbox_hostbox_write(0, reply, reply->rhdr.hdr.size);
+
+	return 1;
+}
+
+static int ipc_glb_debug(uint32_t header)
+{
+	uint32_t cmd = iCS(header);
+
+	switch (cmd) {
+	case SOF_IPC_DEBUG_MEM_STATS:
+		return ipc_debug_mem_stats();
+	case SOF_IPC_DEBUG_EDF_STATS:
+		return ipc_debug_edf_stats();
+	case SOF_IPC_DEBUG_LL_STATS:
+		return ipc_debug_ll_stats();
+	case SOF_IPC_DEBUG_CORE_LOAD:
+		return ipc_debug_core_load();
+	default:
+		tr_err(&ipc_tr, "ipc: unknown debug header 0x%x", header);
+		return -EINVAL;
+	}
+}
+
 #if CONFIG_DEBUG
 static int ipc_glb_test_message(uint32_t header)
 {
@@ -1345,6 +1636,9 @@ void ipc_cmd(struct sof_ipc_cmd_hdr *hdr)
 	case SOF_IPC_GLB_PROBE:
 		ret = ipc_glb_probe(hdr->cmd);
 		break;
+	case SOF_IPC_GLB_DEBUG:
+		ret = ipc_glb_debug(hdr->cmd);
+		break;
 #if CONFIG_DEBUG
 	case SOF_IPC_GLB_TEST:
 		ret = ipc_glb_test_message(hdr->cmd);
@@ -15,8 +15,10 @@
 #include <sof/lib/cache.h>
 #include <sof/lib/cpu.h>
 #include <sof/lib/mailbox.h>
+#include <sof/lib/slab.h>
 #include <sof/list.h>
 #include <sof/platform.h>
+#include <sof/schedule/ll_schedule.h>
 #include <sof/sof.h>
 #include <sof/spinlock.h>
 #include <ipc/dai.h>
@@ -62,6 +64,24 @@ int ipc_process_on_core(uint32_t core)
 	return 1;
 }
 
+uint32_t ipc_core_load(uint32_t core)
+{
+	struct idc_msg msg = { .header = IDC_MSG_LOAD,
+			       .extension = IDC_MSG_LOAD_EXT, .core = core, };
+	int ret;
+
+	if (cpu_is_me(core))
+		return schedule_ll_load();
+
+	if (!cpu_is_core_enabled(core))
+		return 0;
+
+	/* the load is returned as the message status */
+	ret = idc_send_msg(&msg, IDC_BLOCKING);
+
+	return ret < 0 ? 0 : ret;
+}
+
 /*
  * Components, buffers and pipelines all use the same set of monotonic ID
  * numbers passed in by the host. They are stored in different lists, hence
@@ -188,8 +208,8 @@ int ipc_comp_new(struct ipc *ipc, struct sof_ipc_comp *comp)
 	}
 
 	/* allocate the IPC component container */
-	icd = rzalloc(SOF_MEM_ZONE_RUNTIME, SOF_MEM_FLAG_SHARED,
-		      SOF_MEM_CAPS_RAM, sizeof(struct ipc_comp_dev));
+	icd = slab_zalloc(SLAB_IPC_COMP_DEV, SOF_MEM_FLAG_SHARED,
+			  SOF_MEM_CAPS_RAM, sizeof(struct ipc_comp_dev));
 	if (!icd) {
 		tr_err(&ipc_tr, "ipc_comp_new(): alloc failed");
 		rfree(cd);
@@ -233,6 +253,7 @@ int ipc_comp_free(struct ipc *ipc, uint32_t comp_id)
 			icd->cd->pipeline->sink_comp = NULL;
 		if (icd->cd == icd->cd->pipeline->sched_comp)
 			icd->cd->pipeline->sched_comp = NULL;
+		pipeline_copy_plan_invalidate(icd->cd->pipeline);
 	}
 
 	/* free component and remove from list */
@@ -267,8 +288,8 @@ int ipc_buffer_new(struct ipc *ipc, struct sof_ipc_buffer *desc)
 		return -ENOMEM;
 	}
 
-	ibd = rzalloc(SOF_MEM_ZONE_RUNTIME, SOF_MEM_FLAG_SHARED,
-		      SOF_MEM_CAPS_RAM, sizeof(struct ipc_comp_dev));
+	ibd = slab_zalloc(SLAB_IPC_COMP_DEV, SOF_MEM_FLAG_SHARED,
+			  SOF_MEM_CAPS_RAM, sizeof(struct ipc_comp_dev));
 	if (!ibd) {
 		buffer_free(buffer);
 		return -ENOMEM;
@@ -314,6 +335,11 @@ int ipc_buffer_free(struct ipc *ipc, uint32_t buffer_id)
 		if (ibd->cb->source == icd->cd &&
 		    ibd->cb->source->state != COMP_STATE_READY)
 			return -EINVAL;
+
+		/* graph of the connected pipeline is going to change */
+		if ((ibd->cb->sink == icd->cd || ibd->cb->source == icd->cd) &&
+		    icd->cd->pipeline)
+			pipeline_copy_plan_invalidate(icd->cd->pipeline);
 	}
 
 	/* free buffer and remove from list */
@@ -339,7 +365,9 @@ static int ipc_comp_to_buffer_connect(struct ipc_comp_dev *comp,
 	if (buffer->core != comp->core) {
 		dcache_invalidate_region(buffer->cb, sizeof(*buffer->cb));
 
-		buffer->cb->inter_core = true;
+		ret = buffer_set_inter_core(buffer->cb);
+		if (ret < 0)
+			return ret;
 
 		if (!comp->cd->is_shared) {
 			comp->cd = comp_make_shared(comp->cd);
@@ -374,7 +402,9 @@ static int ipc_buffer_to_comp_connect(struct ipc_comp_dev *buffer,
 	if (buffer->core != comp->core) {
 		dcache_invalidate_region(buffer->cb, sizeof(*buffer->cb));
 
-		buffer->cb->inter_core = true;
+		ret = buffer_set_inter_core(buffer->cb);
+		if (ret < 0)
+			return ret;
 
 		if (!comp->cd->is_shared) {
 			comp->cd = comp_make_shared(comp->cd);
@@ -480,8 +510,8 @@ int ipc_pipeline_new(struct ipc *ipc,
 	}
 
 	/* allocate the IPC pipeline container */
-	ipc_pipe = rzalloc(SOF_MEM_ZONE_RUNTIME, SOF_MEM_FLAG_SHARED,
-			   SOF_MEM_CAPS_RAM, sizeof(struct ipc_comp_dev));
+	ipc_pipe = slab_zalloc(SLAB_IPC_COMP_DEV, SOF_MEM_FLAG_SHARED,
+			       SOF_MEM_CAPS_RAM, sizeof(struct ipc_comp_dev));
 	if (!ipc_pipe) {
 		pipeline_free(pipe);
 		return -ENOMEM;
@@ -676,6 +706,9 @@ int ipc_init(struct sof *sof)
 	spinlock_init(&sof->ipc->lock);
 	list_init(&sof->ipc->msg_list);
 	list_init(&sof->ipc->comp_list);
+#if CONFIG_IPC_PIPELINE_PLACEMENT
+	list_init(&sof->ipc->placement_list);
+#endif
 
 	return platform_ipc_init(sof->ipc);
 }
@@ -0,0 +1,379 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/common.h>
+#include <sof/drivers/ipc.h>
+#include <sof/lib/alloc.h>
+#include <sof/lib/cpu.h>
+#include <sof/list.h>
+#include <sof/math/numbers.h>
+#include <sof/string.h>
+#include <sof/trace/trace.h>
+#include <ipc/header.h>
+#include <ipc/topology.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* object of a pipeline not placed yet, created when it is */
+struct ipc_placement_object {
+	struct list_item list;
+	uint32_t id;
+	/* copy of the IPC creating the object follows */
+};
+
+/* core chosen for a pipeline, kept until the pipeline is freed */
+struct ipc_placement {
+	struct list_item list;
+	struct list_item objects;	/* objects waiting for the core */
+	uint32_t pipeline_id;
+	uint32_t comp_id;	/* pipeline component id, 0 until placed */
+	uint32_t core;
+	uint32_t kcps;		/* reserved demand from the topology */
+	bool placed;
+};
+
+static struct ipc_placement *ipc_placement_get(struct ipc *ipc,
+					       uint32_t pipeline_id)
+{
+	struct ipc_placement *place;
+	struct list_item *clist;
+
+	list_for_item(clist, &ipc->placement_list) {
+		place = container_of(clist, struct ipc_placement, list);
+		if (place->pipeline_id == pipeline_id)
+			return place;
+	}
+
+	return NULL;
+}
+
+/* pipeline with a waiting object of the given id */
+static struct ipc_placement *ipc_placement_get_object(struct ipc *ipc,
+						      uint32_t id)
+{
+	struct ipc_placement_object *obj;
+	struct ipc_placement *place;
+	struct list_item *clist;
+	struct list_item *olist;
+
+	list_for_item(clist, &ipc->placement_list) {
+		place = container_of(clist, struct ipc_placement, list);
+		list_for_item(olist, &place->objects) {
+			obj = container_of(olist, struct ipc_placement_object,
+					   list);
+			if (obj->id == id)
+				return place;
+		}
+	}
+
+	return NULL;
+}
+
+static void ipc_placement_delete(struct ipc_placement *place)
+{
+	struct ipc_placement_object *obj;
+	struct list_item *olist;
+	struct list_item *tmp;
+
+	list_for_item_safe(olist, tmp, &place->objects) {
+		obj = container_of(olist, struct ipc_placement_object, list);
+		list_item_del(&obj->list);
+		rfree(obj);
+	}
+
+	list_item_del(&place->list);
+	rfree(place);
+}
+
+uint32_t ipc_placement_count(struct ipc *ipc, uint32_t core)
+{
+	struct ipc_placement *place;
+	struct list_item *clist;
+	uint32_t count = 0;
+
+	list_for_item(clist, &ipc->placement_list) {
+		place = container_of(clist, struct ipc_placement, list);
+		if (place->placed && place->core == core)
+			count++;
+	}
+
+	return count;
+}
+
+uint32_t ipc_placement_reserved(struct ipc *ipc, uint32_t core)
+{
+	struct ipc_placement *place;
+	struct list_item *clist;
+	uint32_t kcps = 0;
+
+	list_for_item(clist, &ipc->placement_list) {
+		place = container_of(clist, struct ipc_placement, list);
+		if (place->placed && place->core == core)
+			kcps += place->kcps;
+	}
+
+	return kcps;
+}
+
+/* enabled core with the lowest load, ties go to the one with fewer
+ * pipelines and then to the lower id
+ */
+static uint32_t ipc_placement_pick(struct ipc *ipc)
+{
+	uint32_t best = PLATFORM_PRIMARY_CORE_ID;
+	uint32_t best_load = UINT32_MAX;
+	uint32_t best_count = UINT32_MAX;
+	uint32_t count;
+	uint32_t load;
+	int i;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (!cpu_is_core_enabled(i))
+			continue;
+
+		load = MAX(ipc_core_load(i), ipc_placement_reserved(ipc, i));
+		count = ipc_placement_count(ipc, i);
+
+		if (load < best_load ||
+		    (load == best_load && count < best_count)) {
+			best = i;
+			best_load = load;
+			best_count = count;
+		}
+	}
+
+	tr_info(&ipc_tr, "ipc_placement_pick(): core %u load %u kcps pipelines %u",
+		best, best_load, best_count);
+
+	return best;
+}
+
+/* creates the waiting objects of a pipeline on its core, in the order
+ * the host sent them
+ */
+static int ipc_placement_create(struct ipc *ipc, struct ipc_placement *place)
+{
+	struct ipc_placement_object *obj;
+	struct sof_ipc_comp *comp;
+	struct list_item *olist;
+	struct list_item *tmp;
+	int ret;
+
+	list_for_item_safe(olist, tmp, &place->objects) {
+		obj = container_of(olist, struct ipc_placement_object, list);
+		comp = (struct sof_ipc_comp *)(obj + 1);
+		comp->core = place->core;
+
+		ret = memcpy_s(ipc->comp_data, SOF_IPC_MSG_MAX_SIZE, comp,
+			       comp->hdr.size);
+		assert(!ret);
+		platform_shared_commit(ipc->comp_data, comp->hdr.size);
+
+		if (!cpu_is_me(place->core))
+			ret = ipc_process_on_core(place->core);
+		else if ((comp->hdr.cmd & SOF_CMD_TYPE_MASK) ==
+			 SOF_IPC_TPLG_BUFFER_NEW)
+			ret = ipc_buffer_new(ipc, ipc->comp_data);
+		else
+			ret = ipc_comp_new(ipc, ipc->comp_data);
+
+		/* the other core replies to the host on its own */
+		if (ret >= 0 && !ipc_get_comp_by_id(ipc, obj->id))
+			ret = -EINVAL;
+
+		if (ret < 0) {
+			tr_err(&ipc_tr, "ipc_placement_create(): pipe %u object %u creation failed %d",
+			       place->pipeline_id, obj->id, ret);
+			return ret;
+		}
+
+		list_item_del(&obj->list);
+		rfree(obj);
+	}
+
+	return 0;
+}
+
+static int ipc_placement_set(struct ipc *ipc, struct ipc_placement *place,
+			     uint32_t core)
+{
+	place->core = core;
+	place->placed = true;
+
+	tr_info(&ipc_tr, "ipc_placement_set(): pipe %u on core %u",
+		place->pipeline_id, core);
+
+	return ipc_placement_create(ipc, place);
+}
+
+static struct ipc_placement *ipc_placement_new(struct ipc *ipc,
+					       uint32_t pipeline_id)
+{
+	struct ipc_placement *place;
+
+	place = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			sizeof(*place));
+	if (!place)
+		return NULL;
+
+	place->pipeline_id = pipeline_id;
+	list_init(&place->objects);
+	list_item_append(&place->list, &ipc->placement_list);
+
+	return place;
+}
+
+int ipc_placement_object(struct ipc *ipc, struct sof_ipc_comp *comp)
+{
+	struct ipc_placement_object *obj;
+	struct ipc_placement *place;
+	int ret;
+
+	/* a secondary core set by the topology is kept */
+	if (cpu_is_secondary(comp->core))
+		return 0;
+
+	place = ipc_placement_get(ipc, comp->pipeline_id);
+	if (place && place->placed) {
+		comp->core = place->core;
+		return 0;
+	}
+
+	if (!place) {
+		place = ipc_placement_new(ipc, comp->pipeline_id);
+		if (!place)
+			goto err;
+	}
+
+	obj = rmalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+		      sizeof(*obj) + comp->hdr.size);
+	if (!obj) {
+		if (list_is_empty(&place->objects))
+			ipc_placement_delete(place);
+		goto err;
+	}
+
+	obj->id = comp->id;
+	ret = memcpy_s(obj + 1, comp->hdr.size, comp, comp->hdr.size);
+	assert(!ret);
+	list_item_append(&obj->list, &place->objects);
+
+	return 1;
+
+err:
+	tr_err(&ipc_tr, "ipc_placement_object(): pipe %u out of memory",
+	       comp->pipeline_id);
+	return -ENOMEM;
+}
+
+int ipc_placement_pipeline(struct ipc *ipc, struct sof_ipc_pipe_new *pipe_desc)
+{
+	struct ipc_placement *sched_place;
+	struct ipc_placement *place;
+	struct ipc_comp_dev *icd;
+	int ret;
+
+	place = ipc_placement_get(ipc, pipe_desc->pipeline_id);
+	if (!place) {
+		place = ipc_placement_new(ipc, pipe_desc->pipeline_id);
+		if (!place) {
+			tr_err(&ipc_tr, "ipc_placement_pipeline(): pipe %u out of memory",
+			       pipe_desc->pipeline_id);
+			return -ENOMEM;
+		}
+	}
+
+	place->comp_id = pipe_desc->comp_id;
+	if (pipe_desc->period)
+		place->kcps = (uint64_t)pipe_desc->period_mips * 1000 /
+			pipe_desc->period;
+
+	if (place->placed) {
+		pipe_desc->core = place->core;
+		return 0;
+	}
+
+	/* the pipeline goes where its scheduling component is, pipelines
+	 * scheduled by one component are placed as one group
+	 */
+	icd = ipc_get_comp_by_id(ipc, pipe_desc->sched_id);
+	sched_place = ipc_placement_get_object(ipc, pipe_desc->sched_id);
+	if (cpu_is_secondary(pipe_desc->core)) {
+		/* a secondary core set by the topology is kept */
+	} else if (icd) {
+		pipe_desc->core = icd->core;
+	} else if (sched_place && sched_place != place) {
+		/* the scheduling pipeline isn't created yet, place it now */
+		ret = ipc_placement_set(ipc, sched_place,
+					ipc_placement_pick(ipc));
+		if (ret < 0) {
+			ipc_placement_delete(sched_place);
+			goto err;
+		}
+
+		pipe_desc->core = sched_place->core;
+	} else {
+		pipe_desc->core = ipc_placement_pick(ipc);
+	}
+
+	ret = ipc_placement_set(ipc, place, pipe_desc->core);
+	if (ret < 0)
+		goto err;
+
+	return 0;
+
+err:
+	ipc_placement_delete(place);
+	return ret;
+}
+
+bool ipc_placement_object_free(struct ipc *ipc, uint32_t id)
+{
+	struct ipc_placement_object *obj;
+	struct ipc_placement *place;
+	struct list_item *olist;
+
+	place = ipc_placement_get_object(ipc, id);
+	if (!place)
+		return false;
+
+	list_for_item(olist, &place->objects) {
+		obj = container_of(olist, struct ipc_placement_object, list);
+		if (obj->id == id) {
+			list_item_del(&obj->list);
+			rfree(obj);
+			break;
+		}
+	}
+
+	/* nothing left of a pipeline the host never created */
+	if (!place->placed && list_is_empty(&place->objects))
+		ipc_placement_delete(place);
+
+	return true;
+}
+
+void ipc_placement_free(struct ipc *ipc, uint32_t comp_id)
+{
+	struct ipc_placement *place;
+	struct list_item *clist;
+
+	list_for_item(clist, &ipc->placement_list) {
+		place = container_of(clist, struct ipc_placement, list);
+		if (place->placed && place->comp_id == comp_id) {
+			ipc_placement_delete(place);
+			return;
+		}
+	}
+}
+
+void ipc_placement_drop(struct ipc *ipc, uint32_t pipeline_id)
+{
+	struct ipc_placement *place;
+
+	place = ipc_placement_get(ipc, pipeline_id);
+	if (place)
+		ipc_placement_delete(place);
+}
@@ -91,6 +91,11 @@ void sa_init(struct sof *sof, uint64_t timeout)
 {
 	uint64_t ticks;
 
+#if CONFIG_SCHEDULE_LL_MULTI_RATE
+	/* don't wake the scheduler on every system tick */
+	timeout *= CONFIG_SCHEDULE_LL_AGENT_TICKS;
+#endif
+
 	if (timeout > UINT_MAX)
 		tr_warn(&sa_tr, "sa_init(), timeout > %u", UINT_MAX);
 	else
@@ -127,10 +132,10 @@ void sa_init(struct sof *sof, uint64_t timeout)
 			      SOF_SCHEDULE_LL_TIMER,
 			      SOF_TASK_PRI_HIGH, validate, sof->sa, 0, 0);
 
-	schedule_task(&sof->sa->work, 0, timeout);
-
 	/* set last check time to now to give time for boot completion */
 	sof->sa->last_check = platform_timer_get(timer_get());
 
+	schedule_task(&sof->sa->work, 0, timeout);
+
 	platform_shared_commit(sof->sa, sizeof(*sof->sa));
 }
@@ -6,12 +6,14 @@
 //         Keyon Jie <yang.jie@linux.intel.com>
 
 #include <sof/debug/panic.h>
+#include <sof/drivers/timer.h>
 #include <sof/lib/alloc.h>
 #include <sof/lib/cache.h>
 #include <sof/lib/cpu.h>
 #include <sof/lib/dma.h>
 #include <sof/lib/memory.h>
 #include <sof/lib/mm_heap.h>
+#include <sof/lib/slab.h>
 #include <sof/lib/uuid.h>
 #include <sof/math/numbers.h>
 #include <sof/spinlock.h>
@@ -616,6 +618,21 @@ out:
 #define DEBUG_TRACE_PTR(ptr, bytes, zone, caps, flags)
 #endif
 
+/* called with the memmap lock held, start is taken before locking */
+static void alloc_stats_update(struct mm *memmap, enum mem_zone zone,
+			       void *ptr, uint64_t start)
+{
+	struct mm_zone_stats *stats = &memmap->stats.zone[zone];
+	uint32_t cycles = arch_timer_get_system(cpu_timer_get()) - start;
+
+	if (ptr)
+		stats->allocs++;
+	else
+		stats->failures++;
+
+	stats->alloc_cycles_max = MAX(stats->alloc_cycles_max, cycles);
+}
+
 /* allocate single block for system runtime */
 static void *rmalloc_sys_runtime(uint32_t flags, int caps, int core,
 				 size_t bytes)
@@ -704,11 +721,15 @@ void *rmalloc(enum mem_zone zone, uint32_t flags, uint32_t caps, size_t bytes)
 {
 	struct mm *memmap = memmap_get();
 	uint32_t lock_flags;
+	uint64_t start;
 	void *ptr = NULL;
 
+	start = arch_timer_get_system(cpu_timer_get());
+
 	spin_lock_irq(&memmap->lock, lock_flags);
 
 	ptr = _malloc_unlocked(zone, flags, caps, bytes);
+	alloc_stats_update(memmap, zone, ptr, start);
 
 	spin_unlock_irq(&memmap->lock, lock_flags);
 
@@ -733,14 +754,19 @@ void *rzalloc_core_sys(int core, size_t bytes)
 {
 	struct mm *memmap = memmap_get();
 	uint32_t flags;
+	uint64_t start;
 	void *ptr = NULL;
 
+	start = arch_timer_get_system(cpu_timer_get());
+
 	spin_lock_irq(&memmap->lock, flags);
 
 	ptr = rmalloc_sys(0, 0, core, bytes);
 	if (ptr)
 		bzero(ptr, bytes);
 
+	alloc_stats_update(memmap, SOF_MEM_ZONE_SYS, ptr, start);
+
 	spin_unlock_irq(&memmap->lock, flags);
 
 	return ptr;
@@ -860,10 +886,14 @@ void *rballoc_align(uint32_t flags, uint32_t caps, size_t bytes,
 	struct mm *memmap = memmap_get();
 	void *ptr = NULL;
 	uint32_t lock_flags;
+	uint64_t start;
+
+	start = arch_timer_get_system(cpu_timer_get());
 
 	spin_lock_irq(&memmap->lock, lock_flags);
 
 	ptr = _balloc_unlocked(flags, caps, bytes, alignment);
+	alloc_stats_update(memmap, SOF_MEM_ZONE_BUFFER, ptr, start);
 
 	spin_unlock_irq(&memmap->lock, lock_flags);
 
@@ -871,6 +901,175 @@ void *rballoc_align(uint32_t flags, uint32_t caps, size_t bytes,
 	return ptr;
 }
 
+/* longest run of free blocks in the map, in bytes */
+static size_t block_map_max_free(struct block_map *map)
+{
+	unsigned int run = 0;
+	unsigned int max = 0;
+	int i;
+
+	for (i = map->first_free; i < map->count; i++) {
+		if (map->block[i].used)
+			run = 0;
+		else
+			max = MAX(max, ++run);
+	}
+
+	platform_shared_commit(map->block, sizeof(*map->block) * map->count);
+	platform_shared_commit(map, sizeof(*map));
+
+	return max * map->block_size;
+}
+
+size_t rballoc_max_size(uint32_t caps, uint32_t alignment)
+{
+	struct mm *memmap = memmap_get();
+	struct mm_heap *heap;
+	uint32_t lock_flags;
+	size_t size = 0;
+	unsigned int i, n;
+	int j;
+
+	spin_lock_irq(&memmap->lock, lock_flags);
+
+	for (i = 0, n = PLATFORM_HEAP_BUFFER, heap = memmap->buffer;
+	     i < PLATFORM_HEAP_BUFFER;
+	     i = heap - memmap->buffer + 1, n = PLATFORM_HEAP_BUFFER - i,
+	     heap++) {
+		heap = get_heap_from_caps(heap, n, caps);
+		if (!heap)
+			break;
+
+		for (j = 0; j < heap->blocks; j++)
+			size = MAX(size, block_map_max_free(&heap->map[j]));
+	}
+
+	spin_unlock_irq(&memmap->lock, lock_flags);
+
+	platform_shared_commit(memmap, sizeof(*memmap));
+
+	/* alloc_heap_buffer() reserves the alignment on top of the request */
+	return size > alignment ? size - alignment : 0;
+}
+
+size_t rballoc_heap_size(void *ptr)
+{
+	struct mm *memmap = memmap_get();
+	struct block_map *map = NULL;
+	struct mm_heap *heap;
+	struct block_hdr *hdr;
+	uint32_t lock_flags;
+	size_t size = 0;
+	int block;
+	int i;
+
+	spin_lock_irq(&memmap->lock, lock_flags);
+
+	heap = get_heap_from_ptr(ptr);
+	if (!heap)
+		goto out;
+
+	for (i = 0; i < heap->blocks; i++) {
+		map = &heap->map[i];
+		if ((uint32_t)ptr < map->base + map->block_size * map->count)
+			break;
+	}
+
+	if (i == heap->blocks)
+		goto out;
+
+	/* the blocks are counted in the header of the unaligned pointer */
+	block = ((uint32_t)ptr - map->base) / map->block_size;
+	hdr = &map->block[block];
+	if (hdr->unaligned_ptr && hdr->unaligned_ptr != ptr) {
+		block = ((uint32_t)hdr->unaligned_ptr - map->base) /
+			map->block_size;
+		hdr = &map->block[block];
+	}
+
+	size = hdr->size * map->block_size;
+
+	platform_shared_commit(map->block, sizeof(*map->block) * map->count);
+	platform_shared_commit(map, sizeof(*map));
+
+out:
+	spin_unlock_irq(&memmap->lock, lock_flags);
+
+	return size;
+}
+
+void heap_stats_get(struct mm_stats *stats)
+{
+	struct mm *memmap = memmap_get();
+	uint32_t lock_flags;
+
+	spin_lock_irq(&memmap->lock, lock_flags);
+	*stats = memmap->stats;
+	spin_unlock_irq(&memmap->lock, lock_flags);
+
+	platform_shared_commit(memmap, sizeof(*memmap));
+}
+
+int heap_info(enum mem_zone zone, int index, struct mm_heap_info *info)
+{
+	struct mm *memmap = memmap_get();
+	struct mm_heap *heap;
+	uint32_t lock_flags;
+	int count;
+	int i;
+
+	switch (zone) {
+	case SOF_MEM_ZONE_SYS:
+		heap = memmap->system;
+		count = PLATFORM_HEAP_SYSTEM;
+		break;
+	case SOF_MEM_ZONE_SYS_RUNTIME:
+		heap = memmap->system_runtime;
+		count = PLATFORM_HEAP_SYSTEM_RUNTIME;
+		break;
+	case SOF_MEM_ZONE_RUNTIME:
+		heap = memmap->runtime;
+		count = PLATFORM_HEAP_RUNTIME;
+		break;
+	case SOF_MEM_ZONE_BUFFER:
+		heap = memmap->buffer;
+		count = PLATFORM_HEAP_BUFFER;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	platform_shared_commit(memmap, sizeof(*memmap));
+
+	if (index < 0 || index >= count)
+		return -EINVAL;
+
+	heap += index;
+
+	spin_lock_irq(&memmap->lock, lock_flags);
+
+	info->caps = heap->caps;
+	info->size = heap->size;
+	info->used = heap->info.used;
+	info->free = heap->info.free;
+
+	/* system heaps are linear, the free space is a single run */
+	if (zone == SOF_MEM_ZONE_SYS) {
+		info->max_free = heap->info.free;
+	} else {
+		info->max_free = 0;
+		for (i = 0; i < heap->blocks; i++)
+			info->max_free = MAX(info->max_free,
+					     block_map_max_free(&heap->map[i]));
+	}
+
+	spin_unlock_irq(&memmap->lock, lock_flags);
+
+	platform_shared_commit(heap, sizeof(*heap));
+
+	return 0;
+}
+
 static void _rfree_unlocked(void *ptr)
 {
 	struct mm *memmap = memmap_get();
@@ -906,9 +1105,28 @@ void rfree(void *ptr)
 {
 	struct mm *memmap = memmap_get();
 	uint32_t flags;
+	uint32_t cycles;
+	uint64_t start;
+
+	if (!ptr)
+		return;
+
+#if CONFIG_SLAB_CACHE
+	if (slab_free(platform_rfree_prepare(ptr)))
+		return;
+#endif
+
+	start = arch_timer_get_system(cpu_timer_get());
 
 	spin_lock_irq(&memmap->lock, flags);
+
 	_rfree_unlocked(ptr);
+
+	cycles = arch_timer_get_system(cpu_timer_get()) - start;
+	memmap->stats.frees++;
+	memmap->stats.free_cycles_max = MAX(memmap->stats.free_cycles_max,
+					    cycles);
+
 	spin_unlock_irq(&memmap->lock, flags);
 }
 
@@ -918,14 +1136,18 @@ void *rbrealloc_align(void *ptr, uint32_t flags, uint32_t caps, size_t bytes,
 	struct mm *memmap = memmap_get();
 	void *new_ptr = NULL;
 	uint32_t lock_flags;
+	uint64_t start;
 	size_t copy_bytes = MIN(bytes, old_bytes);
 
 	if (!bytes)
 		return new_ptr;
 
+	start = arch_timer_get_system(cpu_timer_get());
+
 	spin_lock_irq(&memmap->lock, lock_flags);
 
 	new_ptr = _balloc_unlocked(flags, caps, bytes, alignment);
+	alloc_stats_update(memmap, SOF_MEM_ZONE_BUFFER, new_ptr, start);
 
 	if (new_ptr && ptr && !(flags & SOF_MEM_FLAG_NO_COPY))
 		memcpy_s(new_ptr, copy_bytes, ptr, copy_bytes);
@@ -1031,6 +1253,10 @@ void heap_trace_all(int force)
 		heap_trace(memmap->buffer, PLATFORM_HEAP_BUFFER);
 		tr_info(&mem_tr, "heap: runtime status");
 		heap_trace(memmap->runtime, PLATFORM_HEAP_RUNTIME);
+#if CONFIG_SLAB_CACHE
+		tr_info(&mem_tr, "heap: slab cache status");
+		slab_trace();
+#endif
 	}
 
 	memmap->heap_trace_updated = 0;
@@ -1067,5 +1293,9 @@ void init_heap(struct sof *sof)
 
 	spinlock_init(&memmap->lock);
 
+#if CONFIG_SLAB_CACHE
+	slab_init(memmap);
+#endif
+
 	platform_shared_commit(memmap, sizeof(*memmap));
 }
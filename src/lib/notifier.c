@@ -17,6 +17,7 @@
 #include <sof/list.h>
 #include <sof/sof.h>
 #include <ipc/topology.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 /* 1fb15a7a-83cd-4c2e-8b32-4da1b2adeeaf */
@@ -141,10 +142,9 @@ static void notifier_notify(const void *caller, enum notify_id type, void *data)
 	}
 }
 
-void notifier_notify_remote(void)
+void notifier_notify_remote_data(struct notify_data *notify_data)
 {
 	struct notify *notify = *arch_notify_get();
-	struct notify_data *notify_data = notify_data_get() + cpu_get_id();
 
 	if (!list_is_empty(&notify->list[notify_data->type])) {
 		dcache_invalidate_region(notify_data->data,
@@ -152,13 +152,78 @@ void notifier_notify_remote(void)
 		notifier_notify(notify_data->caller, notify_data->type,
 				notify_data->data);
 	}
+}
+
+void notifier_notify_remote(void)
+{
+	struct notify_data *notify_data = notify_data_get() + cpu_get_id();
+
+	notifier_notify_remote_data(notify_data);
 
 	platform_shared_commit(notify_data, sizeof(*notify_data));
 }
 
+#if CONFIG_IDC_RING
+/* events are queued to all targets before any doorbell is rung, so the
+ * targets handle them in parallel and events sent in a row are handled
+ * in one pass
+ */
+static void notifier_event_remote(const void *caller, enum notify_id type,
+				  uint32_t core_mask, void *data,
+				  uint32_t data_size)
+{
+	struct notify_data notify_data = {
+		.caller = caller,
+		.type = type,
+		.data_size = data_size,
+		.data = data,
+	};
+	struct idc_msg notify_msg = { IDC_MSG_NOTIFY, IDC_MSG_NOTIFY_EXT, 0,
+		sizeof(notify_data), &notify_data, };
+	uint32_t posted = 0;
+	bool written = false;
+	int i;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (!(core_mask & NOTIFIER_TARGET_CORE_MASK(i)) ||
+		    cpu_is_me(i) || !cpu_is_core_enabled(i))
+			continue;
+
+		/* NOTE: for transcore events, payload has to
+		 * be allocated on heap, not on stack
+		 */
+		if (!written) {
+			dcache_writeback_region(data, data_size);
+			written = true;
+		}
+
+		notify_msg.core = i;
+		if (idc_ring_post(&notify_msg, NULL) < 0)
+			tr_err(&nt_tr, "notifier_event_remote(): core %d lost event %d",
+			       i, type);
+		else
+			posted |= NOTIFIER_TARGET_CORE_MASK(i);
+	}
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (posted & NOTIFIER_TARGET_CORE_MASK(i))
+			idc_ring_flush(i);
+	}
+}
+#endif
+
 void notifier_event(const void *caller, enum notify_id type, uint32_t core_mask,
 		    void *data, uint32_t data_size)
 {
+#if CONFIG_IDC_RING
+	/* local events don't touch the rings nor the cache */
+	if (core_mask & ~NOTIFIER_TARGET_CORE_MASK(cpu_get_id()))
+		notifier_event_remote(caller, type, core_mask, data,
+				      data_size);
+
+	if (core_mask & NOTIFIER_TARGET_CORE_MASK(cpu_get_id()))
+		notifier_notify(caller, type, data);
+#else
 	struct notify_data *notify_data;
 	struct idc_msg notify_msg = { IDC_MSG_NOTIFY, IDC_MSG_NOTIFY_EXT };
 	int i;
@@ -190,6 +255,7 @@ void notifier_event(const void *caller, enum notify_id type, uint32_t core_mask,
 			}
 		}
 	}
+#endif
 }
 
 void init_system_notify(struct sof *sof)
@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+/*
+ * Object caches in front of the runtime heap. Components, buffers, tasks
+ * and their IPC descriptors are created and destroyed on every topology
+ * load and stream open/close, each of them walking the heap block maps.
+ * Every core gets a cache per object type instead, served by a bitmap.
+ * Only these objects are allocated with slab_zalloc(), other runtime
+ * allocations always go to the heap.
+ */
+
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/common.h>
+#include <sof/debug/panic.h>
+#include <sof/drivers/ipc.h>
+#include <sof/lib/alloc.h>
+#include <sof/lib/cache.h>
+#include <sof/lib/cpu.h>
+#include <sof/lib/memory.h>
+#include <sof/lib/mm_heap.h>
+#include <sof/lib/slab.h>
+#include <sof/lib/uuid.h>
+#include <sof/schedule/task.h>
+#include <sof/spinlock.h>
+#include <sof/trace/trace.h>
+#include <ipc/topology.h>
+#include <ipc/trace.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* fdc3e8f9-e420-46e7-999e-da72873fa80a */
+DECLARE_SOF_UUID("slab", slab_uuid, 0xfdc3e8f9, 0xe420, 0x46e7,
+		 0x99, 0x9e, 0xda, 0x72, 0x87, 0x3f, 0xa8, 0x0a);
+
+DECLARE_TR_CTX(slab_tr, SOF_UUID(slab_uuid), LOG_LEVEL_INFO);
+
+/* the largest of the IPC descriptions allocated along with comp_dev */
+union slab_ipc_comp {
+	struct sof_ipc_comp_host host;
+	struct sof_ipc_comp_dai dai;
+	struct sof_ipc_comp_mixer mixer;
+	struct sof_ipc_comp_volume volume;
+	struct sof_ipc_comp_src src;
+	struct sof_ipc_comp_asrc asrc;
+	struct sof_ipc_comp_mux mux;
+	struct sof_ipc_comp_tone tone;
+	struct sof_ipc_comp_process process;
+};
+
+static const uint32_t slab_obj_size[SLAB_CACHE_COUNT] = {
+	[SLAB_IPC_COMP_DEV] = sizeof(struct ipc_comp_dev),
+	[SLAB_TASK] = sizeof(struct pipeline_task),
+	[SLAB_BUFFER] = sizeof(struct comp_buffer),
+	[SLAB_COMP_DEV] = sizeof(struct comp_dev) +
+		sizeof(union slab_ipc_comp),
+};
+
+void slab_init(struct mm *memmap)
+{
+	struct slab_cache *cache;
+	int core;
+	int i;
+
+	for (core = 0; core < PLATFORM_CORE_COUNT; core++) {
+		for (i = 0; i < SLAB_CACHE_COUNT; i++) {
+			cache = &memmap->slab[core][i];
+			cache->obj_size = ALIGN_UP(slab_obj_size[i],
+						   PLATFORM_DCACHE_ALIGN);
+			cache->count = CONFIG_SLAB_CACHE_OBJECTS;
+			spinlock_init(&cache->lock);
+		}
+	}
+}
+
+static void *slab_alloc(enum slab_cache_type type, uint32_t flags,
+			uint32_t caps, size_t bytes)
+{
+	struct mm *memmap = memmap_get();
+	struct slab_cache *cache = &memmap->slab[cpu_get_id()][type];
+	uint32_t lock_flags;
+	void *ptr = NULL;
+	int i;
+
+	spin_lock_irq(&cache->lock, lock_flags);
+
+	/* other capabilities ask for a particular memory */
+	if (caps != SOF_MEM_CAPS_RAM || bytes > cache->obj_size) {
+		cache->misses++;
+		spin_unlock_irq(&cache->lock, lock_flags);
+		return NULL;
+	}
+
+	/* carve the cache out of the buffer heap on the first use */
+	if (!cache->base) {
+		cache->base = (uintptr_t)rballoc(0, SOF_MEM_CAPS_RAM,
+						 cache->obj_size * cache->count);
+		if (cache->base)
+			cache->free = cache->count == SLAB_MAX_OBJECTS ?
+				0xffffffff : (1u << cache->count) - 1;
+	}
+
+	i = ffs(cache->free);
+	if (i) {
+		cache->free &= ~(1u << (i - 1));
+		cache->allocs++;
+		cache->peak = MAX(cache->peak,
+				  cache->count - popcount(cache->free));
+		ptr = (void *)(cache->base + (i - 1) * cache->obj_size);
+	} else {
+		cache->misses++;
+	}
+
+	spin_unlock_irq(&cache->lock, lock_flags);
+
+	platform_shared_commit(cache, sizeof(*cache));
+
+	if (ptr && (flags & SOF_MEM_FLAG_SHARED))
+		ptr = platform_shared_get(ptr, bytes);
+
+	return ptr;
+}
+
+void *slab_zalloc(enum slab_cache_type type, uint32_t flags, uint32_t caps,
+		  size_t bytes)
+{
+	void *ptr;
+
+	ptr = slab_alloc(type, flags, caps, bytes);
+	if (!ptr)
+		return rzalloc(SOF_MEM_ZONE_RUNTIME, flags, caps, bytes);
+
+	bzero(ptr, bytes);
+
+	return ptr;
+}
+
+bool slab_free(void *ptr)
+{
+	struct mm *memmap = memmap_get();
+	struct slab_cache *cache;
+	uintptr_t offset;
+	uint32_t lock_flags;
+	uint32_t bit;
+	int core;
+	int i;
+
+	for (core = 0; core < PLATFORM_CORE_COUNT; core++) {
+		for (i = 0; i < SLAB_CACHE_COUNT; i++) {
+			cache = &memmap->slab[core][i];
+			offset = (uintptr_t)ptr - cache->base;
+			if (cache->base &&
+			    offset < cache->obj_size * cache->count)
+				goto found;
+		}
+	}
+
+	return false;
+
+found:
+	if (offset % cache->obj_size) {
+		tr_err(&slab_tr, "slab_free(): %p is not an object of core %d cache %d",
+		       (uintptr_t)ptr, core, i);
+		panic(SOF_IPC_PANIC_MEM);
+	}
+
+	/* the object may be reused by a different core */
+	dcache_writeback_invalidate_region(ptr, cache->obj_size);
+
+	bit = 1u << (offset / cache->obj_size);
+
+	spin_lock_irq(&cache->lock, lock_flags);
+
+	if (cache->free & bit)
+		tr_err(&slab_tr, "slab_free(): double free of %p",
+		       (uintptr_t)ptr);
+
+	cache->free |= bit;
+
+	spin_unlock_irq(&cache->lock, lock_flags);
+
+	platform_shared_commit(cache, sizeof(*cache));
+
+	return true;
+}
+
+void slab_info_get(struct slab_info *info)
+{
+	struct mm *memmap = memmap_get();
+	struct slab_cache *cache;
+	int core;
+	int i;
+
+	info->size = 0;
+	info->used = 0;
+
+	for (core = 0; core < PLATFORM_CORE_COUNT; core++) {
+		for (i = 0; i < SLAB_CACHE_COUNT; i++) {
+			cache = &memmap->slab[core][i];
+			if (!cache->base)
+				continue;
+
+			info->size += cache->obj_size * cache->count;
+			info->used += cache->obj_size *
+				(cache->count - popcount(cache->free));
+
+			platform_shared_commit(cache, sizeof(*cache));
+		}
+	}
+}
+
+#if CONFIG_TRACE
+void slab_trace(void)
+{
+	struct mm *memmap = memmap_get();
+	struct slab_cache *cache;
+	int core;
+	int i;
+
+	for (core = 0; core < PLATFORM_CORE_COUNT; core++) {
+		for (i = 0; i < SLAB_CACHE_COUNT; i++) {
+			cache = &memmap->slab[core][i];
+			if (!cache->base && !cache->misses)
+				continue;
+
+			tr_info(&slab_tr, " slab: core %d cache %d base 0x%x size %d",
+				core, i, cache->base, cache->obj_size);
+			tr_info(&slab_tr, "  used %d peak %d count %d",
+				cache->base ?
+				cache->count - popcount(cache->free) : 0,
+				cache->peak, cache->count);
+			tr_info(&slab_tr, "  allocs %d misses %d",
+				cache->allocs, cache->misses);
+
+			platform_shared_commit(cache, sizeof(*cache));
+		}
+	}
+}
+#else
+void slab_trace(void) { }
+#endif
@@ -42,7 +42,8 @@ int fir_delay_size(struct sof_fir_coef_data *config)
 	if (config->length > SOF_FIR_MAX_LENGTH || config->length < 1)
 		return -EINVAL;
 
-	return config->length * sizeof(int32_t);
+	/* The delay line is kept twice, see fir_32x16() */
+	return 2 * config->length * sizeof(int32_t);
 }
 
 int fir_init_coef(struct fir_state_32x16 *fir,
@@ -59,63 +60,122 @@ int fir_init_coef(struct fir_state_32x16 *fir,
 void fir_init_delay(struct fir_state_32x16 *fir, int32_t **data)
 {
 	fir->delay = *data;
-	*data += fir->length; /* Point to next delay line start */
+	*data += 2 * fir->length; /* Point to next delay line start */
 }
 
+/* Every sample is written to delay[rwi] and to delay[rwi + length], so the
+ * last length samples are always found linearly, the newest one at
+ * delay[rwi + length] and the oldest at delay[rwi + 1]. The upper copy is
+ * written before computing the output, the lower one after it as the
+ * previous sample in that place is still the oldest one in the window.
+ */
 int32_t fir_32x16(struct fir_state_32x16 *fir, int32_t x)
 {
 	int64_t y = 0;
-	int32_t *data = &fir->delay[fir->rwi];
+	int32_t *data;
 	int16_t *coef = &fir->coef[0];
-	int n1;
-	int n2;
 	int n;
 
 	/* Bypass is set with length set to zero. */
 	if (!fir->length)
 		return x;
 
-	/* Write sample to delay */
+	data = &fir->delay[fir->rwi + fir->length];
 	*data = x;
 
-	/* Advance write pointer and calculate into n1 max. number of taps
-	 * to process before circular wrap.
+	/* Data is Q1.31, coef is Q1.15, product is Q2.46 */
+	for (n = 0; n < fir->length; n++)
+		y += (int64_t)coef[n] * data[-n];
+
+	fir->delay[fir->rwi] = x;
+	if (++fir->rwi == fir->length)
+		fir->rwi = 0;
+
+	/* Q2.46 -> Q2.31, saturate to Q1.31 */
+	return sat_int32(y >> (15 + fir->out_shift));
+}
+
+/* Four successive outputs, their windows share the coefficient loads and
+ * all but one of the data loads. The caller makes sure the four samples
+ * fit before the delay line index wraps.
+ */
+static void fir_32x16_4x(struct fir_state_32x16 *fir, const int32_t *x,
+			 int32_t *y)
+{
+	int64_t y0 = 0;
+	int64_t y1 = 0;
+	int64_t y2 = 0;
+	int64_t y3 = 0;
+	int32_t *data = &fir->delay[fir->rwi + fir->length];
+	int16_t *coef = &fir->coef[0];
+	int32_t d0;
+	int32_t d1;
+	int32_t d2;
+	int32_t d3;
+	int shift = 15 + fir->out_shift;
+	int n;
+
+	data[0] = x[0];
+	data[1] = x[1];
+	data[2] = x[2];
+	data[3] = x[3];
+
+	/* Output k has its newest sample in data[k], the window of four
+	 * samples slides down by one per tap.
 	 */
-	n1 = ++fir->rwi;
+	d1 = data[1];
+	d2 = data[2];
+	d3 = data[3];
+	for (n = 0; n < fir->length; n++) {
+		d0 = data[-n];
+		y0 += (int64_t)coef[n] * d0;
+		y1 += (int64_t)coef[n] * d1;
+		y2 += (int64_t)coef[n] * d2;
+		y3 += (int64_t)coef[n] * d3;
+		d3 = d2;
+		d2 = d1;
+		d1 = d0;
+	}
+
+	data = &fir->delay[fir->rwi];
+	data[0] = x[0];
+	data[1] = x[1];
+	data[2] = x[2];
+	data[3] = x[3];
+
+	fir->rwi += 4;
 	if (fir->rwi == fir->length)
 		fir->rwi = 0;
 
-	/* Check if no need to un-wrap FIR data. */
-	if (n1 > fir->length) {
-		/* Data is Q1.31, coef is Q1.15, product is Q2.46 */
-		for (n = 0; n < fir->length; n++) {
-			y += (int64_t)(*coef) * (*data);
-			coef++;
-			data--;
-		}
+	/* Q2.46 -> Q2.31, saturate to Q1.31 */
+	y[0] = sat_int32(y0 >> shift);
+	y[1] = sat_int32(y1 >> shift);
+	y[2] = sat_int32(y2 >> shift);
+	y[3] = sat_int32(y3 >> shift);
+}
 
-		/* Q2.46 -> Q2.31, saturate to Q1.31 */
-		return sat_int32(y >> (15 + fir->out_shift));
-	}
+void fir_32x16_block(struct fir_state_32x16 *fir, const int32_t *x,
+		     int32_t *y, int frames)
+{
+	int i = 0;
 
-	/* Part 1, loop n1 times */
-	for (n = 0; n < n1; n++) {
-		y += (int64_t)(*coef) * (*data);
-		coef++;
-		data--;
+	/* Bypass is set with length set to zero. */
+	if (!fir->length) {
+		for (i = 0; i < frames; i++)
+			y[i] = x[i];
+		return;
 	}
 
-	/* Part 2, un-wrap data, continue n2 times */
-	n2 = fir->length - n1;
-	data = &fir->delay[fir->length - 1];
-	for (n = 0; n < n2; n++) {
-		y += (int64_t)(*coef) * (*data);
-		coef++;
-		data--;
+	while (i < frames) {
+		if (frames - i >= 4 && fir->rwi + 4 <= fir->length) {
+			/* x is read before y is written, in place is fine */
+			fir_32x16_4x(fir, &x[i], &y[i]);
+			i += 4;
+		} else {
+			y[i] = fir_32x16(fir, x[i]);
+			i++;
+		}
 	}
-
-	/* Q2.46 -> Q2.31, saturate to Q1.31 */
-	return sat_int32(y >> (15 + fir->out_shift));
 }
 
 #endif
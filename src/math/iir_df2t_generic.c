@@ -104,4 +104,108 @@ int32_t iir_df2t(struct iir_state_df2t *iir, int32_t x)
 	return out;
 }
 
+/* One biquad over a block, Q1.31 samples filtered in place */
+static void iir_df2t_biquad_block(const int32_t *coef, int64_t *delay,
+				  int32_t *x, int frames)
+{
+	const int32_t a2 = coef[0];
+	const int32_t a1 = coef[1];
+	const int32_t b2 = coef[2];
+	const int32_t b1 = coef[3];
+	const int32_t b0 = coef[4];
+	const int32_t shift = coef[5];
+	const int32_t gain = coef[6];
+	int64_t d0 = delay[0];
+	int64_t d1 = delay[1];
+	int64_t acc;
+	int32_t in;
+	int32_t tmp;
+	int i;
+
+	for (i = 0; i < frames; i++) {
+		in = x[i];
+		acc = (int64_t)b0 * in + d0;
+		tmp = (int32_t)Q_SHIFT_RND(acc, 61, 31);
+		d0 = d1 + (int64_t)b1 * in + (int64_t)a1 * tmp;
+		d1 = (int64_t)b2 * in + (int64_t)a2 * tmp;
+		acc = (int64_t)gain * tmp;
+		acc = Q_SHIFT_RND(acc, 45 + shift, 31);
+		x[i] = sat_int32(acc);
+	}
+
+	delay[0] = d0;
+	delay[1] = d1;
+}
+
+void iir_df2t_block(struct iir_state_df2t *iir, int32_t *x, int frames)
+{
+	int i;
+
+	/* Bypass is set with number of biquads set to zero. */
+	if (!iir->biquads)
+		return;
+
+	/* Parallel sections need the input kept for every section, these
+	 * are rare enough to be left to the per sample version.
+	 */
+	if (iir->biquads != iir->biquads_in_series) {
+		for (i = 0; i < frames; i++)
+			x[i] = iir_df2t(iir, x[i]);
+		return;
+	}
+
+	for (i = 0; i < iir->biquads; i++)
+		iir_df2t_biquad_block(&iir->coef[i * SOF_EQ_IIR_NBIQUAD_DF2T],
+				      &iir->delay[i * IIR_DF2T_NUM_DELAYS],
+				      x, frames);
+}
+
+/* The lanes are the innermost loop with no dependency between them so the
+ * compiler can map them to SIMD lanes.
+ */
+void iir_df2t_block_lanes(struct iir_state_df2t **iir, int32_t **x,
+			  int lanes, int frames)
+{
+	int32_t coef[IIR_DF2T_MAX_LANES][SOF_EQ_IIR_NBIQUAD_DF2T];
+	int64_t d0[IIR_DF2T_MAX_LANES];
+	int64_t d1[IIR_DF2T_MAX_LANES];
+	int64_t acc;
+	int32_t in;
+	int32_t tmp;
+	int i;
+	int j;
+	int k;
+	int l;
+
+	for (j = 0; j < iir[0]->biquads; j++) {
+		for (l = 0; l < lanes; l++) {
+			for (k = 0; k < SOF_EQ_IIR_NBIQUAD_DF2T; k++)
+				coef[l][k] = iir[l]->coef[j *
+					SOF_EQ_IIR_NBIQUAD_DF2T + k];
+			d0[l] = iir[l]->delay[j * IIR_DF2T_NUM_DELAYS];
+			d1[l] = iir[l]->delay[j * IIR_DF2T_NUM_DELAYS + 1];
+		}
+
+		for (i = 0; i < frames; i++) {
+			for (l = 0; l < lanes; l++) {
+				in = x[l][i];
+				acc = (int64_t)coef[l][4] * in + d0[l];
+				tmp = (int32_t)Q_SHIFT_RND(acc, 61, 31);
+				d0[l] = d1[l] + (int64_t)coef[l][3] * in +
+					(int64_t)coef[l][1] * tmp;
+				d1[l] = (int64_t)coef[l][2] * in +
+					(int64_t)coef[l][0] * tmp;
+				acc = (int64_t)coef[l][6] * tmp;
+				acc = Q_SHIFT_RND(acc, 45 + coef[l][5], 31);
+				x[l][i] = sat_int32(acc);
+			}
+		}
+
+		for (l = 0; l < lanes; l++) {
+			iir[l]->delay[j * IIR_DF2T_NUM_DELAYS] = d0[l];
+			iir[l]->delay[j * IIR_DF2T_NUM_DELAYS + 1] = d1[l];
+		}
+	}
+}
+
 #endif
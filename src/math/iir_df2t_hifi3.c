@@ -131,4 +131,197 @@ int32_t iir_df2t(struct iir_state_df2t *iir, int32_t x)
 	return out;
 }
 
+/* One biquad over a block, Q1.31 samples filtered in place. The sequence of
+ * operations per sample is the same as in iir_df2t().
+ */
+static void iir_df2t_biquad_block(int32_t *coef, int64_t *delay,
+				  int32_t *x, int frames)
+{
+	ae_f32x2 *coefp = (ae_f32x2 *)coef;
+	ae_valign align = AE_LA64_PP(coefp);
+	ae_f32x2 coef_a2a1;
+	ae_f32x2 coef_b2b1;
+	ae_f32x2 coef_b0shift;
+	ae_f32x2 gain;
+	ae_f64 *delayp = (ae_f64 *)delay;
+	ae_f64 d0 = delayp[0];
+	ae_f64 d1 = delayp[1];
+	ae_f64 acc;
+	ae_f32 in;
+	ae_f32 tmp;
+	int shift;
+	int i;
+
+	AE_LA32X2_IP(coef_a2a1, align, coefp);
+	AE_LA32X2_IP(coef_b2b1, align, coefp);
+	AE_LA32X2_IP(coef_b0shift, align, coefp);
+	AE_LA32X2_IP(gain, align, coefp);
+	shift = AE_SEL32_LL(coef_b0shift, coef_b0shift);
+
+	for (i = 0; i < frames; i++) {
+		in = x[i];
+
+		acc = AE_SRAI64(d0, 1); /* Convert d0 to Q18.46 */
+		AE_MULAF32R_HH(acc, coef_b0shift, in); /* Coef b0 */
+		acc = AE_SLAI64S(acc, 1); /* Convert to Q17.47 */
+		tmp = AE_ROUND32F48SSYM(acc); /* Round to Q1.31 */
+
+		acc = AE_SRAI64(d1, 1); /* Convert d1 to Q18.46 */
+		AE_MULAF32R_LL(acc, coef_b2b1, in); /* Coef b1 */
+		AE_MULAF32R_LL(acc, coef_a2a1, tmp); /* Coef a1 */
+		d0 = AE_SLAI64S(acc, 1); /* Convert to Q17.47 */
+
+		acc = AE_MULF32R_HH(coef_b2b1, in); /* Coef b2 */
+		AE_MULAF32R_HH(acc, coef_a2a1, tmp); /* Coef a2 */
+		d1 = AE_SLAI64S(acc, 1); /* Convert to Q17.47 */
+
+		acc = AE_MULF32R_HH(gain, tmp); /* Gain */
+		acc = AE_SLAI64S(acc, 17); /* Convert to Q17.47 */
+		acc = AE_SRAA64(acc, shift);
+		x[i] = AE_ROUND32F48SSYM(acc);
+	}
+
+	delayp[0] = d0;
+	delayp[1] = d1;
+}
+
+/* One biquad of two channels in lockstep. The two channels are independent
+ * chains of operations that the compiler bundles to use both multipliers.
+ */
+static void iir_df2t_biquad_block_2ch(int32_t *coef0, int64_t *delay0,
+				      int32_t *x0, int32_t *coef1,
+				      int64_t *delay1, int32_t *x1,
+				      int frames)
+{
+	ae_f32x2 *coefp0 = (ae_f32x2 *)coef0;
+	ae_f32x2 *coefp1 = (ae_f32x2 *)coef1;
+	ae_valign align0 = AE_LA64_PP(coefp0);
+	ae_valign align1 = AE_LA64_PP(coefp1);
+	ae_f32x2 coef_a2a1_0;
+	ae_f32x2 coef_b2b1_0;
+	ae_f32x2 coef_b0shift_0;
+	ae_f32x2 gain_0;
+	ae_f32x2 coef_a2a1_1;
+	ae_f32x2 coef_b2b1_1;
+	ae_f32x2 coef_b0shift_1;
+	ae_f32x2 gain_1;
+	ae_f64 *delayp0 = (ae_f64 *)delay0;
+	ae_f64 *delayp1 = (ae_f64 *)delay1;
+	ae_f64 d0_0 = delayp0[0];
+	ae_f64 d1_0 = delayp0[1];
+	ae_f64 d0_1 = delayp1[0];
+	ae_f64 d1_1 = delayp1[1];
+	ae_f64 acc0;
+	ae_f64 acc1;
+	ae_f32 in0;
+	ae_f32 in1;
+	ae_f32 tmp0;
+	ae_f32 tmp1;
+	int shift0;
+	int shift1;
+	int i;
+
+	AE_LA32X2_IP(coef_a2a1_0, align0, coefp0);
+	AE_LA32X2_IP(coef_b2b1_0, align0, coefp0);
+	AE_LA32X2_IP(coef_b0shift_0, align0, coefp0);
+	AE_LA32X2_IP(gain_0, align0, coefp0);
+	shift0 = AE_SEL32_LL(coef_b0shift_0, coef_b0shift_0);
+
+	AE_LA32X2_IP(coef_a2a1_1, align1, coefp1);
+	AE_LA32X2_IP(coef_b2b1_1, align1, coefp1);
+	AE_LA32X2_IP(coef_b0shift_1, align1, coefp1);
+	AE_LA32X2_IP(gain_1, align1, coefp1);
+	shift1 = AE_SEL32_LL(coef_b0shift_1, coef_b0shift_1);
+
+	for (i = 0; i < frames; i++) {
+		in0 = x0[i];
+		in1 = x1[i];
+
+		/* Output, Q17.47 delays are aligned to Q18.46 of MAC */
+		acc0 = AE_SRAI64(d0_0, 1);
+		acc1 = AE_SRAI64(d0_1, 1);
+		AE_MULAF32R_HH(acc0, coef_b0shift_0, in0);
+		AE_MULAF32R_HH(acc1, coef_b0shift_1, in1);
+		tmp0 = AE_ROUND32F48SSYM(AE_SLAI64S(acc0, 1));
+		tmp1 = AE_ROUND32F48SSYM(AE_SLAI64S(acc1, 1));
+
+		/* Delay d0 */
+		acc0 = AE_SRAI64(d1_0, 1);
+		acc1 = AE_SRAI64(d1_1, 1);
+		AE_MULAF32R_LL(acc0, coef_b2b1_0, in0);
+		AE_MULAF32R_LL(acc1, coef_b2b1_1, in1);
+		AE_MULAF32R_LL(acc0, coef_a2a1_0, tmp0);
+		AE_MULAF32R_LL(acc1, coef_a2a1_1, tmp1);
+		d0_0 = AE_SLAI64S(acc0, 1);
+		d0_1 = AE_SLAI64S(acc1, 1);
+
+		/* Delay d1 */
+		acc0 = AE_MULF32R_HH(coef_b2b1_0, in0);
+		acc1 = AE_MULF32R_HH(coef_b2b1_1, in1);
+		AE_MULAF32R_HH(acc0, coef_a2a1_0, tmp0);
+		AE_MULAF32R_HH(acc1, coef_a2a1_1, tmp1);
+		d1_0 = AE_SLAI64S(acc0, 1);
+		d1_1 = AE_SLAI64S(acc1, 1);
+
+		/* Gain and output shift, round to Q1.31 */
+		acc0 = AE_SLAI64S(AE_MULF32R_HH(gain_0, tmp0), 17);
+		acc1 = AE_SLAI64S(AE_MULF32R_HH(gain_1, tmp1), 17);
+		x0[i] = AE_ROUND32F48SSYM(AE_SRAA64(acc0, shift0));
+		x1[i] = AE_ROUND32F48SSYM(AE_SRAA64(acc1, shift1));
+	}
+
+	delayp0[0] = d0_0;
+	delayp0[1] = d1_0;
+	delayp1[0] = d0_1;
+	delayp1[1] = d1_1;
+}
+
+void iir_df2t_block(struct iir_state_df2t *iir, int32_t *x, int frames)
+{
+	int i;
+
+	/* Bypass is set with number of biquads set to zero. */
+	if (!iir->biquads)
+		return;
+
+	/* Parallel sections need the input kept for every section, these
+	 * are rare enough to be left to the per sample version.
+	 */
+	if (iir->biquads != iir->biquads_in_series) {
+		for (i = 0; i < frames; i++)
+			x[i] = iir_df2t(iir, x[i]);
+		return;
+	}
+
+	for (i = 0; i < iir->biquads; i++)
+		iir_df2t_biquad_block(&iir->coef[i * SOF_EQ_IIR_NBIQUAD_DF2T],
+				      &iir->delay[i * IIR_DF2T_NUM_DELAYS],
+				      x, frames);
+}
+
+void iir_df2t_block_lanes(struct iir_state_df2t **iir, int32_t **x,
+			  int lanes, int frames)
+{
+	int c;
+	int d;
+	int i;
+	int l;
+
+	for (i = 0; i < iir[0]->biquads; i++) {
+		c = i * SOF_EQ_IIR_NBIQUAD_DF2T;
+		d = i * IIR_DF2T_NUM_DELAYS;
+
+		for (l = 0; l + 1 < lanes; l += 2)
+			iir_df2t_biquad_block_2ch(&iir[l]->coef[c],
+						  &iir[l]->delay[d], x[l],
+						  &iir[l + 1]->coef[c],
+						  &iir[l + 1]->delay[d],
+						  x[l + 1], frames);
+
+		if (l < lanes)
+			iir_df2t_biquad_block(&iir[l]->coef[c],
+					      &iir[l]->delay[d], x[l], frames);
+	}
+}
+
 #endif
@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/debug/panic.h>
+#include <sof/lib/alloc.h>
+#include <sof/schedule/edf_schedule.h>
+#include <sof/schedule/task.h>
+#include <sof/string.h>
+#include <ipc/topology.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* The ready queue of the EDF scheduler is a binary min-heap of tasks.
+ * Every task keeps its heap position in its private data, so removal
+ * of a completed or cancelled task from the middle of the heap is
+ * O(log n) too. Tasks with equal deadlines run in queueing order.
+ */
+
+static inline struct edf_task_pdata *edf_queue_pdata(struct task *task)
+{
+	return edf_sch_get_pdata(task);
+}
+
+static bool edf_queue_before(struct task *a, struct task *b)
+{
+	struct edf_task_pdata *pa = edf_queue_pdata(a);
+	struct edf_task_pdata *pb = edf_queue_pdata(b);
+
+	if (pa->deadline != pb->deadline)
+		return pa->deadline < pb->deadline;
+
+	/* let the order number wrap */
+	return (int32_t)(pa->seq - pb->seq) < 0;
+}
+
+static void edf_queue_set(struct edf_queue *queue, int idx, struct task *task)
+{
+	queue->tasks[idx] = task;
+	edf_queue_pdata(task)->queue_idx = idx;
+}
+
+static void edf_queue_up(struct edf_queue *queue, int idx)
+{
+	struct task *task = queue->tasks[idx];
+	int parent;
+
+	while (idx > 0) {
+		parent = (idx - 1) >> 1;
+		if (!edf_queue_before(task, queue->tasks[parent]))
+			break;
+
+		edf_queue_set(queue, idx, queue->tasks[parent]);
+		idx = parent;
+	}
+
+	edf_queue_set(queue, idx, task);
+}
+
+static void edf_queue_down(struct edf_queue *queue, int idx)
+{
+	struct task *task = queue->tasks[idx];
+	int child;
+
+	while ((child = 2 * idx + 1) < queue->count) {
+		if (child + 1 < queue->count &&
+		    edf_queue_before(queue->tasks[child + 1],
+				     queue->tasks[child]))
+			child++;
+
+		if (!edf_queue_before(queue->tasks[child], task))
+			break;
+
+		edf_queue_set(queue, idx, queue->tasks[child]);
+		idx = child;
+	}
+
+	edf_queue_set(queue, idx, task);
+}
+
+/* Makes room for size tasks, so that insertion never needs to allocate */
+int edf_queue_reserve(struct edf_queue *queue, int size)
+{
+	struct task **tasks;
+	int ret;
+
+	if (size <= queue->size)
+		return 0;
+
+	tasks = rzalloc(SOF_MEM_ZONE_SYS_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			size * sizeof(*tasks));
+	if (!tasks)
+		return -ENOMEM;
+
+	if (queue->count) {
+		ret = memcpy_s(tasks, size * sizeof(*tasks), queue->tasks,
+			       queue->count * sizeof(*tasks));
+		assert(!ret);
+	}
+
+	rfree(queue->tasks);
+	queue->tasks = tasks;
+	queue->size = size;
+
+	return 0;
+}
+
+void edf_queue_free(struct edf_queue *queue)
+{
+	rfree(queue->tasks);
+	queue->tasks = NULL;
+	queue->count = 0;
+	queue->size = 0;
+}
+
+void edf_queue_insert(struct edf_queue *queue, struct task *task,
+		      uint64_t deadline)
+{
+	struct edf_task_pdata *pdata = edf_queue_pdata(task);
+
+	/* room is reserved when the task is initialised */
+	assert(queue->count < queue->size);
+
+	pdata->deadline = deadline;
+	pdata->seq = queue->seq++;
+
+	queue->tasks[queue->count] = task;
+	edf_queue_up(queue, queue->count++);
+}
+
+void edf_queue_remove(struct edf_queue *queue, struct task *task)
+{
+	int idx = edf_queue_pdata(task)->queue_idx;
+
+	assert(idx < queue->count && queue->tasks[idx] == task);
+
+	/* move the last task to the hole and restore the heap order */
+	if (--queue->count == idx)
+		return;
+
+	queue->tasks[idx] = queue->tasks[queue->count];
+	if (idx > 0 && edf_queue_before(queue->tasks[idx],
+					queue->tasks[(idx - 1) >> 1]))
+		edf_queue_up(queue, idx);
+	else
+		edf_queue_down(queue, idx);
+}
+
+/* Called when a queued task starts to run */
+void edf_task_stats_start(struct task *task, uint64_t now)
+{
+	struct edf_task_pdata *pdata = edf_queue_pdata(task);
+	uint32_t latency = now - pdata->ready;
+
+	pdata->stats.runs++;
+	if (latency > pdata->stats.latency_max)
+		pdata->stats.latency_max = latency;
+}
+
+/* Called when a task completes its run */
+void edf_task_stats_complete(struct task *task, uint64_t now)
+{
+	struct edf_task_pdata *pdata = edf_queue_pdata(task);
+
+	if (edf_deadline_is_time(pdata->deadline) && now > pdata->deadline)
+		pdata->stats.missed++;
+}
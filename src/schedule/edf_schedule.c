@@ -30,7 +30,9 @@ DECLARE_SOF_UUID("edf-schedule", edf_sched_uuid, 0x77de2074, 0x828c, 0x4044,
 DECLARE_TR_CTX(edf_tr, SOF_UUID(edf_sched_uuid), LOG_LEVEL_INFO);
 
 struct edf_schedule_data {
-	struct list_item list;	/* list of tasks in priority queue */
+	struct edf_queue queue;	/* queued and running tasks */
+	struct list_item tasks;	/* all initialised tasks, by task->list */
+	int num_tasks;		/* number of initialised tasks */
 	uint32_t clock;
 	int irq;
 };
@@ -58,39 +60,15 @@ static void schedule_edf_task_run(struct task *task, void *data)
 static void edf_scheduler_run(void *data)
 {
 	struct edf_schedule_data *edf_sch = data;
-	uint64_t deadline_next = SOF_TASK_DEADLINE_IDLE;
-	struct task *task_next = NULL;
-	struct list_item *tlist;
-	struct task *task;
-	uint64_t deadline;
+	struct task *task_next;
 	uint32_t flags;
 
 	tr_dbg(&edf_tr, "edf_scheduler_run()");
 
 	irq_local_disable(flags);
 
-	/* find next task to run */
-	list_for_item(tlist, &edf_sch->list) {
-		task = container_of(tlist, struct task, list);
-
-		if (task->state != SOF_TASK_STATE_QUEUED &&
-		    task->state != SOF_TASK_STATE_RUNNING)
-			continue;
-
-		deadline = task_get_deadline(task);
-
-		if (deadline == SOF_TASK_DEADLINE_NOW) {
-			/* task needs to be scheduled ASAP */
-			task_next = task;
-			break;
-		}
-
-		/* get earliest deadline */
-		if (deadline <= deadline_next) {
-			deadline_next = deadline;
-			task_next = task;
-		}
-	}
+	/* the earliest deadline is at the top of the ready queue */
+	task_next = edf_queue_first(&edf_sch->queue);
 
 	irq_local_enable(flags);
 
@@ -104,6 +82,7 @@ static int schedule_edf_task(void *data, struct task *task, uint64_t start,
 			     uint64_t period)
 {
 	struct edf_schedule_data *edf_sch = data;
+	struct edf_task_pdata *edf_pdata = edf_sch_get_pdata(task);
 	uint32_t flags;
 	(void) period; /* not used */
 	(void) start; /* not used */
@@ -119,8 +98,9 @@ static int schedule_edf_task(void *data, struct task *task, uint64_t start,
 		return -EALREADY;
 	}
 
-	/* add task to the list */
-	list_item_append(&task->list, &edf_sch->list);
+	/* add task to the ready queue, the deadline is read once here */
+	edf_pdata->ready = platform_timer_get(timer_get());
+	edf_queue_insert(&edf_sch->queue, task, task_get_deadline(task));
 
 	task->state = SOF_TASK_STATE_QUEUED;
 
@@ -135,7 +115,9 @@ int schedule_task_init_edf(struct task *task, const struct sof_uuid_entry *uid,
 			   const struct task_ops *ops,
 			   void *data, uint16_t core, uint32_t flags)
 {
+	struct edf_schedule_data *edf_sch;
 	struct edf_task_pdata *edf_pdata = NULL;
+	uint32_t irq_flags;
 	int ret = 0;
 
 	ret = schedule_task_init(task, uid, SOF_SCHEDULE_EDF, 0, ops->run, data,
@@ -160,9 +142,23 @@ int schedule_task_init_edf(struct task *task, const struct sof_uuid_entry *uid,
 
 	if (task_context_alloc(&edf_pdata->ctx) < 0)
 		goto error;
+	edf_sch = scheduler_get_data(SOF_SCHEDULE_EDF);
 	if (task_context_init(edf_pdata->ctx, &schedule_edf_task_run,
-			      task, scheduler_get_data(SOF_SCHEDULE_EDF),
-			      task->core, NULL, 0) < 0)
+			      task, edf_sch, task->core, NULL, 0) < 0)
+		goto error;
+
+	/* make room for the task in the ready queue */
+	irq_local_disable(irq_flags);
+
+	ret = edf_queue_reserve(&edf_sch->queue, edf_sch->num_tasks + 1);
+	if (!ret) {
+		edf_sch->num_tasks++;
+		list_item_append(&task->list, &edf_sch->tasks);
+	}
+
+	irq_local_enable(irq_flags);
+
+	if (ret < 0)
 		goto error;
 
 	/* flush for secondary core */
@@ -189,6 +185,10 @@ static int schedule_edf_task_running(void *data, struct task *task)
 
 	irq_local_disable(flags);
 
+	/* a preempted task resumes in running state */
+	if (task->state == SOF_TASK_STATE_QUEUED)
+		edf_task_stats_start(task, platform_timer_get(timer_get()));
+
 	task_context_set(edf_pdata->ctx);
 	task->state = SOF_TASK_STATE_RUNNING;
 
@@ -199,6 +199,7 @@ static int schedule_edf_task_running(void *data, struct task *task)
 
 static int schedule_edf_task_complete(void *data, struct task *task)
 {
+	struct edf_schedule_data *edf_sch = data;
 	uint32_t flags;
 
 	tr_dbg(&edf_tr, "schedule_edf_task_complete()");
@@ -208,7 +209,8 @@ static int schedule_edf_task_complete(void *data, struct task *task)
 	task_complete(task);
 
 	task->state = SOF_TASK_STATE_COMPLETED;
-	list_item_del(&task->list);
+	edf_queue_remove(&edf_sch->queue, task);
+	edf_task_stats_complete(task, platform_timer_get(timer_get()));
 
 	irq_local_enable(flags);
 
@@ -217,6 +219,7 @@ static int schedule_edf_task_complete(void *data, struct task *task)
 
 static int schedule_edf_task_cancel(void *data, struct task *task)
 {
+	struct edf_schedule_data *edf_sch = data;
 	uint32_t flags;
 
 	tr_dbg(&edf_tr, "schedule_edf_task_cancel()");
@@ -226,7 +229,7 @@ static int schedule_edf_task_cancel(void *data, struct task *task)
 	/* cancel and delete only if queued */
 	if (task->state == SOF_TASK_STATE_QUEUED) {
 		task->state = SOF_TASK_STATE_CANCEL;
-		list_item_del(&task->list);
+		edf_queue_remove(&edf_sch->queue, task);
 	}
 
 	irq_local_enable(flags);
@@ -236,13 +239,21 @@ static int schedule_edf_task_cancel(void *data, struct task *task)
 
 static int schedule_edf_task_free(void *data, struct task *task)
 {
+	struct edf_schedule_data *edf_sch = data;
 	struct edf_task_pdata *edf_pdata = edf_sch_get_pdata(task);
 	uint32_t flags;
 
 	irq_local_disable(flags);
 
+	if (task->state == SOF_TASK_STATE_QUEUED ||
+	    task->state == SOF_TASK_STATE_RUNNING)
+		edf_queue_remove(&edf_sch->queue, task);
+
 	task->state = SOF_TASK_STATE_FREE;
 
+	list_item_del(&task->list);
+	edf_sch->num_tasks--;
+
 	task_context_free(edf_pdata->ctx);
 	edf_pdata->ctx = NULL;
 	rfree(edf_pdata);
@@ -261,7 +272,7 @@ int scheduler_init_edf(void)
 
 	edf_sch = rzalloc(SOF_MEM_ZONE_SYS, 0, SOF_MEM_CAPS_RAM,
 			  sizeof(*edf_sch));
-	list_init(&edf_sch->list);
+	list_init(&edf_sch->tasks);
 	edf_sch->clock = PLATFORM_DEFAULT_CLOCK;
 
 	scheduler_init(SOF_SCHEDULE_EDF, &schedule_edf_ops, edf_sch);
@@ -295,11 +306,40 @@ static void scheduler_free_edf(void *data)
 	/* free main task context */
 	task_main_free();
 
-	list_item_del(&edf_sch->list);
+	edf_queue_free(&edf_sch->queue);
 
 	irq_local_enable(flags);
 }
 
+int schedule_edf_task_stats(struct edf_task_info *info, int count)
+{
+	struct edf_schedule_data *edf_sch =
+		scheduler_get_data(SOF_SCHEDULE_EDF);
+	struct edf_task_pdata *edf_pdata;
+	struct list_item *tlist;
+	struct task *task;
+	uint32_t flags;
+	int i = 0;
+
+	irq_local_disable(flags);
+
+	list_for_item(tlist, &edf_sch->tasks) {
+		if (i == count)
+			break;
+
+		task = container_of(tlist, struct task, list);
+		edf_pdata = edf_sch_get_pdata(task);
+		info[i].uid = task->uid;
+		info[i].state = task->state;
+		info[i].stats = edf_pdata->stats;
+		i++;
+	}
+
+	irq_local_enable(flags);
+
+	return i;
+}
+
 static void schedule_edf(void *data)
 {
 	struct edf_schedule_data *edf_sch = data;
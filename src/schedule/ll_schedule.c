@@ -17,6 +17,7 @@
 #include <sof/lib/notifier.h>
 #include <sof/lib/perf_cnt.h>
 #include <sof/lib/uuid.h>
+#include <sof/math/numbers.h>
 #include <sof/list.h>
 #include <sof/platform.h>
 #include <sof/schedule/ll_schedule.h>
@@ -50,6 +51,9 @@ struct ll_schedule_data {
 
 const struct scheduler_ops schedule_ll_ops;
 
+/* weight of the last run in the average run time is 1/2^LL_AVG_SHIFT */
+#define LL_AVG_SHIFT	4
+
 #define perf_ll_sched_trace(pcd, ll_sched)			\
 	tr_info(&ll_tr, "perf ll_work peak plat %u cpu %u",	\
 		(uint32_t)((pcd)->plat_delta_peak),		\
@@ -87,10 +91,75 @@ static void schedule_ll_task_update_start(struct ll_schedule_data *sch,
 
 	next = sch->domain->ticks_per_ms * pdata->period / 1000;
 
-	if (sch->domain->synchronous)
+	if (sch->domain->multi_rate && next) {
+		/* stay on the period grid, skip periods missed by a late run */
+		do
+			task->start += next;
+		while (task->start <= last_tick);
+	} else if (sch->domain->synchronous) {
 		task->start += next;
-	else
+	} else {
 		task->start = next + last_tick;
+	}
+}
+
+/* records the earliest start of the tasks of this core in the domain */
+static void schedule_ll_next_tick_update(struct ll_schedule_data *sch)
+{
+	struct list_item *tlist;
+	struct task *task;
+	uint64_t next = 0;
+
+	list_for_item(tlist, &sch->tasks) {
+		task = container_of(tlist, struct task, list);
+		if (!next || task->start < next)
+			next = task->start;
+	}
+
+	/* read by other cores arming the domain */
+	spin_lock(&sch->domain->lock);
+
+	sch->domain->next_tick[cpu_get_id()] = next;
+
+	platform_shared_commit(sch->domain, sizeof(*sch->domain));
+
+	spin_unlock(&sch->domain->lock);
+}
+
+static void schedule_ll_task_budget_update(struct task *task)
+{
+	struct ll_task_pdata *pdata = ll_sch_get_pdata(task);
+
+	if (pdata->budget_hint)
+		pdata->budget = pdata->budget_hint;
+	else
+		pdata->budget = MIN(pdata->period *
+				    clock_get_freq(CLK_CPU(cpu_get_id())) /
+				    1000000, UINT32_MAX);
+}
+
+static void schedule_ll_task_account(struct task *task, uint32_t cycles)
+{
+	struct ll_task_pdata *pdata = ll_sch_get_pdata(task);
+	struct ll_task_stats *stats = &pdata->stats;
+	bool peak = cycles > stats->cycles_peak;
+
+	if (stats->runs++)
+		stats->cycles_avg += (int32_t)(cycles - stats->cycles_avg) >>
+			LL_AVG_SHIFT;
+	else
+		stats->cycles_avg = cycles;
+
+	if (peak)
+		stats->cycles_peak = cycles;
+
+	if (!pdata->budget || cycles <= pdata->budget)
+		return;
+
+	/* trace the first overrun and the new peaks only */
+	if (!stats->overruns++ || peak)
+		tr_warn(&ll_tr, "task %p id %u overrun %u cycles budget %u",
+			task, pdata->id, cycles, pdata->budget);
 }
 
 static void schedule_ll_tasks_execute(struct ll_schedule_data *sch,
@@ -99,6 +168,7 @@ static void schedule_ll_tasks_execute(struct ll_schedule_data *sch,
 	struct list_item *wlist;
 	struct list_item *tlist;
 	struct task *task;
+	uint32_t cycles;
 	int cpu = cpu_get_id();
 	int count;
 
@@ -110,7 +180,12 @@ static void schedule_ll_tasks_execute(struct ll_schedule_data *sch,
 		if (task->state != SOF_TASK_STATE_PENDING)
 			continue;
 
+		cycles = (uint32_t)arch_timer_get_system(cpu_timer_get());
 		task->state = task_run(task);
+		cycles = (uint32_t)arch_timer_get_system(cpu_timer_get()) -
+			cycles;
+
+		schedule_ll_task_account(task, cycles);
 
 		/* do we need to reschedule this task */
 		if (task->state == SOF_TASK_STATE_COMPLETED) {
@@ -196,6 +271,9 @@ static void schedule_ll_tasks_run(void *data)
 	if (schedule_ll_is_pending(sch))
 		schedule_ll_tasks_execute(sch, last_tick);
 
+	if (sch->domain->multi_rate)
+		schedule_ll_next_tick_update(sch);
+
 	notifier_event(sch, NOTIFIER_ID_LL_POST_RUN,
 		       NOTIFIER_TARGET_CORE_LOCAL, NULL, 0);
 
@@ -274,6 +352,7 @@ static void schedule_ll_domain_clear(struct ll_schedule_data *sch,
 	count = atomic_sub(&sch->num_tasks, 1);
 	if (count == 1) {
 		sch->domain->registered[cpu_get_id()] = false;
+		sch->domain->next_tick[cpu_get_id()] = 0;
 
 		/* reschedule if we are the last client */
 		if (atomic_read(&sch->domain->num_clients)) {
@@ -319,6 +398,35 @@ static void schedule_ll_task_insert(struct task *task, struct list_item *tasks)
 	list_item_append(&task->list, tasks);
 }
 
+/* On a multi rate domain the first start of a task is the next point of
+ * its period grid, so tasks whose periods are multiples of each other
+ * always run in the same wakeups. The domain is rearmed when it would
+ * sleep past the start.
+ */
+static void schedule_ll_task_start_grid(struct ll_schedule_data *sch,
+					struct task *task)
+{
+	struct ll_task_pdata *pdata = ll_sch_get_pdata(task);
+	uint64_t period = sch->domain->ticks_per_ms * pdata->period / 1000;
+	uint64_t now = platform_timer_get(timer_get());
+	uint64_t *next;
+
+	task->start += now;
+	if (period)
+		task->start = (task->start + period - 1) / period * period;
+
+	spin_lock(&sch->domain->lock);
+
+	next = &sch->domain->next_tick[cpu_get_id()];
+	if (!*next || task->start < *next)
+		*next = task->start;
+
+	if (task->start < sch->domain->last_tick)
+		domain_set(sch->domain, now);
+
+	spin_unlock(&sch->domain->lock);
+}
+
 static int schedule_ll_task(void *data, struct task *task, uint64_t start,
 			    uint64_t period)
 {
@@ -352,6 +460,7 @@ static int schedule_ll_task(void *data, struct task *task, uint64_t start,
 			task->priority, task->flags, UINT_MAX);
 
 	pdata->period = period;
+	schedule_ll_task_budget_update(task);
 
 	/* insert task into the list */
 	schedule_ll_task_insert(task, &sch->tasks);
@@ -365,7 +474,9 @@ static int schedule_ll_task(void *data, struct task *task, uint64_t start,
 
 	task->start = sch->domain->ticks_per_ms * start / 1000;
 
-	if (sch->domain->synchronous)
+	if (sch->domain->multi_rate)
+		schedule_ll_task_start_grid(sch, task);
+	else if (sch->domain->synchronous)
 		task->start += platform_timer_get(timer_get());
 	else
 		task->start += sch->domain->last_tick;
@@ -407,6 +518,85 @@ int schedule_task_init_ll(struct task *task,
 	return 0;
 }
 
+void schedule_task_budget_ll(struct task *task, uint32_t id, uint32_t budget)
+{
+	struct ll_task_pdata *pdata = ll_sch_get_pdata(task);
+
+	pdata->id = id;
+	pdata->budget_hint = budget;
+}
+
+int schedule_ll_task_stats(uint16_t type, struct ll_task_info *info,
+			   int count)
+{
+	struct ll_schedule_data *sch = scheduler_get_data(type);
+	struct ll_task_pdata *pdata;
+	struct list_item *tlist;
+	struct task *task;
+	uint32_t flags;
+	int i = 0;
+
+	if (!sch)
+		return 0;
+
+	irq_local_disable(flags);
+
+	list_for_item(tlist, &sch->tasks) {
+		if (i == count)
+			break;
+
+		task = container_of(tlist, struct task, list);
+		pdata = ll_sch_get_pdata(task);
+		info[i].uid = task->uid;
+		info[i].id = pdata->id;
+		info[i].budget = pdata->budget;
+		info[i].stats = pdata->stats;
+		i++;
+	}
+
+	irq_local_enable(flags);
+
+	return i;
+}
+
+uint32_t schedule_ll_load(void)
+{
+	static const uint16_t types[] = {
+		SOF_SCHEDULE_LL_TIMER, SOF_SCHEDULE_LL_DMA,
+	};
+	struct ll_schedule_data *sch;
+	struct ll_task_pdata *pdata;
+	struct list_item *tlist;
+	struct task *task;
+	uint64_t load = 0;
+	uint32_t cycles;
+	uint32_t flags;
+	int i;
+
+	irq_local_disable(flags);
+
+	for (i = 0; i < ARRAY_SIZE(types); i++) {
+		sch = scheduler_get_data(types[i]);
+		if (!sch)
+			continue;
+
+		list_for_item(tlist, &sch->tasks) {
+			task = container_of(tlist, struct task, list);
+			pdata = ll_sch_get_pdata(task);
+			if (!pdata->period)
+				continue;
+
+			cycles = pdata->stats.runs ? pdata->stats.cycles_avg :
+				pdata->budget_hint;
+			load += (uint64_t)cycles * 1000 / pdata->period;
+		}
+	}
+
+	irq_local_enable(flags);
+
+	return MIN(load, UINT32_MAX);
+}
+
 static int schedule_ll_task_free(void *data, struct task *task)
 {
 	struct ll_task_pdata *ll_pdata;
@@ -527,7 +717,13 @@ static void ll_scheduler_recalculate_tasks(struct ll_schedule_data *sch,
 		task->start = delta_ms ?
 			current + sch->domain->ticks_per_ms * delta_ms :
 			current + (sch->domain->ticks_per_ms >> 3);
+
+		/* budgets of whole periods follow the clock */
+		schedule_ll_task_budget_update(task);
 	}
+
+	if (sch->domain->multi_rate)
+		schedule_ll_next_tick_update(sch);
 }
 
 static void ll_scheduler_notify(void *arg, enum notify_id type, void *data)
@@ -8,6 +8,7 @@
 #include <sof/lib/alloc.h>
 #include <sof/lib/cpu.h>
 #include <sof/lib/memory.h>
+#include <sof/math/numbers.h>
 #include <sof/platform.h>
 #include <sof/schedule/ll_schedule.h>
 #include <sof/schedule/ll_schedule_domain.h>
@@ -233,16 +234,17 @@ static void timer_domain_set(struct ll_schedule_domain *domain, uint64_t start)
 	uint64_t ticks_req = ticks_tout + start;
 	uint64_t ticks_set;
 
+	/* sleep through the ticks without a task due */
+	if (domain->multi_rate)
+		ticks_req = MAX(ticks_req, domain_next_tick(domain));
+
 #ifdef __ZEPHYR__
 	uint64_t ticks_delta;
 	int core = cpu_get_id();
 
-	/* work out next start time relative to start */
-	ticks_delta = ticks_req - platform_timer_get(timer_domain->timer);
-
-	/* have we overshot the period length ?? */
-	if (ticks_delta > ticks_tout)
-		ticks_delta = ticks_tout;
+	/* work out next start time relative to now */
+	ticks_delta = domain_ticks_delta(ticks_req, start,
+					 platform_timer_get(timer_domain->timer));
 
 	k_delayed_work_submit_to_queue(&timer_domain[core].ll_workq[core],
 				       &zdata[core].work,
@@ -299,6 +301,10 @@ struct ll_schedule_domain *timer_domain_init(struct timer *timer, int clk,
 	timer_domain->timer = timer;
 	timer_domain->timeout = timeout;
 
+#if CONFIG_SCHEDULE_LL_MULTI_RATE
+	domain->multi_rate = true;
+#endif
+
 	ll_sch_domain_set_pdata(domain, timer_domain);
 
 	platform_shared_commit(domain, sizeof(*domain));
@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <errno.h>
+#include <cmocka.h>
+
+#include <sof/audio/asrc/asrc_drift.h>
+#include <sof/audio/format.h>
+#include <sof/math/numbers.h>
+
+/* Timestamps of a 48 kHz DAI against a 19.2 MHz wall clock, taken
+ * every 48 samples as the component copy() does.
+ */
+#define TEST_FS			48000
+#define TEST_WALCLK_RATE	19200000
+#define TEST_PERIOD		48
+#define TEST_UPDATES		1000
+
+/* Allowed error of the final estimate */
+#define TEST_TOLERANCE		Q_CONVERT_FLOAT(5e-6, 30)
+
+struct test_stream {
+	double skew;		/* rate factor of the DAI */
+	double ts;		/* exact wall clock time */
+	uint32_t seed;
+	int jitter;		/* peak timestamp jitter in ticks */
+	int32_t sample;
+};
+
+static void test_stream_init(struct test_stream *s, double skew, int jitter)
+{
+	s->skew = skew;
+	s->jitter = jitter;
+	s->seed = 1;
+
+	/* start close to the wrap of the timestamps */
+	s->ts = INT32_MAX - 10 * TEST_WALCLK_RATE / 1000;
+	s->sample = INT32_MAX - 10 * TEST_PERIOD;
+}
+
+/* Update with the next timestamp of the synthetic stream */
+static int test_stream_update(struct test_stream *s, struct asrc_drift *drift)
+{
+	int64_t ts;
+	int jitter = 0;
+
+	if (s->jitter) {
+		s->seed = s->seed * 1103515245 + 12345;
+		jitter = (int)((s->seed >> 16) % (2 * s->jitter + 1)) -
+			s->jitter;
+	}
+
+	ts = (int64_t)s->ts + jitter;
+	s->ts += (double)TEST_PERIOD * TEST_WALCLK_RATE / TEST_FS * s->skew;
+	s->sample = (int32_t)((uint32_t)s->sample + TEST_PERIOD);
+
+	return asrc_drift_update(drift, (int32_t)(uint32_t)ts, s->sample,
+				 TEST_WALCLK_RATE, TEST_FS);
+}
+
+static void test_run(struct asrc_drift *drift,
+		     enum asrc_drift_estimator estimator, double skew,
+		     int jitter)
+{
+	struct test_stream s;
+	int ret;
+	int i;
+
+	test_stream_init(&s, skew, jitter);
+	assert_int_equal(asrc_drift_init(drift, estimator,
+					 Q_CONVERT_FLOAT(1.0, 30)), 0);
+
+	/* the first timestamp only seeds the deltas */
+	assert_int_equal(test_stream_update(&s, drift), 0);
+
+	for (i = 0; i < TEST_UPDATES; i++) {
+		ret = test_stream_update(&s, drift);
+		assert_int_equal(ret, 1);
+	}
+
+	assert_int_equal(drift->metrics.updates, TEST_UPDATES);
+	assert_true(ABS(drift->skew - (int32_t)(skew * (1 << 30))) <
+		    TEST_TOLERANCE);
+	assert_true(drift->metrics.locked);
+	assert_int_equal(drift->metrics.lock_losses, 0);
+}
+
+static void test_audio_asrc_drift_kalman(void **state)
+{
+	struct asrc_drift drift;
+
+	(void)state;
+
+	test_run(&drift, ASRC_DRIFT_KALMAN, 1.0001, 1);
+
+	/* lock in some tens of 1 ms updates */
+	assert_true(drift.metrics.lock_updates < 64);
+	assert_true(drift.metrics.lock_time_us < 64000);
+	assert_true(drift.metrics.jitter_max > 0);
+}
+
+static void test_audio_asrc_drift_lpf(void **state)
+{
+	struct asrc_drift drift;
+
+	(void)state;
+
+	test_run(&drift, ASRC_DRIFT_LPF, 0.9999, 1);
+	assert_true(drift.metrics.lock_updates > 64);
+}
+
+static void test_audio_asrc_drift_faster_lock(void **state)
+{
+	struct asrc_drift kalman;
+	struct asrc_drift lpf;
+
+	(void)state;
+
+	test_run(&kalman, ASRC_DRIFT_KALMAN, 0.9998, 2);
+	test_run(&lpf, ASRC_DRIFT_LPF, 0.9998, 2);
+	assert_true(kalman.metrics.lock_updates <
+		    lpf.metrics.lock_updates / 2);
+	assert_true(kalman.metrics.lock_time_us < lpf.metrics.lock_time_us);
+}
+
+static void test_audio_asrc_drift_failed_timestamp(void **state)
+{
+	struct asrc_drift drift;
+
+	(void)state;
+
+	assert_int_equal(asrc_drift_init(&drift, ASRC_DRIFT_ESTIMATORS,
+					 Q_CONVERT_FLOAT(1.0, 30)), -EINVAL);
+
+	assert_int_equal(asrc_drift_init(&drift, ASRC_DRIFT_KALMAN,
+					 Q_CONVERT_FLOAT(1.0, 30)), 0);
+	assert_int_equal(asrc_drift_update(&drift, 0, 0, TEST_WALCLK_RATE,
+					   TEST_FS), 0);
+
+	/* no samples between the timestamps */
+	assert_int_equal(asrc_drift_update(&drift, 19200, 0,
+					   TEST_WALCLK_RATE, TEST_FS),
+			 -EINVAL);
+	assert_int_equal(drift.skew, Q_CONVERT_FLOAT(1.0, 30));
+	assert_int_equal(drift.metrics.updates, 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_asrc_drift_kalman),
+		cmocka_unit_test(test_audio_asrc_drift_lpf),
+		cmocka_unit_test(test_audio_asrc_drift_faster_lock),
+		cmocka_unit_test(test_audio_asrc_drift_failed_timestamp),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/drivers/ipc.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#define TEST_BUFFERS	3
+
+static const uint32_t test_size[TEST_BUFFERS] = { 200, 64, 384 };
+
+static void test_buffers_new(struct comp_buffer **buffers)
+{
+	struct sof_ipc_buffer desc;
+	int i;
+
+	for (i = 0; i < TEST_BUFFERS; i++) {
+		memset(&desc, 0, sizeof(desc));
+		desc.comp.id = i;
+		desc.size = test_size[i];
+		buffers[i] = buffer_new(&desc);
+		assert_non_null(buffers[i]);
+	}
+}
+
+static void test_audio_buffer_arena_new(void **state)
+{
+	struct comp_buffer *buffers[TEST_BUFFERS];
+	struct buffer_arena *arena;
+	char *addr;
+	int i;
+
+	(void)state;
+
+	test_buffers_new(buffers);
+	assert_int_equal(buffer_arena_new(buffers, TEST_BUFFERS), 0);
+
+	arena = buffers[0]->arena;
+	assert_non_null(arena);
+	assert_int_equal(arena->users, TEST_BUFFERS);
+
+	/* buffers follow each other at cache line boundaries */
+	addr = arena->addr;
+	for (i = 0; i < TEST_BUFFERS; i++) {
+		assert_ptr_equal(buffers[i]->arena, arena);
+		assert_ptr_equal(buffers[i]->stream.addr, addr);
+		assert_int_equal(buffers[i]->stream.size, test_size[i]);
+		assert_int_equal(audio_stream_get_free_bytes(&buffers[i]->stream),
+				 test_size[i]);
+		addr += ALIGN_UP(test_size[i], PLATFORM_DCACHE_ALIGN);
+	}
+
+	/* smaller size stays in place, bigger one leaves the arena */
+	addr = buffers[1]->stream.addr;
+	assert_int_equal(buffer_set_size(buffers[1], 32), 0);
+	assert_ptr_equal(buffers[1]->stream.addr, addr);
+	assert_ptr_equal(buffers[1]->arena, arena);
+	assert_int_equal(buffer_set_size(buffers[1], 128), 0);
+	assert_null(buffers[1]->arena);
+	assert_int_equal(buffers[1]->stream.size, 128);
+	assert_int_equal(arena->users, TEST_BUFFERS - 1);
+
+	for (i = 0; i < TEST_BUFFERS; i++)
+		buffer_free(buffers[i]);
+}
+
+static void test_audio_buffer_arena_inplace(void **state)
+{
+	struct comp_buffer *buffers[TEST_BUFFERS];
+	struct comp_buffer *packed[2];
+	struct sof_ipc_buffer desc = {
+		.size = test_size[0],
+	};
+	void *own;
+
+	(void)state;
+
+	test_buffers_new(buffers);
+	buffer_free(buffers[1]);
+	buffers[1] = buffer_new(&desc);
+
+	/* in-place sink has no memory to pack, it follows its source */
+	assert_int_equal(buffer_inplace_attach(buffers[1], buffers[0]), 0);
+	packed[0] = buffers[0];
+	packed[1] = buffers[2];
+	assert_int_equal(buffer_arena_new(packed, 2), 0);
+	assert_null(buffers[1]->arena);
+	assert_ptr_equal(buffers[0]->stream.addr, buffers[0]->arena->addr);
+	assert_ptr_equal(buffers[1]->stream.addr, buffers[0]->stream.addr);
+	assert_int_equal(buffers[0]->arena->users, 2);
+
+	/* detached sink gets memory of its own */
+	assert_int_equal(buffer_inplace_detach(buffers[1]), 0);
+	own = buffers[1]->stream.addr;
+	assert_non_null(own);
+	assert_ptr_not_equal(own, buffers[0]->stream.addr);
+
+	buffer_free(buffers[2]);
+	buffer_free(buffers[0]);
+	buffer_free(buffers[1]);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_buffer_arena_new),
+		cmocka_unit_test(test_audio_buffer_arena_inplace),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
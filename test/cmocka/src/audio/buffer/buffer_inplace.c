@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/drivers/ipc.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#define TEST_BUFFER_SIZE	256
+
+static struct comp_buffer *test_buffer_new(uint32_t id)
+{
+	struct sof_ipc_buffer desc = {
+		.comp.id = id,
+		.size = TEST_BUFFER_SIZE,
+	};
+
+	return buffer_new(&desc);
+}
+
+/* what an in-place component does for the bytes */
+static void test_process(struct comp_buffer *source, struct comp_buffer *sink,
+			 uint32_t bytes)
+{
+	assert_ptr_equal(source->stream.r_ptr, sink->stream.w_ptr);
+
+	comp_update_buffer_produce(sink, bytes);
+	comp_update_buffer_consume(source, bytes);
+}
+
+static void test_audio_buffer_inplace_pair(void **state)
+{
+	struct comp_buffer *source = test_buffer_new(1);
+	struct comp_buffer *sink = test_buffer_new(2);
+
+	(void)state;
+
+	assert_int_equal(buffer_inplace_attach(sink, source), 0);
+	assert_true(buffer_is_inplace(sink));
+	assert_false(buffer_is_inplace(source));
+	assert_ptr_equal(sink->stream.addr, source->stream.addr);
+
+	comp_update_buffer_produce(source, 96);
+	assert_int_equal(audio_stream_get_free_bytes(&source->stream), 160);
+
+	/* processed bytes still occupy the memory until sink is read */
+	test_process(source, sink, 64);
+	assert_int_equal(audio_stream_get_avail_bytes(&source->stream), 32);
+	assert_int_equal(audio_stream_get_avail_bytes(&sink->stream), 64);
+	assert_int_equal(audio_stream_get_free_bytes(&source->stream), 160);
+	assert_int_equal(audio_stream_get_free_bytes(&sink->stream), 192);
+
+	comp_update_buffer_consume(sink, 64);
+	assert_int_equal(audio_stream_get_free_bytes(&source->stream), 224);
+
+	/* fill the memory across the wrap */
+	comp_update_buffer_produce(source, 224);
+	assert_int_equal(audio_stream_get_free_bytes(&source->stream), 0);
+	test_process(source, sink, 256);
+	assert_int_equal(audio_stream_get_free_bytes(&source->stream), 0);
+	assert_int_equal(audio_stream_get_avail_bytes(&sink->stream), 256);
+
+	comp_update_buffer_consume(sink, 128);
+	assert_int_equal(audio_stream_get_free_bytes(&source->stream), 128);
+
+	buffer_free(sink);
+	buffer_free(source);
+}
+
+static void test_audio_buffer_inplace_chain(void **state)
+{
+	struct comp_buffer *a = test_buffer_new(1);
+	struct comp_buffer *b = test_buffer_new(2);
+	struct comp_buffer *c = test_buffer_new(3);
+
+	(void)state;
+
+	/* playback prepares from the sink end of the chain */
+	assert_int_equal(buffer_inplace_attach(c, b), 0);
+	assert_int_equal(buffer_inplace_attach(b, a), 0);
+	assert_ptr_equal(b->stream.addr, a->stream.addr);
+	assert_ptr_equal(c->stream.addr, a->stream.addr);
+
+	comp_update_buffer_produce(a, 128);
+	test_process(a, b, 96);
+	test_process(b, c, 64);
+	assert_int_equal(audio_stream_get_free_bytes(&a->stream), 128);
+	assert_int_equal(audio_stream_get_free_bytes(&b->stream), 160);
+	assert_int_equal(audio_stream_get_free_bytes(&c->stream), 192);
+
+	comp_update_buffer_consume(c, 64);
+	assert_int_equal(audio_stream_get_free_bytes(&a->stream), 192);
+	assert_int_equal(audio_stream_get_free_bytes(&b->stream), 224);
+
+	/* detached buffer takes the rest of the chain along */
+	assert_int_equal(buffer_inplace_detach(b), 0);
+	assert_false(buffer_is_inplace(b));
+	assert_ptr_not_equal(b->stream.addr, a->stream.addr);
+	assert_ptr_equal(c->stream.addr, b->stream.addr);
+	assert_int_equal(audio_stream_get_free_bytes(&a->stream), 224);
+	assert_int_equal(audio_stream_get_free_bytes(&b->stream), 256);
+
+	buffer_free(a);
+	buffer_free(b);
+	buffer_free(c);
+}
+
+static void test_audio_buffer_inplace_size_mismatch(void **state)
+{
+	struct sof_ipc_buffer desc = {
+		.size = TEST_BUFFER_SIZE / 2,
+	};
+	struct comp_buffer *source = test_buffer_new(1);
+	struct comp_buffer *sink = buffer_new(&desc);
+
+	(void)state;
+
+	assert_int_not_equal(buffer_inplace_attach(sink, source), 0);
+	assert_false(buffer_is_inplace(sink));
+
+	buffer_free(sink);
+	buffer_free(source);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_buffer_inplace_pair),
+		cmocka_unit_test(test_audio_buffer_inplace_chain),
+		cmocka_unit_test(test_audio_buffer_inplace_size_mismatch),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
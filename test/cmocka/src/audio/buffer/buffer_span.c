@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/audio_stream.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#define TEST_CHANNELS		3
+#define TEST_SOURCE_FRAMES	32
+#define TEST_SINK_FRAMES	20
+
+static int32_t source_data[TEST_SOURCE_FRAMES * TEST_CHANNELS];
+static int16_t sink_data[TEST_SINK_FRAMES * TEST_CHANNELS];
+
+static void test_stream_init(struct audio_stream *stream, void *data,
+			     size_t size, enum sof_ipc_frame fmt)
+{
+	memset(stream, 0, sizeof(*stream));
+	stream->addr = data;
+	stream->end_addr = (char *)data + size;
+	stream->size = size;
+	stream->channels = TEST_CHANNELS;
+	stream->frame_fmt = fmt;
+}
+
+/* The spans must visit the same samples as the frag macros, in order */
+static void test_span(int r, int w, int offset, int frames)
+{
+	struct audio_stream_span span;
+	struct audio_stream source;
+	struct audio_stream sink;
+	int idx = offset * TEST_CHANNELS;
+	int spans = 0;
+	int i;
+
+	test_stream_init(&source, source_data, sizeof(source_data),
+			 SOF_IPC_FRAME_S32_LE);
+	test_stream_init(&sink, sink_data, sizeof(sink_data),
+			 SOF_IPC_FRAME_S16_LE);
+	source.r_ptr = &source_data[r * TEST_CHANNELS];
+	sink.w_ptr = &sink_data[w * TEST_CHANNELS];
+
+	audio_stream_span_init(&span, &source, &sink, offset, frames);
+	while (audio_stream_span_next(&span)) {
+		for (i = 0; i < span.samples; i++, idx++) {
+			assert_ptr_equal((const int32_t *)span.src + i,
+					 audio_stream_read_frag_s32(&source,
+								    idx));
+			assert_ptr_equal((int16_t *)span.snk + i,
+					 audio_stream_write_frag_s16(&sink,
+								     idx));
+		}
+		spans++;
+	}
+
+	assert_int_equal(idx, (offset + frames) * TEST_CHANNELS);
+
+	/* a span ends only at a wrap of either stream */
+	assert_true(spans <= 3);
+}
+
+static void test_audio_stream_span_no_wrap(void **state)
+{
+	(void)state;
+
+	test_span(0, 0, 0, TEST_SINK_FRAMES);
+}
+
+static void test_audio_stream_span_wrap(void **state)
+{
+	int r;
+	int w;
+	int offset;
+	int frames;
+
+	(void)state;
+
+	for (r = 0; r < TEST_SOURCE_FRAMES; r++)
+		for (w = 0; w < TEST_SINK_FRAMES; w++)
+			for (offset = 0; offset < 4; offset++)
+				for (frames = 0;
+				     offset + frames <= TEST_SINK_FRAMES;
+				     frames++)
+					test_span(r, w, offset, frames);
+}
+
+static void test_audio_stream_span_source_only(void **state)
+{
+	struct audio_stream_span span;
+	struct audio_stream source;
+	int idx = 0;
+	int i;
+
+	(void)state;
+
+	test_stream_init(&source, source_data, sizeof(source_data),
+			 SOF_IPC_FRAME_S32_LE);
+	source.r_ptr = &source_data[(TEST_SOURCE_FRAMES - 1) * TEST_CHANNELS];
+
+	audio_stream_span_init(&span, &source, NULL, 0, TEST_SOURCE_FRAMES);
+	while (audio_stream_span_next(&span)) {
+		assert_null(span.snk);
+		for (i = 0; i < span.samples; i++, idx++)
+			assert_ptr_equal((const int32_t *)span.src + i,
+					 audio_stream_read_frag_s32(&source,
+								    idx));
+	}
+
+	assert_int_equal(idx, TEST_SOURCE_FRAMES * TEST_CHANNELS);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_stream_span_no_wrap),
+		cmocka_unit_test(test_audio_stream_span_wrap),
+		cmocka_unit_test(test_audio_stream_span_source_only),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/drivers/ipc.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <math.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+/* drops the local stream state and reads it back from the positions */
+static void buffer_resync(struct comp_buffer *buf)
+{
+	uint32_t flags = 0;
+
+	buf->stream.r_ptr = NULL;
+	buf->stream.w_ptr = NULL;
+	buf->stream.avail = 0;
+	buf->stream.free = 0;
+
+	buffer_lock(buf, &flags);
+	buffer_unlock(buf, flags);
+}
+
+static void test_audio_buffer_spsc_produce_consume_wrap(void **state)
+{
+	(void)state;
+
+	struct sof_ipc_buffer test_buf_desc = {
+		.size = 10
+	};
+
+	struct comp_buffer *buf = buffer_new(&test_buf_desc);
+	char *addr;
+
+	assert_non_null(buf);
+	assert_int_equal(buffer_set_inter_core(buf), 0);
+	assert_non_null(buf->spsc);
+
+	addr = buf->stream.addr;
+
+	comp_update_buffer_produce(buf, 6);
+	comp_update_buffer_consume(buf, 4);
+	buffer_resync(buf);
+
+	assert_int_equal(audio_stream_get_avail_bytes(&buf->stream), 2);
+	assert_int_equal(audio_stream_get_free_bytes(&buf->stream), 8);
+	assert_ptr_equal(buf->stream.r_ptr, addr + 4);
+	assert_ptr_equal(buf->stream.w_ptr, addr + 6);
+
+	/* fill up across the wrap, full is told apart from empty */
+	comp_update_buffer_produce(buf, 8);
+	buffer_resync(buf);
+
+	assert_int_equal(audio_stream_get_avail_bytes(&buf->stream), 10);
+	assert_int_equal(audio_stream_get_free_bytes(&buf->stream), 0);
+	assert_ptr_equal(buf->stream.r_ptr, addr + 4);
+	assert_ptr_equal(buf->stream.w_ptr, addr + 4);
+
+	comp_update_buffer_consume(buf, 10);
+	buffer_resync(buf);
+
+	assert_int_equal(audio_stream_get_avail_bytes(&buf->stream), 0);
+	assert_int_equal(audio_stream_get_free_bytes(&buf->stream), 10);
+	assert_ptr_equal(buf->stream.r_ptr, addr + 4);
+	assert_ptr_equal(buf->stream.w_ptr, addr + 4);
+
+	buffer_reset_pos(buf, NULL);
+	buffer_resync(buf);
+
+	assert_int_equal(audio_stream_get_avail_bytes(&buf->stream), 0);
+	assert_ptr_equal(buf->stream.r_ptr, addr);
+	assert_ptr_equal(buf->stream.w_ptr, addr);
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_spsc_not_used_on_overrun(void **state)
+{
+	(void)state;
+
+	struct sof_ipc_buffer test_buf_desc = {
+		.size = 10,
+		.flags = SOF_BUF_OVERRUN_PERMITTED,
+	};
+
+	struct comp_buffer *buf = buffer_new(&test_buf_desc);
+
+	assert_non_null(buf);
+	assert_int_equal(buffer_set_inter_core(buf), 0);
+	assert_true(buf->inter_core);
+	assert_null(buf->spsc);
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_spsc_not_used_on_underrun(void **state)
+{
+	(void)state;
+
+	struct sof_ipc_buffer test_buf_desc = {
+		.size = 10,
+		.flags = SOF_BUF_UNDERRUN_PERMITTED,
+	};
+
+	struct comp_buffer *buf = buffer_new(&test_buf_desc);
+
+	assert_non_null(buf);
+	assert_int_equal(buffer_set_inter_core(buf), 0);
+	assert_true(buf->inter_core);
+	assert_null(buf->spsc);
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_spsc_reader_passes_writer(void **state)
+{
+	(void)state;
+
+	struct sof_ipc_buffer test_buf_desc = {
+		.size = 10
+	};
+
+	struct comp_buffer *buf = buffer_new(&test_buf_desc);
+	char *addr;
+
+	assert_non_null(buf);
+	assert_int_equal(buffer_set_inter_core(buf), 0);
+	assert_non_null(buf->spsc);
+
+	addr = buf->stream.addr;
+
+	comp_update_buffer_produce(buf, 2);
+	comp_update_buffer_consume(buf, 4);
+	buffer_resync(buf);
+
+	assert_int_equal(audio_stream_get_avail_bytes(&buf->stream), 0);
+	assert_int_equal(audio_stream_get_free_bytes(&buf->stream), 10);
+	assert_ptr_equal(buf->stream.r_ptr, addr + 4);
+	assert_ptr_equal(buf->stream.w_ptr, addr + 2);
+
+	/* same across the wrap of the positions */
+	comp_update_buffer_produce(buf, 18);
+	comp_update_buffer_consume(buf, 19);
+	buffer_resync(buf);
+
+	assert_int_equal(audio_stream_get_avail_bytes(&buf->stream), 0);
+	assert_int_equal(audio_stream_get_free_bytes(&buf->stream), 10);
+
+	buffer_free(buf);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_buffer_spsc_produce_consume_wrap),
+		cmocka_unit_test(test_audio_buffer_spsc_not_used_on_overrun),
+		cmocka_unit_test(test_audio_buffer_spsc_not_used_on_underrun),
+		cmocka_unit_test(test_audio_buffer_spsc_reader_passes_writer),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
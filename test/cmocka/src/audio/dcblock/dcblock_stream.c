@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/component.h>
+#include <sof/audio/dcblock/dcblock.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#define TEST_CHANNELS		2
+#define TEST_FRAMES		4
+#define TEST_SINK_FRAMES	8
+#define TEST_SINK_FILL		0x55
+
+/* sink frames already holding data, the filter writes after them */
+#define TEST_SINK_USED		3
+
+static int32_t source_data[TEST_FRAMES * TEST_CHANNELS];
+static int32_t sink_data[TEST_SINK_FRAMES * TEST_CHANNELS];
+static struct comp_data cd;
+static struct comp_dev dev;
+
+static void test_stream_init(struct audio_stream *stream, void *data,
+			     size_t size, enum sof_ipc_frame fmt)
+{
+	memset(stream, 0, sizeof(*stream));
+	stream->addr = data;
+	stream->end_addr = (char *)data + size;
+	stream->size = size;
+	stream->channels = TEST_CHANNELS;
+	stream->frame_fmt = fmt;
+	stream->r_ptr = data;
+	stream->w_ptr = data;
+}
+
+static int32_t test_input(int frame, int ch)
+{
+	return 100 * (frame + 1) + ch;
+}
+
+/* With R = 0 the filter outputs x[n] - x[n-1], so the first frame comes
+ * out as it is and every later one as the step between frames.
+ */
+static void test_dcblock(enum sof_ipc_frame fmt, size_t sample_bytes)
+{
+	struct audio_stream source;
+	struct audio_stream sink;
+	dcblock_func func = dcblock_find_func(fmt);
+	size_t frame_bytes = sample_bytes * TEST_CHANNELS;
+	uint8_t fill[TEST_SINK_USED * TEST_CHANNELS * sizeof(int32_t)];
+	int32_t expect;
+	int32_t y;
+	int idx;
+	int f;
+	int c;
+
+	assert_non_null(func);
+
+	memset(&cd, 0, sizeof(cd));
+	dev.priv_data = &cd;
+
+	test_stream_init(&source, source_data, TEST_FRAMES * frame_bytes,
+			 fmt);
+	test_stream_init(&sink, sink_data, TEST_SINK_FRAMES * frame_bytes,
+			 fmt);
+	memset(sink_data, TEST_SINK_FILL, sizeof(sink_data));
+	memset(fill, TEST_SINK_FILL, sizeof(fill));
+	sink.w_ptr = (char *)sink_data + TEST_SINK_USED * frame_bytes;
+
+	for (f = 0; f < TEST_FRAMES; f++)
+		for (c = 0; c < TEST_CHANNELS; c++) {
+			if (sample_bytes == sizeof(int16_t))
+				((int16_t *)source_data)[f * TEST_CHANNELS + c] =
+					test_input(f, c);
+			else
+				source_data[f * TEST_CHANNELS + c] =
+					test_input(f, c);
+		}
+
+	func(&dev, &source, &sink, TEST_FRAMES);
+
+	/* data the sink already held stays */
+	assert_memory_equal(sink_data, fill, TEST_SINK_USED * frame_bytes);
+
+	for (f = 0; f < TEST_FRAMES; f++)
+		for (c = 0; c < TEST_CHANNELS; c++) {
+			idx = f * TEST_CHANNELS + c;
+			if (sample_bytes == sizeof(int16_t))
+				y = *(int16_t *)audio_stream_write_frag_s16(&sink,
+									    idx);
+			else
+				y = *(int32_t *)audio_stream_write_frag_s32(&sink,
+									    idx);
+
+			expect = f ? test_input(f, c) - test_input(f - 1, c) :
+				test_input(f, c);
+			assert_int_equal(y, expect);
+		}
+}
+
+#if CONFIG_FORMAT_S16LE
+static void test_dcblock_s16(void **state)
+{
+	(void)state;
+
+	test_dcblock(SOF_IPC_FRAME_S16_LE, sizeof(int16_t));
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE
+static void test_dcblock_s24(void **state)
+{
+	(void)state;
+
+	test_dcblock(SOF_IPC_FRAME_S24_4LE, sizeof(int32_t));
+}
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+static void test_dcblock_s32(void **state)
+{
+	(void)state;
+
+	test_dcblock(SOF_IPC_FRAME_S32_LE, sizeof(int32_t));
+}
+#endif /* CONFIG_FORMAT_S32LE */
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+#if CONFIG_FORMAT_S16LE
+		cmocka_unit_test(test_dcblock_s16),
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+		cmocka_unit_test(test_dcblock_s24),
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+		cmocka_unit_test(test_dcblock_s32),
+#endif /* CONFIG_FORMAT_S32LE */
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -55,6 +55,13 @@ int schedule_task_init_ll(struct task *task,
 	return 0;
 }
 
+void schedule_task_budget_ll(struct task *task, uint32_t id, uint32_t budget)
+{
+	(void)task;
+	(void)id;
+	(void)budget;
+}
+
 void rfree(void *ptr)
 {
 	(void)ptr;
@@ -130,3 +137,26 @@ int comp_verify_params(struct comp_dev *dev, uint32_t flag,
 	(void)params;
 	return 0;
 }
+
+int buffer_inplace_attach(struct comp_buffer *sink, struct comp_buffer *source)
+{
+	(void)sink;
+	(void)source;
+
+	return 0;
+}
+
+int buffer_inplace_detach(struct comp_buffer *buffer)
+{
+	(void)buffer;
+
+	return 0;
+}
+
+int buffer_arena_new(struct comp_buffer **buffers, uint32_t count)
+{
+	(void)buffers;
+	(void)count;
+
+	return 0;
+}
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <math.h>
+#include <errno.h>
+#include <cmocka.h>
+
+#include <sof/audio/src/src.h>
+#include <sof/audio/src/src_config.h>
+#include <sof/common.h>
+
+/* Tolerance of the sub-filter DC gain */
+#define CMP_TOLERANCE 0.01
+
+struct test_rates {
+	int fs_in;
+	int fs_out;
+	int stages;
+};
+
+static const struct test_rates test_rates[] = {
+	{ 48000, 48000, 0 },
+	{ 48000, 16000, 1 },
+	{ 16000, 48000, 1 },
+	{ 32000, 24000, 1 },
+	{ 48000, 44100, 2 },
+	{ 44100, 48000, 2 },
+	{ 8000, 192000, 2 },
+	{ 192000, 8000, 2 },
+	{ 11025, 16000, 2 },
+	{ 176400, 12000, 2 },
+};
+
+static double test_coef(const struct src_stage *s, int i)
+{
+#if SRC_SHORT
+	return ((const int16_t *)s->coefs)[i] / 32768.0;
+#else
+	return ((const int32_t *)s->coefs)[i] / 2147483648.0;
+#endif
+}
+
+/* Checks the DC gain of every sub-filter of a stage */
+static void test_stage_gain(const struct src_stage *s, double gain)
+{
+	double sum;
+	int i;
+	int j;
+
+	for (i = 0; i < s->num_of_subfilters; i++) {
+		sum = 0;
+		for (j = 0; j < s->subfilter_length; j++)
+			sum += test_coef(s, i * s->subfilter_length + j);
+
+		assert_true(fabs(ldexp(sum, -s->shift) - gain) < CMP_TOLERANCE);
+	}
+}
+
+static void test_audio_src_coef_design(void **state)
+{
+	const struct test_rates *r;
+	struct src_stage *s1;
+	struct src_stage *s2;
+	double gain;
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < ARRAY_SIZE(test_rates); i++) {
+		struct src_param a = { 0 };
+
+		r = &test_rates[i];
+		assert_int_equal(src_coef_design(&a, r->fs_in, r->fs_out), 0);
+
+		s1 = a.stage1;
+		s2 = a.stage2;
+
+		/* the stages convert exactly between the rates */
+		assert_int_equal((int64_t)r->fs_in * s1->blk_out * s2->blk_out,
+				 (int64_t)r->fs_out * s1->blk_in * s2->blk_in);
+		assert_int_equal(s1->filter_length == 1 ? 0 :
+				 s2->filter_length == 1 ? 1 : 2, r->stages);
+
+		/* -1 dB in total */
+		gain = r->stages == 2 ? pow(10, -0.5 / 20) : pow(10, -1.0 / 20);
+		if (r->stages) {
+			assert_int_equal(s1->subfilter_length % 4, 0);
+			assert_int_equal(s1->filter_length,
+					 s1->num_of_subfilters *
+					 s1->subfilter_length);
+			test_stage_gain(s1, gain);
+		}
+
+		if (r->stages == 2) {
+			assert_int_equal(s2->subfilter_length % 4, 0);
+			test_stage_gain(s2, gain);
+		}
+
+		src_coef_free(&a);
+		assert_null(a.conv);
+	}
+}
+
+static void test_audio_src_coef_reuse(void **state)
+{
+	struct src_param a = { 0 };
+	struct src_conv *conv;
+
+	(void)state;
+
+	assert_int_equal(src_coef_design(&a, 48000, 44100), 0);
+	conv = a.conv;
+
+	/* same rates keep the filters */
+	assert_int_equal(src_coef_design(&a, 48000, 44100), 0);
+	assert_ptr_equal(a.conv, conv);
+
+	/* new rates design new filters */
+	assert_int_equal(src_coef_design(&a, 44100, 48000), 0);
+	assert_int_equal(a.stage1->blk_in, 7);
+	assert_int_equal(a.stage1->num_of_subfilters, 8);
+
+	src_coef_free(&a);
+}
+
+static void test_audio_src_coef_unsupported(void **state)
+{
+	struct src_param a = { 0 };
+
+	(void)state;
+
+	/* the filters would exceed the delay line limits */
+	assert_int_equal(src_coef_design(&a, 11025, 192000), -EINVAL);
+	assert_null(a.conv);
+
+	assert_int_equal(src_coef_design(&a, 0, 48000), -EINVAL);
+	assert_null(a.conv);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_src_coef_design),
+		cmocka_unit_test(test_audio_src_coef_reuse),
+		cmocka_unit_test(test_audio_src_coef_unsupported),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -27,6 +27,13 @@ void WEAK *rballoc_align(uint32_t flags, uint32_t caps, size_t bytes,
 	return malloc(bytes);
 }
 
+size_t WEAK rballoc_heap_size(void *ptr)
+{
+	(void)ptr;
+
+	return 0;
+}
+
 void WEAK *rzalloc(enum mem_zone zone, uint32_t flags, uint32_t caps,
 		   size_t bytes)
 {
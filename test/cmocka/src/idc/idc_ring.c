@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/drivers/idc.h>
+#include <sof/lib/cpu.h>
+#include <sof/sof.h>
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#define TEST_EXECUTED_MAX	64
+
+/* the test posts to the ring of its own core and drains it itself */
+static struct idc_ring test_rings[PLATFORM_CORE_COUNT][PLATFORM_CORE_COUNT];
+static struct idc test_idc;
+static struct core_context test_ctx;
+
+static uint32_t executed[TEST_EXECUTED_MAX];
+static uint32_t executed_count;
+
+static struct sof sof;
+
+struct tr_ctx idc_tr;
+
+struct sof *sof_get(void)
+{
+	return &sof;
+}
+
+#if CONFIG_MULTICORE
+int idc_send_msg(struct idc_msg *msg, uint32_t mode)
+{
+	(void)msg;
+	(void)mode;
+
+	return 0;
+}
+#endif
+
+uint64_t clock_ms_to_ticks(int clock, uint64_t ms)
+{
+	(void)clock;
+
+	return ms;
+}
+
+/* records the message, its status is the extension */
+int idc_cmd_run(struct idc_msg *msg)
+{
+	uint32_t *data = msg->payload;
+
+	if (msg->payload)
+		assert_int_equal(*data, msg->header);
+
+	executed[executed_count++] = msg->header;
+
+	return msg->extension;
+}
+
+static int setup(void **state)
+{
+	(void)state;
+
+	memset(test_rings, 0, sizeof(test_rings));
+	test_idc.ring = &test_rings[0][0];
+	test_ctx.idc = &test_idc;
+	cpu_write_threadptr((int)&test_ctx);
+	executed_count = 0;
+
+	return 0;
+}
+
+static struct idc_ring *test_ring(void)
+{
+	return idc_ring_get(&test_idc, cpu_get_id(), cpu_get_id());
+}
+
+static int test_post(uint32_t header, uint32_t *cookie)
+{
+	struct idc_msg msg = { header, header + 1, cpu_get_id(),
+		sizeof(header), &header, };
+
+	return idc_ring_post(&msg, cookie);
+}
+
+static void test_idc_ring_post_drain(void **state)
+{
+	struct idc_ring *ring = test_ring();
+	uint32_t cookie[3];
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < 3; i++)
+		assert_int_equal(test_post(i, &cookie[i]), 0);
+
+	/* nothing runs before the doorbell */
+	assert_int_equal(executed_count, 0);
+	assert_int_equal(ring->doorbell, 0);
+
+	/* one doorbell for all of them */
+	assert_int_equal(idc_ring_flush(cpu_get_id()), 0);
+	assert_int_equal(ring->doorbell, 1);
+	assert_false(idc_ring_bell_set(ring));
+
+	assert_int_equal(idc_ring_drain(cpu_get_id()), 0);
+	assert_int_equal(executed_count, 3);
+	assert_int_equal(ring->doorbell, 0);
+	assert_int_equal(ring->tail, ring->head);
+
+	for (i = 0; i < 3; i++) {
+		assert_int_equal(executed[i], i);
+		assert_int_equal(idc_ring_wait(cpu_get_id(), cookie[i]), i + 1);
+	}
+
+	/* empty ring doesn't ring */
+	assert_int_equal(idc_ring_flush(cpu_get_id()), 0);
+	assert_int_equal(ring->doorbell, 0);
+}
+
+static void test_idc_ring_full(void **state)
+{
+	struct idc_ring *ring = test_ring();
+	uint32_t head;
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < CONFIG_IDC_RING_DEPTH; i++)
+		assert_int_equal(test_post(i, NULL), 0);
+
+	/* messages nobody waits for are dropped and counted */
+	head = ring->head;
+	assert_int_equal(test_post(i, NULL), -EBUSY);
+	assert_int_equal(test_post(i, NULL), -EBUSY);
+	assert_int_equal(ring->head, head);
+	assert_int_equal(ring->dropped, 2);
+
+	assert_int_equal(idc_ring_drain(cpu_get_id()), 0);
+	assert_int_equal(executed_count, CONFIG_IDC_RING_DEPTH);
+
+	assert_int_equal(test_post(i, NULL), 0);
+	assert_int_equal(ring->dropped, 2);
+}
+
+static void test_idc_ring_wrap(void **state)
+{
+	int posted = 0;
+	int i;
+
+	(void)state;
+
+	/* batches not dividing the depth start all over the ring */
+	while (posted < 3 * CONFIG_IDC_RING_DEPTH + 1) {
+		for (i = 0; i < CONFIG_IDC_RING_DEPTH - 1; i++)
+			assert_int_equal(test_post(posted + i, NULL), 0);
+
+		assert_int_equal(idc_ring_drain(cpu_get_id()), 0);
+		posted += i;
+	}
+
+	assert_int_equal(executed_count, posted);
+	for (i = 0; i < posted; i++)
+		assert_int_equal(executed[i], i);
+}
+
+static void test_idc_ring_cookie_wrap(void **state)
+{
+	struct idc_ring *ring = test_ring();
+	uint32_t cookie[CONFIG_IDC_RING_DEPTH];
+	int i;
+
+	(void)state;
+
+	ring->head = UINT32_MAX - 1;
+	ring->tail = ring->head;
+
+	for (i = 0; i < CONFIG_IDC_RING_DEPTH; i++)
+		assert_int_equal(test_post(i, &cookie[i]), 0);
+
+	/* counters wrapped and the ring still holds every message */
+	assert_int_equal(cookie[1], 0);
+	assert_int_equal(test_post(i, NULL), -EBUSY);
+
+	assert_int_equal(idc_ring_drain(cpu_get_id()), 0);
+	assert_int_equal(ring->tail, ring->head);
+
+	for (i = 0; i < CONFIG_IDC_RING_DEPTH; i++) {
+		assert_int_equal(executed[i], i);
+		assert_int_equal(idc_ring_wait(cpu_get_id(), cookie[i]), i + 1);
+	}
+}
+
+static void test_idc_ring_doorbell_race(void **state)
+{
+	struct idc_ring *ring = test_ring();
+
+	(void)state;
+
+	/* target core emptied the ring but hasn't cleared the doorbell */
+	assert_int_equal(test_post(0, NULL), 0);
+	assert_int_equal(idc_ring_flush(cpu_get_id()), 0);
+	ring->tail = ring->head;
+
+	/* message posted now doesn't ring again */
+	assert_int_equal(test_post(1, NULL), 0);
+	assert_int_equal(idc_ring_flush(cpu_get_id()), 0);
+	assert_int_equal(ring->doorbell, 1);
+
+	/* so clearing the doorbell finds it */
+	assert_true(idc_ring_bell_clear(ring));
+	assert_int_equal(ring->doorbell, 0);
+
+	/* and the drain runs it before returning */
+	ring->doorbell = 1;
+	assert_int_equal(idc_ring_drain(cpu_get_id()), 0);
+	assert_int_equal(executed_count, 1);
+	assert_int_equal(executed[0], 1);
+	assert_false(idc_ring_bell_clear(ring));
+
+	/* next message rings again */
+	assert_int_equal(test_post(2, NULL), 0);
+	assert_int_equal(idc_ring_flush(cpu_get_id()), 0);
+	assert_int_equal(ring->doorbell, 1);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup(test_idc_ring_post_drain, setup),
+		cmocka_unit_test_setup(test_idc_ring_full, setup),
+		cmocka_unit_test_setup(test_idc_ring_wrap, setup),
+		cmocka_unit_test_setup(test_idc_ring_cookie_wrap, setup),
+		cmocka_unit_test_setup(test_idc_ring_doorbell_race, setup),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
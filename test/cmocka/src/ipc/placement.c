@@ -0,0 +1,362 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/drivers/ipc.h>
+#include <sof/lib/cpu.h>
+#include <ipc/header.h>
+#include <ipc/topology.h>
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmocka.h>
+
+#define TEST_OBJECTS	16
+#define TEST_CREATED	0x100
+
+/* objects created by the placement, in creation order */
+static struct ipc_comp_dev test_created[TEST_OBJECTS];
+static uint32_t test_created_count;
+static uint32_t test_fail_id;
+
+static uint32_t test_load[PLATFORM_CORE_COUNT];
+static uint8_t test_comp_data[SOF_IPC_MSG_MAX_SIZE];
+static struct ipc test_ipc;
+
+struct tr_ctx ipc_tr;
+
+void *rmalloc(enum mem_zone zone, uint32_t flags, uint32_t caps, size_t bytes)
+{
+	(void)zone;
+	(void)flags;
+	(void)caps;
+
+	return malloc(bytes);
+}
+
+#if CONFIG_MULTICORE
+int arch_cpu_is_core_enabled(int id)
+{
+	(void)id;
+
+	return 1;
+}
+#endif
+
+uint32_t ipc_core_load(uint32_t core)
+{
+	return test_load[core];
+}
+
+struct ipc_comp_dev *ipc_get_comp_by_id(struct ipc *ipc, uint32_t id)
+{
+	int i;
+
+	(void)ipc;
+
+	for (i = 0; i < test_created_count; i++)
+		if (test_created[i].id == id)
+			return &test_created[i];
+
+	return NULL;
+}
+
+/* creates the object in the mailbox on the given core */
+static int test_create(uint32_t core)
+{
+	struct sof_ipc_comp *comp = (struct sof_ipc_comp *)test_comp_data;
+
+	assert_int_equal(comp->core, core);
+	if (comp->id == test_fail_id)
+		return -EINVAL;
+
+	test_created[test_created_count].id = comp->id;
+	test_created[test_created_count].core = core;
+	test_created[test_created_count].type =
+		(comp->hdr.cmd & SOF_CMD_TYPE_MASK) == SOF_IPC_TPLG_BUFFER_NEW ?
+		COMP_TYPE_BUFFER : COMP_TYPE_COMPONENT;
+	test_created_count++;
+
+	return 0;
+}
+
+int ipc_comp_new(struct ipc *ipc, struct sof_ipc_comp *comp)
+{
+	(void)ipc;
+	(void)comp;
+
+	return test_create(cpu_get_id());
+}
+
+int ipc_buffer_new(struct ipc *ipc, struct sof_ipc_buffer *desc)
+{
+	(void)ipc;
+	(void)desc;
+
+	return test_create(cpu_get_id());
+}
+
+/* the other core reports failures to the host only */
+int ipc_process_on_core(uint32_t core)
+{
+	test_create(core);
+
+	return 1;
+}
+
+static int setup(void **state)
+{
+	(void)state;
+
+	memset(test_created, 0, sizeof(test_created));
+	memset(test_load, 0, sizeof(test_load));
+	test_created_count = 0;
+	test_fail_id = 0;
+	test_ipc.comp_data = test_comp_data;
+	list_init(&test_ipc.placement_list);
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	uint32_t id;
+
+	(void)state;
+
+	/* releases the placements left by a test */
+	for (id = 1; id < 256; id++) {
+		ipc_placement_free(&test_ipc, id);
+		ipc_placement_object_free(&test_ipc, id);
+	}
+
+	assert_true(list_is_empty(&test_ipc.placement_list));
+
+	return 0;
+}
+
+static int test_object(uint32_t cmd, uint32_t pipeline_id, uint32_t id,
+		       uint32_t core)
+{
+	struct sof_ipc_comp comp = {
+		.hdr = { .cmd = SOF_IPC_GLB_TPLG_MSG | cmd,
+			 .size = sizeof(comp) },
+		.id = id,
+		.pipeline_id = pipeline_id,
+		.core = core,
+	};
+	int ret;
+
+	/* 1 if the object waits, the core + TEST_CREATED if created now */
+	ret = ipc_placement_object(&test_ipc, &comp);
+
+	return ret ? ret : comp.core + TEST_CREATED;
+}
+
+static int test_comp(uint32_t pipeline_id, uint32_t id)
+{
+	return test_object(SOF_IPC_TPLG_COMP_NEW, pipeline_id, id,
+			   PLATFORM_PRIMARY_CORE_ID);
+}
+
+static int test_buffer(uint32_t pipeline_id, uint32_t id)
+{
+	return test_object(SOF_IPC_TPLG_BUFFER_NEW, pipeline_id, id,
+			   PLATFORM_PRIMARY_CORE_ID);
+}
+
+static int test_pipe(uint32_t pipeline_id, uint32_t comp_id,
+		     uint32_t sched_id, uint32_t *core)
+{
+	struct sof_ipc_pipe_new pipe = {
+		.hdr = { .cmd = SOF_IPC_GLB_TPLG_MSG | SOF_IPC_TPLG_PIPE_NEW,
+			 .size = sizeof(pipe) },
+		.comp_id = comp_id,
+		.pipeline_id = pipeline_id,
+		.sched_id = sched_id,
+		.core = PLATFORM_PRIMARY_CORE_ID,
+		.period = 1000,
+		.period_mips = 10,
+	};
+	int ret;
+
+	ret = ipc_placement_pipeline(&test_ipc, &pipe);
+	*core = pipe.core;
+
+	return ret;
+}
+
+static void test_ipc_placement_self(void **state)
+{
+	uint32_t core;
+
+	(void)state;
+
+	if (PLATFORM_CORE_COUNT < 2)
+		skip();
+
+	/* objects wait for the pipeline */
+	test_load[PLATFORM_PRIMARY_CORE_ID] = 500;
+	assert_int_equal(test_comp(1, 10), 1);
+	assert_int_equal(test_buffer(1, 11), 1);
+	assert_int_equal(test_comp(1, 12), 1);
+	assert_int_equal(test_created_count, 0);
+
+	/* pipeline scheduled by its own component picks the idle core */
+	assert_int_equal(test_pipe(1, 13, 12, &core), 0);
+	assert_int_equal(core, 1);
+	assert_int_equal(test_created_count, 3);
+	assert_int_equal(test_created[0].id, 10);
+	assert_int_equal(test_created[1].id, 11);
+	assert_int_equal(test_created[1].type, COMP_TYPE_BUFFER);
+	assert_int_equal(test_created[2].id, 12);
+	assert_int_equal(ipc_placement_count(&test_ipc, 1), 1);
+	assert_int_equal(ipc_placement_reserved(&test_ipc, 1), 10);
+
+	/* later objects of the pipeline are created at once on its core */
+	assert_int_equal(test_comp(1, 14), TEST_CREATED + 1);
+}
+
+static void test_ipc_placement_sched_other(void **state)
+{
+	uint32_t core;
+
+	(void)state;
+
+	if (PLATFORM_CORE_COUNT < 2)
+		skip();
+
+	/* DAI pipeline on the idle core */
+	test_load[PLATFORM_PRIMARY_CORE_ID] = 500;
+	assert_int_equal(test_comp(1, 10), 1);
+	assert_int_equal(test_pipe(1, 11, 10, &core), 0);
+	assert_int_equal(core, 1);
+
+	/* PCM pipeline scheduled by the DAI goes with it, even though the
+	 * primary core is the least loaded one now
+	 */
+	test_load[PLATFORM_PRIMARY_CORE_ID] = 0;
+	test_load[1] = 500;
+	assert_int_equal(test_comp(2, 20), 1);
+	assert_int_equal(test_buffer(2, 21), 1);
+	assert_int_equal(test_pipe(2, 22, 10, &core), 0);
+	assert_int_equal(core, 1);
+	assert_int_equal(test_created_count, 3);
+	assert_int_equal(test_created[1].core, 1);
+	assert_int_equal(test_created[2].core, 1);
+	assert_int_equal(ipc_placement_count(&test_ipc, 1), 2);
+}
+
+static void test_ipc_placement_sched_waiting(void **state)
+{
+	uint32_t core;
+
+	(void)state;
+
+	if (PLATFORM_CORE_COUNT < 2)
+		skip();
+
+	/* scheduling component's pipeline isn't created yet */
+	test_load[PLATFORM_PRIMARY_CORE_ID] = 500;
+	assert_int_equal(test_comp(1, 10), 1);
+	assert_int_equal(test_comp(2, 20), 1);
+
+	/* so it is placed along */
+	assert_int_equal(test_pipe(2, 21, 10, &core), 0);
+	assert_int_equal(core, 1);
+	assert_int_equal(test_created_count, 2);
+	assert_int_equal(test_created[0].id, 10);
+	assert_int_equal(test_created[0].core, 1);
+	assert_int_equal(test_created[1].id, 20);
+
+	/* and keeps its core when it's created */
+	test_load[1] = 1000;
+	assert_int_equal(test_pipe(1, 11, 10, &core), 0);
+	assert_int_equal(core, 1);
+	assert_int_equal(test_created_count, 2);
+	assert_int_equal(ipc_placement_count(&test_ipc, 1), 2);
+}
+
+static void test_ipc_placement_topology_core(void **state)
+{
+	uint32_t core;
+
+	(void)state;
+
+	if (PLATFORM_CORE_COUNT < 2)
+		skip();
+
+	/* secondary core set by the topology is created at once */
+	assert_int_equal(test_object(SOF_IPC_TPLG_COMP_NEW, 1, 10, 1),
+			 TEST_CREATED + 1);
+	assert_int_equal(test_created_count, 0);
+	test_created[test_created_count].id = 10;
+	test_created[test_created_count++].core = 1;
+
+	/* pipeline scheduled there keeps the core busy */
+	assert_int_equal(test_pipe(1, 11, 10, &core), 0);
+	assert_int_equal(core, 1);
+	assert_int_equal(ipc_placement_count(&test_ipc, 1), 1);
+}
+
+static void test_ipc_placement_failure(void **state)
+{
+	uint32_t core;
+
+	(void)state;
+
+	/* pipeline failing to create its objects isn't kept */
+	assert_int_equal(test_comp(1, 10), 1);
+	assert_int_equal(test_comp(1, 11), 1);
+	test_fail_id = 11;
+	assert_int_equal(test_pipe(1, 12, 10, &core), -EINVAL);
+	assert_true(list_is_empty(&test_ipc.placement_list));
+
+	/* nor the one the host failed to create */
+	test_fail_id = 0;
+	assert_int_equal(test_comp(2, 20), 1);
+	assert_int_equal(test_pipe(2, 21, 20, &core), 0);
+	assert_int_equal(ipc_placement_count(&test_ipc, core), 1);
+	ipc_placement_drop(&test_ipc, 2);
+	assert_int_equal(ipc_placement_count(&test_ipc, core), 0);
+	assert_true(list_is_empty(&test_ipc.placement_list));
+
+	/* objects of a pipeline never created are freed by the host */
+	assert_int_equal(test_comp(3, 30), 1);
+	assert_int_equal(test_buffer(3, 31), 1);
+	assert_true(ipc_placement_object_free(&test_ipc, 30));
+	assert_false(ipc_placement_object_free(&test_ipc, 30));
+	assert_true(ipc_placement_object_free(&test_ipc, 31));
+	assert_true(list_is_empty(&test_ipc.placement_list));
+
+	/* a created pipeline is released by its component id */
+	assert_int_equal(test_comp(4, 40), 1);
+	assert_int_equal(test_pipe(4, 41, 40, &core), 0);
+	ipc_placement_free(&test_ipc, 41);
+	assert_true(list_is_empty(&test_ipc.placement_list));
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_ipc_placement_self,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_ipc_placement_sched_other,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_ipc_placement_sched_waiting,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_ipc_placement_topology_core,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_ipc_placement_failure,
+						setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
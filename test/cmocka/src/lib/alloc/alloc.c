@@ -4,9 +4,12 @@
 //
 // Author: Slawomir Blauciak <slawomir.blauciak@linux.intel.com>
 
+#include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdint.h>
 #include <stdarg.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <setjmp.h>
 #include <cmocka.h>
@@ -14,13 +17,17 @@
 #include <sof/sof.h>
 #include <sof/lib/alloc.h>
 #include <sof/lib/mm_heap.h>
+#include <sof/lib/slab.h>
+#include <sof/math/numbers.h>
 #include <ipc/header.h>
 #include <ipc/topology.h>
 
 enum test_type {
 	TEST_BULK = 0,
 	TEST_ZERO,
-	TEST_IMMEDIATE_FREE
+	TEST_IMMEDIATE_FREE,
+	TEST_SLAB,
+	TEST_STATS
 };
 
 struct test_case {
@@ -168,6 +175,17 @@ static struct test_case test_cases[] = {
 	TEST_CASE(256, SOF_MEM_ZONE_RUNTIME, SOF_MEM_CAPS_RAM |
 		  SOF_MEM_CAPS_DMA, 2, TEST_ZERO, "rzalloc_dma"),
 
+	/*
+	 * slab cache tests, objects of the buffer cache
+	 */
+
+	TEST_CASE(32,  SOF_MEM_ZONE_RUNTIME, SOF_MEM_CAPS_RAM, 4, TEST_SLAB,
+		  "slab"),
+	TEST_CASE(64,  SOF_MEM_ZONE_RUNTIME, SOF_MEM_CAPS_RAM, 4, TEST_SLAB,
+		  "slab"),
+	TEST_CASE(64,  SOF_MEM_ZONE_RUNTIME, SOF_MEM_CAPS_RAM, 64, TEST_SLAB,
+		  "slab"),
+
 	/*
 	 * rballoc tests
 	 */
@@ -209,6 +227,15 @@ static struct test_case test_cases[] = {
 		  2, TEST_BULK, "rballoc_dma"),
 	TEST_CASE(2048, SOF_MEM_ZONE_BUFFER, SOF_MEM_CAPS_RAM |
 		  SOF_MEM_CAPS_DMA, 100, TEST_IMMEDIATE_FREE, "rballoc_dma"),
+
+	/*
+	 * allocator statistics
+	 */
+
+	TEST_CASE(256, SOF_MEM_ZONE_BUFFER, SOF_MEM_CAPS_RAM, 4, TEST_STATS,
+		  "stats"),
+	TEST_CASE(0x7fffffff, SOF_MEM_ZONE_BUFFER, SOF_MEM_CAPS_RAM, 1,
+		  TEST_STATS, "stats"),
 };
 
 static int setup(void **state)
@@ -313,6 +340,136 @@ static void test_lib_alloc_zero(struct test_case *tc)
 	free(all_mem);
 }
 
+static bool is_zero(const char *mem, size_t size)
+{
+	size_t i;
+
+	for (i = 0; i < size; ++i)
+		if (mem[i])
+			return false;
+
+	return true;
+}
+
+/*
+ * Typed objects come zeroed and in order from one block and are reused
+ * once freed, other runtime allocations never come from the caches.
+ */
+static void test_lib_alloc_slab(struct test_case *tc)
+{
+	int cached = MIN(tc->alloc_num, CONFIG_SLAB_CACHE_OBJECTS);
+	char **all_mem = malloc(sizeof(void *) * tc->alloc_num);
+	struct slab_info before;
+	struct slab_info after;
+	size_t stride;
+	char *heap;
+	int i;
+
+	slab_info_get(&before);
+
+	for (i = 0; i < tc->alloc_num; ++i) {
+		all_mem[i] = slab_zalloc(SLAB_BUFFER, 0, tc->alloc_caps,
+					 tc->alloc_size);
+		assert_non_null(all_mem[i]);
+		assert_true(is_zero(all_mem[i], tc->alloc_size));
+		memset(all_mem[i], 0xa5, tc->alloc_size);
+	}
+
+	stride = cached > 1 ? all_mem[1] - all_mem[0] : tc->alloc_size;
+	assert_true(stride >= tc->alloc_size);
+
+	for (i = 1; i < cached; ++i)
+		assert_ptr_equal(all_mem[i], all_mem[0] + i * stride);
+
+	/* the cache memory and its objects in use are reported */
+	slab_info_get(&after);
+	assert_int_equal(after.used - before.used, cached * stride);
+	assert_true(after.size >= after.used);
+
+	heap = rzalloc(tc->alloc_zone, 0, tc->alloc_caps, tc->alloc_size);
+	assert_non_null(heap);
+	assert_true(heap < all_mem[0] ||
+		    heap >= all_mem[0] + CONFIG_SLAB_CACHE_OBJECTS * stride);
+	rfree(heap);
+
+	rfree(all_mem[0]);
+	assert_ptr_equal(slab_zalloc(SLAB_BUFFER, 0, tc->alloc_caps,
+				     tc->alloc_size), all_mem[0]);
+	assert_true(is_zero(all_mem[0], tc->alloc_size));
+
+	alloc_free((void **)all_mem, tc);
+
+	slab_info_get(&after);
+	assert_int_equal(after.used, before.used);
+
+	free(all_mem);
+}
+
+/* sums up the state of all heaps of the zone */
+static void zone_info(int zone, struct mm_heap_info *info)
+{
+	struct mm_heap_info heap;
+	int i;
+
+	memset(info, 0, sizeof(*info));
+
+	for (i = 0; !heap_info(zone, i, &heap); i++) {
+		assert_true(heap.max_free <= heap.free);
+		info->size += heap.size;
+		info->used += heap.used;
+		info->free += heap.free;
+	}
+
+	assert_true(i > 0);
+}
+
+/* counters follow the allocations and the heaps show the used memory */
+static void test_lib_alloc_stats(struct test_case *tc)
+{
+	void **all_mem = malloc(sizeof(void *) * tc->alloc_num);
+	struct mm_heap_info before;
+	struct mm_heap_info after;
+	struct mm_heap_info none;
+	struct mm_stats start;
+	struct mm_stats end;
+	int expected = 0;
+	int i;
+
+	heap_stats_get(&start);
+	zone_info(tc->alloc_zone, &before);
+
+	for (i = 0; i < tc->alloc_num; ++i) {
+		all_mem[i] = alloc(tc);
+		if (all_mem[i])
+			expected++;
+	}
+
+	heap_stats_get(&end);
+	zone_info(tc->alloc_zone, &after);
+
+	assert_int_equal(end.zone[tc->alloc_zone].allocs -
+			 start.zone[tc->alloc_zone].allocs, expected);
+	assert_int_equal(end.zone[tc->alloc_zone].failures -
+			 start.zone[tc->alloc_zone].failures,
+			 tc->alloc_num - expected);
+	assert_int_equal(after.used + after.free, before.used + before.free);
+
+	if (expected)
+		assert_true(after.used > before.used);
+
+	for (i = 0; i < tc->alloc_num; ++i)
+		rfree(all_mem[i]);
+
+	heap_stats_get(&start);
+	assert_int_equal(start.frees - end.frees, expected);
+	zone_info(tc->alloc_zone, &after);
+	assert_int_equal(after.used, before.used);
+
+	assert_int_equal(heap_info(SOF_MEM_ZONE_COUNT, 0, &none), -EINVAL);
+
+	free(all_mem);
+}
+
 static void test_lib_alloc(void **state)
 {
 	struct test_case *tc = *((struct test_case **)state);
@@ -329,6 +486,14 @@ static void test_lib_alloc(void **state)
 	case TEST_IMMEDIATE_FREE:
 		test_lib_alloc_immediate_free(tc);
 		break;
+
+	case TEST_SLAB:
+		test_lib_alloc_slab(tc);
+		break;
+
+	case TEST_STATS:
+		test_lib_alloc_stats(tc);
+		break;
 	}
 }
 
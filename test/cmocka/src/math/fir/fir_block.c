@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/math/fir_config.h>
+#if FIR_GENERIC
+#include <sof/audio/format.h>
+#include <sof/math/fir_generic.h>
+#include <sof/math/numbers.h>
+#endif
+#include <user/fir.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#define TEST_FRAMES	97
+#define TEST_TAPS	20
+
+#if FIR_GENERIC
+struct test_filter {
+	struct fir_state_32x16 fir;
+	int32_t delay[2 * TEST_TAPS];
+	int16_t blob[SOF_FIR_COEF_NHEADER + TEST_TAPS];
+};
+
+static struct sof_fir_coef_data *test_filter_init(struct test_filter *f,
+						  int out_shift)
+{
+	struct sof_fir_coef_data *config;
+	int32_t *delay = f->delay;
+	uint32_t seed = 7;
+	int i;
+
+	memset(f, 0, sizeof(*f));
+	config = (struct sof_fir_coef_data *)f->blob;
+	config->length = TEST_TAPS;
+	config->out_shift = out_shift;
+	for (i = 0; i < TEST_TAPS; i++) {
+		seed = seed * 1664525 + 1013904223;
+		config->coef[i] = (int16_t)(seed >> 16);
+	}
+
+	assert_true(fir_delay_size(config) <= sizeof(f->delay));
+	fir_init_coef(&f->fir, config);
+	fir_init_delay(&f->fir, &delay);
+
+	return config;
+}
+
+/* noise and full scale steps to exercise saturation */
+static void test_signal(int32_t *x, int n)
+{
+	uint32_t seed = 1;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		seed = seed * 1664525 + 1013904223;
+		x[i] = i % 32 < 16 ? (int32_t)seed : INT32_MAX;
+	}
+}
+
+/* direct convolution with zero initial state */
+static void test_reference(const struct sof_fir_coef_data *config,
+			   const int32_t *x, int32_t *y, int n)
+{
+	int64_t acc;
+	int i;
+	int k;
+
+	for (i = 0; i < n; i++) {
+		acc = 0;
+		for (k = 0; k < config->length && k <= i; k++)
+			acc += (int64_t)config->coef[k] * x[i - k];
+
+		y[i] = sat_int32(acc >> (15 + config->out_shift));
+	}
+}
+
+static void test_sample(int out_shift)
+{
+	struct sof_fir_coef_data *config;
+	struct test_filter f;
+	int32_t x[TEST_FRAMES];
+	int32_t y[TEST_FRAMES];
+	int32_t ref[TEST_FRAMES];
+	int i;
+
+	config = test_filter_init(&f, out_shift);
+	test_signal(x, TEST_FRAMES);
+	test_reference(config, x, ref, TEST_FRAMES);
+
+	for (i = 0; i < TEST_FRAMES; i++)
+		y[i] = fir_32x16(&f.fir, x[i]);
+
+	assert_memory_equal(ref, y, sizeof(ref));
+}
+
+/* frames split to blocks, the last one shorter if they don't divide */
+static void test_block(int block, int out_shift)
+{
+	struct sof_fir_coef_data *config;
+	struct test_filter f;
+	int32_t x[TEST_FRAMES];
+	int32_t y[TEST_FRAMES];
+	int32_t ref[TEST_FRAMES];
+	int i;
+
+	config = test_filter_init(&f, out_shift);
+	test_signal(x, TEST_FRAMES);
+	test_reference(config, x, ref, TEST_FRAMES);
+
+	/* in place, as eq_fir and tdfb use it */
+	memcpy(y, x, sizeof(y));
+	for (i = 0; i < TEST_FRAMES; i += block)
+		fir_32x16_block(&f.fir, &y[i], &y[i],
+				MIN(block, TEST_FRAMES - i));
+
+	assert_memory_equal(ref, y, sizeof(ref));
+}
+#endif
+
+static void test_math_fir_sample(void **state)
+{
+	(void)state;
+
+#if FIR_GENERIC
+	test_sample(0);
+	test_sample(1);
+	test_sample(-1);
+#else
+	skip();
+#endif
+}
+
+static void test_math_fir_block_odd(void **state)
+{
+	(void)state;
+
+#if FIR_GENERIC
+	test_block(1, 0);
+	test_block(3, 1);
+	test_block(7, -1);
+	test_block(TEST_FRAMES, 0);
+#else
+	skip();
+#endif
+}
+
+static void test_math_fir_block_even(void **state)
+{
+	(void)state;
+
+#if FIR_GENERIC
+	test_block(2, 0);
+	test_block(6, 1);
+	test_block(16, -1);
+#else
+	skip();
+#endif
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_math_fir_sample),
+		cmocka_unit_test(test_math_fir_block_odd),
+		cmocka_unit_test(test_math_fir_block_even),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/math/iir_df2t.h>
+#include <user/eq.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#define TEST_FRAMES	100
+#define TEST_BIQUADS	2
+
+/* Coefficients {a2, a1, b2, b1, b0, shift, gain} of a low-pass and of a
+ * high-pass biquad, gain and shift of the second one scale by 0.75.
+ */
+static int32_t test_coef[TEST_BIQUADS * SOF_EQ_IIR_NBIQUAD_DF2T] = {
+	-443244183, 1227280696, 72477573, 144955146, 72477573, 0, 16384,
+	-443244183, 1227280696, 639296736, -1278593472, 639296736, 1, 24576,
+};
+
+struct test_filter {
+	struct iir_state_df2t iir;
+	int64_t delay[TEST_BIQUADS * IIR_DF2T_NUM_DELAYS];
+};
+
+static void test_filter_init(struct test_filter *f, int biquads_in_series)
+{
+	memset(f, 0, sizeof(*f));
+	f->iir.biquads = TEST_BIQUADS;
+	f->iir.biquads_in_series = biquads_in_series;
+	f->iir.coef = test_coef;
+	f->iir.delay = f->delay;
+}
+
+/* noise and full scale steps to exercise rounding and saturation */
+static void test_signal(int32_t *x, int n, uint32_t seed)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		seed = seed * 1664525 + 1013904223;
+		x[i] = i % 40 < 20 ? (int32_t)seed : INT32_MAX;
+	}
+}
+
+static void test_block(int biquads_in_series, int block)
+{
+	struct test_filter ref;
+	struct test_filter f;
+	int32_t x[TEST_FRAMES];
+	int32_t y[TEST_FRAMES];
+	int i;
+
+	test_filter_init(&ref, biquads_in_series);
+	test_filter_init(&f, biquads_in_series);
+	test_signal(x, TEST_FRAMES, 1);
+	test_signal(y, TEST_FRAMES, 1);
+
+	for (i = 0; i < TEST_FRAMES; i++)
+		x[i] = iir_df2t(&ref.iir, x[i]);
+
+	for (i = 0; i < TEST_FRAMES; i += block)
+		iir_df2t_block(&f.iir, &y[i], block);
+
+	assert_memory_equal(x, y, sizeof(x));
+	assert_memory_equal(ref.delay, f.delay, sizeof(ref.delay));
+}
+
+static void test_math_iir_df2t_block_series(void **state)
+{
+	(void)state;
+
+	test_block(TEST_BIQUADS, 10);
+}
+
+static void test_math_iir_df2t_block_parallel(void **state)
+{
+	(void)state;
+
+	test_block(1, 25);
+}
+
+static void test_lanes(int lanes)
+{
+	struct test_filter ref[IIR_DF2T_MAX_LANES];
+	struct test_filter f[IIR_DF2T_MAX_LANES];
+	struct iir_state_df2t *iir[IIR_DF2T_MAX_LANES];
+	int32_t x[IIR_DF2T_MAX_LANES][TEST_FRAMES];
+	int32_t y[IIR_DF2T_MAX_LANES][TEST_FRAMES];
+	int32_t *yp[IIR_DF2T_MAX_LANES];
+	int i;
+	int l;
+
+	for (l = 0; l < lanes; l++) {
+		test_filter_init(&ref[l], TEST_BIQUADS);
+		test_filter_init(&f[l], TEST_BIQUADS);
+		test_signal(x[l], TEST_FRAMES, l + 1);
+		test_signal(y[l], TEST_FRAMES, l + 1);
+		iir[l] = &f[l].iir;
+		yp[l] = y[l];
+
+		for (i = 0; i < TEST_FRAMES; i++)
+			x[l][i] = iir_df2t(&ref[l].iir, x[l][i]);
+	}
+
+	iir_df2t_block_lanes(iir, yp, lanes, TEST_FRAMES);
+
+	for (l = 0; l < lanes; l++) {
+		assert_memory_equal(x[l], y[l], sizeof(x[l]));
+		assert_memory_equal(ref[l].delay, f[l].delay,
+				    sizeof(ref[l].delay));
+	}
+}
+
+static void test_math_iir_df2t_block_lanes_2(void **state)
+{
+	(void)state;
+
+	test_lanes(2);
+}
+
+static void test_math_iir_df2t_block_lanes_3(void **state)
+{
+	(void)state;
+
+	test_lanes(3);
+}
+
+static void test_math_iir_df2t_block_lanes_4(void **state)
+{
+	(void)state;
+
+	test_lanes(IIR_DF2T_MAX_LANES);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_math_iir_df2t_block_series),
+		cmocka_unit_test(test_math_iir_df2t_block_parallel),
+		cmocka_unit_test(test_math_iir_df2t_block_lanes_2),
+		cmocka_unit_test(test_math_iir_df2t_block_lanes_3),
+		cmocka_unit_test(test_math_iir_df2t_block_lanes_4),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
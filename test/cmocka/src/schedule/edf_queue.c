@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <sof/schedule/edf_schedule.h>
+#include <sof/schedule/task.h>
+
+#define TEST_TASKS	16
+
+struct test_queue {
+	struct edf_queue queue;
+	struct task tasks[TEST_TASKS];
+	struct edf_task_pdata pdata[TEST_TASKS];
+};
+
+static int setup(void **state)
+{
+	struct test_queue *tq = test_calloc(1, sizeof(*tq));
+	struct task *task;
+	int i;
+
+	for (i = 0; i < TEST_TASKS; i++) {
+		task = &tq->tasks[i];
+		edf_sch_set_pdata(task, &tq->pdata[i]);
+	}
+
+	*state = tq;
+
+	return edf_queue_reserve(&tq->queue, TEST_TASKS);
+}
+
+static int teardown(void **state)
+{
+	struct test_queue *tq = *state;
+
+	edf_queue_free(&tq->queue);
+	test_free(tq);
+
+	return 0;
+}
+
+/* pops the first task of the queue */
+static struct task *test_pop(struct edf_queue *queue)
+{
+	struct task *task = edf_queue_first(queue);
+
+	if (task)
+		edf_queue_remove(queue, task);
+
+	return task;
+}
+
+static void test_schedule_edf_queue_order(void **state)
+{
+	static const uint64_t deadlines[TEST_TASKS] = {
+		900, 100, 500, SOF_TASK_DEADLINE_IDLE, 300, 700, 200, 800,
+		SOF_TASK_DEADLINE_NOW, 600, 400, 1000, 50, 950, 150, 250,
+	};
+	struct test_queue *tq = *state;
+	struct edf_task_pdata *pdata;
+	struct task *task;
+	uint64_t prev = 0;
+	int i;
+
+	for (i = 0; i < TEST_TASKS; i++)
+		edf_queue_insert(&tq->queue, &tq->tasks[i], deadlines[i]);
+
+	assert_int_equal(tq->queue.count, TEST_TASKS);
+	assert_ptr_equal(edf_queue_first(&tq->queue), &tq->tasks[8]);
+
+	for (i = 0; i < TEST_TASKS; i++) {
+		task = test_pop(&tq->queue);
+		assert_non_null(task);
+		pdata = edf_sch_get_pdata(task);
+		assert_true(pdata->deadline >= prev);
+		prev = pdata->deadline;
+	}
+
+	assert_null(edf_queue_first(&tq->queue));
+}
+
+static void test_schedule_edf_queue_fifo(void **state)
+{
+	struct test_queue *tq = *state;
+	int i;
+
+	/* equal deadlines run in queueing order, across the wrap */
+	tq->queue.seq = UINT32_MAX - TEST_TASKS / 2;
+
+	for (i = 0; i < TEST_TASKS; i++)
+		edf_queue_insert(&tq->queue, &tq->tasks[i],
+				 SOF_TASK_DEADLINE_NOW);
+
+	for (i = 0; i < TEST_TASKS; i++)
+		assert_ptr_equal(test_pop(&tq->queue), &tq->tasks[i]);
+}
+
+static void test_schedule_edf_queue_remove(void **state)
+{
+	struct test_queue *tq = *state;
+	int i;
+
+	for (i = 0; i < TEST_TASKS; i++)
+		edf_queue_insert(&tq->queue, &tq->tasks[i], 1000 - i * 10);
+
+	/* cancel every other task from the middle of the heap */
+	for (i = 0; i < TEST_TASKS; i += 2)
+		edf_queue_remove(&tq->queue, &tq->tasks[i]);
+
+	assert_int_equal(tq->queue.count, TEST_TASKS / 2);
+
+	for (i = TEST_TASKS - 1; i > 0; i -= 2)
+		assert_ptr_equal(test_pop(&tq->queue), &tq->tasks[i]);
+
+	assert_null(edf_queue_first(&tq->queue));
+}
+
+static void test_schedule_edf_queue_reserve(void **state)
+{
+	struct test_queue *tq = *state;
+	int i;
+
+	/* growing keeps the queued tasks */
+	for (i = 0; i < TEST_TASKS; i++)
+		edf_queue_insert(&tq->queue, &tq->tasks[i], i);
+
+	assert_int_equal(edf_queue_reserve(&tq->queue, 2 * TEST_TASKS), 0);
+	assert_int_equal(tq->queue.size, 2 * TEST_TASKS);
+
+	for (i = 0; i < TEST_TASKS; i++)
+		assert_ptr_equal(test_pop(&tq->queue), &tq->tasks[i]);
+}
+
+static void test_schedule_edf_queue_stats(void **state)
+{
+	struct test_queue *tq = *state;
+	struct task *task = &tq->tasks[0];
+	struct edf_task_stats *stats = &tq->pdata[0].stats;
+
+	/* on time run */
+	tq->pdata[0].ready = 1000;
+	edf_queue_insert(&tq->queue, task, 2000);
+	edf_task_stats_start(task, 1200);
+	edf_queue_remove(&tq->queue, task);
+	edf_task_stats_complete(task, 1900);
+
+	assert_int_equal(stats->runs, 1);
+	assert_int_equal(stats->missed, 0);
+	assert_int_equal(stats->latency_max, 200);
+
+	/* late run */
+	tq->pdata[0].ready = 3000;
+	edf_queue_insert(&tq->queue, task, 3500);
+	edf_task_stats_start(task, 3100);
+	edf_queue_remove(&tq->queue, task);
+	edf_task_stats_complete(task, 3600);
+
+	assert_int_equal(stats->runs, 2);
+	assert_int_equal(stats->missed, 1);
+	assert_int_equal(stats->latency_max, 200);
+
+	/* tasks without a time deadline are never late */
+	tq->pdata[0].ready = 4000;
+	edf_queue_insert(&tq->queue, task, SOF_TASK_DEADLINE_IDLE);
+	edf_task_stats_start(task, 4500);
+	edf_queue_remove(&tq->queue, task);
+	edf_task_stats_complete(task, 5000);
+
+	assert_int_equal(stats->runs, 3);
+	assert_int_equal(stats->missed, 1);
+	assert_int_equal(stats->latency_max, 500);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_schedule_edf_queue_order,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_schedule_edf_queue_fifo,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_schedule_edf_queue_remove,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_schedule_edf_queue_reserve,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_schedule_edf_queue_stats,
+						setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
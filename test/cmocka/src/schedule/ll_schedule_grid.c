@@ -0,0 +1,363 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/drivers/timer.h>
+#include <sof/lib/clk.h>
+#include <sof/math/numbers.h>
+#include <sof/schedule/ll_schedule.h>
+#include <sof/schedule/ll_schedule_domain.h>
+#include <sof/schedule/schedule.h>
+#include <sof/schedule/task.h>
+#include <sof/sof.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+/* one tick per microsecond, the domain timeout is a 1 ms system tick */
+#define TEST_TICKS_PER_MS	1000
+#define TEST_SYSTEM_TICK	1000
+
+#define TEST_TASKS		4
+
+/* the platform timer driving the timer domain */
+struct test_timer {
+	void (*handler)(void *arg);
+	void *arg;
+	uint64_t set;		/* ticks of the last platform_timer_set() */
+	uint32_t set_count;
+};
+
+static struct ll_schedule_domain *test_domain;
+static struct test_timer test_platform_timer;
+static struct task test_tasks[TEST_TASKS];
+static uint32_t test_runs[TEST_TASKS];
+static uint64_t test_now;
+
+static struct schedulers *schedulers;
+static struct timer test_timer;
+static struct sof sof;
+
+struct sof *sof_get(void)
+{
+	return &sof;
+}
+
+struct schedulers **arch_schedulers_get(void)
+{
+	return &schedulers;
+}
+
+uint64_t platform_timer_get(struct timer *timer)
+{
+	(void)timer;
+
+	return test_now;
+}
+
+int timer_register(struct timer *timer, void (*handler)(void *arg), void *arg)
+{
+	(void)timer;
+
+	test_platform_timer.handler = handler;
+	test_platform_timer.arg = arg;
+
+	return 0;
+}
+
+void timer_unregister(struct timer *timer, void *arg)
+{
+	(void)timer;
+	(void)arg;
+
+	test_platform_timer.handler = NULL;
+}
+
+void timer_enable(struct timer *timer, void *arg, int core)
+{
+	(void)timer;
+	(void)arg;
+	(void)core;
+}
+
+void timer_disable(struct timer *timer, void *arg, int core)
+{
+	(void)timer;
+	(void)arg;
+	(void)core;
+}
+
+int64_t platform_timer_set(struct timer *timer, uint64_t ticks)
+{
+	(void)timer;
+
+	test_platform_timer.set = ticks;
+	test_platform_timer.set_count++;
+
+	return ticks;
+}
+
+void platform_timer_clear(struct timer *timer)
+{
+	(void)timer;
+}
+
+uint64_t clock_ms_to_ticks(int clock, uint64_t ms)
+{
+	(void)clock;
+
+	return ms * TEST_TICKS_PER_MS;
+}
+
+uint32_t clock_get_freq(int clock)
+{
+	(void)clock;
+
+	return 400000000;
+}
+
+static enum task_state test_task_run(void *data)
+{
+	uint32_t *runs = data;
+
+	(*runs)++;
+
+	return SOF_TASK_STATE_RESCHEDULE;
+}
+
+static int setup(void **state)
+{
+	int i;
+
+	(void)state;
+
+	memset(&test_platform_timer, 0, sizeof(test_platform_timer));
+	memset(test_tasks, 0, sizeof(test_tasks));
+	memset(test_runs, 0, sizeof(test_runs));
+	schedulers = NULL;
+	sof.platform_timer = &test_timer;
+	sof.cpu_timers = &test_timer;
+
+	test_domain = timer_domain_init(&test_timer, 0, TEST_SYSTEM_TICK);
+	test_domain->multi_rate = true;
+
+	scheduler_init_ll(test_domain);
+
+	for (i = 0; i < TEST_TASKS; i++)
+		assert_int_equal(schedule_task_init_ll(&test_tasks[i], NULL,
+						       SOF_SCHEDULE_LL_TIMER,
+						       0, test_task_run,
+						       &test_runs[i], 0, 0),
+				 0);
+
+	return 0;
+}
+
+/* runs the domain as its timer would at the given time */
+static void test_domain_run(uint64_t now)
+{
+	test_now = now;
+	test_platform_timer.handler(test_platform_timer.arg);
+}
+
+static uint64_t test_next_tick(void)
+{
+	return test_domain->next_tick[cpu_get_id()];
+}
+
+static void test_schedule_ll_grid_start(void **state)
+{
+	(void)state;
+
+	/* first starts are the next points of the period grids */
+	test_now = 12345;
+	schedule_task(&test_tasks[0], 0, 1000);
+	schedule_task(&test_tasks[1], 0, 5000);
+	schedule_task(&test_tasks[2], 0, 10000);
+	assert_int_equal(test_tasks[0].start, 13000);
+	assert_int_equal(test_tasks[1].start, 15000);
+	assert_int_equal(test_tasks[2].start, 20000);
+
+	/* start delay is kept before aligning */
+	schedule_task(&test_tasks[3], 3000, 5000);
+	assert_int_equal(test_tasks[3].start, 20000);
+
+	assert_int_equal(test_next_tick(), 13000);
+
+	/* a task already on its grid point stays there */
+	schedule_task_cancel(&test_tasks[0]);
+	test_now = 15000;
+	schedule_task(&test_tasks[0], 0, 5000);
+	assert_int_equal(test_tasks[0].start, 15000);
+}
+
+static void test_schedule_ll_grid_run(void **state)
+{
+	(void)state;
+
+	test_now = 4500;
+	schedule_task(&test_tasks[0], 0, 1000);
+	schedule_task(&test_tasks[1], 0, 5000);
+
+	/* tasks on the same grid point share the wakeup */
+	test_domain_run(5000);
+	assert_int_equal(test_runs[0], 1);
+	assert_int_equal(test_runs[1], 1);
+	assert_int_equal(test_tasks[0].start, 6000);
+	assert_int_equal(test_tasks[1].start, 10000);
+	assert_int_equal(test_next_tick(), 6000);
+
+	/* the 1 ms task alone */
+	test_domain_run(6000);
+	assert_int_equal(test_runs[0], 2);
+	assert_int_equal(test_runs[1], 1);
+	assert_int_equal(test_next_tick(), 7000);
+}
+
+static void test_schedule_ll_grid_skip(void **state)
+{
+	(void)state;
+
+	test_now = 100;
+	schedule_task(&test_tasks[0], 0, 1000);
+	schedule_task(&test_tasks[1], 0, 5000);
+
+	/* a late run runs each task once and skips the periods missed */
+	test_domain->last_tick = 16500;
+	test_domain_run(16500);
+	assert_int_equal(test_runs[0], 1);
+	assert_int_equal(test_runs[1], 1);
+	assert_int_equal(test_tasks[0].start, 17000);
+	assert_int_equal(test_tasks[1].start, 20000);
+	assert_int_equal(test_next_tick(), 17000);
+}
+
+static void test_schedule_ll_grid_idle(void **state)
+{
+	(void)state;
+
+	test_now = 100;
+	schedule_task(&test_tasks[0], 0, 5000);
+	schedule_task(&test_tasks[1], 0, 10000);
+
+	/* the domain sleeps through the system ticks without a task due */
+	test_domain->last_tick = 10000;
+	test_domain_run(10000);
+	assert_int_equal(test_platform_timer.set, 15000);
+	assert_int_equal(test_domain->last_tick, 15000);
+
+	test_domain_run(15000);
+	assert_int_equal(test_runs[0], 2);
+	assert_int_equal(test_runs[1], 1);
+	assert_int_equal(test_domain->last_tick, 20000);
+}
+
+static void test_schedule_ll_grid_rearm(void **state)
+{
+	uint32_t set_count;
+
+	(void)state;
+
+	test_now = 100;
+	schedule_task(&test_tasks[0], 0, 10000);
+	test_domain->last_tick = 10000;
+	set_count = test_platform_timer.set_count;
+
+	/* task due before the armed tick rearms the domain now */
+	test_now = 1000;
+	schedule_task(&test_tasks[1], 0, 5000);
+	assert_int_equal(test_tasks[1].start, 5000);
+	assert_int_equal(test_next_tick(), 5000);
+	assert_int_equal(test_platform_timer.set_count, set_count + 1);
+	assert_int_equal(test_platform_timer.set, 5000);
+	assert_int_equal(test_domain->last_tick, 5000);
+
+	/* task due at the armed tick or later doesn't */
+	schedule_task(&test_tasks[2], 0, 5000);
+	schedule_task(&test_tasks[3], 0, 10000);
+	assert_int_equal(test_platform_timer.set_count, set_count + 1);
+	assert_int_equal(test_next_tick(), 5000);
+}
+
+static void test_schedule_ll_domain_next_tick(void **state)
+{
+	int i;
+
+	(void)state;
+
+	/* no core knows its next tick */
+	assert_int_equal(domain_next_tick(test_domain), 0);
+
+	/* the earliest known tick over all cores */
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++)
+		test_domain->next_tick[i] = 9000 - 1000 * i;
+	assert_int_equal(domain_next_tick(test_domain),
+			 9000 - 1000 * (PLATFORM_CORE_COUNT - 1));
+
+	/* cores not knowing theirs are left out */
+	test_domain->next_tick[PLATFORM_CORE_COUNT - 1] = 0;
+	assert_int_equal(domain_next_tick(test_domain),
+			 PLATFORM_CORE_COUNT > 1 ?
+			 9000 - 1000 * (PLATFORM_CORE_COUNT - 2) : 0);
+}
+
+static void test_schedule_ll_domain_ticks_delta(void **state)
+{
+	(void)state;
+
+	/* ticks left to the request */
+	assert_int_equal(domain_ticks_delta(6000, 5000, 5400), 600);
+
+	/* a request from a start still ahead waits from its start */
+	assert_int_equal(domain_ticks_delta(6000, 5000, 4000), 1000);
+
+	/* an overshot request waits no longer than from its start */
+	assert_int_equal(domain_ticks_delta(6000, 5000, 6500), 1000);
+}
+
+static void test_schedule_ll_domain_set(void **state)
+{
+	(void)state;
+
+	/* a single rate domain wakes every system tick */
+	test_domain->multi_rate = false;
+	test_domain->next_tick[cpu_get_id()] = 9000;
+	domain_set(test_domain, 3000);
+	assert_int_equal(test_platform_timer.set, 3000 + TEST_SYSTEM_TICK);
+	assert_int_equal(test_domain->last_tick, 3000 + TEST_SYSTEM_TICK);
+
+	/* a multi rate one sleeps to the next task due */
+	test_domain->multi_rate = true;
+	domain_set(test_domain, 3000);
+	assert_int_equal(test_platform_timer.set, 9000);
+	assert_int_equal(test_domain->last_tick, 9000);
+
+	/* but never past the system tick */
+	test_domain->next_tick[cpu_get_id()] = 3500;
+	domain_set(test_domain, 3000);
+	assert_int_equal(test_platform_timer.set, 3000 + TEST_SYSTEM_TICK);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup(test_schedule_ll_grid_start, setup),
+		cmocka_unit_test_setup(test_schedule_ll_grid_run, setup),
+		cmocka_unit_test_setup(test_schedule_ll_grid_skip, setup),
+		cmocka_unit_test_setup(test_schedule_ll_grid_idle, setup),
+		cmocka_unit_test_setup(test_schedule_ll_grid_rearm, setup),
+		cmocka_unit_test_setup(test_schedule_ll_domain_next_tick,
+				       setup),
+		cmocka_unit_test_setup(test_schedule_ll_domain_ticks_delta,
+				       setup),
+		cmocka_unit_test_setup(test_schedule_ll_domain_set, setup),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+/*
+ * Prints the reply of the SOF_IPC_DEBUG_MEM_STATS IPC: the state of every
+ * heap with the fragmentation of its free space, and the allocation counts
+ * and worst case latencies of every memory zone.
+ *
+ * Usage to decode a reply saved to a file: ./sof-heapstats -i reply.bin
+ * Latencies are printed in microseconds when the DSP clock is given with -c.
+ *
+ */
+
+#include <ipc/debug.h>
+#include <ipc/header.h>
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define APP_NAME "sof-heapstats"
+
+static const char * const zone_name[SOF_IPC_DEBUG_MEM_ZONE_COUNT] = {
+	[SOF_IPC_DEBUG_MEM_ZONE_SYS] = "sys",
+	[SOF_IPC_DEBUG_MEM_ZONE_SYS_RUNTIME] = "sys_runtime",
+	[SOF_IPC_DEBUG_MEM_ZONE_RUNTIME] = "runtime",
+	[SOF_IPC_DEBUG_MEM_ZONE_BUFFER] = "buffer",
+};
+
+static void usage(void)
+{
+	fprintf(stdout, "Usage %s <option(s)>\n\n", APP_NAME);
+	fprintf(stdout, "%s:\t -i file\tDecode IPC reply file\n", APP_NAME);
+	fprintf(stdout, "%s:\t -c kHz\t\tDSP clock, prints latency in us\n",
+		APP_NAME);
+	fprintf(stdout, "%s:\t -h \t\tHelp, usage info\n", APP_NAME);
+	exit(0);
+}
+
+static const char *get_zone_name(uint32_t zone)
+{
+	return zone < SOF_IPC_DEBUG_MEM_ZONE_COUNT ? zone_name[zone] : "?";
+}
+
+static void print_cycles(uint32_t cycles, uint32_t clk_khz)
+{
+	if (clk_khz)
+		printf(" %10.2f", (double)cycles * 1000 / clk_khz);
+	else
+		printf(" %10u", cycles);
+}
+
+static void print_stats(struct sof_ipc_debug_mem_stats *stats,
+			uint32_t clk_khz)
+{
+	struct sof_ipc_debug_mem_heap *heap;
+	struct sof_ipc_debug_mem_zone *zone;
+	double frag;
+	uint32_t i;
+
+	printf("%-12s %5s %8s %8s %8s %8s %8s %6s\n", "zone", "heap",
+	       "caps", "size", "used", "free", "max free", "frag");
+
+	for (i = 0; i < stats->num_heaps; i++) {
+		heap = &stats->heaps[i];
+
+		/* share of the free space unusable by a single allocation */
+		frag = heap->free ?
+			100.0 * (heap->free - heap->max_free) / heap->free : 0;
+
+		printf("%-12s %5u %8x %8u %8u %8u %8u %5.1f%%\n",
+		       get_zone_name(heap->zone), heap->index, heap->caps,
+		       heap->size, heap->used, heap->free, heap->max_free,
+		       frag);
+	}
+
+	printf("\n%-12s %10s %10s %10s\n", "zone", "allocs", "failures",
+	       clk_khz ? "max us" : "max cycles");
+
+	for (i = 0; i < SOF_IPC_DEBUG_MEM_ZONE_COUNT; i++) {
+		zone = &stats->zones[i];
+
+		printf("%-12s %10u %10u", get_zone_name(i), zone->allocs,
+		       zone->failures);
+		print_cycles(zone->alloc_cycles_max, clk_khz);
+		printf("\n");
+	}
+
+	printf("%-12s %10u %10s", "free", stats->frees, "");
+	print_cycles(stats->free_cycles_max, clk_khz);
+	printf("\n");
+
+	/* slab memory is part of the buffer heap used bytes above */
+	if (stats->slab_size)
+		printf("\nslab caches %u bytes, %u used\n", stats->slab_size,
+		       stats->slab_used);
+}
+
+static int decode_file(const char *file, uint32_t clk_khz)
+{
+	struct sof_ipc_debug_mem_stats *stats;
+	char buf[SOF_IPC_MSG_MAX_SIZE];
+	size_t size;
+	FILE *fd;
+
+	fd = fopen(file, "rb");
+	if (!fd) {
+		fprintf(stderr, "error: unable to open file %s, error %d\n",
+			file, errno);
+		return -errno;
+	}
+
+	size = fread(buf, 1, sizeof(buf), fd);
+	fclose(fd);
+
+	stats = (struct sof_ipc_debug_mem_stats *)buf;
+
+	if (size < sizeof(*stats) || stats->rhdr.hdr.size > size ||
+	    stats->rhdr.hdr.size != sizeof(*stats) +
+	    stats->num_heaps * sizeof(stats->heaps[0])) {
+		fprintf(stderr, "error: %s is not a memory statistics reply\n",
+			file);
+		return -EINVAL;
+	}
+
+	if (stats->rhdr.error < 0) {
+		fprintf(stderr, "error: DSP returned %d\n", stats->rhdr.error);
+		return stats->rhdr.error;
+	}
+
+	print_stats(stats, clk_khz);
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t clk_khz = 0;
+	char *file = NULL;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "hi:c:")) != -1) {
+		switch (opt) {
+		case 'i':
+			file = optarg;
+			break;
+		case 'c':
+			clk_khz = atoi(optarg);
+			break;
+		case 'h':
+		default:
+			usage();
+		}
+	}
+
+	if (!file)
+		usage();
+
+	return decode_file(file, clk_khz) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
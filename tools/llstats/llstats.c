@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+/*
+ * Prints the reply of the SOF_IPC_DEBUG_LL_STATS IPC: the average and peak
+ * run time of every low latency task against its cycle budget, and how
+ * many runs overran the budget. The task with the highest peak load is
+ * the first suspect of an xrun.
+ *
+ * Usage to decode a reply saved to a file: ./sof-llstats -i reply.bin
+ * Run times are printed in microseconds when the DSP clock is given with -c.
+ *
+ */
+
+#include <ipc/debug.h>
+#include <ipc/header.h>
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define APP_NAME "sof-llstats"
+
+static const char * const sched_name[SOF_IPC_DEBUG_LL_SCHED_COUNT] = {
+	[SOF_IPC_DEBUG_LL_SCHED_TIMER] = "timer",
+	[SOF_IPC_DEBUG_LL_SCHED_DMA] = "dma",
+};
+
+static void usage(void)
+{
+	fprintf(stdout, "Usage %s <option(s)>\n\n", APP_NAME);
+	fprintf(stdout, "%s:\t -i file\tDecode IPC reply file\n", APP_NAME);
+	fprintf(stdout, "%s:\t -c kHz\t\tDSP clock, prints run time in us\n",
+		APP_NAME);
+	fprintf(stdout, "%s:\t -h \t\tHelp, usage info\n", APP_NAME);
+	exit(0);
+}
+
+static const char *get_sched_name(uint32_t sched)
+{
+	return sched < SOF_IPC_DEBUG_LL_SCHED_COUNT ? sched_name[sched] : "?";
+}
+
+static void print_cycles(uint32_t cycles, uint32_t clk_khz)
+{
+	if (clk_khz)
+		printf(" %10.2f", (double)cycles * 1000 / clk_khz);
+	else
+		printf(" %10u", cycles);
+}
+
+static double get_load(uint32_t cycles, uint32_t budget)
+{
+	return budget ? 100.0 * cycles / budget : 0;
+}
+
+static void print_stats(struct sof_ipc_debug_ll_stats *stats,
+			uint32_t clk_khz)
+{
+	struct sof_ipc_debug_ll_task *task;
+	struct sof_ipc_debug_ll_task *worst = NULL;
+	double load_max = 0;
+	double load;
+	uint32_t i;
+
+	printf("%-6s %5s %10s %10s %10s %10s %10s %7s %7s %10s\n", "sched",
+	       "id", "uid", "runs", clk_khz ? "budget us" : "budget",
+	       clk_khz ? "avg us" : "avg", clk_khz ? "peak us" : "peak",
+	       "avg", "peak", "overruns");
+
+	for (i = 0; i < stats->num_tasks; i++) {
+		task = &stats->tasks[i];
+
+		printf("%-6s %5u 0x%08x %10u", get_sched_name(task->sched),
+		       task->id, task->uid, task->runs);
+		print_cycles(task->budget, clk_khz);
+		print_cycles(task->cycles_avg, clk_khz);
+		print_cycles(task->cycles_peak, clk_khz);
+
+		load = get_load(task->cycles_peak, task->budget);
+		printf(" %6.1f%% %6.1f%% %10u\n",
+		       get_load(task->cycles_avg, task->budget), load,
+		       task->overruns);
+
+		if (load > load_max) {
+			load_max = load;
+			worst = task;
+		}
+	}
+
+	if (worst)
+		printf("\nhighest peak load %.1f%%, %s task id %u, %u overruns\n",
+		       load_max, get_sched_name(worst->sched), worst->id,
+		       worst->overruns);
+}
+
+static int decode_file(const char *file, uint32_t clk_khz)
+{
+	struct sof_ipc_debug_ll_stats *stats;
+	char buf[SOF_IPC_MSG_MAX_SIZE];
+	size_t size;
+	FILE *fd;
+
+	fd = fopen(file, "rb");
+	if (!fd) {
+		fprintf(stderr, "error: unable to open file %s, error %d\n",
+			file, errno);
+		return -errno;
+	}
+
+	size = fread(buf, 1, sizeof(buf), fd);
+	fclose(fd);
+
+	stats = (struct sof_ipc_debug_ll_stats *)buf;
+
+	if (size < sizeof(*stats) || stats->rhdr.hdr.size > size ||
+	    stats->rhdr.hdr.size != sizeof(*stats) +
+	    stats->num_tasks * sizeof(stats->tasks[0])) {
+		fprintf(stderr, "error: %s is not a LL statistics reply\n",
+			file);
+		return -EINVAL;
+	}
+
+	if (stats->rhdr.error < 0) {
+		fprintf(stderr, "error: DSP returned %d\n", stats->rhdr.error);
+		return stats->rhdr.error;
+	}
+
+	print_stats(stats, clk_khz);
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t clk_khz = 0;
+	char *file = NULL;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "hi:c:")) != -1) {
+		switch (opt) {
+		case 'i':
+			file = optarg;
+			break;
+		case 'c':
+			clk_khz = atoi(optarg);
+			break;
+		case 'h':
+		default:
+			usage();
+		}
+	}
+
+	if (!file)
+		usage();
+
+	return decode_file(file, clk_khz) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -38,6 +38,11 @@ void *rballoc_align(uint32_t flags, uint32_t caps, size_t bytes,
 	return malloc(bytes);
 }
 
+size_t rballoc_heap_size(void *ptr)
+{
+	return malloc_usable_size(ptr);
+}
+
 void *rbrealloc_align(void *ptr, uint32_t flags, uint32_t caps, size_t bytes,
 		      size_t old_bytes, uint32_t alignment)
 {
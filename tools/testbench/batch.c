@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+/*
+ * Batch mode of the testbench. The jobs are read from a text file, one
+ * job per line as
+ *
+ *	<topology_file> <input_file> <output_file1,output_file2,...>
+ *
+ * Empty lines and lines starting with '#' are skipped. The remaining
+ * options of the command line apply to every job.
+ *
+ * Each job runs in its own worker process with its own struct sof, the
+ * firmware context, component driver registration and shared library
+ * table are process wide so this keeps the jobs isolated without any
+ * locking in the library. Up to tp->batch_workers jobs run at once.
+ */
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "testbench/batch.h"
+#include "testbench/common_test.h"
+
+#define TB_BATCH_LINE_LEN	1024
+
+struct tb_batch_job {
+	char *tplg_file;
+	char *input_file;
+	char *output_files;	/* comma separated */
+	int line;		/* line in the batch file */
+	pid_t pid;
+	struct timespec start;
+};
+
+static double tb_batch_elapsed(const struct timespec *start)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) +
+		(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void tb_batch_free(struct tb_batch_job *jobs, int num_jobs)
+{
+	int i;
+
+	for (i = 0; i < num_jobs; i++) {
+		free(jobs[i].tplg_file);
+		free(jobs[i].input_file);
+		free(jobs[i].output_files);
+	}
+
+	free(jobs);
+}
+
+static int tb_batch_parse(const char *file, struct tb_batch_job **jobs_out)
+{
+	struct tb_batch_job *jobs = NULL;
+	struct tb_batch_job *job;
+	char line[TB_BATCH_LINE_LEN];
+	char tplg[TB_BATCH_LINE_LEN];
+	char input[TB_BATCH_LINE_LEN];
+	char outputs[TB_BATCH_LINE_LEN];
+	char first;
+	int num_jobs = 0;
+	int line_num = 0;
+	FILE *f;
+	void *p;
+
+	f = fopen(file, "r");
+	if (!f) {
+		fprintf(stderr, "error: cannot open batch file %s\n", file);
+		return -EINVAL;
+	}
+
+	while (fgets(line, sizeof(line), f)) {
+		line_num++;
+
+		if (sscanf(line, " %c", &first) != 1 || first == '#')
+			continue;
+
+		if (sscanf(line, "%1023s %1023s %1023s", tplg, input,
+			   outputs) != 3) {
+			fprintf(stderr, "error: %s:%d: expected <topology> <input> <outputs>\n",
+				file, line_num);
+			goto err;
+		}
+
+		p = realloc(jobs, (num_jobs + 1) * sizeof(*jobs));
+		if (!p)
+			goto err;
+
+		jobs = p;
+		job = &jobs[num_jobs++];
+		memset(job, 0, sizeof(*job));
+		job->line = line_num;
+		job->tplg_file = strdup(tplg);
+		job->input_file = strdup(input);
+		job->output_files = strdup(outputs);
+		if (!job->tplg_file || !job->input_file || !job->output_files)
+			goto err;
+	}
+
+	fclose(f);
+	*jobs_out = jobs;
+	return num_jobs;
+
+err:
+	fclose(f);
+	tb_batch_free(jobs, num_jobs);
+	return -EINVAL;
+}
+
+/* set up the job files and run it, called in the worker process */
+static int tb_batch_job_run(struct testbench_prm *tp, struct tb_batch_job *job,
+			    tb_job_func run)
+{
+	char *output_token = NULL;
+	char *token;
+	int i;
+
+	tp->tplg_file = job->tplg_file;
+	tp->input_file = job->input_file;
+
+	token = strtok_r(job->output_files, ",", &output_token);
+	for (i = 0; i < MAX_OUTPUT_FILE_NUM && token; i++) {
+		tp->output_file[i] = token;
+		token = strtok_r(NULL, ",", &output_token);
+	}
+
+	if (!i || token) {
+		fprintf(stderr, "error: line %d: 1 to %d output files expected\n",
+			job->line, MAX_OUTPUT_FILE_NUM);
+		return -EINVAL;
+	}
+
+	tp->output_file_num = i;
+
+	/* the job summaries of parallel workers would interleave */
+	if (!debug && !freopen("/dev/null", "w", stdout))
+		return -EIO;
+
+	return run(tp);
+}
+
+static int tb_batch_start(struct testbench_prm *tp, struct tb_batch_job *job,
+			  tb_job_func run)
+{
+	/* don't let the worker inherit and print pending output again */
+	fflush(stdout);
+	fflush(stderr);
+
+	clock_gettime(CLOCK_MONOTONIC, &job->start);
+
+	job->pid = fork();
+	if (job->pid < 0) {
+		fprintf(stderr, "error: cannot start worker: %s\n",
+			strerror(errno));
+		return -errno;
+	}
+
+	if (!job->pid)
+		exit(tb_batch_job_run(tp, job, run) < 0 ? EXIT_FAILURE :
+		     EXIT_SUCCESS);
+
+	return 0;
+}
+
+/* waits for any worker, returns 1 if its job failed */
+static int tb_batch_wait(struct tb_batch_job *jobs, int num_jobs)
+{
+	struct tb_batch_job *job = NULL;
+	bool failed;
+	int status;
+	pid_t pid;
+	int i;
+
+	do {
+		pid = wait(&status);
+	} while (pid < 0 && errno == EINTR);
+
+	if (pid < 0)
+		return -errno;
+
+	for (i = 0; i < num_jobs; i++) {
+		if (jobs[i].pid == pid) {
+			job = &jobs[i];
+			break;
+		}
+	}
+
+	if (!job)
+		return 0;
+
+	failed = !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS;
+	printf("job %d %s: %s %s -> %s, %.2f s\n", i + 1,
+	       failed ? "FAILED" : "OK", job->tplg_file, job->input_file,
+	       job->output_files, tb_batch_elapsed(&job->start));
+
+	return failed;
+}
+
+int tb_batch_run(struct testbench_prm *tp, tb_job_func run)
+{
+	struct tb_batch_job *jobs = NULL;
+	struct timespec start;
+	int num_jobs;
+	int limit;
+	int running = 0;
+	int failed = 0;
+	int next = 0;
+	int ret;
+
+	num_jobs = tb_batch_parse(tp->batch_file, &jobs);
+	if (num_jobs < 0)
+		return num_jobs;
+
+	printf("Running %d jobs on %d workers\n", num_jobs, tp->batch_workers);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	limit = num_jobs;
+	while (next < limit || running) {
+		/* keep all workers busy */
+		while (next < limit && running < tp->batch_workers) {
+			if (tb_batch_start(tp, &jobs[next], run) < 0) {
+				/* no new workers, let the running ones finish */
+				failed += limit - next;
+				limit = next;
+				break;
+			}
+
+			next++;
+			running++;
+		}
+
+		if (!running)
+			break;
+
+		ret = tb_batch_wait(jobs, next);
+		if (ret < 0) {
+			fprintf(stderr, "error: waiting for workers: %s\n",
+				strerror(-ret));
+			failed += running;
+			break;
+		}
+
+		failed += ret;
+		running--;
+	}
+
+	printf("%d jobs, %d failed, %.2f s\n", num_jobs, failed,
+	       tb_batch_elapsed(&start));
+
+	tb_batch_free(jobs, num_jobs);
+
+	return failed ? -EINVAL : 0;
+}
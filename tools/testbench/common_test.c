@@ -250,12 +250,17 @@ void pipeline_xrun(struct pipeline *p, struct comp_dev *dev, int32_t bytes)
 {
 }
 
+/* host platform timer counts nanoseconds, used by the perf counters */
 uint64_t platform_timer_get(struct timer *timer)
 {
-	return 0;
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
 }
 
+/* platform_timer_get() counts nanoseconds */
 uint64_t clock_ms_to_ticks(int clock, uint64_t ms)
 {
-	return 0;
+	return ms * 1000000;
 }
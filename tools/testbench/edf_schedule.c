@@ -21,9 +21,17 @@ DECLARE_TR_CTX(edf_tr, SOF_UUID(edf_sched_uuid), LOG_LEVEL_INFO);
 
 struct edf_schedule_data {
 	struct list_item list; /* list of tasks in priority queue */
+	struct list_item tasks; /* list of all tasks, for the statistics */
 	uint32_t clock;
 };
 
+/* task private data, listed for the statistics */
+struct edf_tb_pdata {
+	struct edf_task_pdata pdata;
+	struct list_item list;
+	struct task *task;
+};
+
 struct scheduler_ops schedule_edf_ops;
 
 static struct edf_schedule_data *sch;
@@ -41,10 +49,14 @@ static int schedule_edf_task(void *data, struct task *task, uint64_t start,
 			      uint64_t period)
 {
 	struct edf_schedule_data *sch = data;
+	struct edf_task_pdata *edf_pdata = edf_sch_get_pdata(task);
 	(void)period;
 	list_item_prepend(&task->list, &sch->list);
 	task->state = SOF_TASK_STATE_QUEUED;
 
+	/* runs at once, so there is no latency and no deadline missed */
+	edf_pdata->stats.runs++;
+
 	if (task->ops.run)
 		task->ops.run(task->data);
 
@@ -57,7 +69,7 @@ int schedule_task_init_edf(struct task *task, const struct sof_uuid_entry *uid,
 			   const struct task_ops *ops, void *data,
 			   uint16_t core, uint32_t flags)
 {
-	struct edf_task_pdata *edf_pdata;
+	struct edf_tb_pdata *tb_pdata;
 	int ret = 0;
 
 	ret = schedule_task_init(task, uid, SOF_SCHEDULE_EDF, 0, ops->run,
@@ -65,8 +77,10 @@ int schedule_task_init_edf(struct task *task, const struct sof_uuid_entry *uid,
 	if (ret < 0)
 		return ret;
 
-	edf_pdata = malloc(sizeof(*edf_pdata));
-	edf_sch_set_pdata(task, edf_pdata);
+	tb_pdata = calloc(1, sizeof(*tb_pdata));
+	tb_pdata->task = task;
+	list_item_append(&tb_pdata->list, &sch->tasks);
+	edf_sch_set_pdata(task, &tb_pdata->pdata);
 
 	task->ops.complete = ops->complete;
 
@@ -79,6 +93,7 @@ int scheduler_init_edf(void)
 	tr_info(&edf_tr, "edf_scheduler_init()");
 	sch = malloc(sizeof(*sch));
 	list_init(&sch->list);
+	list_init(&sch->tasks);
 
 	scheduler_init(SOF_SCHEDULE_EDF, &schedule_edf_ops, sch);
 
@@ -108,16 +123,44 @@ static int schedule_edf_task_cancel(void *data, struct task *task)
 
 static int schedule_edf_task_free(void *data, struct task *task)
 {
+	struct edf_tb_pdata *tb_pdata;
+
 	task->state = SOF_TASK_STATE_FREE;
 	task->ops.run = NULL;
 	task->data = NULL;
 
-	free(edf_sch_get_pdata(task));
+	if (!edf_sch_get_pdata(task))
+		return 0;
+
+	tb_pdata = container_of(edf_sch_get_pdata(task), struct edf_tb_pdata,
+				pdata);
+	list_item_del(&tb_pdata->list);
+	free(tb_pdata);
 	edf_sch_set_pdata(task, NULL);
 
 	return 0;
 }
 
+int schedule_edf_task_stats(struct edf_task_info *info, int count)
+{
+	struct edf_tb_pdata *tb_pdata;
+	struct list_item *tlist;
+	int i = 0;
+
+	list_for_item(tlist, &sch->tasks) {
+		if (i == count)
+			break;
+
+		tb_pdata = container_of(tlist, struct edf_tb_pdata, list);
+		info[i].uid = tb_pdata->task->uid;
+		info[i].state = tb_pdata->task->state;
+		info[i].stats = tb_pdata->pdata.stats;
+		i++;
+	}
+
+	return i;
+}
+
 struct scheduler_ops schedule_edf_ops = {
 	.schedule_task		= schedule_edf_task,
 	.schedule_task_running	= NULL,
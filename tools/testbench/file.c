@@ -8,7 +8,11 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <inttypes.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sof/sof.h>
 #include <sof/list.h>
 #include <sof/audio/stream.h>
@@ -26,6 +30,50 @@ DECLARE_SOF_UUID("file", file_uuid, 0xbfc7488c, 0x75aa, 0x4ce8,
 		 0x9d, 0xbe, 0xd8, 0xda, 0x08, 0xa6, 0x98, 0xc2);
 DECLARE_TR_CTX(file_tr, SOF_UUID(file_uuid), LOG_LEVEL_INFO);
 
+/* output mappings start at this size and double when full */
+#define FILE_MAP_MIN_SIZE	(1 << 20)
+
+#define WAV_FORMAT_PCM		1
+#define WAV_FORMAT_EXTENSIBLE	0xfffe
+
+/* RIFF chunk header */
+struct wav_chunk {
+	char id[4];
+	uint32_t size;
+} __packed;
+
+/* payload of the "fmt " chunk */
+struct wav_fmt {
+	uint16_t format;
+	uint16_t channels;
+	uint32_t rate;
+	uint32_t byte_rate;
+	uint16_t block_align;
+	uint16_t bits;
+} __packed;
+
+/* canonical 44 byte RIFF/WAVE header, written in front of wav output */
+struct wav_header {
+	struct wav_chunk riff;
+	char wave_id[4];
+	struct wav_chunk fmt_chunk;
+	struct wav_fmt fmt;
+	struct wav_chunk data;
+} __packed;
+
+static const struct wav_header wav_header_template = {
+	.riff = { .id = "RIFF" },
+	.wave_id = "WAVE",
+	.fmt_chunk = { .id = "fmt ", .size = sizeof(struct wav_fmt) },
+	.fmt = { .format = WAV_FORMAT_PCM },
+	.data = { .id = "data" },
+};
+
+/* samples in mapped wav files are not necessarily 32-bit aligned */
+struct file_sample32 {
+	int32_t s;
+} __packed;
+
 static const struct comp_driver comp_file_dai;
 static const struct comp_driver comp_file_host;
 
@@ -72,46 +120,18 @@ static int read_samples_32(struct comp_dev *dev,
 			/* copy sample per channel */
 			for (i = 0; i < nch; i++) {
 				/* read sample from file */
-				switch (cd->fs.f_format) {
-				/* text input file */
-				case FILE_TEXT:
-					if (fmt == SOF_IPC_FRAME_S32_LE)
-						ret = fscanf(cd->fs.rfh, "%d",
-							     dest);
-
-					/* mask bits if 24-bit samples */
-					if (fmt == SOF_IPC_FRAME_S24_4LE) {
-						ret = fscanf(cd->fs.rfh, "%d",
-							     &sample);
-						*dest = sample & 0x00ffffff;
-					}
-					/* quit if eof is reached */
-					if (ret == EOF) {
-						cd->fs.reached_eof = 1;
-						goto quit;
-					}
-					break;
-
-				/* raw input file */
-				default:
-					if (fmt == SOF_IPC_FRAME_S32_LE)
-						ret = fread(dest,
-							    sizeof(int32_t),
-							    1, cd->fs.rfh);
-
-					/* mask bits if 24-bit samples */
-					if (fmt == SOF_IPC_FRAME_S24_4LE) {
-						ret = fread(&sample,
-							    sizeof(int32_t),
-							    1, cd->fs.rfh);
-						*dest = sample & 0x00ffffff;
-					}
-					/* quit if eof is reached */
-					if (ret != 1) {
-						cd->fs.reached_eof = 1;
-						goto quit;
-					}
-					break;
+				if (fmt == SOF_IPC_FRAME_S32_LE)
+					ret = fscanf(cd->fs.rfh, "%d", dest);
+
+				/* mask bits if 24-bit samples */
+				if (fmt == SOF_IPC_FRAME_S24_4LE) {
+					ret = fscanf(cd->fs.rfh, "%d", &sample);
+					*dest = sample & 0x00ffffff;
+				}
+				/* quit if eof is reached */
+				if (ret == EOF) {
+					cd->fs.reached_eof = 1;
+					goto quit;
 				}
 				dest++;
 				n_samples++;
@@ -150,25 +170,10 @@ static int read_samples_16(struct comp_dev *dev,
 
 			/* copy sample per channel */
 			for (i = 0; i < nch; i++) {
-				switch (cd->fs.f_format) {
-				/* text input file */
-				case FILE_TEXT:
-					ret = fscanf(cd->fs.rfh, "%hd", dest);
-					if (ret == EOF) {
-						cd->fs.reached_eof = 1;
-						goto quit;
-					}
-					break;
-
-				/* rw pcm input file */
-				default:
-					ret = fread(dest, sizeof(int16_t), 1,
-						    cd->fs.rfh);
-					if (ret != 1) {
-						cd->fs.reached_eof = 1;
-						goto quit;
-					}
-					break;
+				ret = fscanf(cd->fs.rfh, "%hd", dest);
+				if (ret == EOF) {
+					cd->fs.reached_eof = 1;
+					goto quit;
 				}
 
 				dest++;
@@ -208,24 +213,9 @@ static int write_samples_16(struct comp_dev *dev, struct audio_stream *source,
 
 			/* copy sample per channel */
 			for (i = 0; i < nch; i++) {
-				switch (cd->fs.f_format) {
-				/* text output file */
-				case FILE_TEXT:
-					ret = fprintf(cd->fs.wfh,
-						      "%d\n", *src);
-					if (ret < 0)
-						goto quit;
-					break;
-
-				/* raw pcm output file */
-				default:
-					ret = fwrite(src,
-						     sizeof(int16_t),
-						     1, cd->fs.wfh);
-					if (ret != 1)
-						goto quit;
-					break;
-				}
+				ret = fprintf(cd->fs.wfh, "%d\n", *src);
+				if (ret < 0)
+					goto quit;
 
 				src++;
 				n_samples++;
@@ -264,39 +254,15 @@ static int write_samples_32(struct comp_dev *dev, struct audio_stream *source,
 
 			/* copy sample per channel */
 			for (i = 0; i < nch; i++) {
-				switch (cd->fs.f_format) {
-				/* text output file */
-				case FILE_TEXT:
-					if (fmt == SOF_IPC_FRAME_S32_LE)
-						ret = fprintf(cd->fs.wfh,
-							      "%d\n", *src);
-					if (fmt == SOF_IPC_FRAME_S24_4LE) {
-						sample = *src << 8;
-						ret = fprintf(cd->fs.wfh,
-							      "%d\n",
-							      sample >> 8);
-					}
-					if (ret < 0)
-						goto quit;
-					break;
-
-				/* raw pcm output file */
-				default:
-					if (fmt == SOF_IPC_FRAME_S32_LE)
-						ret = fwrite(src,
-							     sizeof(int32_t),
-							     1, cd->fs.wfh);
-					if (fmt == SOF_IPC_FRAME_S24_4LE) {
-						sample = *src << 8;
-						sample >>= 8;
-						ret = fwrite(&sample,
-							     sizeof(int32_t),
-							     1, cd->fs.wfh);
-					}
-					if (ret != 1)
-						goto quit;
-					break;
+				if (fmt == SOF_IPC_FRAME_S32_LE)
+					ret = fprintf(cd->fs.wfh, "%d\n", *src);
+				if (fmt == SOF_IPC_FRAME_S24_4LE) {
+					sample = *src << 8;
+					ret = fprintf(cd->fs.wfh, "%d\n",
+						      sample >> 8);
 				}
+				if (ret < 0)
+					goto quit;
 
 				/* increment read pointer */
 				src++;
@@ -401,13 +367,325 @@ static int file_s24(struct comp_dev *dev, struct audio_stream *sink,
 	return n_samples;
 }
 
+/*
+ * Copy samples from the mapped file, 24-bit samples are masked like the
+ * text input. Wav files keep 24-bit samples MSB aligned in 32 bits.
+ */
+static void file_map_in(struct file_state *fs, void *dest, const void *src,
+			size_t bytes, enum sof_ipc_frame fmt)
+{
+	const struct file_sample32 *src32 = src;
+	int shift = fs->f_format == FILE_WAV ? 8 : 0;
+	int32_t *dest32 = dest;
+	size_t i;
+	int ret;
+
+	if (fmt != SOF_IPC_FRAME_S24_4LE) {
+		ret = memcpy_s(dest, bytes, src, bytes);
+		assert(!ret);
+		return;
+	}
+
+	for (i = 0; i < bytes / sizeof(*src32); i++)
+		dest32[i] = (src32[i].s >> shift) & 0x00ffffff;
+}
+
+/*
+ * Copy samples to the mapped file, 24-bit samples are sign extended for
+ * raw files and MSB aligned for wav files.
+ */
+static void file_map_out(struct file_state *fs, void *dest, const void *src,
+			 size_t bytes, enum sof_ipc_frame fmt)
+{
+	struct file_sample32 *dest32 = dest;
+	const int32_t *src32 = src;
+	int32_t sample;
+	size_t i;
+	int ret;
+
+	if (fmt != SOF_IPC_FRAME_S24_4LE) {
+		ret = memcpy_s(dest, bytes, src, bytes);
+		assert(!ret);
+		return;
+	}
+
+	for (i = 0; i < bytes / sizeof(*dest32); i++) {
+		sample = src32[i] << 8;
+		if (fs->f_format != FILE_WAV)
+			sample >>= 8;
+		dest32[i].s = sample;
+	}
+}
+
+/* extend the output file and its mapping to hold at least size bytes */
+static int file_map_grow(struct file_state *fs, size_t size)
+{
+	size_t map_size = fs->map_size ? fs->map_size : FILE_MAP_MIN_SIZE;
+	void *map;
+
+	while (map_size < size)
+		map_size *= 2;
+
+	if (ftruncate(fs->fd, map_size) < 0)
+		return -errno;
+
+	if (fs->map)
+		munmap(fs->map, fs->map_size);
+
+	map = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+		   fs->fd, 0);
+	if (map == MAP_FAILED) {
+		fs->map = NULL;
+		fs->map_size = 0;
+		return -errno;
+	}
+
+	fs->map = map;
+	fs->map_size = map_size;
+
+	return 0;
+}
+
+/*
+ * Read whole frames from the mapped file into the sink, one memcpy() per
+ * wrap-free span of the buffer.
+ */
+static int file_map_read(struct comp_dev *dev, struct audio_stream *sink,
+			 uint32_t frames)
+{
+	struct file_comp_data *cd = comp_get_drvdata(dev);
+	struct file_state *fs = &cd->fs;
+	size_t frame_bytes = audio_stream_frame_bytes(sink);
+	size_t avail = (fs->data_end - fs->pos) / frame_bytes;
+	size_t bytes = MIN(frames, avail) * frame_bytes;
+	uint8_t *dest = sink->w_ptr;
+	size_t n_bytes;
+
+	if (!bytes) {
+		fs->reached_eof = 1;
+		return 0;
+	}
+
+	n_bytes = bytes;
+	while (bytes) {
+		size_t seg = MIN(bytes,
+				 audio_stream_bytes_without_wrap(sink, dest));
+
+		file_map_in(fs, dest, fs->map + fs->pos, seg, sink->frame_fmt);
+		fs->pos += seg;
+		bytes -= seg;
+		dest = audio_stream_wrap(sink, dest + seg);
+	}
+
+	return n_bytes / cd->sample_container_bytes;
+}
+
+/*
+ * Write frames from the source into the mapped file, one memcpy() per
+ * wrap-free span of the buffer.
+ */
+static int file_map_write(struct comp_dev *dev, struct audio_stream *source,
+			  uint32_t frames)
+{
+	struct file_comp_data *cd = comp_get_drvdata(dev);
+	struct file_state *fs = &cd->fs;
+	size_t bytes = frames * audio_stream_frame_bytes(source);
+	uint8_t *src = source->r_ptr;
+	size_t n_bytes = bytes;
+	int ret;
+
+	if (fs->pos + bytes > fs->map_size) {
+		ret = file_map_grow(fs, fs->pos + bytes);
+		if (ret < 0) {
+			fprintf(stderr, "error: %d growing file %s\n", ret,
+				fs->fn);
+			return 0;
+		}
+	}
+
+	while (bytes) {
+		size_t seg = MIN(bytes,
+				 audio_stream_bytes_without_wrap(source, src));
+
+		file_map_out(fs, fs->map + fs->pos, src, seg,
+			     source->frame_fmt);
+		fs->pos += seg;
+		bytes -= seg;
+		src = audio_stream_wrap(source, src + seg);
+	}
+
+	return n_bytes / cd->sample_container_bytes;
+}
+
+/* function for processing samples of raw and wav files in any format */
+static int file_map_copy(struct comp_dev *dev, struct audio_stream *sink,
+			 struct audio_stream *source, uint32_t frames)
+{
+	struct file_comp_data *cd = comp_get_drvdata(dev);
+	int n_samples = 0;
+
+	switch (cd->fs.mode) {
+	case FILE_READ:
+		n_samples = file_map_read(dev, sink, frames);
+		break;
+	case FILE_WRITE:
+		n_samples = file_map_write(dev, source, frames);
+		break;
+	default:
+		/* TODO: duplex mode */
+		break;
+	}
+
+	cd->fs.n += n_samples;
+	return n_samples;
+}
+
+/* find the format and the samples of a mapped wav file */
+static int wav_parse(struct file_state *fs)
+{
+	const struct wav_chunk *chunk;
+	uint16_t format = 0;
+	size_t pos;
+
+	if (fs->data_end < 12 || memcmp(fs->map, "RIFF", 4) ||
+	    memcmp(fs->map + 8, "WAVE", 4))
+		return -EINVAL;
+
+	for (pos = 12; pos + sizeof(*chunk) <= fs->data_end;
+	     pos += sizeof(*chunk) + chunk->size + (chunk->size & 1)) {
+		chunk = (const struct wav_chunk *)(fs->map + pos);
+
+		if (!memcmp(chunk->id, "fmt ", 4)) {
+			const struct wav_fmt *fmt =
+				(const struct wav_fmt *)(chunk + 1);
+
+			if (chunk->size < sizeof(*fmt) ||
+			    pos + sizeof(*chunk) + sizeof(*fmt) > fs->data_end)
+				return -EINVAL;
+
+			format = fmt->format;
+			fs->wav_channels = fmt->channels;
+			fs->wav_rate = fmt->rate;
+			fs->wav_bits = fmt->bits;
+		}
+
+		if (!memcmp(chunk->id, "data", 4)) {
+			/* streamed files may not know the data size */
+			fs->data_start = pos + sizeof(*chunk);
+			fs->data_end = MIN(fs->data_end,
+					   fs->data_start + chunk->size);
+			break;
+		}
+	}
+
+	if (!fs->data_start ||
+	    (format != WAV_FORMAT_PCM && format != WAV_FORMAT_EXTENSIBLE))
+		return -EINVAL;
+
+	return 0;
+}
+
+/* fill in the header of wav output from the stream format and data size */
+static void wav_write_header(struct file_state *fs)
+{
+	struct wav_header *h = (struct wav_header *)fs->map;
+	uint16_t block_align = fs->wav_channels * fs->wav_bits / 8;
+
+	*h = wav_header_template;
+	h->riff.size = fs->pos - sizeof(h->riff);
+	h->fmt.channels = fs->wav_channels;
+	h->fmt.rate = fs->wav_rate;
+	h->fmt.byte_rate = fs->wav_rate * block_align;
+	h->fmt.block_align = block_align;
+	h->fmt.bits = fs->wav_bits;
+	h->data.size = fs->pos - fs->data_start;
+}
+
+/* map a raw or wav file, input is mapped whole and read only */
+static int file_map_open(struct file_state *fs)
+{
+	struct stat st;
+	int ret;
+
+	if (fs->mode == FILE_READ) {
+		fs->fd = open(fs->fn, O_RDONLY);
+		if (fs->fd < 0)
+			return -errno;
+
+		if (fstat(fs->fd, &st) < 0)
+			return -errno;
+
+		fs->data_end = st.st_size;
+		if (!st.st_size)
+			return fs->f_format == FILE_WAV ? -EINVAL : 0;
+
+		fs->map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE,
+			       fs->fd, 0);
+		if (fs->map == MAP_FAILED) {
+			fs->map = NULL;
+			return -errno;
+		}
+
+		fs->map_size = st.st_size;
+		madvise(fs->map, fs->map_size, MADV_SEQUENTIAL);
+
+		if (fs->f_format == FILE_WAV) {
+			ret = wav_parse(fs);
+			if (ret < 0) {
+				fprintf(stderr, "error: no PCM data in %s\n",
+					fs->fn);
+				return ret;
+			}
+		}
+
+		fs->pos = fs->data_start;
+		return 0;
+	}
+
+	fs->fd = open(fs->fn, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fs->fd < 0)
+		return -errno;
+
+	/* the header is filled in when the file is closed */
+	if (fs->f_format == FILE_WAV)
+		fs->data_start = sizeof(struct wav_header);
+
+	fs->pos = fs->data_start;
+
+	return file_map_grow(fs, FILE_MAP_MIN_SIZE);
+}
+
+static void file_map_close(struct file_state *fs)
+{
+	if (fs->map) {
+		if (fs->mode == FILE_WRITE && fs->f_format == FILE_WAV)
+			wav_write_header(fs);
+
+		munmap(fs->map, fs->map_size);
+	}
+
+	/* drop the unused tail of the output mapping */
+	if (fs->mode == FILE_WRITE && fs->fd >= 0 &&
+	    ftruncate(fs->fd, fs->pos) < 0)
+		fprintf(stderr, "error: truncating file %s\n", fs->fn);
+
+	if (fs->fd >= 0)
+		close(fs->fd);
+}
+
 static enum file_format get_file_format(char *filename)
 {
 	char *ext = strrchr(filename, '.');
 
+	if (!ext)
+		return FILE_RAW;
+
 	if (!strcmp(ext, ".txt"))
 		return FILE_TEXT;
 
+	if (!strcmp(ext, ".wav"))
+		return FILE_WAV;
+
 	return FILE_RAW;
 }
 
@@ -460,6 +738,21 @@ static struct comp_dev *file_new(const struct comp_driver *drv,
 	cd->channels = ipc_file->channels;
 	cd->frame_fmt = ipc_file->frame_fmt;
 
+	/* raw and wav files are memory mapped */
+	cd->fs.fd = -1;
+	if (cd->fs.f_format != FILE_TEXT) {
+		if (file_map_open(&cd->fs) < 0) {
+			fprintf(stderr, "error: opening file %s\n", cd->fs.fn);
+			file_map_close(&cd->fs);
+			free(cd->fs.fn);
+			free(cd);
+			free(dev);
+			return NULL;
+		}
+
+		goto out;
+	}
+
 	/* open file handle(s) depending on mode */
 	switch (cd->fs.mode) {
 	case FILE_READ:
@@ -485,6 +778,7 @@ static struct comp_dev *file_new(const struct comp_driver *drv,
 		break;
 	}
 
+out:
 	cd->fs.reached_eof = 0;
 	cd->fs.n = 0;
 
@@ -499,7 +793,9 @@ static void file_free(struct comp_dev *dev)
 
 	comp_dbg(dev, "file_free()");
 
-	if (cd->fs.mode == FILE_READ)
+	if (cd->fs.f_format != FILE_TEXT)
+		file_map_close(&cd->fs);
+	else if (cd->fs.mode == FILE_READ)
 		fclose(cd->fs.rfh);
 	else
 		fclose(cd->fs.wfh);
@@ -637,6 +933,34 @@ static int file_copy(struct comp_dev *dev)
 	return ret;
 }
 
+/* check wav input against the stream or set the format of wav output */
+static int file_wav_prepare(struct file_comp_data *cd,
+			    struct audio_stream *stream)
+{
+	struct file_state *fs = &cd->fs;
+	int bits = cd->sample_container_bytes * 8;
+
+	if (fs->mode == FILE_WRITE) {
+		fs->wav_rate = stream->rate;
+		fs->wav_channels = stream->channels;
+		fs->wav_bits = bits;
+		return 0;
+	}
+
+	if (fs->wav_bits != bits || fs->wav_channels != stream->channels) {
+		fprintf(stderr, "error: %s has %u channels of %u bits, stream has %u of %d\n",
+			fs->fn, fs->wav_channels, fs->wav_bits,
+			stream->channels, bits);
+		return -EINVAL;
+	}
+
+	if (fs->wav_rate != stream->rate)
+		fprintf(stderr, "warning: %s rate %u Hz, stream rate %u Hz\n",
+			fs->fn, fs->wav_rate, stream->rate);
+
+	return 0;
+}
+
 static int file_prepare(struct comp_dev *dev)
 {
 	struct sof_ipc_comp_config *config = dev_comp_config(dev);
@@ -734,6 +1058,15 @@ static int file_prepare(struct comp_dev *dev)
 		return -EINVAL;
 	}
 
+	if (cd->fs.f_format != FILE_TEXT)
+		cd->file_func = file_map_copy;
+
+	if (cd->fs.f_format == FILE_WAV) {
+		ret = file_wav_prepare(cd, stream);
+		if (ret < 0)
+			return ret;
+	}
+
 	dev->state = COMP_STATE_PREPARE;
 
 	return ret;
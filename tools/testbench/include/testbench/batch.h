@@ -0,0 +1,16 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2020 Intel Corporation. All rights reserved.
+ */
+
+#ifndef _BATCH_H
+#define _BATCH_H
+
+struct testbench_prm;
+
+/* runs one testbench job, returns 0 on success */
+typedef int (*tb_job_func)(struct testbench_prm *tp);
+
+int tb_batch_run(struct testbench_prm *tp, tb_job_func run);
+
+#endif
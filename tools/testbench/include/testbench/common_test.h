@@ -45,6 +45,9 @@ struct testbench_prm {
 	int sched_id;
 	int max_pipeline_id;
 	enum sof_ipc_frame frame_fmt;
+	char *timeline_file; /* Chrome trace of component copies, optional */
+	char *batch_file; /* list of jobs to run, optional */
+	int batch_workers; /* number of jobs run in parallel */
 };
 
 struct shared_lib_table {
@@ -21,6 +21,7 @@ enum file_mode {
 enum file_format {
 	FILE_TEXT = 0,
 	FILE_RAW,
+	FILE_WAV,
 };
 
 /* file component state */
@@ -31,6 +32,19 @@ struct file_state {
 	int n;
 	enum file_mode mode;
 	enum file_format f_format;
+
+	/* raw and wav files are memory mapped instead of using stdio */
+	int fd;
+	uint8_t *map;
+	size_t map_size;
+	size_t data_start; /* offset of the first sample in the file */
+	size_t data_end; /* end of the samples when reading */
+	size_t pos; /* offset of the next sample to read or write */
+
+	/* wav stream format, read from the header or set at prepare */
+	uint32_t wav_rate;
+	uint16_t wav_channels;
+	uint16_t wav_bits;
 };
 
 /* file comp data */
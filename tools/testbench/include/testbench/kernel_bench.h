@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2020 Intel Corporation. All rights reserved.
+ */
+
+#ifndef _KERNEL_BENCH_H
+#define _KERNEL_BENCH_H
+
+#include <sof/audio/component.h>
+#include <ipc/stream.h>
+#include <stdint.h>
+
+struct sof_eq_iir_header_df2t;
+
+/* max number of source or sink streams of a single kernel */
+#define KBENCH_MAX_STREAMS	4
+
+/* size of the benchmark buffers in periods */
+#define KBENCH_BUFFER_PERIODS	2
+
+/*
+ * One benchmark case: a kernel run with a fixed frame format, channels
+ * count and period size. The harness owns the component device and the
+ * buffers, the kernel owns whatever it keeps in priv.
+ */
+struct kbench_case {
+	enum sof_ipc_frame fmt;		/* frame format under test */
+	int channels;			/* channels count under test */
+	int frames;			/* period size in frames */
+
+	struct comp_dev *dev;		/* dummy device the buffers hang on */
+	struct comp_buffer *sources[KBENCH_MAX_STREAMS];
+	struct comp_buffer *sinks[KBENCH_MAX_STREAMS];
+	int num_sources;
+	int num_sinks;
+
+	/* frames consumed from each source/produced to each sink per run */
+	int source_frames;
+	int sink_frames;
+
+	void *priv;			/* kernel private state */
+};
+
+/*
+ * Kernel under test. setup() returns -ENOTSUP for a combination the
+ * kernel does not implement, the case is then silently skipped.
+ */
+struct kbench_kernel {
+	const char *name;
+	int (*setup)(struct kbench_case *bc);
+	void (*run)(struct kbench_case *bc);
+	void (*free)(struct kbench_case *bc);
+};
+
+/* buffer helpers for setup(), free is done by the harness */
+struct comp_buffer *kbench_add_source(struct kbench_case *bc,
+				      enum sof_ipc_frame fmt, int channels,
+				      int frames);
+struct comp_buffer *kbench_add_sink(struct kbench_case *bc,
+				    enum sof_ipc_frame fmt, int channels,
+				    int frames);
+
+/* DF2T IIR setup of identical low-pass biquads in series, free with rfree() */
+struct sof_eq_iir_header_df2t *kbench_iir_config(int num_sections);
+
+extern const struct kbench_kernel kbench_volume;
+extern const struct kbench_kernel kbench_mixer;
+extern const struct kbench_kernel kbench_eq_iir;
+extern const struct kbench_kernel kbench_eq_fir;
+extern const struct kbench_kernel kbench_src;
+extern const struct kbench_kernel kbench_asrc_push;
+extern const struct kbench_kernel kbench_asrc_pull;
+extern const struct kbench_kernel kbench_mux;
+extern const struct kbench_kernel kbench_demux;
+extern const struct kbench_kernel kbench_crossover;
+extern const struct kbench_kernel kbench_tdfb;
+extern const struct kbench_kernel kbench_dcblock;
+extern const struct kbench_kernel kbench_pcm_converter;
+
+#endif /* _KERNEL_BENCH_H */
@@ -0,0 +1,45 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2020 Intel Corporation. All rights reserved.
+ */
+
+#ifndef _PERF_H
+#define _PERF_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+struct sof;
+struct shared_lib_table;
+struct tb_perf_comp;
+
+/*
+ * Per component copy() cost collected from the component performance
+ * counters after every scheduling tick of the testbench.
+ */
+struct tb_perf {
+	struct tb_perf_comp *comps;	/* tracked components */
+	int num_comps;
+	uint32_t period_us;		/* scheduling period for load */
+	uint64_t ticks;			/* ticks seen so far */
+	uint64_t capacity;		/* ticks the sample arrays can hold */
+	uint64_t tick_start;		/* platform time of current tick */
+	uint64_t time_base;		/* platform time of the first tick */
+	uint32_t *tick_ns;		/* whole tick cost per tick */
+	FILE *timeline;			/* Chrome trace output, optional */
+	int timeline_events;
+};
+
+int tb_perf_init(struct tb_perf *perf, struct sof *sof,
+		 struct shared_lib_table *lib_table, uint32_t period_us,
+		 const char *timeline_file);
+
+void tb_perf_tick_begin(struct tb_perf *perf);
+
+void tb_perf_tick_end(struct tb_perf *perf);
+
+void tb_perf_report(struct tb_perf *perf);
+
+void tb_perf_free(struct tb_perf *perf);
+
+#endif
@@ -0,0 +1,718 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+/*
+ * Host microbenchmark for the audio processing kernels. Every kernel is
+ * run on its own across frame formats, channel counts and period sizes
+ * and the cost is reported in nanoseconds per frame. Results can be
+ * written as CSV or JSON and compared against a previous CSV run to catch
+ * performance regressions.
+ */
+
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/lib/alloc.h>
+#include <sof/list.h>
+#include <sof/sof.h>
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <user/eq.h>
+#include "testbench/common_test.h"
+#include "testbench/kernel_bench.h"
+
+#define KBENCH_MAX_LIST		16
+#define KBENCH_NAME_LEN		64
+#define KBENCH_MAX_BASELINE	1024
+
+#define KBENCH_DEFAULT_ITERATIONS	1000
+#define KBENCH_DEFAULT_THRESHOLD	10
+
+struct kbench_result {
+	char kernel[KBENCH_NAME_LEN];
+	char format[8];
+	int channels;
+	int frames;
+	int iterations;
+	double mean_ns;		/* mean ns per frame */
+	double min_ns;		/* best ns per frame */
+};
+
+struct kbench_prm {
+	int formats[KBENCH_MAX_LIST];
+	int num_formats;
+	int channels[KBENCH_MAX_LIST];
+	int num_channels;
+	int frames[KBENCH_MAX_LIST];
+	int num_frames;
+	char *kernels;		/* comma separated names, NULL for all */
+	int iterations;
+	char *csv_file;
+	char *json_file;
+	char *baseline_file;
+	int threshold;		/* allowed slowdown in percent */
+};
+
+static const struct kbench_kernel *kbench_kernels[] = {
+	&kbench_volume,
+	&kbench_mixer,
+	&kbench_eq_iir,
+	&kbench_eq_fir,
+	&kbench_src,
+	&kbench_asrc_push,
+	&kbench_asrc_pull,
+	&kbench_mux,
+	&kbench_demux,
+	&kbench_crossover,
+	&kbench_tdfb,
+	&kbench_dcblock,
+	&kbench_pcm_converter,
+};
+
+/* main firmware context */
+static struct sof sof;
+
+struct sof *sof_get()
+{
+	return &sof;
+}
+
+/*
+ * The component sources linked in register their drivers from
+ * constructors, so the driver list has to exist before any of them runs.
+ */
+__attribute__((constructor(101))) static void kbench_sof_init(void)
+{
+	sys_comp_init(&sof);
+}
+
+static const char *kbench_format_name(enum sof_ipc_frame fmt)
+{
+	switch (fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		return "s16";
+	case SOF_IPC_FRAME_S24_4LE:
+		return "s24";
+	case SOF_IPC_FRAME_S32_LE:
+		return "s32";
+	default:
+		return "unknown";
+	}
+}
+
+static int kbench_format_parse(const char *name)
+{
+	if (!strcmp(name, "s16"))
+		return SOF_IPC_FRAME_S16_LE;
+	if (!strcmp(name, "s24"))
+		return SOF_IPC_FRAME_S24_4LE;
+	if (!strcmp(name, "s32"))
+		return SOF_IPC_FRAME_S32_LE;
+
+	return -EINVAL;
+}
+
+static uint32_t kbench_rand_state = 1;
+
+/* xorshift, repeatable between runs unlike rand() across libc versions */
+static uint32_t kbench_rand(void)
+{
+	kbench_rand_state ^= kbench_rand_state << 13;
+	kbench_rand_state ^= kbench_rand_state >> 17;
+	kbench_rand_state ^= kbench_rand_state << 5;
+	return kbench_rand_state;
+}
+
+static void kbench_fill_noise(struct audio_stream *stream)
+{
+	int16_t *x16 = stream->addr;
+	int32_t *x32 = stream->addr;
+	int n = stream->size / audio_stream_sample_bytes(stream);
+	int i;
+
+	for (i = 0; i < n; i++) {
+		switch (stream->frame_fmt) {
+		case SOF_IPC_FRAME_S16_LE:
+			x16[i] = kbench_rand();
+			break;
+		case SOF_IPC_FRAME_S24_4LE:
+			x32[i] = sign_extend_s24(kbench_rand());
+			break;
+		default:
+			x32[i] = kbench_rand();
+			break;
+		}
+	}
+}
+
+static struct comp_buffer *kbench_buffer_new(enum sof_ipc_frame fmt,
+					     int channels, int frames)
+{
+	struct comp_buffer *buffer;
+	uint32_t size = KBENCH_BUFFER_PERIODS * frames *
+		get_frame_bytes(fmt, channels);
+
+	buffer = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			 sizeof(*buffer));
+	if (!buffer)
+		return NULL;
+
+	buffer->stream.addr = rballoc_align(0, SOF_MEM_CAPS_RAM, size,
+					    PLATFORM_DCACHE_ALIGN);
+	if (!buffer->stream.addr) {
+		rfree(buffer);
+		return NULL;
+	}
+
+	buffer_init(buffer, size, SOF_MEM_CAPS_RAM);
+	list_init(&buffer->source_list);
+	list_init(&buffer->sink_list);
+	buffer->stream.frame_fmt = fmt;
+	buffer->stream.channels = channels;
+
+	return buffer;
+}
+
+static void kbench_buffer_free(struct comp_buffer *buffer)
+{
+	list_item_del(&buffer->source_list);
+	list_item_del(&buffer->sink_list);
+	rfree(buffer->stream.addr);
+	rfree(buffer);
+}
+
+struct comp_buffer *kbench_add_source(struct kbench_case *bc,
+				      enum sof_ipc_frame fmt, int channels,
+				      int frames)
+{
+	struct comp_buffer *buffer;
+
+	if (bc->num_sources == KBENCH_MAX_STREAMS)
+		return NULL;
+
+	buffer = kbench_buffer_new(fmt, channels, frames);
+	if (!buffer)
+		return NULL;
+
+	/* source is kept full, the data is recycled on every run */
+	kbench_fill_noise(&buffer->stream);
+	audio_stream_produce(&buffer->stream, buffer->stream.size);
+
+	list_item_append(&buffer->sink_list, &bc->dev->bsource_list);
+	bc->sources[bc->num_sources++] = buffer;
+
+	return buffer;
+}
+
+struct comp_buffer *kbench_add_sink(struct kbench_case *bc,
+				    enum sof_ipc_frame fmt, int channels,
+				    int frames)
+{
+	struct comp_buffer *buffer;
+
+	if (bc->num_sinks == KBENCH_MAX_STREAMS)
+		return NULL;
+
+	buffer = kbench_buffer_new(fmt, channels, frames);
+	if (!buffer)
+		return NULL;
+
+	list_item_append(&buffer->source_list, &bc->dev->bsink_list);
+	bc->sinks[bc->num_sinks++] = buffer;
+
+	return buffer;
+}
+
+struct sof_eq_iir_header_df2t *kbench_iir_config(int num_sections)
+{
+	struct sof_eq_iir_header_df2t *config;
+	struct sof_eq_iir_biquad_df2t *bq;
+	int i;
+
+	config = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			 sizeof(*config) + num_sections * sizeof(*bq));
+	if (!config)
+		return NULL;
+
+	config->num_sections = num_sections;
+	config->num_sections_in_series = num_sections;
+
+	/* 2nd order Butterworth low-pass at fs / 8 */
+	bq = (struct sof_eq_iir_biquad_df2t *)config->biquads;
+	for (i = 0; i < num_sections; i++) {
+		bq[i].a2 = Q_CONVERT_FLOAT(-0.3333, 30);
+		bq[i].a1 = Q_CONVERT_FLOAT(0.9428, 30);
+		bq[i].b2 = Q_CONVERT_FLOAT(0.0976, 30);
+		bq[i].b1 = Q_CONVERT_FLOAT(0.1953, 30);
+		bq[i].b0 = Q_CONVERT_FLOAT(0.0976, 30);
+		bq[i].output_shift = 0;
+		bq[i].output_gain = Q_CONVERT_FLOAT(1.0, 14);
+	}
+
+	return config;
+}
+
+/* move the stream pointers by one run, keeping sources full and sinks empty */
+static void kbench_advance(struct kbench_case *bc)
+{
+	struct audio_stream *stream;
+	uint32_t bytes;
+	int i;
+
+	for (i = 0; i < bc->num_sources; i++) {
+		stream = &bc->sources[i]->stream;
+		bytes = bc->source_frames * audio_stream_frame_bytes(stream);
+		audio_stream_consume(stream, bytes);
+		audio_stream_produce(stream, bytes);
+	}
+
+	for (i = 0; i < bc->num_sinks; i++) {
+		stream = &bc->sinks[i]->stream;
+		bytes = bc->sink_frames * audio_stream_frame_bytes(stream);
+		audio_stream_produce(stream, bytes);
+		audio_stream_consume(stream, bytes);
+	}
+}
+
+static uint64_t kbench_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void kbench_case_free(const struct kbench_kernel *kernel,
+			     struct kbench_case *bc)
+{
+	int i;
+
+	if (kernel->free)
+		kernel->free(bc);
+
+	for (i = 0; i < bc->num_sources; i++)
+		kbench_buffer_free(bc->sources[i]);
+
+	for (i = 0; i < bc->num_sinks; i++)
+		kbench_buffer_free(bc->sinks[i]);
+
+	rfree(bc->dev);
+}
+
+static int kbench_case_run(const struct kbench_kernel *kernel,
+			   enum sof_ipc_frame fmt, int channels, int frames,
+			   int iterations, struct kbench_result *res)
+{
+	struct kbench_case bc;
+	uint64_t total = 0;
+	uint64_t best = UINT64_MAX;
+	uint64_t t0;
+	uint64_t t;
+	int warmup = MAX(iterations / 10, 1);
+	int ret;
+	int i;
+
+	memset(&bc, 0, sizeof(bc));
+	bc.fmt = fmt;
+	bc.channels = channels;
+	bc.frames = frames;
+	bc.source_frames = frames;
+	bc.sink_frames = frames;
+
+	bc.dev = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			 sizeof(*bc.dev));
+	if (!bc.dev)
+		return -ENOMEM;
+
+	bc.dev->frames = frames;
+	list_init(&bc.dev->bsource_list);
+	list_init(&bc.dev->bsink_list);
+
+	ret = kernel->setup(&bc);
+	if (ret < 0) {
+		kbench_case_free(kernel, &bc);
+		return ret;
+	}
+
+	for (i = 0; i < warmup; i++) {
+		kernel->run(&bc);
+		kbench_advance(&bc);
+	}
+
+	for (i = 0; i < iterations; i++) {
+		t0 = kbench_time_ns();
+		kernel->run(&bc);
+		t = kbench_time_ns() - t0;
+		kbench_advance(&bc);
+
+		total += t;
+		best = MIN(best, t);
+	}
+
+	kbench_case_free(kernel, &bc);
+
+	snprintf(res->kernel, sizeof(res->kernel), "%s", kernel->name);
+	snprintf(res->format, sizeof(res->format), "%s",
+		 kbench_format_name(fmt));
+	res->channels = channels;
+	res->frames = frames;
+	res->iterations = iterations;
+	res->mean_ns = (double)total / iterations / frames;
+	res->min_ns = (double)best / frames;
+
+	return 0;
+}
+
+static bool kbench_kernel_selected(const struct kbench_prm *prm,
+				   const char *name)
+{
+	const char *p = prm->kernels;
+	size_t len = strlen(name);
+
+	if (!p)
+		return true;
+
+	while (p) {
+		if (!strncmp(p, name, len) && (p[len] == ',' || !p[len]))
+			return true;
+
+		p = strchr(p, ',');
+		if (p)
+			p++;
+	}
+
+	return false;
+}
+
+static int kbench_parse_int_list(char *list, int *values, int max)
+{
+	char *save = NULL;
+	char *token;
+	int n = 0;
+
+	for (token = strtok_r(list, ",", &save); token;
+	     token = strtok_r(NULL, ",", &save)) {
+		if (n == max || atoi(token) <= 0)
+			return -EINVAL;
+
+		values[n++] = atoi(token);
+	}
+
+	return n;
+}
+
+static int kbench_parse_formats(char *list, struct kbench_prm *prm)
+{
+	char *save = NULL;
+	char *token;
+	int fmt;
+
+	prm->num_formats = 0;
+	for (token = strtok_r(list, ",", &save); token;
+	     token = strtok_r(NULL, ",", &save)) {
+		fmt = kbench_format_parse(token);
+		if (fmt < 0 || prm->num_formats == KBENCH_MAX_LIST) {
+			fprintf(stderr, "error: invalid format %s\n", token);
+			return -EINVAL;
+		}
+
+		prm->formats[prm->num_formats++] = fmt;
+	}
+
+	return prm->num_formats;
+}
+
+static void kbench_write_csv(const char *file, struct kbench_result *res,
+			     int count)
+{
+	FILE *f = fopen(file, "w");
+	int i;
+
+	if (!f) {
+		fprintf(stderr, "error: cannot write %s\n", file);
+		return;
+	}
+
+	fprintf(f, "kernel,format,channels,frames,iterations,mean_ns_per_frame,min_ns_per_frame\n");
+	for (i = 0; i < count; i++)
+		fprintf(f, "%s,%s,%d,%d,%d,%.3f,%.3f\n", res[i].kernel,
+			res[i].format, res[i].channels, res[i].frames,
+			res[i].iterations, res[i].mean_ns, res[i].min_ns);
+
+	fclose(f);
+}
+
+static void kbench_write_json(const char *file, struct kbench_result *res,
+			      int count)
+{
+	FILE *f = fopen(file, "w");
+	int i;
+
+	if (!f) {
+		fprintf(stderr, "error: cannot write %s\n", file);
+		return;
+	}
+
+	fprintf(f, "{\n\t\"results\": [\n");
+	for (i = 0; i < count; i++) {
+		fprintf(f, "\t\t{\"kernel\": \"%s\", \"format\": \"%s\", ",
+			res[i].kernel, res[i].format);
+		fprintf(f, "\"channels\": %d, \"frames\": %d, \"iterations\": %d, ",
+			res[i].channels, res[i].frames, res[i].iterations);
+		fprintf(f, "\"mean_ns_per_frame\": %.3f, \"min_ns_per_frame\": %.3f}%s\n",
+			res[i].mean_ns, res[i].min_ns,
+			i < count - 1 ? "," : "");
+	}
+
+	fprintf(f, "\t]\n}\n");
+	fclose(f);
+}
+
+/*
+ * Compares the best ns per frame of every result against the baseline CSV
+ * and returns the number of cases that got slower than the threshold.
+ */
+static int kbench_check_baseline(const struct kbench_prm *prm,
+				 struct kbench_result *res, int count)
+{
+	struct kbench_result *base;
+	FILE *f = fopen(prm->baseline_file, "r");
+	char line[256];
+	double limit;
+	int num_base = 0;
+	int regressions = 0;
+	int i;
+	int j;
+
+	if (!f) {
+		fprintf(stderr, "error: cannot read baseline %s\n",
+			prm->baseline_file);
+		return -EINVAL;
+	}
+
+	base = calloc(KBENCH_MAX_BASELINE, sizeof(*base));
+	if (!base) {
+		fclose(f);
+		return -ENOMEM;
+	}
+
+	while (num_base < KBENCH_MAX_BASELINE && fgets(line, sizeof(line), f)) {
+		j = sscanf(line, "%63[^,],%7[^,],%d,%d,%d,%lf,%lf",
+			   base[num_base].kernel, base[num_base].format,
+			   &base[num_base].channels, &base[num_base].frames,
+			   &base[num_base].iterations, &base[num_base].mean_ns,
+			   &base[num_base].min_ns);
+		/* skips the header line too */
+		if (j == 7)
+			num_base++;
+	}
+
+	fclose(f);
+
+	for (i = 0; i < count; i++) {
+		for (j = 0; j < num_base; j++) {
+			if (strcmp(res[i].kernel, base[j].kernel) ||
+			    strcmp(res[i].format, base[j].format) ||
+			    res[i].channels != base[j].channels ||
+			    res[i].frames != base[j].frames)
+				continue;
+
+			limit = base[j].min_ns * (100 + prm->threshold) / 100;
+			if (res[i].min_ns > limit) {
+				printf("REGRESSION %s %s %dch %d: %.3f > %.3f ns (+%d%%)\n",
+				       res[i].kernel, res[i].format,
+				       res[i].channels, res[i].frames,
+				       res[i].min_ns, base[j].min_ns,
+				       prm->threshold);
+				regressions++;
+			}
+			break;
+		}
+	}
+
+	free(base);
+	return regressions;
+}
+
+static void print_usage(char *executable)
+{
+	unsigned int i;
+
+	printf("Usage: %s <options>\n\n", executable);
+	printf("Options:\n");
+	printf("  -k <kernels> comma separated kernels to run, default all\n");
+	printf("  -f <formats> comma separated s16,s24,s32, default all\n");
+	printf("  -n <channels> comma separated channel counts, default 2,8\n");
+	printf("  -p <frames> comma separated period sizes, default 48,480\n");
+	printf("  -i <iterations> timed runs per case, default %d\n",
+	       KBENCH_DEFAULT_ITERATIONS);
+	printf("  -c <file> write results as CSV\n");
+	printf("  -j <file> write results as JSON\n");
+	printf("  -b <file> compare against baseline CSV, exit 1 on regression\n");
+	printf("  -t <percent> allowed slowdown against baseline, default %d\n",
+	       KBENCH_DEFAULT_THRESHOLD);
+	printf("  -d enable component trace\n");
+	printf("  -h print this help\n\n");
+	printf("Kernels:");
+	for (i = 0; i < ARRAY_SIZE(kbench_kernels); i++)
+		printf(" %s", kbench_kernels[i]->name);
+	printf("\n");
+}
+
+static int parse_input_args(int argc, char **argv, struct kbench_prm *prm)
+{
+	int option;
+	int ret = 0;
+
+	while ((option = getopt(argc, argv, "hdk:f:n:p:i:c:j:b:t:")) != -1) {
+		switch (option) {
+		case 'k':
+			prm->kernels = optarg;
+			break;
+		case 'f':
+			ret = kbench_parse_formats(optarg, prm);
+			break;
+		case 'n':
+			ret = kbench_parse_int_list(optarg, prm->channels,
+						    KBENCH_MAX_LIST);
+			prm->num_channels = ret;
+			break;
+		case 'p':
+			ret = kbench_parse_int_list(optarg, prm->frames,
+						    KBENCH_MAX_LIST);
+			prm->num_frames = ret;
+			break;
+		case 'i':
+			prm->iterations = atoi(optarg);
+			if (prm->iterations <= 0)
+				ret = -EINVAL;
+			break;
+		case 'c':
+			prm->csv_file = optarg;
+			break;
+		case 'j':
+			prm->json_file = optarg;
+			break;
+		case 'b':
+			prm->baseline_file = optarg;
+			break;
+		case 't':
+			prm->threshold = atoi(optarg);
+			break;
+		case 'd':
+			test_bench_trace = 1;
+			break;
+		case 'h':
+		default:
+			print_usage(argv[0]);
+			exit(EXIT_FAILURE);
+		}
+
+		if (ret < 0) {
+			print_usage(argv[0]);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	struct kbench_prm prm = {
+		.formats = { SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S24_4LE,
+			     SOF_IPC_FRAME_S32_LE },
+		.num_formats = 3,
+		.channels = { 2, 8 },
+		.num_channels = 2,
+		.frames = { 48, 480 },
+		.num_frames = 2,
+		.iterations = KBENCH_DEFAULT_ITERATIONS,
+		.threshold = KBENCH_DEFAULT_THRESHOLD,
+	};
+	const struct kbench_kernel *kernel;
+	struct kbench_result *res;
+	int max_results;
+	int count = 0;
+	int ret = 0;
+	int k;
+	int f;
+	int c;
+	int p;
+
+	/* kernels trace per call, keep quiet unless asked for */
+	test_bench_trace = 0;
+
+	if (parse_input_args(argc, argv, &prm) < 0)
+		return EXIT_FAILURE;
+
+	max_results = ARRAY_SIZE(kbench_kernels) * prm.num_formats *
+		prm.num_channels * prm.num_frames;
+	res = calloc(max_results, sizeof(*res));
+	if (!res)
+		return EXIT_FAILURE;
+
+	printf("%-14s %-6s %4s %6s %12s %12s\n", "kernel", "format", "ch",
+	       "frames", "mean ns/fr", "min ns/fr");
+
+	for (k = 0; k < ARRAY_SIZE(kbench_kernels); k++) {
+		kernel = kbench_kernels[k];
+		if (!kbench_kernel_selected(&prm, kernel->name))
+			continue;
+
+		for (f = 0; f < prm.num_formats; f++)
+			for (c = 0; c < prm.num_channels; c++)
+				for (p = 0; p < prm.num_frames; p++) {
+					ret = kbench_case_run(kernel,
+							      prm.formats[f],
+							      prm.channels[c],
+							      prm.frames[p],
+							      prm.iterations,
+							      &res[count]);
+					if (ret == -ENOTSUP)
+						continue;
+
+					if (ret < 0) {
+						fprintf(stderr, "error: %s setup failed %d\n",
+							kernel->name, ret);
+						goto out;
+					}
+
+					printf("%-14s %-6s %4d %6d %12.3f %12.3f\n",
+					       res[count].kernel,
+					       res[count].format,
+					       res[count].channels,
+					       res[count].frames,
+					       res[count].mean_ns,
+					       res[count].min_ns);
+					count++;
+				}
+	}
+
+	if (!count) {
+		fprintf(stderr, "error: no case matches the selection\n");
+		ret = -EINVAL;
+		goto out;
+	}
+
+	if (prm.csv_file)
+		kbench_write_csv(prm.csv_file, res, count);
+
+	if (prm.json_file)
+		kbench_write_json(prm.json_file, res, count);
+
+	ret = 0;
+	if (prm.baseline_file) {
+		ret = kbench_check_baseline(&prm, res, count);
+		if (ret > 0)
+			printf("%d case(s) slower than baseline\n", ret);
+	}
+
+out:
+	free(res);
+	return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/asrc/asrc_farrow.h>
+#include <sof/audio/component.h>
+#include <sof/audio/format.h>
+#include <sof/lib/alloc.h>
+#include <sof/math/numbers.h>
+#include <sof/platform.h>
+#include <errno.h>
+#include "testbench/kernel_bench.h"
+
+/* 48 kHz to 44.1 kHz is the common playback conversion */
+#define ASRC_BENCH_FS_SOURCE	48000
+#define ASRC_BENCH_FS_SINK	44100
+
+/* margin the component adds to the nominal frames counts */
+#define ASRC_BENCH_FRAMES_MARGIN	10
+
+struct asrc_bench {
+	struct asrc_farrow *asrc_obj;
+	enum asrc_operation_mode mode;
+	int sample_bits;
+	int source_frames;
+	int sink_frames;
+	int source_frames_max;
+	int sink_frames_max;
+	uint8_t *buf;
+	uint8_t *ibuf[PLATFORM_MAX_CHANNELS];
+	uint8_t *obuf[PLATFORM_MAX_CHANNELS];
+};
+
+static int asrc_bench_setup(struct kbench_case *bc,
+			    enum asrc_operation_mode mode)
+{
+	struct asrc_bench *ab;
+	int32_t fs_prim;
+	int32_t fs_sec;
+	int frame_bytes;
+	int sample_bytes;
+	int frames;
+	int size;
+	int ret;
+	int i;
+
+	if (bc->channels > PLATFORM_MAX_CHANNELS)
+		return -ENOTSUP;
+
+	ab = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*ab));
+	if (!ab)
+		return -ENOMEM;
+
+	bc->priv = ab;
+	ab->mode = mode;
+
+	/* S24_4LE is run by the component as shifted 32 bit data */
+	switch (bc->fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		ab->sample_bits = 16;
+		break;
+	case SOF_IPC_FRAME_S32_LE:
+		ab->sample_bits = 32;
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	/* the sink period is fixed, as asrc_params() does */
+	ab->sink_frames = bc->frames;
+	ab->source_frames = ceil_divide(bc->frames * ASRC_BENCH_FS_SOURCE,
+					ASRC_BENCH_FS_SINK);
+	ab->source_frames_max = ab->source_frames + ASRC_BENCH_FRAMES_MARGIN;
+	ab->sink_frames_max = ab->sink_frames + ASRC_BENCH_FRAMES_MARGIN;
+	frames = MAX(ab->source_frames_max, ab->sink_frames_max);
+
+	/* linear interleaved input and output buffers */
+	sample_bytes = ab->sample_bits >> 3;
+	frame_bytes = sample_bytes * bc->channels;
+	ab->buf = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			  (ab->source_frames_max + ab->sink_frames_max) *
+			  frame_bytes);
+	if (!ab->buf)
+		return -ENOMEM;
+
+	for (i = 0; i < bc->channels; i++) {
+		ab->ibuf[i] = ab->buf + i * sample_bytes;
+		ab->obuf[i] = ab->ibuf[i] + ab->source_frames_max * frame_bytes;
+	}
+
+	/* pseudo random input, the kernel cost does not depend on it */
+	for (i = 0; i < ab->source_frames_max * frame_bytes; i++)
+		ab->buf[i] = (i * 2654435761u) >> 24;
+
+	ret = asrc_get_required_size(bc->dev, &size, bc->channels,
+				     ab->sample_bits);
+	if (ret)
+		return -EINVAL;
+
+	ab->asrc_obj = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			       size);
+	if (!ab->asrc_obj)
+		return -ENOMEM;
+
+	if (mode == ASRC_OM_PUSH) {
+		fs_prim = ASRC_BENCH_FS_SOURCE;
+		fs_sec = ASRC_BENCH_FS_SINK;
+	} else {
+		fs_prim = ASRC_BENCH_FS_SINK;
+		fs_sec = ASRC_BENCH_FS_SOURCE;
+	}
+
+	ret = asrc_initialise(bc->dev, ab->asrc_obj, bc->channels, fs_prim,
+			      fs_sec, ASRC_IOF_INTERLEAVED,
+			      ASRC_IOF_INTERLEAVED, ASRC_BM_LINEAR, frames,
+			      ab->sample_bits, ASRC_CM_FEEDBACK, mode);
+	if (ret)
+		return -EINVAL;
+
+	ret = asrc_update_drift(bc->dev, ab->asrc_obj,
+				Q_CONVERT_FLOAT(1.0, 30));
+	if (ret)
+		return -EINVAL;
+
+	/* the kernel works on private linear buffers, no streams to move */
+	bc->source_frames = 0;
+	bc->sink_frames = 0;
+
+	return 0;
+}
+
+static int asrc_push_setup(struct kbench_case *bc)
+{
+	return asrc_bench_setup(bc, ASRC_OM_PUSH);
+}
+
+static int asrc_pull_setup(struct kbench_case *bc)
+{
+	return asrc_bench_setup(bc, ASRC_OM_PULL);
+}
+
+static void asrc_bench_run(struct kbench_case *bc)
+{
+	struct asrc_bench *ab = bc->priv;
+	int in_frames;
+	int out_frames;
+	int idx;
+
+	if (ab->mode == ASRC_OM_PUSH) {
+		/* fixed input, variable output */
+		in_frames = ab->source_frames;
+		out_frames = ab->sink_frames_max;
+		if (ab->sample_bits == 16)
+			asrc_process_push16(bc->dev, ab->asrc_obj,
+					    (int16_t **)ab->ibuf, &in_frames,
+					    (int16_t **)ab->obuf, &out_frames,
+					    &idx, 0);
+		else
+			asrc_process_push32(bc->dev, ab->asrc_obj,
+					    (int32_t **)ab->ibuf, &in_frames,
+					    (int32_t **)ab->obuf, &out_frames,
+					    &idx, 0);
+	} else {
+		/* fixed output, variable input */
+		in_frames = ab->source_frames_max;
+		out_frames = ab->sink_frames;
+		if (ab->sample_bits == 16)
+			asrc_process_pull16(bc->dev, ab->asrc_obj,
+					    (int16_t **)ab->ibuf, &in_frames,
+					    (int16_t **)ab->obuf, &out_frames,
+					    in_frames, &idx);
+		else
+			asrc_process_pull32(bc->dev, ab->asrc_obj,
+					    (int32_t **)ab->ibuf, &in_frames,
+					    (int32_t **)ab->obuf, &out_frames,
+					    in_frames, &idx);
+	}
+}
+
+static void asrc_bench_free(struct kbench_case *bc)
+{
+	struct asrc_bench *ab = bc->priv;
+
+	if (!ab)
+		return;
+
+	rfree(ab->asrc_obj);
+	rfree(ab->buf);
+	rfree(ab);
+}
+
+const struct kbench_kernel kbench_asrc_push = {
+	.name = "asrc_push",
+	.setup = asrc_push_setup,
+	.run = asrc_bench_run,
+	.free = asrc_bench_free,
+};
+
+const struct kbench_kernel kbench_asrc_pull = {
+	.name = "asrc_pull",
+	.setup = asrc_pull_setup,
+	.run = asrc_bench_run,
+	.free = asrc_bench_free,
+};
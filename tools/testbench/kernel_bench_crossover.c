@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/crossover/crossover.h>
+#include <sof/audio/eq_iir/iir.h>
+#include <sof/lib/alloc.h>
+#include <sof/platform.h>
+#include <user/eq.h>
+#include <errno.h>
+#include "testbench/kernel_bench.h"
+
+/* one LR4 low-pass/high-pass pair per channel */
+#define CROSSOVER_BENCH_SINKS	CROSSOVER_2WAY_NUM_SINKS
+
+struct crossover_bench {
+	struct comp_data cd;
+	struct sof_eq_iir_header_df2t *config;
+	int64_t *delay;
+};
+
+static int crossover_setup(struct kbench_case *bc)
+{
+	struct crossover_bench *xb;
+	int64_t *delay;
+	int i;
+
+	if (bc->channels > PLATFORM_MAX_CHANNELS)
+		return -ENOTSUP;
+
+	xb = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*xb));
+	if (!xb)
+		return -ENOMEM;
+
+	bc->priv = xb;
+	comp_set_drvdata(bc->dev, &xb->cd);
+
+	xb->cd.crossover_process = crossover_find_proc_func(bc->fmt);
+	if (!xb->cd.crossover_process)
+		return -ENOTSUP;
+
+	xb->cd.crossover_split = crossover_find_split_func(CROSSOVER_BENCH_SINKS);
+
+	/* an LR4 filter is two identical biquads in series */
+	xb->config = kbench_iir_config(2);
+	xb->delay = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			    2 * CROSSOVER_NUM_DELAYS_LR4 * sizeof(int64_t) *
+			    bc->channels);
+	if (!xb->config || !xb->delay)
+		return -ENOMEM;
+
+	delay = xb->delay;
+	for (i = 0; i < bc->channels; i++) {
+		iir_init_coef_df2t(&xb->cd.state[i].lowpass[0], xb->config);
+		iir_init_delay_df2t(&xb->cd.state[i].lowpass[0], &delay);
+		iir_init_coef_df2t(&xb->cd.state[i].highpass[0], xb->config);
+		iir_init_delay_df2t(&xb->cd.state[i].highpass[0], &delay);
+	}
+
+	if (!kbench_add_source(bc, bc->fmt, bc->channels, bc->frames))
+		return -ENOMEM;
+
+	for (i = 0; i < CROSSOVER_BENCH_SINKS; i++)
+		if (!kbench_add_sink(bc, bc->fmt, bc->channels, bc->frames))
+			return -ENOMEM;
+
+	return 0;
+}
+
+static void crossover_run(struct kbench_case *bc)
+{
+	struct crossover_bench *xb = bc->priv;
+
+	xb->cd.crossover_process(bc->dev, bc->sources[0], bc->sinks,
+				 CROSSOVER_BENCH_SINKS, bc->frames);
+}
+
+static void crossover_free(struct kbench_case *bc)
+{
+	struct crossover_bench *xb = bc->priv;
+
+	if (!xb)
+		return;
+
+	rfree(xb->delay);
+	rfree(xb->config);
+	rfree(xb);
+}
+
+const struct kbench_kernel kbench_crossover = {
+	.name = "crossover",
+	.setup = crossover_setup,
+	.run = crossover_run,
+	.free = crossover_free,
+};
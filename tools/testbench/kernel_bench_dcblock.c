@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/dcblock/dcblock.h>
+#include <sof/audio/format.h>
+#include <sof/lib/alloc.h>
+#include <sof/platform.h>
+#include <errno.h>
+#include "testbench/kernel_bench.h"
+
+static int dcblock_setup(struct kbench_case *bc)
+{
+	struct comp_data *cd;
+	int i;
+
+	if (bc->channels > PLATFORM_MAX_CHANNELS)
+		return -ENOTSUP;
+
+	cd = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*cd));
+	if (!cd)
+		return -ENOMEM;
+
+	comp_set_drvdata(bc->dev, cd);
+	bc->priv = cd;
+
+	cd->dcblock_func = dcblock_find_func(bc->fmt);
+	if (!cd->dcblock_func)
+		return -ENOTSUP;
+
+	for (i = 0; i < bc->channels; i++)
+		cd->R_coeffs[i] = Q_CONVERT_FLOAT(0.98, 30);
+
+	if (!kbench_add_source(bc, bc->fmt, bc->channels, bc->frames) ||
+	    !kbench_add_sink(bc, bc->fmt, bc->channels, bc->frames))
+		return -ENOMEM;
+
+	return 0;
+}
+
+static void dcblock_run(struct kbench_case *bc)
+{
+	struct comp_data *cd = bc->priv;
+
+	cd->dcblock_func(bc->dev, &bc->sources[0]->stream,
+			 &bc->sinks[0]->stream, bc->frames);
+}
+
+static void dcblock_free(struct kbench_case *bc)
+{
+	rfree(bc->priv);
+}
+
+const struct kbench_kernel kbench_dcblock = {
+	.name = "dcblock",
+	.setup = dcblock_setup,
+	.run = dcblock_run,
+	.free = dcblock_free,
+};
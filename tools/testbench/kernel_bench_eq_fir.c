@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/eq_fir/eq_fir.h>
+#include <sof/lib/alloc.h>
+#include <sof/platform.h>
+#include <user/fir.h>
+#include <errno.h>
+#include "testbench/kernel_bench.h"
+
+/* typical EQ FIR length */
+#define EQ_FIR_BENCH_TAPS	64
+
+struct eq_fir_bench {
+	struct fir_state_32x16 fir[PLATFORM_MAX_CHANNELS];
+	struct sof_fir_coef_data *config;
+	int32_t *delay;
+	void (*func)(struct fir_state_32x16 *fir,
+		     const struct audio_stream *source,
+		     struct audio_stream *sink, int frames, int nch);
+};
+
+static int eq_fir_setup(struct kbench_case *bc)
+{
+	struct eq_fir_bench *eb;
+	int32_t *delay;
+	int size;
+	int i;
+
+	if (bc->channels > PLATFORM_MAX_CHANNELS)
+		return -ENOTSUP;
+
+	eb = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*eb));
+	if (!eb)
+		return -ENOMEM;
+
+	bc->priv = eb;
+
+	switch (bc->fmt) {
+#if CONFIG_FORMAT_S16LE
+	case SOF_IPC_FRAME_S16_LE:
+		eb->func = eq_fir_s16;
+		break;
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	case SOF_IPC_FRAME_S24_4LE:
+		eb->func = eq_fir_s24;
+		break;
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	case SOF_IPC_FRAME_S32_LE:
+		eb->func = eq_fir_s32;
+		break;
+#endif /* CONFIG_FORMAT_S32LE */
+	default:
+		return -ENOTSUP;
+	}
+
+	eb->config = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			     sizeof(*eb->config) +
+			     EQ_FIR_BENCH_TAPS * sizeof(int16_t));
+	if (!eb->config)
+		return -ENOMEM;
+
+	/* moving average, the coefficient values don't affect the cost */
+	eb->config->length = EQ_FIR_BENCH_TAPS;
+	eb->config->out_shift = 0;
+	for (i = 0; i < EQ_FIR_BENCH_TAPS; i++)
+		eb->config->coef[i] = INT16_MAX / EQ_FIR_BENCH_TAPS;
+
+	size = fir_delay_size(eb->config);
+	if (size < 0)
+		return size;
+
+	eb->delay = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			    size * bc->channels);
+	if (!eb->delay)
+		return -ENOMEM;
+
+	delay = eb->delay;
+	for (i = 0; i < bc->channels; i++) {
+		fir_init_coef(&eb->fir[i], eb->config);
+		fir_init_delay(&eb->fir[i], &delay);
+	}
+
+	if (!kbench_add_source(bc, bc->fmt, bc->channels, bc->frames) ||
+	    !kbench_add_sink(bc, bc->fmt, bc->channels, bc->frames))
+		return -ENOMEM;
+
+	return 0;
+}
+
+static void eq_fir_run(struct kbench_case *bc)
+{
+	struct eq_fir_bench *eb = bc->priv;
+
+	eb->func(eb->fir, &bc->sources[0]->stream, &bc->sinks[0]->stream,
+		 bc->frames, bc->channels);
+}
+
+static void eq_fir_free(struct kbench_case *bc)
+{
+	struct eq_fir_bench *eb = bc->priv;
+
+	if (!eb)
+		return;
+
+	rfree(eb->delay);
+	rfree(eb->config);
+	rfree(eb);
+}
+
+const struct kbench_kernel kbench_eq_fir = {
+	.name = "eq_fir",
+	.setup = eq_fir_setup,
+	.run = eq_fir_run,
+	.free = eq_fir_free,
+};
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/eq_iir/eq_iir.h>
+#include <sof/audio/eq_iir/iir.h>
+#include <sof/lib/alloc.h>
+#include <sof/platform.h>
+#include <user/eq.h>
+#include <errno.h>
+#include "testbench/kernel_bench.h"
+
+/* typical speaker EQ size */
+#define EQ_IIR_BENCH_SECTIONS	4
+
+struct eq_iir_bench {
+	struct comp_data cd;
+	struct sof_eq_iir_header_df2t *config;
+};
+
+static int eq_iir_setup(struct kbench_case *bc)
+{
+	struct eq_iir_bench *eb;
+	int64_t *delay;
+	int size;
+	int i;
+
+	if (bc->channels > PLATFORM_MAX_CHANNELS)
+		return -ENOTSUP;
+
+	eb = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*eb));
+	if (!eb)
+		return -ENOMEM;
+
+	bc->priv = eb;
+	comp_set_drvdata(bc->dev, &eb->cd);
+
+	for (i = 0; i < fm_configured_count; i++) {
+		if (fm_configured[i].source == bc->fmt &&
+		    fm_configured[i].sink == bc->fmt)
+			eb->cd.eq_iir_func = fm_configured[i].func;
+	}
+
+	if (!eb->cd.eq_iir_func)
+		return -ENOTSUP;
+
+	eb->config = kbench_iir_config(EQ_IIR_BENCH_SECTIONS);
+	if (!eb->config)
+		return -ENOMEM;
+
+	size = iir_delay_size_df2t(eb->config);
+	if (size < 0)
+		return size;
+
+	eb->cd.iir_delay_size = size * bc->channels;
+	eb->cd.iir_delay = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+				   eb->cd.iir_delay_size);
+	if (!eb->cd.iir_delay)
+		return -ENOMEM;
+
+	delay = eb->cd.iir_delay;
+	for (i = 0; i < bc->channels; i++) {
+		iir_init_coef_df2t(&eb->cd.iir[i], eb->config);
+		iir_init_delay_df2t(&eb->cd.iir[i], &delay);
+	}
+
+	if (!kbench_add_source(bc, bc->fmt, bc->channels, bc->frames) ||
+	    !kbench_add_sink(bc, bc->fmt, bc->channels, bc->frames))
+		return -ENOMEM;
+
+	return 0;
+}
+
+static void eq_iir_run(struct kbench_case *bc)
+{
+	struct eq_iir_bench *eb = bc->priv;
+
+	eb->cd.eq_iir_func(bc->dev, &bc->sources[0]->stream,
+			   &bc->sinks[0]->stream, bc->frames);
+}
+
+static void eq_iir_free(struct kbench_case *bc)
+{
+	struct eq_iir_bench *eb = bc->priv;
+
+	if (!eb)
+		return;
+
+	rfree(eb->cd.iir_delay);
+	rfree(eb->config);
+	rfree(eb);
+}
+
+const struct kbench_kernel kbench_eq_iir = {
+	.name = "eq_iir",
+	.setup = eq_iir_setup,
+	.run = eq_iir_run,
+	.free = eq_iir_free,
+};
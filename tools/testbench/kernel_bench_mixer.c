@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/mixer.h>
+#include <errno.h>
+#include "testbench/kernel_bench.h"
+
+/* number of mixed streams */
+#define MIXER_BENCH_SOURCES	2
+
+static int mixer_setup(struct kbench_case *bc)
+{
+	int i;
+
+	bc->priv = mixer_get_processing_function(bc->fmt);
+	if (!bc->priv)
+		return -ENOTSUP;
+
+	for (i = 0; i < MIXER_BENCH_SOURCES; i++)
+		if (!kbench_add_source(bc, bc->fmt, bc->channels, bc->frames))
+			return -ENOMEM;
+
+	if (!kbench_add_sink(bc, bc->fmt, bc->channels, bc->frames))
+		return -ENOMEM;
+
+	return 0;
+}
+
+static void mixer_run(struct kbench_case *bc)
+{
+	const struct audio_stream *sources[MIXER_BENCH_SOURCES];
+	mixer_func mix_func = bc->priv;
+	int i;
+
+	for (i = 0; i < MIXER_BENCH_SOURCES; i++)
+		sources[i] = &bc->sources[i]->stream;
+
+	mix_func(bc->dev, &bc->sinks[0]->stream, sources, MIXER_BENCH_SOURCES,
+		 bc->frames);
+}
+
+const struct kbench_kernel kbench_mixer = {
+	.name = "mixer",
+	.setup = mixer_setup,
+	.run = mixer_run,
+};
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/mux.h>
+#include <sof/bit.h>
+#include <sof/lib/alloc.h>
+#include <sof/platform.h>
+#include <errno.h>
+#include "testbench/kernel_bench.h"
+
+/* streams interleaved channel by channel */
+#define MUX_BENCH_STREAMS	2
+
+static int mux_bench_alloc(struct kbench_case *bc)
+{
+	struct comp_data *cd;
+	int i;
+	int j;
+
+	if (bc->channels > PLATFORM_MAX_CHANNELS)
+		return -ENOTSUP;
+
+	cd = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*cd) +
+		     MUX_BENCH_STREAMS * sizeof(struct mux_stream_data));
+	if (!cd)
+		return -ENOMEM;
+
+	comp_set_drvdata(bc->dev, cd);
+	bc->priv = cd;
+
+	/* even channels go to/come from the first stream, odd to the second */
+	cd->config.num_streams = MUX_BENCH_STREAMS;
+	for (i = 0; i < MUX_BENCH_STREAMS; i++) {
+		cd->config.streams[i].pipeline_id = i;
+		for (j = i; j < bc->channels; j += MUX_BENCH_STREAMS)
+			cd->config.streams[i].mask[j] = BIT(j);
+	}
+
+	return 0;
+}
+
+static int mux_setup(struct kbench_case *bc)
+{
+	struct comp_data *cd;
+	int ret;
+	int i;
+
+	ret = mux_bench_alloc(bc);
+	if (ret < 0)
+		return ret;
+
+	cd = bc->priv;
+
+	for (i = 0; i < MUX_BENCH_STREAMS; i++)
+		if (!kbench_add_source(bc, bc->fmt, bc->channels, bc->frames))
+			return -ENOMEM;
+
+	if (!kbench_add_sink(bc, bc->fmt, bc->channels, bc->frames))
+		return -ENOMEM;
+
+	mux_prepare_look_up_table(bc->dev);
+	cd->mux = mux_get_processing_function(bc->dev);
+	if (!cd->mux)
+		return -ENOTSUP;
+
+	return 0;
+}
+
+static void mux_run(struct kbench_case *bc)
+{
+	struct comp_data *cd = bc->priv;
+	const struct audio_stream *sources[MUX_BENCH_STREAMS];
+	int i;
+
+	for (i = 0; i < MUX_BENCH_STREAMS; i++)
+		sources[i] = &bc->sources[i]->stream;
+
+	cd->mux(bc->dev, &bc->sinks[0]->stream, sources, bc->frames,
+		&cd->lookup[0]);
+}
+
+static int demux_setup(struct kbench_case *bc)
+{
+	struct comp_data *cd;
+	int ret;
+	int i;
+
+	ret = mux_bench_alloc(bc);
+	if (ret < 0)
+		return ret;
+
+	cd = bc->priv;
+
+	if (!kbench_add_source(bc, bc->fmt, bc->channels, bc->frames))
+		return -ENOMEM;
+
+	for (i = 0; i < MUX_BENCH_STREAMS; i++)
+		if (!kbench_add_sink(bc, bc->fmt, bc->channels, bc->frames))
+			return -ENOMEM;
+
+	demux_prepare_look_up_table(bc->dev);
+	cd->demux = demux_get_processing_function(bc->dev);
+	if (!cd->demux)
+		return -ENOTSUP;
+
+	return 0;
+}
+
+static void demux_run(struct kbench_case *bc)
+{
+	struct comp_data *cd = bc->priv;
+	int i;
+
+	for (i = 0; i < MUX_BENCH_STREAMS; i++)
+		cd->demux(bc->dev, &bc->sinks[i]->stream,
+			  &bc->sources[0]->stream, bc->frames, &cd->lookup[i]);
+}
+
+static void mux_bench_free(struct kbench_case *bc)
+{
+	rfree(bc->priv);
+}
+
+const struct kbench_kernel kbench_mux = {
+	.name = "mux",
+	.setup = mux_setup,
+	.run = mux_run,
+	.free = mux_bench_free,
+};
+
+const struct kbench_kernel kbench_demux = {
+	.name = "demux",
+	.setup = demux_setup,
+	.run = demux_run,
+	.free = mux_bench_free,
+};
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/pcm_converter.h>
+#include <errno.h>
+#include "testbench/kernel_bench.h"
+
+static int pcm_converter_setup(struct kbench_case *bc)
+{
+	enum sof_ipc_frame out;
+	pcm_converter_func func;
+
+	/* convert to the 32 bit host format, S32_LE down to 16 bits */
+	out = bc->fmt == SOF_IPC_FRAME_S32_LE ? SOF_IPC_FRAME_S16_LE :
+		SOF_IPC_FRAME_S32_LE;
+
+	func = pcm_get_conversion_function(bc->fmt, out);
+	if (!func)
+		return -ENOTSUP;
+
+	bc->priv = func;
+
+	if (!kbench_add_source(bc, bc->fmt, bc->channels, bc->frames) ||
+	    !kbench_add_sink(bc, out, bc->channels, bc->frames))
+		return -ENOMEM;
+
+	return 0;
+}
+
+static void pcm_converter_run(struct kbench_case *bc)
+{
+	pcm_converter_func func = bc->priv;
+
+	func(&bc->sources[0]->stream, 0, &bc->sinks[0]->stream, 0,
+	     bc->frames * bc->channels);
+}
+
+static void pcm_converter_free(struct kbench_case *bc)
+{
+}
+
+const struct kbench_kernel kbench_pcm_converter = {
+	.name = "pcm_converter",
+	.setup = pcm_converter_setup,
+	.run = pcm_converter_run,
+	.free = pcm_converter_free,
+};
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/src/src.h>
+#include <sof/lib/alloc.h>
+#include <errno.h>
+#include "testbench/kernel_bench.h"
+
+/* 3:1 decimation is done by a single polyphase stage */
+#define SRC_BENCH_FS_IN		48000
+#define SRC_BENCH_FS_OUT	16000
+
+struct src_bench {
+	struct src_param param;
+	struct polyphase_src src;
+	struct src_stage_prm s1;
+	void (*polyphase_func)(struct src_stage_prm *s);
+	int32_t *delay_lines;
+};
+
+static int src_setup(struct kbench_case *bc)
+{
+	struct src_bench *sb;
+	int times;
+	int ret;
+
+	sb = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*sb));
+	if (!sb)
+		return -ENOMEM;
+
+	bc->priv = sb;
+
+	switch (bc->fmt) {
+#if CONFIG_FORMAT_S16LE
+	case SOF_IPC_FRAME_S16_LE:
+		sb->polyphase_func = src_polyphase_stage_cir_s16;
+		break;
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	case SOF_IPC_FRAME_S24_4LE:
+		sb->polyphase_func = src_polyphase_stage_cir;
+		sb->s1.shift = 8;
+		break;
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	case SOF_IPC_FRAME_S32_LE:
+		sb->polyphase_func = src_polyphase_stage_cir;
+		break;
+#endif /* CONFIG_FORMAT_S32LE */
+	default:
+		return -ENOTSUP;
+	}
+
+	ret = src_buffer_lengths(&sb->param, SRC_BENCH_FS_IN, SRC_BENCH_FS_OUT,
+				 bc->channels, bc->frames);
+	if (ret < 0)
+		return -ENOTSUP;
+
+	sb->delay_lines = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+				  sb->param.total * sizeof(int32_t));
+	if (!sb->delay_lines)
+		return -ENOMEM;
+
+	ret = src_polyphase_init(&sb->src, &sb->param,
+				 sb->delay_lines + sb->param.sbuf_length);
+	if (ret != 1)
+		return -ENOTSUP;
+
+	/* whole blocks only, as the component copy() does */
+	times = bc->frames / sb->src.stage1->blk_in;
+	if (!times)
+		return -ENOTSUP;
+
+	bc->source_frames = times * sb->src.stage1->blk_in;
+	bc->sink_frames = times * sb->src.stage1->blk_out;
+
+	if (!kbench_add_source(bc, bc->fmt, bc->channels, bc->frames) ||
+	    !kbench_add_sink(bc, bc->fmt, bc->channels, bc->sink_frames))
+		return -ENOMEM;
+
+	sb->s1.times = times;
+	sb->s1.nch = bc->channels;
+	sb->s1.state = &sb->src.state1;
+	sb->s1.stage = sb->src.stage1;
+
+	return 0;
+}
+
+static void src_run(struct kbench_case *bc)
+{
+	struct src_bench *sb = bc->priv;
+	struct audio_stream *source = &bc->sources[0]->stream;
+	struct audio_stream *sink = &bc->sinks[0]->stream;
+
+	sb->s1.x_rptr = source->r_ptr;
+	sb->s1.x_end_addr = source->end_addr;
+	sb->s1.x_size = source->size;
+	sb->s1.y_wptr = sink->w_ptr;
+	sb->s1.y_addr = sink->addr;
+	sb->s1.y_end_addr = sink->end_addr;
+	sb->s1.y_size = sink->size;
+
+	sb->polyphase_func(&sb->s1);
+}
+
+static void src_free(struct kbench_case *bc)
+{
+	struct src_bench *sb = bc->priv;
+
+	if (!sb)
+		return;
+
+	src_param_free(&sb->param);
+	rfree(sb->delay_lines);
+	rfree(sb);
+}
+
+const struct kbench_kernel kbench_src = {
+	.name = "src",
+	.setup = src_setup,
+	.run = src_run,
+	.free = src_free,
+};
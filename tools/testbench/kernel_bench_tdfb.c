@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/tdfb/tdfb_comp.h>
+#include <sof/bit.h>
+#include <sof/lib/alloc.h>
+#include <sof/platform.h>
+#include <user/fir.h>
+#include <user/tdfb.h>
+#include <errno.h>
+#include "testbench/kernel_bench.h"
+
+/* typical beamformer filter length */
+#define TDFB_BENCH_TAPS		64
+
+/* beam output is stereo */
+#define TDFB_BENCH_OUT_CH	2
+
+struct tdfb_bench {
+	struct tdfb_comp_data cd;
+	struct sof_fir_coef_data *coef;
+	int16_t channel_map[3 * PLATFORM_MAX_CHANNELS];
+};
+
+static int tdfb_setup(struct kbench_case *bc)
+{
+	struct tdfb_bench *tb;
+	int32_t *delay;
+	int out_nch = MIN(bc->channels, TDFB_BENCH_OUT_CH);
+	int nf = bc->channels;
+	int size;
+	int i;
+
+	/* filters run on frame pairs */
+	if (bc->channels > PLATFORM_MAX_CHANNELS || bc->frames & 1)
+		return -ENOTSUP;
+
+	tb = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*tb));
+	if (!tb)
+		return -ENOMEM;
+
+	bc->priv = tb;
+
+	switch (bc->fmt) {
+#if CONFIG_FORMAT_S16LE
+	case SOF_IPC_FRAME_S16_LE:
+		tb->cd.tdfb_func = tdfb_fir_s16;
+		break;
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	case SOF_IPC_FRAME_S24_4LE:
+		tb->cd.tdfb_func = tdfb_fir_s24;
+		break;
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	case SOF_IPC_FRAME_S32_LE:
+		tb->cd.tdfb_func = tdfb_fir_s32;
+		break;
+#endif /* CONFIG_FORMAT_S32LE */
+	default:
+		return -ENOTSUP;
+	}
+
+	tb->cd.config = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+				sizeof(*tb->cd.config));
+	tb->coef = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			   sizeof(*tb->coef) +
+			   TDFB_BENCH_TAPS * sizeof(int16_t));
+	if (!tb->cd.config || !tb->coef)
+		return -ENOMEM;
+
+	tb->coef->length = TDFB_BENCH_TAPS;
+	for (i = 0; i < TDFB_BENCH_TAPS; i++)
+		tb->coef->coef[i] = INT16_MAX / TDFB_BENCH_TAPS;
+
+	/* one filter per microphone, mixed alternately to the beam outputs */
+	tb->cd.config->num_filters = nf;
+	tb->cd.config->num_output_channels = out_nch;
+	tb->cd.config->num_output_streams = 1;
+	tb->cd.input_channel_select = &tb->channel_map[0];
+	tb->cd.output_channel_mix = &tb->channel_map[nf];
+	tb->cd.output_stream_mix = &tb->channel_map[2 * nf];
+	for (i = 0; i < nf; i++) {
+		tb->cd.input_channel_select[i] = i;
+		tb->cd.output_channel_mix[i] = BIT(i % out_nch);
+		tb->cd.output_stream_mix[i] = 0;
+	}
+
+	size = fir_delay_size(tb->coef);
+	if (size < 0)
+		return size;
+
+	tb->cd.fir_delay_size = size * nf;
+	tb->cd.fir_delay = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+				   tb->cd.fir_delay_size);
+	if (!tb->cd.fir_delay)
+		return -ENOMEM;
+
+	delay = tb->cd.fir_delay;
+	for (i = 0; i < nf; i++) {
+		fir_init_coef(&tb->cd.fir[i], tb->coef);
+		fir_init_delay(&tb->cd.fir[i], &delay);
+	}
+
+	if (!kbench_add_source(bc, bc->fmt, bc->channels, bc->frames) ||
+	    !kbench_add_sink(bc, bc->fmt, out_nch, bc->frames))
+		return -ENOMEM;
+
+	return 0;
+}
+
+static void tdfb_run(struct kbench_case *bc)
+{
+	struct tdfb_bench *tb = bc->priv;
+
+	tb->cd.tdfb_func(&tb->cd, &bc->sources[0]->stream,
+			 &bc->sinks[0]->stream, bc->frames);
+}
+
+static void tdfb_free(struct kbench_case *bc)
+{
+	struct tdfb_bench *tb = bc->priv;
+
+	if (!tb)
+		return;
+
+	rfree(tb->cd.fir_delay);
+	rfree(tb->cd.config);
+	rfree(tb->coef);
+	rfree(tb);
+}
+
+const struct kbench_kernel kbench_tdfb = {
+	.name = "tdfb",
+	.setup = tdfb_setup,
+	.run = tdfb_run,
+	.free = tdfb_free,
+};
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/volume.h>
+#include <sof/lib/alloc.h>
+#include <errno.h>
+#include "testbench/kernel_bench.h"
+
+static int volume_setup(struct kbench_case *bc)
+{
+	struct comp_data *cd;
+	int i;
+
+	if (bc->channels > SOF_IPC_MAX_CHANNELS)
+		return -ENOTSUP;
+
+	if (!kbench_add_source(bc, bc->fmt, bc->channels, bc->frames) ||
+	    !kbench_add_sink(bc, bc->fmt, bc->channels, bc->frames))
+		return -ENOMEM;
+
+	cd = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*cd));
+	if (!cd)
+		return -ENOMEM;
+
+	comp_set_drvdata(bc->dev, cd);
+	bc->priv = cd;
+
+	/* -6 dB, a gain that touches every sample */
+	for (i = 0; i < bc->channels; i++)
+		cd->volume[i] = VOL_ZERO_DB / 2;
+
+	cd->scale_vol = vol_get_processing_function(bc->dev);
+	if (!cd->scale_vol)
+		return -ENOTSUP;
+
+	return 0;
+}
+
+static void volume_run(struct kbench_case *bc)
+{
+	struct comp_data *cd = bc->priv;
+
+	cd->scale_vol(bc->dev, &bc->sinks[0]->stream,
+		      &bc->sources[0]->stream, bc->frames);
+}
+
+static void volume_free(struct kbench_case *bc)
+{
+	rfree(bc->priv);
+}
+
+const struct kbench_kernel kbench_volume = {
+	.name = "volume",
+	.setup = volume_setup,
+	.run = volume_run,
+	.free = volume_free,
+};
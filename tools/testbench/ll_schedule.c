@@ -15,3 +15,19 @@ int schedule_task_init_ll(struct task *task,
 	return schedule_task_init(task, uid, type, priority, run, data, core,
 				  flags);
 }
+
+void schedule_task_budget_ll(struct task *task, uint32_t id, uint32_t budget)
+{
+}
+
+/* tasks are run by the testbench itself, no statistics are kept */
+int schedule_ll_task_stats(uint16_t type, struct ll_task_info *info,
+			   int count)
+{
+	return 0;
+}
+
+uint32_t schedule_ll_load(void)
+{
+	return 0;
+}
@@ -0,0 +1,333 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2020 Intel Corporation. All rights reserved.
+
+/*
+ * Per component cycle accounting for the testbench. The component copy()
+ * is already bracketed by the performance counters in comp_copy(), this
+ * reads them back after every scheduling tick, keeps the cost of each
+ * period and reports mean, p99 and max per component. Optionally every
+ * copy is written as a Chrome trace event to view the timeline of ticks
+ * in chrome://tracing or Perfetto.
+ */
+
+#include <sof/audio/component.h>
+#include <sof/drivers/ipc.h>
+#include <sof/drivers/timer.h>
+#include <sof/list.h>
+#include <sof/sof.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "testbench/common_test.h"
+#include "testbench/perf.h"
+
+#define TB_PERF_NAME_LEN	32
+#define TB_PERF_MIN_TICKS	1024
+
+/* the host platform timer counts nanoseconds */
+#define TB_PERF_TICKS_PER_US	1000
+
+struct tb_perf_comp {
+	struct comp_dev *dev;
+	char name[TB_PERF_NAME_LEN];
+	uint32_t *ns;		/* copy() cost of every period it ran */
+	uint64_t count;
+	uint64_t sum;
+	uint32_t max;
+};
+
+/* name the component after its library table entry and id */
+static void tb_perf_comp_name(struct tb_perf_comp *pc,
+			      struct shared_lib_table *lib_table)
+{
+	const struct comp_driver *drv = pc->dev->drv;
+	const char *name = "comp";
+	int i;
+
+	for (i = 0; i < NUM_WIDGETS_SUPPORTED; i++) {
+		if (drv->type != SOF_COMP_NONE &&
+		    drv->type == lib_table[i].widget_type) {
+			name = lib_table[i].comp_name;
+			break;
+		}
+
+		if (drv->type == SOF_COMP_NONE && lib_table[i].uid &&
+		    !memcmp(lib_table[i].uid, drv->uid, UUID_SIZE)) {
+			name = lib_table[i].comp_name;
+			break;
+		}
+	}
+
+	snprintf(pc->name, sizeof(pc->name), "%s.%u", name,
+		 dev_comp_id(pc->dev));
+}
+
+static void tb_perf_event(struct tb_perf *perf, const char *name, int pid,
+			  uint64_t start, uint64_t duration)
+{
+	fprintf(perf->timeline,
+		"%s\n\t\t{\"name\": \"%s\", \"ph\": \"X\", \"pid\": %d, \"tid\": 0, ",
+		perf->timeline_events++ ? "," : "", name, pid);
+	fprintf(perf->timeline, "\"ts\": %.3f, \"dur\": %.3f}",
+		(double)(start - perf->time_base) / TB_PERF_TICKS_PER_US,
+		(double)duration / TB_PERF_TICKS_PER_US);
+}
+
+static void tb_perf_process_name(struct tb_perf *perf, int pid,
+				 const char *name)
+{
+	fprintf(perf->timeline,
+		"%s\n\t\t{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %d, ",
+		perf->timeline_events++ ? "," : "", pid);
+	fprintf(perf->timeline, "\"args\": {\"name\": \"%s\"}}", name);
+}
+
+static int tb_perf_timeline_open(struct tb_perf *perf, const char *file)
+{
+	char name[TB_PERF_NAME_LEN];
+	uint32_t last_pid = 0;
+	uint32_t pid;
+	int i;
+
+	perf->timeline = fopen(file, "w");
+	if (!perf->timeline) {
+		fprintf(stderr, "error: cannot open timeline %s\n", file);
+		return -EINVAL;
+	}
+
+	fprintf(perf->timeline, "{\n\t\"traceEvents\": [");
+
+	/* pid 0 is the scheduler, every pipeline gets its own track */
+	tb_perf_process_name(perf, 0, "ticks");
+	for (i = 0; i < perf->num_comps; i++) {
+		pid = dev_comp_pipe_id(perf->comps[i].dev);
+		if (pid == last_pid)
+			continue;
+
+		snprintf(name, sizeof(name), "pipeline %u", pid);
+		tb_perf_process_name(perf, pid, name);
+		last_pid = pid;
+	}
+
+	return 0;
+}
+
+static int tb_perf_grow(struct tb_perf *perf)
+{
+	uint64_t capacity = perf->capacity ? 2 * perf->capacity :
+		TB_PERF_MIN_TICKS;
+	uint32_t *ns;
+	int i;
+
+	ns = realloc(perf->tick_ns, capacity * sizeof(*ns));
+	if (!ns)
+		return -ENOMEM;
+
+	perf->tick_ns = ns;
+
+	for (i = 0; i < perf->num_comps; i++) {
+		ns = realloc(perf->comps[i].ns, capacity * sizeof(*ns));
+		if (!ns)
+			return -ENOMEM;
+
+		perf->comps[i].ns = ns;
+	}
+
+	perf->capacity = capacity;
+
+	return 0;
+}
+
+int tb_perf_init(struct tb_perf *perf, struct sof *sof,
+		 struct shared_lib_table *lib_table, uint32_t period_us,
+		 const char *timeline_file)
+{
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+	int n = 0;
+
+	memset(perf, 0, sizeof(*perf));
+	perf->period_us = period_us;
+
+	list_for_item(clist, &sof->ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type == COMP_TYPE_COMPONENT)
+			perf->num_comps++;
+	}
+
+	perf->comps = calloc(perf->num_comps, sizeof(*perf->comps));
+	if (!perf->comps && perf->num_comps)
+		return -ENOMEM;
+
+	list_for_item(clist, &sof->ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type != COMP_TYPE_COMPONENT)
+			continue;
+
+		perf->comps[n].dev = icd->cd;
+		tb_perf_comp_name(&perf->comps[n], lib_table);
+		n++;
+	}
+
+	if (tb_perf_grow(perf) < 0)
+		return -ENOMEM;
+
+	if (timeline_file)
+		return tb_perf_timeline_open(perf, timeline_file);
+
+	return 0;
+}
+
+void tb_perf_tick_begin(struct tb_perf *perf)
+{
+	perf->tick_start = platform_timer_get(timer_get());
+	if (!perf->ticks)
+		perf->time_base = perf->tick_start;
+}
+
+/*
+ * Gets the copy() cost of the component in the current tick, the counters
+ * are stamped at the end of every copy so an older stamp means the component
+ * did not run in this tick.
+ */
+static bool tb_perf_comp_cost(struct tb_perf *perf, struct tb_perf_comp *pc,
+			      uint64_t *end, uint32_t *ns)
+{
+#if CONFIG_PERFORMANCE_COUNTERS
+	struct perf_cnt_data *pcd = &pc->dev->pcd;
+
+	if (pcd->plat_ts < perf->tick_start)
+		return false;
+
+	*end = pcd->plat_ts;
+	*ns = pcd->plat_delta_last;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void tb_perf_tick_end(struct tb_perf *perf)
+{
+	uint64_t tick_end = platform_timer_get(timer_get());
+	struct tb_perf_comp *pc;
+	uint64_t end;
+	uint32_t ns;
+	int i;
+
+	if (perf->ticks == perf->capacity && tb_perf_grow(perf) < 0) {
+		fprintf(stderr, "error: out of memory for perf data\n");
+		return;
+	}
+
+	perf->tick_ns[perf->ticks++] = tick_end - perf->tick_start;
+
+	if (perf->timeline)
+		tb_perf_event(perf, "tick", 0, perf->tick_start,
+			      tick_end - perf->tick_start);
+
+	for (i = 0; i < perf->num_comps; i++) {
+		pc = &perf->comps[i];
+		if (!tb_perf_comp_cost(perf, pc, &end, &ns))
+			continue;
+
+		pc->ns[pc->count++] = ns;
+		pc->sum += ns;
+		pc->max = MAX(pc->max, ns);
+
+		if (perf->timeline)
+			tb_perf_event(perf, pc->name, dev_comp_pipe_id(pc->dev),
+				      end - ns, ns);
+	}
+}
+
+static int tb_perf_cmp(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* nearest rank percentile, sorts the data in place */
+static uint32_t tb_perf_percentile(uint32_t *ns, uint64_t count, int pct)
+{
+	uint64_t rank;
+
+	if (!count)
+		return 0;
+
+	qsort(ns, count, sizeof(*ns), tb_perf_cmp);
+	rank = (count * pct + 99) / 100;
+
+	return ns[rank ? rank - 1 : 0];
+}
+
+static void tb_perf_print(struct tb_perf *perf, const char *name,
+			  uint32_t *ns, uint64_t count, uint64_t sum,
+			  uint32_t max)
+{
+	double mean = count ? (double)sum / count : 0;
+	double load = perf->period_us ?
+		100 * mean / TB_PERF_TICKS_PER_US / perf->period_us : 0;
+
+	printf("%-20s %8llu %10.2f %10.2f %10.2f %7.2f%%\n", name,
+	       (unsigned long long)count, mean / TB_PERF_TICKS_PER_US,
+	       (double)tb_perf_percentile(ns, count, 99) / TB_PERF_TICKS_PER_US,
+	       (double)max / TB_PERF_TICKS_PER_US, load);
+}
+
+void tb_perf_report(struct tb_perf *perf)
+{
+	struct tb_perf_comp *pc;
+	uint64_t sum = 0;
+	uint32_t max = 0;
+	uint64_t t;
+	int i;
+
+	printf("==========================================================\n");
+	printf("		       Component Load\n");
+	printf("==========================================================\n");
+
+#if !CONFIG_PERFORMANCE_COUNTERS
+	printf("note: performance counters are disabled in this build\n");
+#endif
+
+	printf("%-20s %8s %10s %10s %10s %8s\n", "component", "periods",
+	       "mean us", "p99 us", "max us", "load");
+
+	for (i = 0; i < perf->num_comps; i++) {
+		pc = &perf->comps[i];
+		tb_perf_print(perf, pc->name, pc->ns, pc->count, pc->sum,
+			      pc->max);
+	}
+
+	for (t = 0; t < perf->ticks; t++) {
+		sum += perf->tick_ns[t];
+		max = MAX(max, perf->tick_ns[t]);
+	}
+
+	tb_perf_print(perf, "tick", perf->tick_ns, perf->ticks, sum, max);
+	printf("Load is mean cost against the %u us scheduling period.\n",
+	       perf->period_us);
+}
+
+void tb_perf_free(struct tb_perf *perf)
+{
+	int i;
+
+	if (perf->timeline) {
+		fprintf(perf->timeline, "\n\t]\n}\n");
+		fclose(perf->timeline);
+	}
+
+	for (i = 0; i < perf->num_comps; i++)
+		free(perf->comps[i].ns);
+
+	free(perf->comps);
+	free(perf->tick_ns);
+}
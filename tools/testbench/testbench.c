@@ -9,10 +9,13 @@
 #include <sof/list.h>
 #include <getopt.h>
 #include <dlfcn.h>
+#include <unistd.h>
 #include "testbench/common_test.h"
 #include <tplg_parser/topology.h>
 #include "testbench/trace.h"
 #include "testbench/file.h"
+#include "testbench/perf.h"
+#include "testbench/batch.h"
 
 #define DECLARE_SOF_TB_UUID(entity_name, uuid_name,			\
 			 va, vb, vc,					\
@@ -139,8 +142,14 @@ static void print_usage(char *executable)
 	printf("Usage: %s -i <input_file> ", executable);
 	printf("-o <output_file1,output_file2,...> ");
 	printf("-t <tplg_file> -b <input_format> -c <channels>");
-	printf("-a <comp1=comp1_library,comp2=comp2_library>\n");
+	printf("-a <comp1=comp1_library,comp2=comp2_library> ");
+	printf("[-T <timeline_json>]\n");
+	printf("Batch usage: %s -B <batch_file> [-j <workers>] ", executable);
+	printf("-b <input_format> <other options>\n");
 	printf("input_format should be S16_LE, S32_LE, S24_LE or FLOAT_LE\n");
+	printf("timeline_json is a Chrome trace of every component copy\n");
+	printf("batch_file lists one <tplg_file> <input_file> ");
+	printf("<output_file1,output_file2,...> job per line\n");
 	printf("Example Usage:\n");
 	printf("%s -i in.txt -o out.txt -t test.tplg ", executable);
 	printf("-r 48000 -R 96000 -c 2");
@@ -182,7 +191,7 @@ static void parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 	int option = 0;
 	int ret = 0;
 
-	while ((option = getopt(argc, argv, "hdi:o:t:b:a:r:R:c:")) != -1) {
+	while ((option = getopt(argc, argv, "hdi:o:t:b:a:r:R:c:T:B:j:")) != -1) {
 		switch (option) {
 		/* input sample file */
 		case 'i':
@@ -225,6 +234,21 @@ static void parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 			tp->channels = atoi(optarg);
 			break;
 
+		/* component copy timeline file */
+		case 'T':
+			tp->timeline_file = strdup(optarg);
+			break;
+
+		/* batch of jobs */
+		case 'B':
+			tp->batch_file = strdup(optarg);
+			break;
+
+		/* number of parallel batch jobs */
+		case 'j':
+			tp->batch_workers = atoi(optarg);
+			break;
+
 		/* enable debug prints */
 		case 'd':
 			debug = 1;
@@ -242,9 +266,8 @@ static void parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 	}
 }
 
-int main(int argc, char **argv)
+static int run_testbench(struct testbench_prm *tp)
 {
-	struct testbench_prm tp;
 	struct ipc_comp_dev *pcm_dev;
 	struct pipeline *p;
 	struct pipeline *curr_p;
@@ -252,33 +275,12 @@ int main(int argc, char **argv)
 	struct comp_dev *cd;
 	struct file_comp_data *frcd, *fwcd;
 	char pipeline[DEBUG_MSG_LEN];
+	struct tb_perf perf;
 	clock_t tic, toc;
 	double c_realtime, t_exec;
 	int n_in, n_out, ret;
 	int i;
 
-	/* initialize input and output sample rates, files, etc. */
-	tp.fs_in = 0;
-	tp.fs_out = 0;
-	tp.bits_in = 0;
-	tp.input_file = NULL;
-	tp.tplg_file = NULL;
-	for (i = 0; i < MAX_OUTPUT_FILE_NUM; i++)
-		tp.output_file[i] = NULL;
-	tp.output_file_num = 0;
-	tp.channels = TESTBENCH_NCH;
-	tp.max_pipeline_id = 0;
-
-	/* command line arguments*/
-	parse_input_args(argc, argv, &tp);
-
-	/* check args */
-	if (!tp.tplg_file || !tp.input_file || !tp.output_file_num ||
-	    !tp.bits_in) {
-		print_usage(argv[0]);
-		exit(EXIT_FAILURE);
-	}
-
 	/* initialize ipc and scheduler */
 	if (tb_pipeline_setup(&sof) < 0) {
 		fprintf(stderr, "error: pipeline init\n");
@@ -286,13 +288,13 @@ int main(int argc, char **argv)
 	}
 
 	/* parse topology file and create pipeline */
-	if (parse_topology(&sof, lib_table, &tp, pipeline) < 0) {
+	if (parse_topology(&sof, lib_table, tp, pipeline) < 0) {
 		fprintf(stderr, "error: parsing topology\n");
 		exit(EXIT_FAILURE);
 	}
 
 	/* Get pointer to filewrite */
-	pcm_dev = ipc_get_comp_by_id(sof.ipc, tp.fw_id);
+	pcm_dev = ipc_get_comp_by_id(sof.ipc, tp->fw_id);
 	if (!pcm_dev) {
 		fprintf(stderr, "error: failed to get pointers to filewrite\n");
 		exit(EXIT_FAILURE);
@@ -300,7 +302,7 @@ int main(int argc, char **argv)
 	fwcd = comp_get_drvdata(pcm_dev->cd);
 
 	/* Get pointer to fileread */
-	pcm_dev = ipc_get_comp_by_id(sof.ipc, tp.fr_id);
+	pcm_dev = ipc_get_comp_by_id(sof.ipc, tp->fr_id);
 	if (!pcm_dev) {
 		fprintf(stderr, "error: failed to get pointers to fileread\n");
 		exit(EXIT_FAILURE);
@@ -308,28 +310,37 @@ int main(int argc, char **argv)
 	frcd = comp_get_drvdata(pcm_dev->cd);
 
 	/* Run pipeline until EOF from fileread */
-	pcm_dev = ipc_get_comp_by_id(sof.ipc, tp.sched_id);
+	pcm_dev = ipc_get_comp_by_id(sof.ipc, tp->sched_id);
 	p = pcm_dev->cd->pipeline;
 	ipc_pipe = &p->ipc_pipe;
 
 	/* input and output sample rate */
-	if (!tp.fs_in)
-		tp.fs_in = ipc_pipe->period * ipc_pipe->frames_per_sched;
+	if (!tp->fs_in)
+		tp->fs_in = ipc_pipe->period * ipc_pipe->frames_per_sched;
 
-	if (!tp.fs_out)
-		tp.fs_out = ipc_pipe->period * ipc_pipe->frames_per_sched;
+	if (!tp->fs_out)
+		tp->fs_out = ipc_pipe->period * ipc_pipe->frames_per_sched;
 
 	/* set pipeline params and trigger start */
-	if (tb_pipeline_start(sof.ipc, ipc_pipe, &tp) < 0) {
+	if (tb_pipeline_start(sof.ipc, ipc_pipe, tp) < 0) {
 		fprintf(stderr, "error: pipeline params\n");
 		exit(EXIT_FAILURE);
 	}
 
+	/* per component cost of each scheduling period */
+	if (tb_perf_init(&perf, &sof, lib_table, ipc_pipe->period,
+			 tp->timeline_file) < 0) {
+		fprintf(stderr, "error: perf init\n");
+		exit(EXIT_FAILURE);
+	}
+
 	cd = pcm_dev->cd;
 	tb_enable_trace(false); /* reduce trace output */
 	tic = clock();
 
 	while (frcd->fs.reached_eof == 0) {
+		tb_perf_tick_begin(&perf);
+
 		/*
 		 * Schedule copy for all pipelines which have the same schedule
 		 * component as the working one.
@@ -338,7 +349,7 @@ int main(int argc, char **argv)
 		 * increasing IDs started from 1, we could take care of it in
 		 * test topologies so this for-loop will walk all pipelines.
 		 */
-		for (i = 1; i <= tp.max_pipeline_id; i++) {
+		for (i = 1; i <= tp->max_pipeline_id; i++) {
 			pcm_dev = ipc_get_comp_by_ppl_id(sof.ipc,
 							 COMP_TYPE_PIPELINE, i);
 			if (pcm_dev) {
@@ -347,6 +358,8 @@ int main(int argc, char **argv)
 					pipeline_schedule_copy(curr_p, 0);
 			}
 		}
+
+		tb_perf_tick_end(&perf);
 	}
 
 	if (!frcd->fs.reached_eof)
@@ -365,7 +378,7 @@ int main(int argc, char **argv)
 	n_in = frcd->fs.n;
 	n_out = fwcd->fs.n;
 	t_exec = (double)(toc - tic) / CLOCKS_PER_SEC;
-	c_realtime = (double)n_out / tp.channels / tp.fs_out / t_exec;
+	c_realtime = (double)n_out / tp->channels / tp->fs_out / t_exec;
 
 	/* free all components/buffers in pipeline */
 	free_comps();
@@ -376,22 +389,79 @@ int main(int argc, char **argv)
 	printf("==========================================================\n");
 	printf("Test Pipeline:\n");
 	printf("%s\n", pipeline);
-	printf("Input bit format: %s\n", tp.bits_in);
-	printf("Input sample rate: %d\n", tp.fs_in);
-	printf("Output sample rate: %d\n", tp.fs_out);
-	for (i = 0; i < tp.output_file_num; i++) {
+	printf("Input bit format: %s\n", tp->bits_in);
+	printf("Input sample rate: %d\n", tp->fs_in);
+	printf("Output sample rate: %d\n", tp->fs_out);
+	for (i = 0; i < tp->output_file_num; i++) {
 		printf("Output[%d] written to file: \"%s\"\n",
-		       i, tp.output_file[i]);
+		       i, tp->output_file[i]);
 	}
 	printf("Input sample count: %d\n", n_in);
 	printf("Output sample count: %d\n", n_out);
 	printf("Total execution time: %.2f us, %.2f x realtime\n",
 	       1e3 * t_exec, c_realtime);
+	if (tp->timeline_file)
+		printf("Timeline written to file: \"%s\"\n", tp->timeline_file);
+
+	/* print component load, the perf data is kept by the tracker */
+	tb_perf_report(&perf);
+	tb_perf_free(&perf);
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	struct testbench_prm tp;
+	int ret;
+	int i;
+
+	/* initialize input and output sample rates, files, etc. */
+	tp.fs_in = 0;
+	tp.fs_out = 0;
+	tp.bits_in = 0;
+	tp.input_file = NULL;
+	tp.tplg_file = NULL;
+	for (i = 0; i < MAX_OUTPUT_FILE_NUM; i++)
+		tp.output_file[i] = NULL;
+	tp.output_file_num = 0;
+	tp.channels = TESTBENCH_NCH;
+	tp.max_pipeline_id = 0;
+	tp.timeline_file = NULL;
+	tp.batch_file = NULL;
+	tp.batch_workers = sysconf(_SC_NPROCESSORS_ONLN);
+
+	/* command line arguments*/
+	parse_input_args(argc, argv, &tp);
+
+	/* batch jobs get the files from the batch file */
+	if (tp.batch_file) {
+		/* jobs would overwrite each other's timeline */
+		if (!tp.bits_in || tp.batch_workers < 1 || tp.timeline_file) {
+			print_usage(argv[0]);
+			exit(EXIT_FAILURE);
+		}
+
+		ret = tb_batch_run(&tp, run_testbench);
+		goto out;
+	}
+
+	/* check args */
+	if (!tp.tplg_file || !tp.input_file || !tp.output_file_num ||
+	    !tp.bits_in) {
+		print_usage(argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	ret = run_testbench(&tp);
 
+out:
 	/* free all other data */
 	free(tp.bits_in);
 	free(tp.input_file);
 	free(tp.tplg_file);
+	free(tp.timeline_file);
+	free(tp.batch_file);
 	for (i = 0; i < tp.output_file_num; i++)
 		free(tp.output_file[i]);
 
@@ -401,5 +471,5 @@ int main(int argc, char **argv)
 			dlclose(lib_table[i].handle);
 	}
 
-	return EXIT_SUCCESS;
+	return ret < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
 }
@@ -130,3 +130,9 @@ int schedule_task_init_edf_with_budget(struct task *task,
 {
 	return schedule_task_init_edf(task, uid, ops, data, core, flags);
 }
+
+/* the work queue keeps no per task statistics */
+int schedule_edf_task_stats(struct edf_task_info *info, int count)
+{
+	return 0;
+}
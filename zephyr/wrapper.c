@@ -151,6 +151,12 @@ void *rballoc_align(uint32_t flags, uint32_t caps, size_t bytes,
 	return heap_alloc_aligned(&sof_heap, alignment, bytes);
 }
 
+/* the Zephyr heap doesn't report the space taken by a block */
+size_t rballoc_heap_size(void *ptr)
+{
+	return 0;
+}
+
 /*
  * Free's memory allocated by above alloc calls.
  */